@@ -0,0 +1,453 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * register backends
+ *
+ * a context reaches the registers through a backend, which maps the page
+ * at a physical address into the process:
+ *
+ *   devmem  the real thing, pages of /dev/mem
+ *   sim     a memory image of the peripheral space for running the tools
+ *           on a development host; every described register starts at its
+ *           reset value
+ *           with no argument the image is anonymous memory private to the
+ *           context, otherwise the argument names an image file which is
+ *           created (and seeded) if needed and mapped shared, so the state
+ *           carries over from one tool to the next, e.g.
+ *             $ LPC32X0_SIM=/tmp/lpc.img lpc32x0-write 0x40004050 0x1
+ *             $ LPC32X0_SIM=/tmp/lpc.img lpc32x0-dump -r 0x40004050
+ *           SPI1, the SPI-NOR flash on it, its chip selects and the GPDMA
+ *           (for SPI1) are modelled (see spisim.c), configured from the
+ *           environment:
+ *             LPC32X0_SIM_FLASH      the on-board flash's image file
+ *                                    (default: anonymous, erased)
+ *             LPC32X0_SIM_BOOTSTICK  the bootstick flash's image file
+ *                                    (default: no bootstick)
+ *           the model's timing runs at the HCLK the image's clock registers
+ *           give (with the lpc32x0__osc_hz() oscillator) when it is opened,
+ *           and again once a capture has been loaded into the image
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "registers.h"
+#include "sim.h"
+
+/*
+ * devmem
+ */
+typedef struct {
+	int fd;
+} DevMem_t;
+
+static void *
+devmem_open (unused const char *arg_p)
+{
+	DevMem_t *devMem_p;
+
+	devMem_p = malloc(sizeof(*devMem_p));
+	if (devMem_p == NULL) {
+		perror("malloc()");
+		return NULL;
+	}
+	devMem_p->fd = open("/dev/mem", O_RDWR | O_SYNC);
+	if (devMem_p->fd == -1) {
+		perror("open(/dev/mem)");
+		free(devMem_p);
+		return NULL;
+	}
+	return devMem_p;
+}
+
+static void
+devmem_close (void *state_p)
+{
+	DevMem_t *devMem_p = state_p;
+
+	close(devMem_p->fd);
+	free(devMem_p);
+}
+
+static void *
+devmem_map (void *state_p, uint32_t base, size_t len)
+{
+	void *map_p;
+	DevMem_t *devMem_p = state_p;
+
+	map_p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, devMem_p->fd, base);
+	if (map_p == MAP_FAILED) {
+		perror("mmap()");
+		return NULL;
+	}
+	return map_p;
+}
+
+static void
+devmem_unmap (unused void *state_p, void *map_p, size_t len)
+{
+	munmap(map_p, len);
+}
+
+const Lpc32x0Backend_t lpc32x0__devmem_backend = {
+	.name_p = "devmem",
+	.open_fp = devmem_open,
+	.close_fp = devmem_close,
+	.map_fp = devmem_map,
+	.unmap_fp = devmem_unmap,
+};
+
+/*
+ * sim
+ *
+ * anonymous images allocate a page the first time it is mapped and keep it
+ * until the context is closed; file images are sparse files covering every
+ * described register, mapped page by page like /dev/mem
+ */
+#define SIM_PAGESZ 0x1000
+
+typedef struct {
+	uint32_t base;
+	void *page_p;
+} SimPage_t;
+
+typedef struct {
+	uint32_t base;
+	size_t len;
+	void *map_p;
+} SimMemMap_t;
+
+typedef struct {
+	int fd;
+	SimPage_t *pages_p;
+	size_t pageCnt;
+	size_t pageMax;
+	SimMemMap_t *mems_p;
+	size_t memCnt;
+	size_t memMax;
+	volatile uint32_t *p3_p;
+	SpiSim_t *spi_p;
+} Sim_t;
+
+static void *
+sim_map (void *state_p, uint32_t base, size_t len)
+{
+	size_t i;
+	void *map_p;
+	SimPage_t *tmp_p;
+	Sim_t *sim_p = state_p;
+
+	if (sim_p->fd != -1) {
+		map_p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, sim_p->fd, base);
+		if (map_p == MAP_FAILED) {
+			perror("mmap()");
+			return NULL;
+		}
+		return map_p;
+	}
+
+	for (i=0; i<sim_p->pageCnt; ++i)
+		if (sim_p->pages_p[i].base == base)
+			return sim_p->pages_p[i].page_p;
+
+	if (sim_p->pageCnt == sim_p->pageMax) {
+		tmp_p = realloc(sim_p->pages_p, (sim_p->pageMax + 16) * sizeof(*tmp_p));
+		if (tmp_p == NULL) {
+			perror("realloc()");
+			return NULL;
+		}
+		sim_p->pages_p = tmp_p;
+		sim_p->pageMax += 16;
+	}
+	map_p = mmap(NULL, SIM_PAGESZ, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map_p == MAP_FAILED) {
+		perror("mmap()");
+		return NULL;
+	}
+	sim_p->pages_p[sim_p->pageCnt].base = base;
+	sim_p->pages_p[sim_p->pageCnt].page_p = map_p;
+	++sim_p->pageCnt;
+	return map_p;
+}
+
+static void
+sim_unmap (void *state_p, void *map_p, size_t len)
+{
+	Sim_t *sim_p = state_p;
+
+	// anonymous pages hold the image, they're only freed on close
+	if (sim_p->fd != -1)
+		munmap(map_p, len);
+}
+
+/*
+ * memory isn't part of the image: each mapping is fresh anonymous memory,
+ * so the tools that use it (e.g. lpc32x0-membench) run, but on the host's
+ * memory
+ * the mappings are remembered so the models' DMA can reach them (see
+ * sim_find_mem())
+ */
+static void *
+sim_map_mem (void *state_p, uint32_t base, size_t len)
+{
+	void *map_p;
+	SimMemMap_t *tmp_p;
+	Sim_t *sim_p = state_p;
+
+	if (sim_p->memCnt == sim_p->memMax) {
+		tmp_p = realloc(sim_p->mems_p, (sim_p->memMax + 4) * sizeof(*tmp_p));
+		if (tmp_p == NULL) {
+			perror("realloc()");
+			return NULL;
+		}
+		sim_p->mems_p = tmp_p;
+		sim_p->memMax += 4;
+	}
+	map_p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map_p == MAP_FAILED) {
+		perror("mmap()");
+		return NULL;
+	}
+	sim_p->mems_p[sim_p->memCnt].base = base;
+	sim_p->mems_p[sim_p->memCnt].len = len;
+	sim_p->mems_p[sim_p->memCnt].map_p = map_p;
+	++sim_p->memCnt;
+	return map_p;
+}
+
+static void
+sim_unmap_mem (void *state_p, void *map_p, size_t len)
+{
+	size_t i;
+	Sim_t *sim_p = state_p;
+
+	for (i=0; i<sim_p->memCnt; ++i)
+		if (sim_p->mems_p[i].map_p == map_p) {
+			sim_p->mems_p[i] = sim_p->mems_p[--sim_p->memCnt];
+			break;
+		}
+	munmap(map_p, len);
+}
+
+/*
+ * where the 'len' bytes at physical address 'addr' are mapped, or NULL
+ */
+static void *
+sim_find_mem (void *state_p, uint32_t addr, size_t len)
+{
+	size_t i;
+	Sim_t *sim_p = state_p;
+
+	for (i=0; i<sim_p->memCnt; ++i)
+		if ((addr >= sim_p->mems_p[i].base) && (len <= sim_p->mems_p[i].len)
+				&& ((addr - sim_p->mems_p[i].base) <= (sim_p->mems_p[i].len - len)))
+			return (uint8_t*)sim_p->mems_p[i].map_p + (addr - sim_p->mems_p[i].base);
+	return NULL;
+}
+
+static void
+sim_close (void *state_p)
+{
+	size_t i;
+	Sim_t *sim_p = state_p;
+
+	spisim_close(sim_p->spi_p);
+	if ((sim_p->p3_p != NULL) && (sim_p->fd != -1))
+		munmap((void*)sim_p->p3_p, SIM_PAGESZ);
+	for (i=0; i<sim_p->pageCnt; ++i)
+		munmap(sim_p->pages_p[i].page_p, SIM_PAGESZ);
+	free(sim_p->pages_p);
+	for (i=0; i<sim_p->memCnt; ++i)
+		munmap(sim_p->mems_p[i].map_p, sim_p->mems_p[i].len);
+	free(sim_p->mems_p);
+	if (sim_p->fd != -1)
+		close(sim_p->fd);
+	free(sim_p);
+}
+
+// every described register at its reset value
+static bool
+sim_seed (Sim_t *sim_p, RegisterDescription_t **index_pp, size_t cnt)
+{
+	size_t i;
+	uint32_t base;
+	uint8_t *page_p = NULL;
+
+	base = 0;
+	for (i=0; i<cnt; ++i) {
+		if ((page_p == NULL) || ((index_pp[i]->addr & ~(uint32_t)(SIM_PAGESZ - 1)) != base)) {
+			if ((page_p != NULL) && (sim_p->fd != -1))
+				munmap(page_p, SIM_PAGESZ);
+			base = index_pp[i]->addr & ~(uint32_t)(SIM_PAGESZ - 1);
+			page_p = sim_map(sim_p, base, SIM_PAGESZ);
+			if (page_p == NULL)
+				return false;
+		}
+		// aliases of an address keep the first description's reset value
+		if ((i > 0) && (index_pp[i-1]->addr == index_pp[i]->addr))
+			continue;
+		*(uint32_t*)(page_p + (index_pp[i]->addr & (SIM_PAGESZ - 1))) = index_pp[i]->resetState;
+	}
+	if ((page_p != NULL) && (sim_p->fd != -1))
+		munmap(page_p, SIM_PAGESZ);
+	return true;
+}
+
+static uint32_t
+page_word (const uint8_t *page_p, uint32_t addr)
+{
+	return *(const uint32_t*)(page_p + (addr & (SIM_PAGESZ - 1)));
+}
+
+// HCLK from the image's clock registers, so the models agree with lpc32x0__get_clocks()
+static bool
+sim_hclk (Sim_t *sim_p, uint32_t *hclk_p)
+{
+	uint8_t *page_p;
+	ClockRegs_t regs;
+	Clocks_t clocks;
+
+	page_p = sim_map(sim_p, PWR_CTRL & ~(uint32_t)(SIM_PAGESZ - 1), SIM_PAGESZ);
+	if (page_p == NULL)
+		return false;
+	regs.pwrCtrl = page_word(page_p, PWR_CTRL);
+	regs.oscCtrl = page_word(page_p, OSC_CTRL);
+	regs.sysclkCtrl = page_word(page_p, SYSCLK_CTRL);
+	regs.pll397Ctrl = page_word(page_p, PLL397_CTRL);
+	regs.hclkpllCtrl = page_word(page_p, HCLKPLL_CTRL);
+	regs.hclkdivCtrl = page_word(page_p, HCLKDIV_CTRL);
+	regs.usbCtrl = page_word(page_p, USB_CTRL);
+	regs.usbdivCtrl = page_word(page_p, USBDIV_CTRL);
+	sim_unmap(sim_p, page_p, SIM_PAGESZ);
+
+	lpc32x0__eval_clocks(&regs, 0, &clocks);
+	if ((clocks.hclk == 0) || (clocks.hclk > 0xffffffffull)) {
+		printf("the image's clock registers give an HCLK of %" PRIu64 " Hz\n", clocks.hclk);
+		return false;
+	}
+	*hclk_p = (uint32_t)clocks.hclk;
+	return true;
+}
+
+// the models keep the GPIO page mapped
+static bool
+sim_open_models (Sim_t *sim_p)
+{
+	uint32_t hclk;
+	SimMem_t mem;
+
+	if (!sim_hclk(sim_p, &hclk))
+		return false;
+
+	sim_p->p3_p = sim_map(sim_p, P3_INP_STATE & ~(uint32_t)(SIM_PAGESZ - 1), SIM_PAGESZ);
+	if (sim_p->p3_p == NULL)
+		return false;
+	mem.find_fp = sim_find_mem;
+	mem.arg_p = sim_p;
+	sim_p->spi_p = spisim_open(sim_p->p3_p, hclk, getenv("LPC32X0_SIM_FLASH"), getenv("LPC32X0_SIM_BOOTSTICK"), &mem);
+	return (sim_p->spi_p != NULL);
+}
+
+static void *
+sim_open (const char *arg_p)
+{
+	size_t cnt;
+	off_t size;
+	struct stat st;
+	Sim_t *sim_p;
+	RegisterDescription_t **index_pp;
+
+	index_pp = lpc32x0__reg_index(&cnt);
+	if ((index_pp == NULL) || (cnt == 0))
+		return NULL;
+
+	sim_p = calloc(1, sizeof(*sim_p));
+	if (sim_p == NULL) {
+		perror("calloc()");
+		return NULL;
+	}
+	sim_p->fd = -1;
+
+	if ((arg_p != NULL) && (*arg_p != 0)) {
+		sim_p->fd = open(arg_p, O_RDWR | O_CREAT, 0644);
+		if ((sim_p->fd == -1) || (fstat(sim_p->fd, &st) == -1)) {
+			perror(arg_p);
+			sim_close(sim_p);
+			return NULL;
+		}
+		// an existing image keeps its state
+		if (st.st_size != 0)
+			goto models;
+
+		size = (off_t)(index_pp[cnt-1]->addr & ~(uint32_t)(SIM_PAGESZ - 1)) + SIM_PAGESZ;
+		if (ftruncate(sim_p->fd, size) == -1) {
+			perror(arg_p);
+			sim_close(sim_p);
+			return NULL;
+		}
+	}
+
+	if (!sim_seed(sim_p, index_pp, cnt)) {
+		sim_close(sim_p);
+		return NULL;
+	}
+models:
+	if (!sim_open_models(sim_p)) {
+		sim_close(sim_p);
+		return NULL;
+	}
+	return sim_p;
+}
+
+// a capture may have changed the clock registers
+bool
+sim_reclock (void *state_p)
+{
+	uint32_t hclk;
+	Sim_t *sim_p = state_p;
+
+	if (!sim_hclk(sim_p, &hclk))
+		return false;
+	spisim_set_hclk(sim_p->spi_p, hclk);
+	return true;
+}
+
+static const RegHook_t *
+sim_hook (void *state_p, uint32_t addr)
+{
+	Sim_t *sim_p = state_p;
+
+	return spisim_hook(sim_p->spi_p, addr);
+}
+
+bool
+sim_get_spi_stats (void *state_p, SpiSimStats_t *stats_p)
+{
+	Sim_t *sim_p = state_p;
+
+	spisim_get_stats(sim_p->spi_p, stats_p);
+	return true;
+}
+
+const Lpc32x0Backend_t lpc32x0__sim_backend = {
+	.name_p = "sim",
+	.open_fp = sim_open,
+	.close_fp = sim_close,
+	.map_fp = sim_map,
+	.unmap_fp = sim_unmap,
+	.hook_fp = sim_hook,
+	.map_mem_fp = sim_map_mem,
+	.unmap_mem_fp = sim_unmap_mem,
+};
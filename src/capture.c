@@ -0,0 +1,444 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * streaming parser for register captures
+ *
+ * the input is read in large blocks and split into lines by hand; each line
+ * is recognized as one of:
+ *
+ *   gdb "x/Nx":     0x40024000:     0x0066506c      0xfea1eb93 ...
+ *                   0xc0008000 <stext>: 0x...       0x...
+ *   U-Boot "md.l":  40024000: 0060418b bea7fa74 00800440    .A`.t.......
+ *   devmem:         # devmem 0x40004058          (address, possibly with
+ *                   0x0001601E                    the value on the next line)
+ *                   # devmem 0x40004058 32 0x1601e
+ *   hexdump -C:     40004000  6c 50 66 00 93 eb a1 fe  40 04 80 00 01 04 01 00  |lPf.....@.......|
+ *                   *
+ *   anything else is ignored
+ *
+ * any number of words are accepted per line; the ASCII tail U-Boot adds
+ * (separated from the words by several spaces) and hexdump's |...| column
+ * are skipped
+ *
+ * a binary snapshot (see snapshot.c) is recognized by its magic at the start
+ * of the input
+ *
+ * gdb captures taken under a running lpc32xx kernel show the kernel's static
+ * I/O mapping (e.g. 0xf4004000 for 0x40004000); those addresses are
+ * translated back to physical addresses
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "registers.h"
+
+#define CAPTURE_BLOCKSZ (1024 * 1024)
+
+typedef struct {
+	CaptureWord_t word_fp;
+	void *arg_p;
+	CaptureStats_t *stats_p;
+
+	// devmem
+	bool devmemPending;
+	uint32_t devmemAddr;
+
+	// hexdump -C
+	bool hexdumpActive;
+	bool hexdumpRepeat;
+	uint32_t hexdumpNext;
+	uint8_t hexdumpLast[32];
+	size_t hexdumpLastLen;
+} ParseState_t;
+
+static bool
+is_hex (char c)
+{
+	return ((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'f')) || ((c >= 'A') && (c <= 'F'));
+}
+
+static unsigned
+hex_val (char c)
+{
+	if (c <= '9')
+		return (unsigned)(c - '0');
+	if (c >= 'a')
+		return (unsigned)(c - 'a' + 10);
+	return (unsigned)(c - 'A' + 10);
+}
+
+/*
+ * parse a hex number (optionally 0x-prefixed, at most 8 digits) at *p_p
+ * which must be followed by whitespace, the end of the line, or 'term'
+ * on success *p_p is moved past the number
+ */
+static bool
+parse_hex (const char **p_p, const char *end_p, char term, uint32_t *val_p, bool *prefixed_p)
+{
+	const char *p = *p_p;
+	unsigned digits = 0;
+	uint32_t val = 0;
+
+	if (prefixed_p != NULL)
+		*prefixed_p = false;
+	if (((end_p - p) > 2) && (p[0] == '0') && ((p[1] == 'x') || (p[1] == 'X'))) {
+		p += 2;
+		if (prefixed_p != NULL)
+			*prefixed_p = true;
+	}
+	while ((p < end_p) && is_hex(*p)) {
+		if (++digits > 8)
+			return false;
+		val = (val << 4) | hex_val(*p++);
+	}
+	if (digits == 0)
+		return false;
+	if ((p < end_p) && (*p != ' ') && (*p != '\t') && (*p != '\r') && (*p != term))
+		return false;
+
+	*val_p = val;
+	*p_p = p;
+	return true;
+}
+
+/*
+ * parse a decimal number (at most 9 digits) at *p_p, bounded by 'end_p'
+ * (the read block isn't NUL-terminated, so no sscanf())
+ * on success *p_p is moved past the digits
+ */
+static bool
+parse_dec (const char **p_p, const char *end_p, uint32_t *val_p)
+{
+	const char *p = *p_p;
+	unsigned digits = 0;
+	uint32_t val = 0;
+
+	while ((p < end_p) && (*p >= '0') && (*p <= '9')) {
+		if (++digits > 9)
+			return false;
+		val = (val * 10) + (uint32_t)(*p++ - '0');
+	}
+	if (digits == 0)
+		return false;
+
+	*val_p = val;
+	*p_p = p;
+	return true;
+}
+
+static const char *
+skip_blanks (const char *p, const char *end_p)
+{
+	while ((p < end_p) && ((*p == ' ') || (*p == '\t') || (*p == '\r')))
+		++p;
+	return p;
+}
+
+/*
+ * the lpc32xx kernel maps its peripherals at
+ *   IO_ADDRESS(x) = 0xf0000000 | ((x & 0xff000000) >> 4) | (x & 0x000fffff)
+ */
+static uint32_t
+phys_addr (uint32_t addr)
+{
+	if ((addr & 0xf0000000) != 0xf0000000)
+		return addr;
+	return ((addr & 0x0ff00000) << 4) | (addr & 0x000fffff);
+}
+
+static void
+emit (ParseState_t *state_p, uint32_t addr, uint32_t val)
+{
+	++state_p->stats_p->words;
+	(*state_p->word_fp)(addr, val, state_p->arg_p);
+}
+
+static void
+emit_hexdump_line (ParseState_t *state_p, uint32_t offset, const uint8_t *bytes_p, size_t len)
+{
+	size_t i;
+
+	for (i=0; (i+4)<=len; i+=4) {
+		if (offset > (0xffffffff - i))
+			break;
+		emit(state_p, offset + (uint32_t)i,
+				(uint32_t)bytes_p[i] | ((uint32_t)bytes_p[i+1] << 8) |
+				((uint32_t)bytes_p[i+2] << 16) | ((uint32_t)bytes_p[i+3] << 24));
+	}
+}
+
+/*
+ * hexdump prints "*" instead of lines identical to the previous one; when
+ * the next offset shows up, replay the previous line up to it
+ */
+static void
+hexdump_catch_up (ParseState_t *state_p, uint32_t offset)
+{
+	uint32_t next;
+
+	if (!state_p->hexdumpRepeat || (state_p->hexdumpLastLen == 0))
+		return;
+	state_p->hexdumpRepeat = false;
+
+	for (next=state_p->hexdumpNext; next<offset; next+=(uint32_t)state_p->hexdumpLastLen) {
+		emit_hexdump_line(state_p, next, state_p->hexdumpLast, state_p->hexdumpLastLen);
+		if (next > (0xffffffff - state_p->hexdumpLastLen))
+			break;
+	}
+}
+
+static bool
+parse_hexdump (ParseState_t *state_p, uint32_t offset, const char *p, const char *end_p)
+{
+	uint8_t bytes[32];
+	size_t len = 0;
+
+	while (len < sizeof(bytes)) {
+		p = skip_blanks(p, end_p);
+		if (((end_p - p) < 2) || !is_hex(p[0]) || !is_hex(p[1]))
+			break;
+		if (((end_p - p) > 2) && (p[2] != ' ') && (p[2] != '\t') && (p[2] != '\r'))
+			break;
+		bytes[len++] = (uint8_t)((hex_val(p[0]) << 4) | hex_val(p[1]));
+		p += 2;
+	}
+	if (len == 0)
+		return false;
+
+	hexdump_catch_up(state_p, offset);
+	emit_hexdump_line(state_p, offset, bytes, len);
+	memcpy(state_p->hexdumpLast, bytes, len);
+	state_p->hexdumpLastLen = len;
+	state_p->hexdumpNext = offset + (uint32_t)len;
+	state_p->hexdumpActive = true;
+	return true;
+}
+
+static void
+parse_devmem (ParseState_t *state_p, const char *p, const char *end_p)
+{
+	uint32_t addr, width, val;
+
+	p = skip_blanks(p, end_p);
+	if (!parse_hex(&p, end_p, 0, &addr, NULL))
+		return;
+	p = skip_blanks(p, end_p);
+
+	// optional width, then optional value to write
+	if (parse_dec(&p, end_p, &width)) {
+		while ((p < end_p) && (*p != ' ') && (*p != '\t'))
+			++p;
+		p = skip_blanks(p, end_p);
+		if ((p < end_p) && parse_hex(&p, end_p, 0, &val, NULL)) {
+			emit(state_p, addr, val);
+			return;
+		}
+	}
+	state_p->devmemPending = true;
+	state_p->devmemAddr = addr;
+}
+
+static void
+parse_line (ParseState_t *state_p, const char *p, const char *end_p)
+{
+	bool prefixed, pending;
+	uint32_t addr, val, i;
+	const char *q;
+
+	++state_p->stats_p->lines;
+	pending = state_p->devmemPending;
+	state_p->devmemPending = false;
+
+	p = skip_blanks(p, end_p);
+	if (p == end_p)
+		return;
+
+	// hexdump's marker for repeated lines
+	if ((*p == '*') && (skip_blanks(p+1, end_p) == end_p)) {
+		if (state_p->hexdumpActive)
+			state_p->hexdumpRepeat = true;
+		return;
+	}
+
+	if (!parse_hex(&p, end_p, ':', &addr, &prefixed)) {
+		// a devmem command, possibly after a shell prompt
+		for (q=p; (q+6)<=end_p; ++q) {
+			q = memchr(q, 'd', (size_t)(end_p - q));
+			if ((q == NULL) || ((q+6) > end_p))
+				break;
+			if ((memcmp(q, "devmem", 6) == 0) && ((q == p) || (q[-1] == ' ') || (q[-1] == '/'))
+					&& (((q+6) == end_p) || (q[6] == ' ') || (q[6] == '\t'))) {
+				parse_devmem(state_p, q+6, end_p);
+				break;
+			}
+		}
+		return;
+	}
+
+	// gdb puts the symbol between the address and the colon
+	q = skip_blanks(p, end_p);
+	if ((q < end_p) && (*q == '<')) {
+		while ((q < end_p) && (*q != '>'))
+			++q;
+		if (q < end_p)
+			++q;
+	}
+
+	if ((q < end_p) && (*q == ':')) {
+		// gdb x/Nx or U-Boot md.l
+		addr = phys_addr(addr);
+		p = q + 1;
+		for (i=0; ; ++i) {
+			q = skip_blanks(p, end_p);
+			if (q == end_p)
+				break;
+			// U-Boot's ASCII column is set off by several spaces
+			if (!prefixed && (i > 0) && ((q - p) > 1) && (memchr(p, '\t', (size_t)(q - p)) == NULL))
+				break;
+			p = q;
+			if (!parse_hex(&p, end_p, 0, &val, NULL))
+				break;
+			if (addr > (0xffffffff - (4 * i)))
+				break;
+			emit(state_p, addr + (4 * i), val);
+		}
+		return;
+	}
+
+	p = skip_blanks(p, end_p);
+	if (p == end_p) {
+		// a lone number: the result of a devmem read, or the final
+		// offset of a hexdump
+		if (pending)
+			emit(state_p, state_p->devmemAddr, addr);
+		else if (state_p->hexdumpActive)
+			hexdump_catch_up(state_p, addr);
+		return;
+	}
+
+	if (!prefixed)
+		parse_hexdump(state_p, addr, p, end_p);
+}
+
+/*
+ * parse a binary snapshot from the block buffer; returns the number of bytes
+ * consumed (0 if more are needed) and sets *remain_p to the number of pairs
+ * still to come
+ */
+static size_t
+parse_snapshot (ParseState_t *state_p, const uint8_t *buf_p, size_t len, bool *inHdr_p, size_t *remain_p)
+{
+	size_t used = 0;
+
+	if (*inHdr_p) {
+		if (len < SNAPSHOT_HDRSZ)
+			return 0;
+		if (!lpc32x0__snapshot_header(buf_p, remain_p, NULL))
+			*remain_p = 0;
+		*inHdr_p = false;
+		used = SNAPSHOT_HDRSZ;
+		++state_p->stats_p->lines;
+	}
+	while ((*remain_p > 0) && ((len - used) >= 8)) {
+		emit(state_p,
+				(uint32_t)buf_p[used] | ((uint32_t)buf_p[used+1] << 8) | ((uint32_t)buf_p[used+2] << 16) | ((uint32_t)buf_p[used+3] << 24),
+				(uint32_t)buf_p[used+4] | ((uint32_t)buf_p[used+5] << 8) | ((uint32_t)buf_p[used+6] << 16) | ((uint32_t)buf_p[used+7] << 24));
+		used += 8;
+		--*remain_p;
+	}
+	return used;
+}
+
+/*
+ * read the capture from 'fd' until EOF, calling 'word_fp' for every
+ * address/value pair found
+ */
+bool
+lpc32x0__parse_capture (int fd, CaptureWord_t word_fp, void *arg_p, CaptureStats_t *stats_p)
+{
+	char *buf_p;
+	char *nl_p;
+	size_t have = 0, start, used;
+	ssize_t rd;
+	bool eof = false, first = true, binary = false, inHdr = true;
+	size_t remain = 0;
+	CaptureStats_t localStats;
+	ParseState_t state;
+
+	if (word_fp == NULL)
+		return false;
+	if (stats_p == NULL)
+		stats_p = &localStats;
+	memset(stats_p, 0, sizeof(*stats_p));
+	memset(&state, 0, sizeof(state));
+	state.word_fp = word_fp;
+	state.arg_p = arg_p;
+	state.stats_p = stats_p;
+
+	buf_p = malloc(CAPTURE_BLOCKSZ);
+	if (buf_p == NULL) {
+		perror("malloc()");
+		return false;
+	}
+
+	while (!eof) {
+		rd = read(fd, buf_p + have, CAPTURE_BLOCKSZ - have);
+		if (rd < 0) {
+			if (errno == EINTR)
+				continue;
+			perror("read()");
+			free(buf_p);
+			return false;
+		}
+		if (rd == 0)
+			eof = true;
+		have += (size_t)rd;
+		stats_p->bytes += (size_t)rd;
+
+		if (first && (have > 0)) {
+			if ((unsigned char)buf_p[0] == (unsigned char)SNAPSHOT_MAGIC[0]) {
+				if ((have < 8) && !eof)
+					continue;
+				binary = ((have >= 8) && lpc32x0__is_snapshot(buf_p));
+			}
+			first = false;
+		}
+
+		if (binary) {
+			used = parse_snapshot(&state, (uint8_t*)buf_p, have, &inHdr, &remain);
+			if (!inHdr && (remain == 0))
+				break;
+			memmove(buf_p, buf_p + used, have - used);
+			have -= used;
+			continue;
+		}
+
+		// hand every complete line to the parser
+		start = 0;
+		while ((nl_p = memchr(buf_p + start, '\n', have - start)) != NULL) {
+			parse_line(&state, buf_p + start, nl_p);
+			start = (size_t)(nl_p - buf_p) + 1;
+		}
+
+		// a partial line at EOF, or one that doesn't fit in the buffer
+		if ((start < have) && (eof || ((start == 0) && (have == CAPTURE_BLOCKSZ)))) {
+			parse_line(&state, buf_p + start, buf_p + have);
+			start = have;
+		}
+
+		memmove(buf_p, buf_p + start, have - start);
+		have -= start;
+	}
+
+	free(buf_p);
+	return true;
+}
@@ -9,1513 +9,674 @@
 
 #include "registers.h"
 
-static void
-clkpower__pwr_ctrl (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[10]", "force HCLK and ARMCLK to run from PERIPH_CLK in order to save power");
-	field = print_field(val, 10, 10);
-	if (field == 0)
-		printf("normal mode (ARM and AHB not running on PERIPH_CLK)");
-	else
-		printf("ARM and AHB matrix (AHB) runs with PERIPH_CLK frequency");
-	printf("\n");
-
-	printf(ITEMFMT, "[9]", "EMCSREFREQ value");
-	field = print_field(val, 9, 9);
-	if (field == 0)
-		printf("no SDRAM self refresh");
-	else
-		printf("SDRAM self refresh request");
-	printf("\n");
-
-	printf(ITEMFMT, "[8]", "update EMCSREFREQ");
-	field = print_field(val, 8, 8);
-	if (field == 0)
-		printf("no action");
-	else
-		printf("update EMCSREFREQ according to PWR_CTRL[9]");
-	printf("\n");
-
-	printf(ITEMFMT, "[7]", "SDRAM auto-exit self-refresh enable");
-	field = print_field(val, 7, 7);
-	if (field == 0)
-		printf("disable auto exit self refresh");
-	else
-		printf("enable auto exit self refresh");
-	printf("\n");
-
-	printf(ITEMFMT, "[5]", "HIGHCORE pin level");
-	field = print_field(val, 5, 5);
-	if (field == 0)
-		printf("HIGHCORE will drive low");
-	else
-		printf("HIGHCORE will drive high");
-	printf("\n");
-
-	printf(ITEMFMT, "[4]", "SYSCLKEN pin level");
-	field = print_field(val, 4, 4);
-	if (field == 0)
-		printf("SYSCLKEN will drive low");
-	else
-		printf("SYSCLKEN will drive high");
-	printf("\n");
-
-	printf(ITEMFMT, "[3]", "SYSCLKEN pin drives high");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("SYSCLKEN will drive high when not in STOP mode");
-	else
-		printf("SYSCLKEN will always drive the level specified by bit 4");
-	printf("\n");
-
-	printf(ITEMFMT, "[2]", "RUN mode control");
-	field = print_field(val, 2, 2);
-	if (field == 0)
-		printf("direct RUN mode");
-	else
-		printf("normal RUN mode (ARM and HCLK is sourced from PLL output)");
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "core voltage supply level signalling control");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("HIGHCORE pin will drive high during STOP mode and drive low in all other modes");
-	else
-		printf("HIGHCORE pin is always driving the level as specified in bit 5");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "STOP mode control register");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("restore value to 0 if STOP was never entered");
-	else
-		printf("instruct hardware to enter STOP mode");
-}
-
-static void
-clkpower__osc_ctrl (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[8:2]", "load capacitance");
-	field = print_field(val, 8, 2);
-	if (field == 0x40)
-		printf("default setting of 6.4pF added");
-	else
-		printf("add %d x 0.1 pF load capacitance to SYSX_IN and SYSX_OUT", field);
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "main oscillator test mode");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("normal mode (either oscillation mode or power down mode)");
-	else
-		printf("test mode");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "main oscillator enable");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("main oscillator is enabled");
-	else
-		printf("main oscillator is diabled and in power down mode");
-}
-
-static void
-clkpower__sysclk_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[11:2]", "bad phase clock switch");
-	field = print_field(val, 11, 2);
-	printf("0x%08x\n", field);
-
-	printf(ITEMFMT, "[1]", "main oscillator switch");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("switch to main oscillator");
-	else
-		printf("switch to 13' MHz clock source (PLL397 output)");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "SYSCLK MUX status");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("main oscillator selected as the clock source");
-	else
-		printf("13' MHz PLL397 output selected as the clock source");
-}
-
-static void
-clkpower__pll397_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[10]", "PLL MSLOCK status");
-	field = print_field(val, 10, 10);
-	if (field == 0)
-		printf("PLL is not locked");
-	else
-		printf("PLL is locked and stable");
-	printf("\n");
-
-	printf(ITEMFMT, "[9]", "PLL397 bypass control");
-	field = print_field(val, 9, 9);
-	if (field == 0)
-		printf("bypass - PLL is bypassed and output clock is the input clock");
-	else
-		printf("no bypass");
-	printf("\n");
-
-	printf(ITEMFMT, "[8:6]", "PLL397 charge pump bias control");
-	field = print_field(val, 8, 6);
-	switch (field) {
-		case 0:
-			printf("Normal bias setting");
-			break;
-		case 1:
-			printf("-12.5%% of resistance");
-			break;
-		case 2:
-			printf("-25%% of resistance");
-			break;
-		case 3:
-			printf("-37.5%% of resistance");
-			break;
-		case 4:
-			printf("+12.5%% of resistance");
-			break;
-		case 5:
-			printf("+25%% of resistance");
-			break;
-		case 6:
-			printf("+37.5%% of resistance");
-			break;
-		case 7:
-			printf("+50%% of resistance");
-			break;
-		default:
-			printf("??");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "PLL397 operational control");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("PLL is running");
-	else
-		printf("PLL397 is stopped and is in low power mode");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "PLL LOCK status");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("PLL is not locked");
-	else
-		printf("PLL is locked and stable");
-	printf("\n");
-
-}
-
-static void
-clkpower__hclkpll_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[16]", "PLL power down");
-	field = print_field(val, 16, 16);
-	if (field == 0)
-		printf("PLL is in power down mode");
-	else
-		printf("PLL is in operating mode");
-	printf("\n");
-
-	printf(ITEMFMT, "[15]", "bypass control");
-	field = print_field(val, 15, 15);
-	if (field == 0)
-		printf("CCO clock is sent to the post divider");
-	else
-		printf("PLL input clock bypasses the CCO and is sent directly to the post divider");
-	printf("\n");
-
-	printf(ITEMFMT, "[14]", "direct output control");
-	field = print_field(val, 14, 14);
-	if (field == 0)
-		printf("the output of the post-divider is used as output of the PLL");
-	else
-		printf("CCO clock is the direct output of the PLL, bypassing the post divider");
-	printf("\n");
-
-	printf(ITEMFMT, "[13]", "feedback divider path control");
-	field = print_field(val, 13, 13);
-	if (field == 0)
-		printf("feedback divider clocked by the CCO clock");
-	else
-		printf("feedback divider clocked by the FCLKOUT");
-	printf("\n");
-
-	printf(ITEMFMT, "[12:11]", "PLL post-divider P setting");
-	field = print_field(val, 12, 11);
-	switch (field) {
-		case 0:
-			printf("divide by 2");
-			break;
-		case 1:
-			printf("divide by 4");
-			break;
-		case 2:
-			printf("divide by 8");
-			break;
-		case 3:
-			printf("divide by 16");
-			break;
-		default:
-			printf("??");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[10:9]", "PLL pre-divider N setting");
-	field = print_field(val, 10, 9);
-	printf("%d\n", field+1);
-
-	printf(ITEMFMT, "[8:1]", "PLL feedback divider M setting");
-	field = print_field(val, 8, 1);
-	printf("%d\n", field+1);
-
-	printf(ITEMFMT, "[0]", "PLL LOCK status");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("PLL is not locked");
-	else
-		printf("PLL is locked and stable");
-	printf("\n");
-}
-
-static void
-clkpower__hclkdiv_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[8:7]", "DDRAM_CLK control");
-	field = print_field(val, 8, 7);
-	switch (field) {
-		case 0:
-			printf("DDRAM clock stopped");
-			break;
-		case 1:
-			printf("DDRAM nominal speed");
-			break;
-		case 2:
-			printf("DDRAM half speed");
-			break;
-		case 3:
-			printf("not used");
-			break;
-		default:
-			printf("??");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[6:2]", "PERIPH_CLK divider control");
-	field = print_field(val, 6, 2);
-	if (field == 0)
-		printf("PERIPH_CLK is ARM PLL clock in RUN mode");
-	else
-		printf("PERIPH_CLK is ARM PLL clock divided by %d in RUN mode", field+1);
-	printf("\n");
-
-	printf(ITEMFMT, "[1:0]", "HCLK divider control");
-	field = print_field(val, 1, 0);
-	switch (field) {
-		case 0:
-			printf("HCLK is ARM PLL clock in RUN mode");
-			break;
-		case 1:
-			printf("HCLK is ARM PLL clock divided by 2 in RUN mode");
-			break;
-		case 2:
-			printf("HCLK is ARM PLL clock divided by 4 in RUN mode");
-			break;
-		case 3:
-			printf("not used");
-			break;
-		default:
-			printf("??");
-			break;
-	}
-	printf("\n");
-}
-
-static void
-clkpower__test_clk (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[6:5]", "the selected clock is output on GPO_0 TEST_CLK1 pin if bit 4 of this register is 1");
-	field = print_field(val, 6, 5);
-	switch (field) {
-		case 0:
-			printf("PERIPH_CLK, this clock stops in STOP mode");
-			break;
-		case 1:
-			printf("RTC clock, un-synchronized version");
-			break;
-		case 2:
-			printf("main oscillator clock");
-			break;
-		case 3:
-			printf("not used");
-			break;
-		default:
-			printf("??");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[4]", "GPO_0 TST_CLK1 output");
-	field = print_field(val, 4, 4);
-	if (field == 0)
-		printf("output is connected to the GPIO block");
-	else
-		printf("output is the clock selected by register bits [6:5]");
-	printf("\n");
-
-	printf(ITEMFMT, "[3:1]", "the selected clock is output on TST_CLK2 pin if bit 0 of this register contain 1");
-	field = print_field(val, 3, 1);
-	switch (field) {
-		case 0:
-			printf("HCLK");
-			break;
-		case 1:
-			printf("PERIPH_CLK");
-			break;
-		case 2:
-			printf("USB clock");
-			break;
-		case 3:
-		case 4:
-			printf("reserved");
-			break;
-		case 5:
-			printf("main oscillator clock");
-			break;
-		case 6:
-			printf("reserved");
-			break;
-		case 7:
-			printf("PLL397 output clock (13.008896 MHz)");
-			break;
-		default:
-			printf("??");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "TST_CLK2");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("TST_CLK2 is turned off");
-	else
-		printf("TST_CLK2 outputs the clock selected by register bits [3:1]");
-	printf("\n");
-}
-
-static void
-clkpower__autoclk_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[6]", "USB slave HCLK clocking");
-	field = print_field(val, 6, 6);
-	if (field == 0)
-		printf("autoclock enabled on USB slave HCLK");
-	else
-		printf("always clocked (autoclock disabled)");
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "IRAM clocking");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("autoclock enabled on IRAM");
-	else
-		printf("always clocked");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "IROM clocking");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("autoclock enabled on IROM");
-	else
-		printf("always clocked");
-	printf("\n");
-}
-
-static void
-clkpower__start_er_pin(uint32_t val)
-{
-	printf(ITEMFMT, "", "The following devices can or cannot start up the chip from STOP mode");
-	print_field(val, 31, 31);
-	printf("[31] UART7_RX\n");
-	print_field(val, 30, 30);
-	printf("[30] UART7_HCTS\n");
-	print_field(val, 29, 29);
-	printf("[29] (reserved)\n");
-	print_field(val, 28, 28);
-	printf("[28] UART6_IRRX\n");
-	print_field(val, 27, 27);
-	printf("[27] (reserved)\n");
-	print_field(val, 26, 26);
-	printf("[26] UART5_RX/USB_DAT_VP\n");
-	print_field(val, 25, 25);
-	printf("[25] GPI_28\n");
-	print_field(val, 24, 24);
-	printf("[24] UART3_RX\n");
-	print_field(val, 23, 23);
-	printf("[23] UART2_HCTS\n");
-	print_field(val, 22, 22);
-	printf("[22] UART2_RX\n");
-	print_field(val, 21, 21);
-	printf("[21] UART1_RX\n");
-	print_field(val, 20, 19);
-	printf("[20:19] (reserved)\n");
-	print_field(val, 18, 18);
-	printf("[18] SDIO_INT_N\n");
-	print_field(val, 17, 17);
-	printf("[17] MSDIO_START (logical OR of MS_DIO[3:0])\n");
-	print_field(val,16, 16);
-	printf("[16] GPI_6/HSTIM_CAP\n");
-	print_field(val, 15, 15);
-	printf("[15] GPI_5\n");
-	print_field(val, 14, 14);
-	printf("[14] GPI_4\n");
-	print_field(val, 13, 13);
-	printf("[13] GPI_3\n");
-	print_field(val, 12, 12);
-	printf("[12] GPI_2\n");
-	print_field(val, 11, 11);
-	printf("[11] GPI_1/SERVICE_N\n");
-	print_field(val, 10, 10);
-	printf("[10] GPI_0/I2S1RX_SDA\n");
-	print_field(val, 9, 9);
-	printf("[9] SYSCLKEN\n");
-	print_field(val, 8, 8);
-	printf("[8] SPI1_DATIN\n");
-	print_field(val, 7, 7);
-	printf("[7] GPI_7\n");
-	print_field(val, 6, 6);
-	printf("[6] SPI2_DATIN\n");
-	print_field(val, 5, 5);
-	printf("[5] GPI_19/UART4_RX\n");
-	print_field(val, 4, 4);
-	printf("[4] GPI_9\n");
-	print_field(val, 3, 3);
-	printf("[3] GPI_8\n");
-	print_field(val, 2, 0);
-	printf("[2:0] (reserved)\n");
-	printf("\n");
-}
-
-static void
-clkpower__start_er_int(uint32_t val)
-{
-	printf(ITEMFMT, "", "The following internal sources can start up the chip from STOP mode");
-	print_field(val, 31, 31);
-	printf("[31] TS_INT\n");
-	print_field(val, 30, 30);
-	printf("[30] TS_P\n");
-	print_field(val, 29, 29);
-	printf("[29] TS_AUX\n");
-	print_field(val, 28, 27);
-	printf("[28:27] (reserved)\n");
-	print_field(val, 26, 26);
-	printf("[26] USB_AHB_NEED_CLK\n");
-	print_field(val, 25, 25);
-	printf("[25] MSTIMER_INT\n");
-	print_field(val, 24, 24);
-	printf("[24] RTC_INT interrupt from RTC\n");
-	print_field(val, 23, 23);
-	printf("[23] USB_NEED_CLK\n");
-	print_field(val, 22, 22);
-	printf("[22] USB_INT\n");
-	print_field(val, 21, 21);
-	printf("[21] USB_I2C_INT\n");
-	print_field(val, 20, 20);
-	printf("[20] USB_OTG_TIMER_INT\n");
-	print_field(val, 19, 19);
-	printf("[19] USB_OTG_ATX_INT_N\n");
-	print_field(val, 18, 17);
-	printf("[18:17] (reserved)\n");
-	print_field(val, 16, 16);
-	printf("[16] KEY_IRQ\n");
-	print_field(val, 15, 8);
-	printf("[15:8] (reserved)\n");
-	print_field(val, 7, 7);
-	printf("[7] ethernet MAC start request\n");
-	print_field(val, 6, 6);
-	printf("[6] port 0/port 1 start request (OR's all or port 0 and port 1, see P0_INTR_ER)\n");
-	print_field(val, 5, 5);
-	printf("[5] GPIO_5\n");
-	print_field(val, 4, 4);
-	printf("[4] GPIO_4\n");
-	print_field(val, 3, 3);
-	printf("[3] GPIO_3\n");
-	print_field(val, 2, 2);
-	printf("[2] GPIO_2\n");
-	print_field(val, 1, 1);
-	printf("[1] GPIO_1\n");
-	print_field(val, 0, 0);
-	printf("[0] GPIO_0\n");
-	printf("\n");
-}
-
-static void
-clkpower__p0_intr_er(uint32_t val)
-{
-	print_field(val, 31, 11);
-	printf("[31:11] P1.[23:3]\n");
-	print_field(val, 10, 10);
-	printf("[10] P1.2\n");
-	print_field(val, 9, 9);
-	printf("[9] P1.1\n");
-	print_field(val, 8, 8);
-	printf("[8] P1.0\n");
-	print_field(val, 7, 7);
-	printf("[7] P0.7\n");
-	print_field(val, 6, 6);
-	printf("[6] P0.6\n");
-	print_field(val, 5, 5);
-	printf("[5] P0.5\n");
-	print_field(val, 4, 4);
-	printf("[4] P0.4\n");
-	print_field(val, 3, 3);
-	printf("[3] P0.3\n");
-	print_field(val, 2, 2);
-	printf("[2] P0.2\n");
-	print_field(val, 1, 1);
-	printf("[1] P0.1\n");
-	print_field(val, 0, 0);
-	printf("[0] P0.0\n");
-	printf("\n");
-}
-
-static void
-clkpower__start_sr_pin(uint32_t val)
-{
-	print_field(val, 31, 3);
-	printf("[31:3] current state of device pin startup sources after masking with START_ER_PIN\n");
-	print_field(val, 2, 0);
-	printf("[2:0] (reserved)\n");
-	printf("\n");
-}
-
-static void
-clkpower__start_sr_int(uint32_t val)
-{
-	print_field(val, 31, 3);
-	printf("[31:3] current state of possible internal startup sources, after masking with START_ER_INT\n");
-	print_field(val, 2, 0);
-	printf("[2:0] (reserved)\n");
-	printf("\n");
-}
-
-static void
-clkpower__start_rsr_pin(uint32_t val)
-{
-	print_field(val, 31, 3);
-	printf("[31:3] current state of possible device pin startup sources, prior to masking\n");
-	print_field(val, 2, 0);
-	printf("[2:0] (reserved)\n");
-	printf("\n");
-}
-
-static void
-clkpower__start_rsr_int(uint32_t val)
-{
-	print_field(val, 31, 3);
-	printf("[31:3] current state of possible internal startup sources, prior to masking\n");
-	print_field(val, 2, 0);
-	printf("[2:0] (reserved)\n");
-	printf("\n");
-}
-
-static void
-clkpower__start_apr_pin(uint32_t val)
-{
-	print_field(val, 31, 3);
-	printf("[31:3] allows selecting the polarity that device pin start signal sources use as a start condition\n");
-	print_field(val, 2, 0);
-	printf("[2:0] (reserved)\n");
-	printf("\n");
-}
-
-static void
-clkpower__start_apr_int(uint32_t val)
-{
-	print_field(val, 31, 3);
-	printf("[31:3] allows selecting the polarity that internal start signal sources use as a start condition\n");
-	print_field(val, 2, 0);
-	printf("[2:0] (reserved)\n");
-	printf("\n");
-}
-
-static void
-clkpower__usb_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[24]", "USB slave HCLK control");
-	field = print_field(val, 24, 24);
-	if (field == 0)
-		printf("disabled");
-	else
-		printf("enabled");
-	printf("\n");
-
-	printf(ITEMFMT, "[23]", "usb_i2c enable");
-	field = print_field(val, 23, 23);
-	if (field == 0)
-		printf("ip_3506_otg_tx_en_n is fed to OE_TP_N pad");
-	else
-		printf("'0' is fed to OE_TP_N pad");
-	printf("\n");
-
-	printf(ITEMFMT, "[22]", "usb_dev_need_clk_en");
-	field = print_field(val, 22, 22);
-	if (field == 0)
-		printf("usb_dev_need_clk is not let into the clock switch");
-	else
-		printf("usb_dev_need_clk is let into clock switch");
-	printf("\n");
-
-	printf(ITEMFMT, "[21]", "usb_host_need_clk_en");
-	field = print_field(val, 21, 21);
-	if (field == 0)
-		printf("usb_host_need_clk_en is not let into the clock switch");
-	else
-		printf("usb_host_need_clk_en is let into clock switch");
-	printf("\n");
-
-	printf(ITEMFMT, "[20:19]", "pad control for USB_DAT_VP and USB_SE0_VM pads");
-	field = print_field(val, 20, 19);
-	switch (field) {
-		case 0:
-			printf("pull-up added to pad");
-			break;
-		case 1:
-			printf("bus keeper, retains the last driven value");
-			break;
-		case 2:
-			printf("no added function");
-			break;
-		case 3:
-			printf("pull-down added to pad");
-			break;
-		default:
-			printf("??");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[18]", "USB_Clken2 clock control");
-	field = print_field(val, 18, 18);
-	if (field == 0)
-		printf("stop clock going into USB clock");
-	else
-		printf("enable clock going into USB clock");
-	printf("\n");
-
-	printf(ITEMFMT, "[17]", "USB_Clken1 clock control");
-	field = print_field(val, 17, 17);
-	if (field == 0)
-		printf("stop clock going into the USB PLL");
-	else
-		printf("enable clock going into the USB PLL");
-	printf("\n");
-
-	printf(ITEMFMT, "[16]", "PLL power down");
-	field = print_field(val, 16, 16);
-	if (field == 0)
-		printf("PLL is in power down mode");
-	else
-		printf("PLL is in operating mode");
-	printf("\n");
-
-	printf(ITEMFMT, "[15]", "bypass control");
-	field = print_field(val, 15, 15);
-	if (field == 0)
-		printf("CCO clock is sent to the post divider");
-	else
-		printf("PLL input clock bypasses the CCO and is sent directly to the post divider");
-	printf("\n");
-
-	printf(ITEMFMT, "[14]", "direct output control");
-	field = print_field(val, 14, 14);
-	if (field == 0)
-		printf("the output of the post-divider is used as output of the PLL");
-	else
-		printf("CCO clock is the direct output of the PLL, bypassing the post divider");
-	printf("\n");
-
-	printf(ITEMFMT, "[13]", "feedback divider path control");
-	field = print_field(val, 13, 13);
-	if (field == 0)
-		printf("feedback divider clocked by CCO clock");
-	else
-		printf("feedback divider clocked by post FCLKOUT");
-	printf("\n");
-
-	printf(ITEMFMT, "[12:11]", "PLL post-divider (P) setting");
-	field = print_field(val, 12, 11);
-	switch (field) {
-		case 0:
-			printf("divide by 2 (P=1)");
-			break;
-		case 1:
-			printf("divide by 4 (P=2)");
-			break;
-		case 2:
-			printf("divide by 8 (P=4)");
-			break;
-		case 3:
-			printf("divide by 16 (P=8)");
-			break;
-		default:
-			printf("??");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[10:9]", "PLL pre-divider (N) setting");
-	field = print_field(val, 10, 9);
-	printf("%d\n", field + 1);
-
-	printf(ITEMFMT, "[8:1]", "PLL feedback divider (M) setting");
-	field = print_field(val, 8, 1);
-	printf("%d\n", field + 1);
-
-	printf(ITEMFMT, "[0]", "PLL lock status");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("PLL not locked");
-	else
-		printf("PLL locked, output clock stable");
-	printf("\n");
-}
-
-static void
-clkpower__usb_div(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[3:0]", "USB_RATE: controls USB pre-clock divider");
-	field = print_field(val, 3, 0);
-	printf("%d\n", field + 1);
-	printf("\n");
-}
-
-static void
-clkpower__ms_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[10]", "disable SDcard pins");
-	field = print_field(val, 10, 10);
-	if (field == 0)
-		printf("enable SDcard interface pins");
-	else
-		printf("disable SDcard interface pins and enable peripheral MUX registers");
-	printf("\n");
-
-	printf(ITEMFMT, "[9]", "enables clock and pull-ups to MSSDIO pins");
-	field = print_field(val, 9, 9);
-	if (field == 0)
-		printf("MSSDIO pull-up and clock disable");
-	else
-		printf("MSSDIO pull-up and clock enable");
-	printf("\n");
-
-	printf(ITEMFMT, "[8]", "MSSDIO2 and MSSDIO3 pad control");
-	field = print_field(val, 8, 8);
-	if (field == 0)
-		printf("MSSDIO2 and 3 pad has pull-up enabled");
-	else
-		printf("MSSDIO2 and 3 pad has no pull-up");
-	printf("\n");
-
-	printf(ITEMFMT, "[7]", "MSSDIO1 pad control");
-	field = print_field(val, 7, 7);
-	if (field == 0)
-		printf("MSSDIO1 pad has pull-up enabled");
-	else
-		printf("MSSDIO1 pad has no pull-up");
-	printf("\n");
-
-	printf(ITEMFMT, "[6]", "MSSDIO0/MSBS pad control");
-	field = print_field(val, 6, 6);
-	if (field == 0)
-		printf("MSSDIO0 pad has pull-up enabled");
-	else
-		printf("MSSDIO0 pad has no pull-up");
-	printf("\n");
-
-	printf(ITEMFMT, "[5]", "SDcard clock control");
-	field = print_field(val, 5, 5);
-	if (field == 0)
-		printf("clocks disabled");
-	else
-		printf("clocks enabled");
-	printf("\n");
-
-	printf(ITEMFMT, "[3:0]", "divider ratio when generating clock from ARM PLL output clock");
-	field = print_field(val, 3, 0);
-	switch (field) {
-		case 0:
-			printf("MSSDCLK stopped, divider in low power mode");
-			break;
-		default:
-			printf("MSSDCLK equals ARM PLL output clock divided by %d", field);
-			break;
-	}
-	printf("\n");
-}
-
-static void
-clkpower__dmaclk_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[0]", "DMA clock");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("all clocks to DMA stopped, no access to DMA registers allowed");
-	else
-		printf("all clocks to DMA enabled");
-	printf("\n");
-}
-
-static void
-clkpower__flashclk_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[5]", "which NAND flash controller interrupt is connected to the interrupt controller");
-	field = print_field(val, 5, 5);
-	if (field == 0)
-		printf("enable the SLC NAND flash controller interrupt");
-	else
-		printf("enable the MLC NAND flash controller interrupt");
-	printf("\n");
-
-	printf(ITEMFMT, "[4]", "enable NAND_DMA_REQ on NAND_RnB (MLC only)");
-	field = print_field(val, 4, 4);
-	if (field == 0)
-		printf("disable");
-	else
-		printf("enable");
-	printf("\n");
-
-	printf(ITEMFMT, "[3]", "enable NAND_DMA_REQ on NAND_INT (MLC only)");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("disable");
-	else
-		printf("enable");
-	printf("\n");
-
-	printf(ITEMFMT, "[2]", "SLC/MLC select");
-	field = print_field(val, 2, 2);
-	if (field == 0)
-		printf("MLC");
-	else
-		printf("SLC");
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "MLC NAND flash clock enable");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("disable clocks to the block, including the AHB interface");
-	else
-		printf("enable clock");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "SLC NAND flash clock enable control");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("disable clocks to the block, including to the AHB interface");
-	else
-		printf("enable clock");
-	printf("\n");
-}
-
-static void
-clkpower__macclk_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[4:3]", "ethernet MAC hardware interface control");
-	field = print_field(val, 4, 3);
-	switch (field) {
-		case 0:
-			printf("do not connect ethernet MAC to port pins");
-			break;
-		case 1:
-			printf("connect ethernet MAC to port pins in MII mode");
-			break;
-		case 2:
-			printf("do not connect ethernet MAC to port pins");
-			break;
-		case 3:
-			printf("connect ethernet MAC to port pins in RMII mode");
-			break;
-		default:
-			printf("??");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[2]", "MASTER_CLK");
-	field = print_field(val, 2, 2); 
-	if (field == 0)
-		printf("disabled");
-	else
-		printf("enabled");
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "REG_CLK");
-	field = print_field(val, 1, 1); 
-	if (field == 0)
-		printf("disabled");
-	else
-		printf("enabled");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "SLAVE_CLK");
-	field = print_field(val, 0, 0); 
-	if (field == 0)
-		printf("disabled");
-	else
-		printf("enabled");
-}
-
-static void
-clkpower__lcdclk_ctrl(uint32_t val)
-{
-	uint32_t field;
-	uint32_t type;
-
-	printf(ITEMFMT, "[8]", "DISPLAY_TYPE");
-	type = print_field(val, 8, 8);
-	printf("%s\n", type == 1? "STN" : "TFT");
-
-	printf(ITEMFMT, "[7:6]", "MODE_SELECT");
-	field = print_field(val, 7, 6);
-	if (type == 0) { /* TFT */
-		switch (field) {
-			case 0:
-				printf("single panel, 12-bit (4:4:4), 18 pins");
-				break;
-			case 1:
-				printf("single panel, 16-bit (5:6:5), 22 pins");
-				break;
-			case 2:
-				printf("single panel, 16-bit (1:5:5:5), 24 pins");
-				break;
-			case 3:
-				printf("single panel, 24-bit, 30 pins");
-				break;
-			default:
-				printf("?");
-				break;
-		}
-	}
-	else { /* STN */
-		switch (field) {
-			case 0:
-				printf("single panel, 4-bit mono, 10 pins");
-				break;
-			case 1:
-				printf("single panel, 8-bit mono/colour, 14 pins");
-				break;
-			case 2:
-				printf("dual panel, 4-bit mono, 14 pins");
-				break;
-			case 3:
-				printf("dual panel, 8-bit mono/colour, 22 pins");
-				break;
-			default:
-				printf("?");
-				break;
-		}
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[5]", "HCLK_ENABLE");
-	field = print_field(val, 5, 5);
-	printf("%sable HCLK signal to LCD controller\n", field == 0? "dis" : "en");
-
-	printf(ITEMFMT, "[4:0]", "CLKDIV");
-	printf("\t\t\tLCD panel clock prescaler: 0x%x\n", get_field(val, 4, 0));
-}
-
-static void
-clkpower__i2s_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[6]", "I2S1 CLK_TX_MODE select");
-	field = print_field(val, 6, 6);
-	if (field == 0)
-		printf("TX_CLK drives I2S TX timing");
-	else
-		printf("RX_CLK drives I2S TX timing");
-	printf("\n");
-
-	printf(ITEMFMT, "[5]", "I2S1_RX_MODE select");
-	field = print_field(val, 5, 5);
-	if (field == 0)
-		printf("RX_CLK drives I2S RX timing");
-	else
-		printf("TX_CLK drives I2S RX timing");
-	printf("\n");
-
-	printf(ITEMFMT, "[4]", "I2S1 DMA1 connection control");
-	field = print_field(val, 4, 4);
-	if (field == 0)
-		printf("UART7 RX is connected to DMA (I2S1 DMA 1 is not conntected to DMA");
-	else
-		printf("I2S1 DMA 1 in connected to DMA (UART7 RX is not connected to DMA)");
-	printf("\n");
-
-	printf(ITEMFMT, "[3]", "I2S0_CLK_TX_MODE select");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("TX_CLK drives I2S TX timing");
-	else
-		printf("RX_CLK drives I2S TX timing");
-	printf("\n");
-
-	printf(ITEMFMT, "[2]", "I2S0_CLK_RX_MODE select");
-	field = print_field(val, 2, 2);
-	if (field == 0)
-		printf("RX_CLK drives I2S RX timing");
-	else
-		printf("TX_CLK drives I2S RX timing");
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "I2S1_CLK enable");
-	field = print_field(val, 1, 1);
-	printf("%s\n", (field == 0)? "disable" : "enable");
-
-	printf(ITEMFMT, "[1]", "I2S0_CLK enable");
-	field = print_field(val, 0, 0);
-	printf("%s\n", (field == 0)? "disable" : "enable");
-}
-
-static void
-clkpower__ssp_ctrl(uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[5]", "SSP1 RX DMA connection control");
-	field = print_field(val, 5, 5);
-	if (field == 0)
-		printf("SSP1 RX is not conntected to DMA and SPI2 is connected to DMA");
-	else
-		printf("SSP1 RX is connected to DMA and SPI2 is not connected to DMA");
-	printf("\n");
-
-	printf(ITEMFMT, "[4]", "SSP1 TX DMA connection control");
-	field = print_field(val, 4, 4);
-	if (field == 0)
-		printf("SSP1 TX is not connected to DMA and SPI1 is connected to DMA");
-	else
-		printf("SSP1 TX is connected to DMA and SPI1 is not connected to DMA");
-	printf("\n");
+static const char * const periphRun[] = {
+	"normal mode (ARM and AHB not running on PERIPH_CLK)",
+	"ARM and AHB matrix (AHB) runs with PERIPH_CLK frequency",
+};
+static const char * const selfRefresh[] = {"no SDRAM self refresh", "SDRAM self refresh request"};
+static const char * const updateSelfRefresh[] = {"no action", "update EMCSREFREQ according to PWR_CTRL[9]"};
+static const char * const autoExit[] = {"disable auto exit self refresh", "enable auto exit self refresh"};
+static const char * const highcoreLevel[] = {"HIGHCORE will drive low", "HIGHCORE will drive high"};
+static const char * const sysclkenLevel[] = {"SYSCLKEN will drive low", "SYSCLKEN will drive high"};
+static const char * const sysclkenHigh[] = {
+	"SYSCLKEN will drive high when not in STOP mode",
+	"SYSCLKEN will always drive the level specified by bit 4",
+};
+static const char * const runMode[] = {
+	"direct RUN mode",
+	"normal RUN mode (ARM and HCLK is sourced from PLL output)",
+};
+static const char * const highcoreCtrl[] = {
+	"HIGHCORE pin will drive high during STOP mode and drive low in all other modes",
+	"HIGHCORE pin is always driving the level as specified in bit 5",
+};
+static const char * const stopMode[] = {
+	"restore value to 0 if STOP was never entered",
+	"instruct hardware to enter STOP mode",
+};
 
-	printf(ITEMFMT, "[3]", "SSP0 RX DMA connection control");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("SSP0 RX is not connected to DMA");
-	else
-		printf("SSP0 RX is connected to DMA");
-	printf("\n");
+static const FieldDescription_t clkpower__pwr_ctrl[] = {
+	{.high=10, .low=10, .name_p="force HCLK and ARMCLK to run from PERIPH_CLK in order to save power", FIELDTEXT(periphRun)},
+	{.high=9, .low=9, .name_p="EMCSREFREQ value", FIELDTEXT(selfRefresh)},
+	{.high=8, .low=8, .name_p="update EMCSREFREQ", FIELDTEXT(updateSelfRefresh)},
+	{.high=7, .low=7, .name_p="SDRAM auto-exit self-refresh enable", FIELDTEXT(autoExit)},
+	{.high=5, .low=5, .name_p="HIGHCORE pin level", FIELDTEXT(highcoreLevel)},
+	{.high=4, .low=4, .name_p="SYSCLKEN pin level", FIELDTEXT(sysclkenLevel)},
+	{.high=3, .low=3, .name_p="SYSCLKEN pin drives high", FIELDTEXT(sysclkenHigh)},
+	{.high=2, .low=2, .name_p="RUN mode control", FIELDTEXT(runMode)},
+	{.high=1, .low=1, .name_p="core voltage supply level signalling control", FIELDTEXT(highcoreCtrl)},
+	{.high=0, .low=0, .name_p="STOP mode control register", FIELDTEXT(stopMode)},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[2]", "SSP0 TX DMA connection control");
-	field = print_field(val, 2, 2);
-	if (field == 0)
-		printf("SSP0 TX is not connected to DMA");
-	else
-		printf("SSP0 TX is connected to DMA");
-	printf("\n");
+static const char * const loadCap[0x41] = {
+	[0x40] = "default setting of 6.4pF added",
+};
+static const char * const oscTest[] = {
+	"normal mode (either oscillation mode or power down mode)",
+	"test mode",
+};
+static const char * const oscEnable[] = {
+	"main oscillator is enabled",
+	"main oscillator is diabled and in power down mode",
+};
 
-	printf(ITEMFMT, "[1]", "SSP1 clock enable");
-	field = print_field(val, 1, 1);
-	printf("%s\n", (field == 0)? "disable" : "enable");
+static const FieldDescription_t clkpower__osc_ctrl[] = {
+	{.high=8, .low=2, .name_p="load capacitance", FIELDTEXT(loadCap), .fmt_p="add %d x 0.1 pF load capacitance to SYSX_IN and SYSX_OUT"},
+	{.high=1, .low=1, .name_p="main oscillator test mode", FIELDTEXT(oscTest)},
+	{.high=0, .low=0, .name_p="main oscillator enable", FIELDTEXT(oscEnable)},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "SSP0 clock enable");
-	field = print_field(val, 0, 0);
-	printf("%s\n", (field == 0)? "disable" : "enable");
-}
+static const char * const oscSwitch[] = {
+	"switch to main oscillator",
+	"switch to 13' MHz clock source (PLL397 output)",
+};
+static const char * const sysclkMux[] = {
+	"main oscillator selected as the clock source",
+	"13' MHz PLL397 output selected as the clock source",
+};
 
-static void
-clkpower__spi_ctrl(uint32_t val)
-{
-	int pin1 = 0;
-	int pin5 = 0;
-	uint32_t field;
+static const FieldDescription_t clkpower__sysclk_ctrl[] = {
+	{.high=11, .low=2, .name_p="bad phase clock switch", .fmt_p="0x%08x"},
+	{.high=1, .low=1, .name_p="main oscillator switch", FIELDTEXT(oscSwitch)},
+	{.high=0, .low=0, .name_p="SYSCLK MUX status", FIELDTEXT(sysclkMux)},
+	{.name_p=NULL},
+};
 
-	pin1 = val & 0x02;
-	pin5 = val & 0x20;
+static const char * const pllLock[] = {"PLL is not locked", "PLL is locked and stable"};
+static const char * const pll397Bypass[] = {
+	"no bypass",
+	"bypass - PLL is bypassed and output clock is the input clock",
+};
+static const char * const chargePump[] = {
+	"Normal bias setting",
+	"-12.5% of resistance",
+	"-25% of resistance",
+	"-37.5% of resistance",
+	"+12.5% of resistance",
+	"+25% of resistance",
+	"+37.5% of resistance",
+	"+50% of resistance",
+};
+static const char * const pll397Run[] = {"PLL is running", "PLL397 is stopped and is in low power mode"};
+
+static const FieldDescription_t clkpower__pll397_ctrl[] = {
+	{.high=10, .low=10, .name_p="PLL MSLOCK status", FIELDTEXT(pllLock)},
+	{.high=9, .low=9, .name_p="PLL397 bypass control", FIELDTEXT(pll397Bypass)},
+	{.high=8, .low=6, .name_p="PLL397 charge pump bias control", FIELDTEXT(chargePump)},
+	{.high=1, .low=1, .name_p="PLL397 operational control", FIELDTEXT(pll397Run)},
+	{.high=0, .low=0, .name_p="PLL LOCK status", FIELDTEXT(pllLock), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[7]", "SPI2_DATIO output level");
-	field = print_field(val, 7, 7);
-	if (pin5 == 0) {
-		if (field == 0)
-			printf("the pin drives low (pin 5 == 0)");
-		else
-			printf("the pin drives high (pin 5 == 0)");
-	}
-	else
-		printf("this pin is driven by the SPI2 block");
-	printf("\n");
+static const char * const pllPower[] = {"PLL is in power down mode", "PLL is in operating mode"};
+static const char * const pllBypass[] = {
+	"CCO clock is sent to the post divider",
+	"PLL input clock bypasses the CCO and is sent directly to the post divider",
+};
+static const char * const pllDirect[] = {
+	"the output of the post-divider is used as output of the PLL",
+	"CCO clock is the direct output of the PLL, bypassing the post divider",
+};
+static const char * const pllFeedback[] = {
+	"feedback divider clocked by the CCO clock",
+	"feedback divider clocked by the FCLKOUT",
+};
+static const char * const pllPostDiv[] = {"divide by 2", "divide by 4", "divide by 8", "divide by 16"};
+
+static const FieldDescription_t clkpower__hclkpll_ctrl[] = {
+	{.high=16, .low=16, .name_p="PLL power down", FIELDTEXT(pllPower)},
+	{.high=15, .low=15, .name_p="bypass control", FIELDTEXT(pllBypass)},
+	{.high=14, .low=14, .name_p="direct output control", FIELDTEXT(pllDirect)},
+	{.high=13, .low=13, .name_p="feedback divider path control", FIELDTEXT(pllFeedback)},
+	{.high=12, .low=11, .name_p="PLL post-divider P setting", FIELDTEXT(pllPostDiv)},
+	{.high=10, .low=9, .name_p="PLL pre-divider N setting", .fmt_p="%d", .offset=1},
+	{.high=8, .low=1, .name_p="PLL feedback divider M setting", .fmt_p="%d", .offset=1},
+	{.high=0, .low=0, .name_p="PLL LOCK status", FIELDTEXT(pllLock), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[6]", "SPI2_CLK output level");
-	field = print_field(val, 6, 6);
-	if (pin5 == 0) {
-		if (field == 0)
-			printf("the pin drives low (bit 5 == 0)");
-		else
-			printf("the pin drives high (bit 5 == 0)");
-	}
-	else
-		printf("this pin is driven by the SPI2 block");
-	printf("\n");
+static const char * const ddramClk[] = {
+	"DDRAM clock stopped",
+	"DDRAM nominal speed",
+	"DDRAM half speed",
+	"not used",
+};
+static const char * const periphDiv[] = {"PERIPH_CLK is ARM PLL clock in RUN mode"};
+static const char * const hclkDiv[] = {
+	"HCLK is ARM PLL clock in RUN mode",
+	"HCLK is ARM PLL clock divided by 2 in RUN mode",
+	"HCLK is ARM PLL clock divided by 4 in RUN mode",
+	"not used",
+};
 
-	printf(ITEMFMT, "[5]", "output pin control");
-	field = print_field(val, 5, 5);
-	if (field == 0)
-		printf("SPI2_DATIO and SPI2_CLK outputs the level set by bit 6 and 7");
-	else
-		printf("SPI2_DATIO and SPI2_CLK are driven by the SPI2 block");
-	printf("\n");
+static const FieldDescription_t clkpower__hclkdiv_ctrl[] = {
+	{.high=8, .low=7, .name_p="DDRAM_CLK control", FIELDTEXT(ddramClk)},
+	{.high=6, .low=2, .name_p="PERIPH_CLK divider control", FIELDTEXT(periphDiv), .fmt_p="PERIPH_CLK is ARM PLL clock divided by %d in RUN mode", .offset=1},
+	{.high=1, .low=0, .name_p="HCLK divider control", FIELDTEXT(hclkDiv), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[4]", "SPI2 clock enable control");
-	field = print_field(val, 4, 4);
-	printf("%s\n", (field == 0)? "disable" : "enable");
+static const char * const testClk1[] = {
+	"PERIPH_CLK, this clock stops in STOP mode",
+	"RTC clock, un-synchronized version",
+	"main oscillator clock",
+	"not used",
+};
+static const char * const testClk1Out[] = {
+	"output is connected to the GPIO block",
+	"output is the clock selected by register bits [6:5]",
+};
+static const char * const testClk2[] = {
+	"HCLK",
+	"PERIPH_CLK",
+	"USB clock",
+	"reserved",
+	"reserved",
+	"main oscillator clock",
+	"reserved",
+	"PLL397 output clock (13.008896 MHz)",
+};
+static const char * const testClk2Out[] = {
+	"TST_CLK2 is turned off",
+	"TST_CLK2 outputs the clock selected by register bits [3:1]",
+};
 
-	printf(ITEMFMT, "[3]", "SPI1_DATIO output level");
-	field = print_field(val, 3, 3);
-	if (pin1 == 0) {
-		if (field == 0)
-			printf("the pin drives low (bit 1 == 0)");
-		else
-			printf("the pin drives high (bit 1 == 0)");
-	}
-	else
-		printf("this pin is driven by the SPI1 block");
-	printf("\n");
+static const FieldDescription_t clkpower__test_clk[] = {
+	{.high=6, .low=5, .name_p="the selected clock is output on GPO_0 TEST_CLK1 pin if bit 4 of this register is 1", FIELDTEXT(testClk1)},
+	{.high=4, .low=4, .name_p="GPO_0 TST_CLK1 output", FIELDTEXT(testClk1Out)},
+	{.high=3, .low=1, .name_p="the selected clock is output on TST_CLK2 pin if bit 0 of this register contain 1", FIELDTEXT(testClk2)},
+	{.high=0, .low=0, .name_p="TST_CLK2", FIELDTEXT(testClk2Out), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[2]", "SPI1_CLK output level");
-	field = print_field(val, 2, 2);
-	if (pin1 == 0) {
-		if (field == 0)
-			printf("the pin drives low (bit 1 == 0)");
-		else
-			printf("the pin drives high (bit 1 == 0)");
-	}
-	else
-		printf("this pin is driven by the SPI1 block");
-	printf("\n");
+static const char * const usbAutoclk[] = {
+	"autoclock enabled on USB slave HCLK",
+	"always clocked (autoclock disabled)",
+};
+static const char * const iramAutoclk[] = {"autoclock enabled on IRAM", "always clocked"};
+static const char * const iromAutoclk[] = {"autoclock enabled on IROM", "always clocked"};
+
+static const FieldDescription_t clkpower__autoclk_ctrl[] = {
+	{.high=6, .low=6, .name_p="USB slave HCLK clocking", FIELDTEXT(usbAutoclk)},
+	{.high=1, .low=1, .name_p="IRAM clocking", FIELDTEXT(iramAutoclk)},
+	{.high=0, .low=0, .name_p="IROM clocking", FIELDTEXT(iromAutoclk), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[1]", "output pin control");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("SPI1_DATIO and SPI1_CLK outputs the level set by bit 2 and 3");
-	else
-		printf("SPI1_DATIO and SPI1_CLK are driven by the SPI1 block");
-	printf("\n");
+static const FieldDescription_t clkpower__start_er_pin[] = {
+	{.high=31, .low=0, .name_p="The following devices can or cannot start up the chip from STOP mode", .flags=fieldHeaderOnly|fieldNoRange},
+	{.high=31, .low=31, .name_p="UART7_RX", .flags=fieldNoHeader},
+	{.high=30, .low=30, .name_p="UART7_HCTS", .flags=fieldNoHeader},
+	{.high=29, .low=29, .name_p="(reserved)", .flags=fieldNoHeader},
+	{.high=28, .low=28, .name_p="UART6_IRRX", .flags=fieldNoHeader},
+	{.high=27, .low=27, .name_p="(reserved)", .flags=fieldNoHeader},
+	{.high=26, .low=26, .name_p="UART5_RX/USB_DAT_VP", .flags=fieldNoHeader},
+	{.high=25, .low=25, .name_p="GPI_28", .flags=fieldNoHeader},
+	{.high=24, .low=24, .name_p="UART3_RX", .flags=fieldNoHeader},
+	{.high=23, .low=23, .name_p="UART2_HCTS", .flags=fieldNoHeader},
+	{.high=22, .low=22, .name_p="UART2_RX", .flags=fieldNoHeader},
+	{.high=21, .low=21, .name_p="UART1_RX", .flags=fieldNoHeader},
+	{.high=20, .low=19, .name_p="(reserved)", .flags=fieldNoHeader},
+	{.high=18, .low=18, .name_p="SDIO_INT_N", .flags=fieldNoHeader},
+	{.high=17, .low=17, .name_p="MSDIO_START (logical OR of MS_DIO[3:0])", .flags=fieldNoHeader},
+	{.high=16, .low=16, .name_p="GPI_6/HSTIM_CAP", .flags=fieldNoHeader},
+	{.high=15, .low=15, .name_p="GPI_5", .flags=fieldNoHeader},
+	{.high=14, .low=14, .name_p="GPI_4", .flags=fieldNoHeader},
+	{.high=13, .low=13, .name_p="GPI_3", .flags=fieldNoHeader},
+	{.high=12, .low=12, .name_p="GPI_2", .flags=fieldNoHeader},
+	{.high=11, .low=11, .name_p="GPI_1/SERVICE_N", .flags=fieldNoHeader},
+	{.high=10, .low=10, .name_p="GPI_0/I2S1RX_SDA", .flags=fieldNoHeader},
+	{.high=9, .low=9, .name_p="SYSCLKEN", .flags=fieldNoHeader},
+	{.high=8, .low=8, .name_p="SPI1_DATIN", .flags=fieldNoHeader},
+	{.high=7, .low=7, .name_p="GPI_7", .flags=fieldNoHeader},
+	{.high=6, .low=6, .name_p="SPI2_DATIN", .flags=fieldNoHeader},
+	{.high=5, .low=5, .name_p="GPI_19/UART4_RX", .flags=fieldNoHeader},
+	{.high=4, .low=4, .name_p="GPI_9", .flags=fieldNoHeader},
+	{.high=3, .low=3, .name_p="GPI_8", .flags=fieldNoHeader},
+	{.high=2, .low=0, .name_p="(reserved)", .flags=fieldNoHeader|fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "SPI1 clock control");
-	field = print_field(val, 0, 0);
-	printf("%s\n", (field == 0)? "disable" : "enable");
-}
+static const FieldDescription_t clkpower__start_er_int[] = {
+	{.high=31, .low=0, .name_p="The following internal sources can start up the chip from STOP mode", .flags=fieldHeaderOnly|fieldNoRange},
+	{.high=31, .low=31, .name_p="TS_INT", .flags=fieldNoHeader},
+	{.high=30, .low=30, .name_p="TS_P", .flags=fieldNoHeader},
+	{.high=29, .low=29, .name_p="TS_AUX", .flags=fieldNoHeader},
+	{.high=28, .low=27, .name_p="(reserved)", .flags=fieldNoHeader},
+	{.high=26, .low=26, .name_p="USB_AHB_NEED_CLK", .flags=fieldNoHeader},
+	{.high=25, .low=25, .name_p="MSTIMER_INT", .flags=fieldNoHeader},
+	{.high=24, .low=24, .name_p="RTC_INT interrupt from RTC", .flags=fieldNoHeader},
+	{.high=23, .low=23, .name_p="USB_NEED_CLK", .flags=fieldNoHeader},
+	{.high=22, .low=22, .name_p="USB_INT", .flags=fieldNoHeader},
+	{.high=21, .low=21, .name_p="USB_I2C_INT", .flags=fieldNoHeader},
+	{.high=20, .low=20, .name_p="USB_OTG_TIMER_INT", .flags=fieldNoHeader},
+	{.high=19, .low=19, .name_p="USB_OTG_ATX_INT_N", .flags=fieldNoHeader},
+	{.high=18, .low=17, .name_p="(reserved)", .flags=fieldNoHeader},
+	{.high=16, .low=16, .name_p="KEY_IRQ", .flags=fieldNoHeader},
+	{.high=15, .low=8, .name_p="(reserved)", .flags=fieldNoHeader},
+	{.high=7, .low=7, .name_p="ethernet MAC start request", .flags=fieldNoHeader},
+	{.high=6, .low=6, .name_p="port 0/port 1 start request (OR's all or port 0 and port 1, see P0_INTR_ER)", .flags=fieldNoHeader},
+	{.high=5, .low=5, .name_p="GPIO_5", .flags=fieldNoHeader},
+	{.high=4, .low=4, .name_p="GPIO_4", .flags=fieldNoHeader},
+	{.high=3, .low=3, .name_p="GPIO_3", .flags=fieldNoHeader},
+	{.high=2, .low=2, .name_p="GPIO_2", .flags=fieldNoHeader},
+	{.high=1, .low=1, .name_p="GPIO_1", .flags=fieldNoHeader},
+	{.high=0, .low=0, .name_p="GPIO_0", .flags=fieldNoHeader|fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
-static void
-clkpower__i2cclk_ctrl(uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t clkpower__p0_intr_er[] = {
+	{.high=31, .low=11, .name_p="P1.[23:3]", .flags=fieldNoHeader},
+	{.high=10, .low=10, .name_p="P1.2", .flags=fieldNoHeader},
+	{.high=9, .low=9, .name_p="P1.1", .flags=fieldNoHeader},
+	{.high=8, .low=8, .name_p="P1.0", .flags=fieldNoHeader},
+	{.high=7, .low=7, .name_p="P0.7", .flags=fieldNoHeader},
+	{.high=6, .low=6, .name_p="P0.6", .flags=fieldNoHeader},
+	{.high=5, .low=5, .name_p="P0.5", .flags=fieldNoHeader},
+	{.high=4, .low=4, .name_p="P0.4", .flags=fieldNoHeader},
+	{.high=3, .low=3, .name_p="P0.3", .flags=fieldNoHeader},
+	{.high=2, .low=2, .name_p="P0.2", .flags=fieldNoHeader},
+	{.high=1, .low=1, .name_p="P0.1", .flags=fieldNoHeader},
+	{.high=0, .low=0, .name_p="P0.0", .flags=fieldNoHeader|fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[4]", "driver strength control for USB_I2C_SCL and USB_I2C_SDA");
-	field = print_field(val, 4, 4);
-	if (field == 0)
-		printf("USB I2C pins operate in low drive mode");
-	else
-		printf("USB I2C pins operate in high drive mode");
-	printf("\n");
+static const FieldDescription_t clkpower__start_sr_pin[] = {
+	{.high=31, .low=3, .name_p="current state of device pin startup sources after masking with START_ER_PIN", .flags=fieldNoHeader},
+	{.high=2, .low=0, .name_p="(reserved)", .flags=fieldNoHeader|fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[3]", "I2C2_SCL and I2C2_SDA driver strength control");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("I2C2 pins operate in low drive mode");
-	else
-		printf("I2C2 pins operate in high drive mode");
-	printf("\n");
+static const FieldDescription_t clkpower__start_sr_int[] = {
+	{.high=31, .low=3, .name_p="current state of possible internal startup sources, after masking with START_ER_INT", .flags=fieldNoHeader},
+	{.high=2, .low=0, .name_p="(reserved)", .flags=fieldNoHeader|fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[2]", "I2C1_SCL and I2C1_SDA driver strength control");
-	field = print_field(val, 2, 2);
-	if (field == 0)
-		printf("I2C1 pins operate in low drive mode");
-	else
-		printf("I2C1 pins operate in high drive mode");
-	printf("\n");
+static const FieldDescription_t clkpower__start_rsr_pin[] = {
+	{.high=31, .low=3, .name_p="current state of possible device pin startup sources, prior to masking", .flags=fieldNoHeader},
+	{.high=2, .low=0, .name_p="(reserved)", .flags=fieldNoHeader|fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[1]", "software must set this bit before using the I2C2 block, it can be cleared if I2C2 block is not in use");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("I2C2 HCLK stopped, no I2C registers are accessible");
-	else
-		printf("I2C2 HCLK enabled");
-	printf("\n");
+static const FieldDescription_t clkpower__start_rsr_int[] = {
+	{.high=31, .low=3, .name_p="current state of possible internal startup sources, prior to masking", .flags=fieldNoHeader},
+	{.high=2, .low=0, .name_p="(reserved)", .flags=fieldNoHeader|fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "software must set this bit before using the I2C1 block, it can be cleared if the I2C1 block is not in use");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("I2C1 HCLK stopped, no I2C registers are accessible");
-	else
-		printf("I2C1 HCLK enabled");
-	printf("\n");
-}
+static const FieldDescription_t clkpower__start_apr_pin[] = {
+	{.high=31, .low=3, .name_p="allows selecting the polarity that device pin start signal sources use as a start condition", .flags=fieldNoHeader},
+	{.high=2, .low=0, .name_p="(reserved)", .flags=fieldNoHeader|fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
-static void
-clkpower__timclk_ctrl1(uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t clkpower__start_apr_int[] = {
+	{.high=31, .low=3, .name_p="allows selecting the polarity that internal start signal sources use as a start condition", .flags=fieldNoHeader},
+	{.high=2, .low=0, .name_p="(reserved)", .flags=fieldNoHeader|fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[6]", "motor control clock enable");
-	field = print_field(val, 6, 6);
-	printf("%s\n", (field == 0)? "disable" : "enable");
+static const char * const enabled[] = {"disabled", "enabled"};
+static const char * const usbI2c[] = {
+	"ip_3506_otg_tx_en_n is fed to OE_TP_N pad",
+	"'0' is fed to OE_TP_N pad",
+};
+static const char * const devNeedClk[] = {
+	"usb_dev_need_clk is not let into the clock switch",
+	"usb_dev_need_clk is let into clock switch",
+};
+static const char * const hostNeedClk[] = {
+	"usb_host_need_clk_en is not let into the clock switch",
+	"usb_host_need_clk_en is let into clock switch",
+};
+static const char * const usbPads[] = {
+	"pull-up added to pad",
+	"bus keeper, retains the last driven value",
+	"no added function",
+	"pull-down added to pad",
+};
+static const char * const usbClken2[] = {
+	"stop clock going into USB clock",
+	"enable clock going into USB clock",
+};
+static const char * const usbClken1[] = {
+	"stop clock going into the USB PLL",
+	"enable clock going into the USB PLL",
+};
+static const char * const usbFeedback[] = {
+	"feedback divider clocked by CCO clock",
+	"feedback divider clocked by post FCLKOUT",
+};
+static const char * const usbPostDiv[] = {
+	"divide by 2 (P=1)",
+	"divide by 4 (P=2)",
+	"divide by 8 (P=4)",
+	"divide by 16 (P=8)",
+};
+static const char * const usbPllLock[] = {"PLL not locked", "PLL locked, output clock stable"};
+
+static const FieldDescription_t clkpower__usb_ctrl[] = {
+	{.high=24, .low=24, .name_p="USB slave HCLK control", FIELDTEXT(enabled)},
+	{.high=23, .low=23, .name_p="usb_i2c enable", FIELDTEXT(usbI2c)},
+	{.high=22, .low=22, .name_p="usb_dev_need_clk_en", FIELDTEXT(devNeedClk)},
+	{.high=21, .low=21, .name_p="usb_host_need_clk_en", FIELDTEXT(hostNeedClk)},
+	{.high=20, .low=19, .name_p="pad control for USB_DAT_VP and USB_SE0_VM pads", FIELDTEXT(usbPads)},
+	{.high=18, .low=18, .name_p="USB_Clken2 clock control", FIELDTEXT(usbClken2)},
+	{.high=17, .low=17, .name_p="USB_Clken1 clock control", FIELDTEXT(usbClken1)},
+	{.high=16, .low=16, .name_p="PLL power down", FIELDTEXT(pllPower)},
+	{.high=15, .low=15, .name_p="bypass control", FIELDTEXT(pllBypass)},
+	{.high=14, .low=14, .name_p="direct output control", FIELDTEXT(pllDirect)},
+	{.high=13, .low=13, .name_p="feedback divider path control", FIELDTEXT(usbFeedback)},
+	{.high=12, .low=11, .name_p="PLL post-divider (P) setting", FIELDTEXT(usbPostDiv)},
+	{.high=10, .low=9, .name_p="PLL pre-divider (N) setting", .fmt_p="%d", .offset=1},
+	{.high=8, .low=1, .name_p="PLL feedback divider (M) setting", .fmt_p="%d", .offset=1},
+	{.high=0, .low=0, .name_p="PLL lock status", FIELDTEXT(usbPllLock), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[5]", "timer 3 clock enable control");
-	field = print_field(val, 5, 5);
-	printf("%s\n", (field == 0)? "disable" : "enable");
+static const FieldDescription_t clkpower__usb_div[] = {
+	{.high=3, .low=0, .name_p="USB_RATE: controls USB pre-clock divider", .fmt_p="%d", .offset=1, .flags=fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[4]", "timer 2 clock enable control");
-	field = print_field(val, 4, 4);
-	printf("%s\n", (field == 0)? "disable" : "enable");
+static const char * const sdPins[] = {
+	"enable SDcard interface pins",
+	"disable SDcard interface pins and enable peripheral MUX registers",
+};
+static const char * const mssdio[] = {"MSSDIO pull-up and clock disable", "MSSDIO pull-up and clock enable"};
+static const char * const mssdio23[] = {
+	"MSSDIO2 and 3 pad has pull-up enabled",
+	"MSSDIO2 and 3 pad has no pull-up",
+};
+static const char * const mssdio1[] = {"MSSDIO1 pad has pull-up enabled", "MSSDIO1 pad has no pull-up"};
+static const char * const mssdio0[] = {"MSSDIO0 pad has pull-up enabled", "MSSDIO0 pad has no pull-up"};
+static const char * const sdClock[] = {"clocks disabled", "clocks enabled"};
+static const char * const msDiv[] = {"MSSDCLK stopped, divider in low power mode"};
+
+static const FieldDescription_t clkpower__ms_ctrl[] = {
+	{.high=10, .low=10, .name_p="disable SDcard pins", FIELDTEXT(sdPins)},
+	{.high=9, .low=9, .name_p="enables clock and pull-ups to MSSDIO pins", FIELDTEXT(mssdio)},
+	{.high=8, .low=8, .name_p="MSSDIO2 and MSSDIO3 pad control", FIELDTEXT(mssdio23)},
+	{.high=7, .low=7, .name_p="MSSDIO1 pad control", FIELDTEXT(mssdio1)},
+	{.high=6, .low=6, .name_p="MSSDIO0/MSBS pad control", FIELDTEXT(mssdio0)},
+	{.high=5, .low=5, .name_p="SDcard clock control", FIELDTEXT(sdClock)},
+	{.high=3, .low=0, .name_p="divider ratio when generating clock from ARM PLL output clock", FIELDTEXT(msDiv), .fmt_p="MSSDCLK equals ARM PLL output clock divided by %d", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[3]", "timer 1 clock enable control");
-	field = print_field(val, 3, 3);
-	printf("%s\n", (field == 0)? "disable" : "enable");
+static const char * const dmaClk[] = {
+	"all clocks to DMA stopped, no access to DMA registers allowed",
+	"all clocks to DMA enabled",
+};
 
-	printf(ITEMFMT, "[2]", "timer 0 clock enable control");
-	field = print_field(val, 2, 2);
-	printf("%s\n", (field == 0)? "disable" : "enable");
+static const FieldDescription_t clkpower__dmaclk_ctrl[] = {
+	{.high=0, .low=0, .name_p="DMA clock", FIELDTEXT(dmaClk), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[1]", "timer 5 clock enable control");
-	field = print_field(val, 1, 1);
-	printf("%s\n", (field == 0)? "disable" : "enable");
+static const char * const nandInt[] = {
+	"enable the SLC NAND flash controller interrupt",
+	"enable the MLC NAND flash controller interrupt",
+};
+static const char * const enable[] = {"disable", "enable"};
+static const char * const nandSel[] = {"MLC", "SLC"};
+static const char * const mlcClk[] = {
+	"disable clocks to the block, including the AHB interface",
+	"enable clock",
+};
+static const char * const slcClk[] = {
+	"disable clocks to the block, including to the AHB interface",
+	"enable clock",
+};
 
-	printf(ITEMFMT, "[0]", "timer 4 clock enable control");
-	field = print_field(val, 0, 0);
-	printf("%s\n", (field == 0)? "disable" : "enable");
-}
+static const FieldDescription_t clkpower__flashclk_ctrl[] = {
+	{.high=5, .low=5, .name_p="which NAND flash controller interrupt is connected to the interrupt controller", FIELDTEXT(nandInt)},
+	{.high=4, .low=4, .name_p="enable NAND_DMA_REQ on NAND_RnB (MLC only)", FIELDTEXT(enable)},
+	{.high=3, .low=3, .name_p="enable NAND_DMA_REQ on NAND_INT (MLC only)", FIELDTEXT(enable)},
+	{.high=2, .low=2, .name_p="SLC/MLC select", FIELDTEXT(nandSel)},
+	{.high=1, .low=1, .name_p="MLC NAND flash clock enable", FIELDTEXT(mlcClk)},
+	{.high=0, .low=0, .name_p="SLC NAND flash clock enable control", FIELDTEXT(slcClk), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-clkpower__timclk_ctrl(uint32_t val)
-{
-	uint32_t field;
+static const char * const macPins[] = {
+	"do not connect ethernet MAC to port pins",
+	"connect ethernet MAC to port pins in MII mode",
+	"do not connect ethernet MAC to port pins",
+	"connect ethernet MAC to port pins in RMII mode",
+};
 
-	printf(ITEMFMT, "[1]", "HSTimer clock enable control");
-	field = print_field(val, 1, 1);
-	printf("%s\n", (field == 0)? "disable" : "enable");
+static const FieldDescription_t clkpower__macclk_ctrl[] = {
+	{.high=4, .low=3, .name_p="ethernet MAC hardware interface control", FIELDTEXT(macPins)},
+	{.high=2, .low=2, .name_p="MASTER_CLK", FIELDTEXT(enabled)},
+	{.high=1, .low=1, .name_p="REG_CLK", FIELDTEXT(enabled)},
+	{.high=0, .low=0, .name_p="SLAVE_CLK", FIELDTEXT(enabled)},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "Watchdog clock enable control");
-	field = print_field(val, 0, 0);
-	printf("%s\n", (field == 0)? "disable" : "enable");
-}
+static const char * const displayType[] = {"TFT", "STN"};
+// TFT modes, then STN modes (DISPLAY_TYPE, bit 8)
+static const char * const lcdMode[] = {
+	"single panel, 12-bit (4:4:4), 18 pins",
+	"single panel, 16-bit (5:6:5), 22 pins",
+	"single panel, 16-bit (1:5:5:5), 24 pins",
+	"single panel, 24-bit, 30 pins",
+	"single panel, 4-bit mono, 10 pins",
+	"single panel, 8-bit mono/colour, 14 pins",
+	"dual panel, 4-bit mono, 14 pins",
+	"dual panel, 8-bit mono/colour, 22 pins",
+};
+static const char * const lcdHclk[] = {
+	"disable HCLK signal to LCD controller",
+	"enable HCLK signal to LCD controller",
+};
 
-static void
-clkpower__adclk_ctrl(uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t clkpower__lcdclk_ctrl[] = {
+	{.high=8, .low=8, .name_p="DISPLAY_TYPE", FIELDTEXT(displayType)},
+	{.high=7, .low=6, .name_p="MODE_SELECT", FIELDTEXT(lcdMode), .qualBit=8, .flags=fieldQualified},
+	{.high=5, .low=5, .name_p="HCLK_ENABLE", FIELDTEXT(lcdHclk)},
+	{.high=4, .low=0, .name_p="CLKDIV", .fmt_p="LCD panel clock prescaler: 0x%x", .flags=fieldNoBits|fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "analog to digital converter and touch screen");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("disable 32kHz clock to ADC block");
-	else
-		printf("enable clock");
-	printf("\n");
-}
+static const char * const txMode[] = {"TX_CLK drives I2S TX timing", "RX_CLK drives I2S TX timing"};
+static const char * const rxMode[] = {"RX_CLK drives I2S RX timing", "TX_CLK drives I2S RX timing"};
+static const char * const i2s1Dma[] = {
+	"UART7 RX is connected to DMA (I2S1 DMA 1 is not conntected to DMA",
+	"I2S1 DMA 1 in connected to DMA (UART7 RX is not connected to DMA)",
+};
 
-static void
-clkpower__adclk_ctrl1(uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t clkpower__i2s_ctrl[] = {
+	{.high=6, .low=6, .name_p="I2S1 CLK_TX_MODE select", FIELDTEXT(txMode)},
+	{.high=5, .low=5, .name_p="I2S1_RX_MODE select", FIELDTEXT(rxMode)},
+	{.high=4, .low=4, .name_p="I2S1 DMA1 connection control", FIELDTEXT(i2s1Dma)},
+	{.high=3, .low=3, .name_p="I2S0_CLK_TX_MODE select", FIELDTEXT(txMode)},
+	{.high=2, .low=2, .name_p="I2S0_CLK_RX_MODE select", FIELDTEXT(rxMode)},
+	{.high=1, .low=1, .name_p="I2S1_CLK enable", FIELDTEXT(enable)},
+	{.high=0, .low=0, .name_p="I2S0_CLK enable", FIELDTEXT(enable), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[8]", "ADC clock select");
-	field = print_field(val, 8, 8);
-	if (field == 0)
-		printf("clock ADC and touch screen from RTC clock");
-	else
-		printf("clock ADC and touch screen from PERIPH_CLK clock");
-	printf("\n");
+static const char * const ssp1Rx[] = {
+	"SSP1 RX is not conntected to DMA and SPI2 is connected to DMA",
+	"SSP1 RX is connected to DMA and SPI2 is not connected to DMA",
+};
+static const char * const ssp1Tx[] = {
+	"SSP1 TX is not connected to DMA and SPI1 is connected to DMA",
+	"SSP1 TX is connected to DMA and SPI1 is not connected to DMA",
+};
+static const char * const ssp0Rx[] = {"SSP0 RX is not connected to DMA", "SSP0 RX is connected to DMA"};
+static const char * const ssp0Tx[] = {"SSP0 TX is not connected to DMA", "SSP0 TX is connected to DMA"};
+
+static const FieldDescription_t clkpower__ssp_ctrl[] = {
+	{.high=5, .low=5, .name_p="SSP1 RX DMA connection control", FIELDTEXT(ssp1Rx)},
+	{.high=4, .low=4, .name_p="SSP1 TX DMA connection control", FIELDTEXT(ssp1Tx)},
+	{.high=3, .low=3, .name_p="SSP0 RX DMA connection control", FIELDTEXT(ssp0Rx)},
+	{.high=2, .low=2, .name_p="SSP0 TX DMA connection control", FIELDTEXT(ssp0Tx)},
+	{.high=1, .low=1, .name_p="SSP1 clock enable", FIELDTEXT(enable)},
+	{.high=0, .low=0, .name_p="SSP0 clock enable", FIELDTEXT(enable), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[7:0]", "controls the clock divider for ADC when peripheral clock (bit 8) is enabled");
-	field = print_field(val, 7, 0);
-	printf("%d\n", field + 1);
-}
+// the output levels only apply while the output pin control bit is 0
+static const char * const spi2Datio[] = {
+	"the pin drives low (pin 5 == 0)",
+	"the pin drives high (pin 5 == 0)",
+	"this pin is driven by the SPI2 block",
+	"this pin is driven by the SPI2 block",
+};
+static const char * const spi2Clk[] = {
+	"the pin drives low (bit 5 == 0)",
+	"the pin drives high (bit 5 == 0)",
+	"this pin is driven by the SPI2 block",
+	"this pin is driven by the SPI2 block",
+};
+static const char * const spi1Out[] = {
+	"the pin drives low (bit 1 == 0)",
+	"the pin drives high (bit 1 == 0)",
+	"this pin is driven by the SPI1 block",
+	"this pin is driven by the SPI1 block",
+};
+static const char * const spi2Pins[] = {
+	"SPI2_DATIO and SPI2_CLK outputs the level set by bit 6 and 7",
+	"SPI2_DATIO and SPI2_CLK are driven by the SPI2 block",
+};
+static const char * const spi1Pins[] = {
+	"SPI1_DATIO and SPI1_CLK outputs the level set by bit 2 and 3",
+	"SPI1_DATIO and SPI1_CLK are driven by the SPI1 block",
+};
 
-static void
-clkpower__keyclk_ctrl(uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t clkpower__spi_ctrl[] = {
+	{.high=7, .low=7, .name_p="SPI2_DATIO output level", FIELDTEXT(spi2Datio), .qualBit=5, .flags=fieldQualified},
+	{.high=6, .low=6, .name_p="SPI2_CLK output level", FIELDTEXT(spi2Clk), .qualBit=5, .flags=fieldQualified},
+	{.high=5, .low=5, .name_p="output pin control", FIELDTEXT(spi2Pins)},
+	{.high=4, .low=4, .name_p="SPI2 clock enable control", FIELDTEXT(enable)},
+	{.high=3, .low=3, .name_p="SPI1_DATIO output level", FIELDTEXT(spi1Out), .qualBit=1, .flags=fieldQualified},
+	{.high=2, .low=2, .name_p="SPI1_CLK output level", FIELDTEXT(spi1Out), .qualBit=1, .flags=fieldQualified},
+	{.high=1, .low=1, .name_p="output pin control", FIELDTEXT(spi1Pins)},
+	{.high=0, .low=0, .name_p="SPI1 clock control", FIELDTEXT(enable), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "keyboard scan peripheral");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("disable clock to keyboard block");
-	else
-		printf("enable clock");
-	printf("\n");
-}
+static const char * const usbI2cDrive[] = {
+	"USB I2C pins operate in low drive mode",
+	"USB I2C pins operate in high drive mode",
+};
+static const char * const i2c2Drive[] = {
+	"I2C2 pins operate in low drive mode",
+	"I2C2 pins operate in high drive mode",
+};
+static const char * const i2c1Drive[] = {
+	"I2C1 pins operate in low drive mode",
+	"I2C1 pins operate in high drive mode",
+};
+static const char * const i2c2Clk[] = {
+	"I2C2 HCLK stopped, no I2C registers are accessible",
+	"I2C2 HCLK enabled",
+};
+static const char * const i2c1Clk[] = {
+	"I2C1 HCLK stopped, no I2C registers are accessible",
+	"I2C1 HCLK enabled",
+};
 
-static void
-clkpower__pwmclk_ctrl(uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t clkpower__i2cclk_ctrl[] = {
+	{.high=4, .low=4, .name_p="driver strength control for USB_I2C_SCL and USB_I2C_SDA", FIELDTEXT(usbI2cDrive)},
+	{.high=3, .low=3, .name_p="I2C2_SCL and I2C2_SDA driver strength control", FIELDTEXT(i2c2Drive)},
+	{.high=2, .low=2, .name_p="I2C1_SCL and I2C1_SDA driver strength control", FIELDTEXT(i2c1Drive)},
+	{.high=1, .low=1, .name_p="software must set this bit before using the I2C2 block, it can be cleared if I2C2 block is not in use", FIELDTEXT(i2c2Clk)},
+	{.high=0, .low=0, .name_p="software must set this bit before using the I2C1 block, it can be cleared if the I2C1 block is not in use", FIELDTEXT(i2c1Clk), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[11:8]", "PWM2_FREQ, controls the clock divider for PWM2");
-	field = print_field(val, 11, 8);
-	switch (field) {
-		case 0:
-			printf("PWM2_CLK = off");
-			break;
-		case 1:
-			printf("PWM2_CLK = CLKin");
-			break;
-		default:
-			printf("PWM2_CLK = CLKin / %d", field);
-			break;
-	}
-	printf("\n");
+static const FieldDescription_t clkpower__timclk_ctrl1[] = {
+	{.high=6, .low=6, .name_p="motor control clock enable", FIELDTEXT(enable)},
+	{.high=5, .low=5, .name_p="timer 3 clock enable control", FIELDTEXT(enable)},
+	{.high=4, .low=4, .name_p="timer 2 clock enable control", FIELDTEXT(enable)},
+	{.high=3, .low=3, .name_p="timer 1 clock enable control", FIELDTEXT(enable)},
+	{.high=2, .low=2, .name_p="timer 0 clock enable control", FIELDTEXT(enable)},
+	{.high=1, .low=1, .name_p="timer 5 clock enable control", FIELDTEXT(enable)},
+	{.high=0, .low=0, .name_p="timer 4 clock enable control", FIELDTEXT(enable), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[7:4]", "PWM1_FREQ, controls the clock divider for PWM1");
-	field = print_field(val, 7, 4);
-	switch (field) {
-		case 0:
-			printf("PWM1_CLK = off");
-			break;
-		case 1:
-			printf("PWM1_CLK = CLKin");
-			break;
-		default:
-			printf("PWM1_CLK = CLKin / %d", field);
-			break;
-	}
-	printf("\n");
+static const FieldDescription_t clkpower__timclk_ctrl[] = {
+	{.high=1, .low=1, .name_p="HSTimer clock enable control", FIELDTEXT(enable)},
+	{.high=0, .low=0, .name_p="Watchdog clock enable control", FIELDTEXT(enable), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[3]", "PWM2 clock source selection");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("32kHz RTC_CLK");
-	else
-		printf("PERIPH_CLK");
-	printf("\n");
+static const char * const adClk[] = {"disable 32kHz clock to ADC block", "enable clock"};
 
-	printf(ITEMFMT, "[2]", "PWM2 block enable");
-	field = print_field(val, 2, 2);
-	if (field == 0)
-		printf("disable clock to PWM2 block");
-	else
-		printf("enable clock to PWM2 block");
-	printf("\n");
+static const FieldDescription_t clkpower__adclk_ctrl[] = {
+	{.high=0, .low=0, .name_p="analog to digital converter and touch screen", FIELDTEXT(adClk), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[1]", "PWM1 clock source selection");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("32kHz RTC_CLK");
-	else
-		printf("PERIPH_CLK");
-	printf("\n");
+static const char * const adClkSel[] = {
+	"clock ADC and touch screen from RTC clock",
+	"clock ADC and touch screen from PERIPH_CLK clock",
+};
 
-	printf(ITEMFMT, "[0]", "PWM1 block enable");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("disable clock to PWM1 block");
-	else
-		printf("enable clock to PWM1 block");
-	printf("\n");
-}
+static const FieldDescription_t clkpower__adclk_ctrl1[] = {
+	{.high=8, .low=8, .name_p="ADC clock select", FIELDTEXT(adClkSel)},
+	{.high=7, .low=0, .name_p="controls the clock divider for ADC when peripheral clock (bit 8) is enabled", .fmt_p="%d", .offset=1, .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-clkpower__uartclk_ctrl(uint32_t val)
-{
-	uint32_t field;
+static const char * const keyClk[] = {"disable clock to keyboard block", "enable clock"};
 
-	printf(ITEMFMT, "[3]", "uart 6");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("HCLK disabled and in low-power mode, no access to UART registers allowed");
-	else
-		printf("HCLK enabled");
-	printf("\n");
+static const FieldDescription_t clkpower__keyclk_ctrl[] = {
+	{.high=0, .low=0, .name_p="keyboard scan peripheral", FIELDTEXT(keyClk), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[2]", "uart 5");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("HCLK disabled and in low-power mode, no access to UART registers allowed");
-	else
-		printf("HCLK enabled");
-	printf("\n");
+static const char * const pwm2Freq[] = {"PWM2_CLK = off", "PWM2_CLK = CLKin"};
+static const char * const pwm1Freq[] = {"PWM1_CLK = off", "PWM1_CLK = CLKin"};
+static const char * const pwmSource[] = {"32kHz RTC_CLK", "PERIPH_CLK"};
+static const char * const pwm2Clk[] = {"disable clock to PWM2 block", "enable clock to PWM2 block"};
+static const char * const pwm1Clk[] = {"disable clock to PWM1 block", "enable clock to PWM1 block"};
+
+static const FieldDescription_t clkpower__pwmclk_ctrl[] = {
+	{.high=11, .low=8, .name_p="PWM2_FREQ, controls the clock divider for PWM2", FIELDTEXT(pwm2Freq), .fmt_p="PWM2_CLK = CLKin / %d"},
+	{.high=7, .low=4, .name_p="PWM1_FREQ, controls the clock divider for PWM1", FIELDTEXT(pwm1Freq), .fmt_p="PWM1_CLK = CLKin / %d"},
+	{.high=3, .low=3, .name_p="PWM2 clock source selection", FIELDTEXT(pwmSource)},
+	{.high=2, .low=2, .name_p="PWM2 block enable", FIELDTEXT(pwm2Clk)},
+	{.high=1, .low=1, .name_p="PWM1 clock source selection", FIELDTEXT(pwmSource)},
+	{.high=0, .low=0, .name_p="PWM1 block enable", FIELDTEXT(pwm1Clk), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[1]", "uart 4");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("HCLK disabled and in low-power mode, no access to UART registers allowed");
-	else
-		printf("HCLK enabled");
-	printf("\n");
+static const char * const uartClk[] = {
+	"HCLK disabled and in low-power mode, no access to UART registers allowed",
+	"HCLK enabled",
+};
 
-	printf(ITEMFMT, "[0]", "uart 3");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("HCLK disabled and in low-power mode, no access to UART registers allowed");
-	else
-		printf("HCLK enabled");
-	printf("\n");
-}
+static const FieldDescription_t clkpower__uartclk_ctrl[] = {
+	{.high=3, .low=3, .name_p="uart 6", FIELDTEXT(uartClk)},
+	{.high=2, .low=2, .name_p="uart 5", FIELDTEXT(uartClk)},
+	{.high=1, .low=1, .name_p="uart 4", FIELDTEXT(uartClk)},
+	{.high=0, .low=0, .name_p="uart 3", FIELDTEXT(uartClk), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-clkpower__pos0_iram_ctrl(uint32_t val)
-{
-	printf(ITEMFMT, "", "Power-Off Switch (POS) 0");
-	print_field(val, 3, 3);
-	printf("[3] control for 0x30000-0x3ffff\n");
-	print_field(val, 2, 2);
-	printf("[2] control for 0x20000-0x2ffff\n");
-	print_field(val, 1, 1);
-	printf("[1] control for 0x10000-0x1ffff\n");
-	printf("\n");
-}
+static const FieldDescription_t clkpower__pos0_iram_ctrl[] = {
+	{.high=3, .low=1, .name_p="Power-Off Switch (POS) 0", .flags=fieldHeaderOnly|fieldNoRange},
+	{.high=3, .low=3, .name_p="control for 0x30000-0x3ffff", .flags=fieldNoHeader},
+	{.high=2, .low=2, .name_p="control for 0x20000-0x2ffff", .flags=fieldNoHeader},
+	{.high=1, .low=1, .name_p="control for 0x10000-0x1ffff", .flags=fieldNoHeader|fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
-static void
-clkpower__pos1_iram_ctrl(uint32_t val)
-{
-	printf(ITEMFMT, "", "Power-Off Switch (POS) 1");
-	print_field(val, 3, 3);
-	printf("[3] control for 0x30000-0x3ffff\n");
-	print_field(val, 2, 2);
-	printf("[2] control for 0x20000-0x2ffff\n");
-	print_field(val, 1, 1);
-	printf("[1] control for 0x10000-0x1ffff\n");
-	printf("\n");
-}
+static const FieldDescription_t clkpower__pos1_iram_ctrl[] = {
+	{.high=3, .low=1, .name_p="Power-Off Switch (POS) 1", .flags=fieldHeaderOnly|fieldNoRange},
+	{.high=3, .low=3, .name_p="control for 0x30000-0x3ffff", .flags=fieldNoHeader},
+	{.high=2, .low=2, .name_p="control for 0x20000-0x2ffff", .flags=fieldNoHeader},
+	{.high=1, .low=1, .name_p="control for 0x10000-0x1ffff", .flags=fieldNoHeader|fieldEOL|fieldBlankLine},
+	{.name_p=NULL},
+};
 
 RegisterDescription_t clkpower[] = {
 	{0x40004044, 0x00000012, "PWR_CTRL", "AHB/ARM power control register", accessRW, clkpower__pwr_ctrl},
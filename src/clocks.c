@@ -0,0 +1,340 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * the clock tree, evaluated from the clkpwr registers
+ *
+ *   main oscillator --+                  +-- (RUN mode) ------------------ ARM_CLK
+ *                     +-- SYSCLK --+-----+-- HCLK PLL --+-- / HCLK div ------ HCLK
+ *   RTC -- PLL397 ----+            |                    +-- / PERIPH div ---- PERIPH_CLK
+ *                                  |                    +-- / 1 or 2 -------- DDRAM_CLK
+ *                                  +-- / USB div -- USB PLL ------------------ USB clock
+ *
+ * in direct RUN mode (PWR_CTRL[2] clear) ARM_CLK, HCLK and PERIPH_CLK all
+ * run from SYSCLK and the HCLK PLL isn't used; PWR_CTRL[10] makes ARM_CLK
+ * and HCLK run from PERIPH_CLK
+ *
+ * both PLLs work the same way (see the HCLKPLL_CTRL fields):
+ *   bypass  direct  feedback
+ *     1       1       -      FCLKOUT = FCLKIN
+ *     1       0       -      FCLKOUT = FCLKIN / 2P
+ *     0       1       -      FCLKOUT = FCCO = M x FCLKIN / N
+ *     0       0       1      FCLKOUT = M x FCLKIN / N, FCCO = 2P x FCLKOUT
+ *     0       0       0      FCCO = M x FCLKIN / N, FCLKOUT = FCCO / 2P
+ * and a PLL that's powered down has no output
+ *
+ * the main oscillator's frequency can't be read from the registers, so
+ * it's given by the caller, or taken from lpc32x0__osc_hz()
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "registers.h"
+
+#define PLL397_MULT 397
+
+// HCLKDIV_CTRL[1:0], 3 isn't used
+static const unsigned hclkDiv[] = {1, 2, 4, 0};
+
+typedef struct {
+	bool power;
+	bool bypass;
+	bool direct;
+	bool feedback;
+	unsigned p;
+	unsigned n;
+	unsigned m;
+	bool locked;
+} Pll_t;
+
+static void
+pll_fields (uint32_t ctrl, Pll_t *pll_p)
+{
+	pll_p->power = (ctrl >> 16) & 1;
+	pll_p->bypass = (ctrl >> 15) & 1;
+	pll_p->direct = (ctrl >> 14) & 1;
+	pll_p->feedback = (ctrl >> 13) & 1;
+	pll_p->p = 1u << ((ctrl >> 11) & 3);
+	pll_p->n = ((ctrl >> 9) & 3) + 1;
+	pll_p->m = ((ctrl >> 1) & 0xff) + 1;
+	pll_p->locked = ctrl & 1;
+}
+
+static uint64_t
+divide (uint64_t hz, uint64_t div)
+{
+	return (div == 0)? 0 : (hz + (div / 2)) / div;
+}
+
+// returns FCLKOUT, *cco_p is FCCO (0 if the CCO isn't used)
+static uint64_t
+pll_out (uint32_t ctrl, uint64_t in, uint64_t *cco_p)
+{
+	Pll_t pll;
+
+	pll_fields(ctrl, &pll);
+	*cco_p = 0;
+	if (!pll.power)
+		return 0;
+	if (pll.bypass)
+		return pll.direct? in : divide(in, 2 * pll.p);
+	if (pll.direct) {
+		*cco_p = divide(in * pll.m, pll.n);
+		return *cco_p;
+	}
+	if (pll.feedback) {
+		*cco_p = divide(in * pll.m * 2 * pll.p, pll.n);
+		return divide(in * pll.m, pll.n);
+	}
+	*cco_p = divide(in * pll.m, pll.n);
+	return divide(*cco_p, 2 * pll.p);
+}
+
+/*
+ * the board's main oscillator: $LPC32X0_OSC (in Hz) if it's set, else
+ * CLK_OSC_HZ; every tool's default, and the sim backend's
+ */
+uint64_t
+lpc32x0__osc_hz (void)
+{
+	char *end_p;
+	const char *env_p;
+	unsigned long long hz;
+	static uint64_t oscHz_G = 0;
+
+	if (oscHz_G != 0)
+		return oscHz_G;
+	oscHz_G = CLK_OSC_HZ;
+	env_p = getenv("LPC32X0_OSC");
+	if ((env_p != NULL) && (*env_p != 0)) {
+		hz = strtoull(env_p, &end_p, 0);
+		if ((*end_p != 0) || (hz == 0))
+			printf("LPC32X0_OSC: bad frequency '%s', using %d Hz\n", env_p, CLK_OSC_HZ);
+		else
+			oscHz_G = hz;
+	}
+	return oscHz_G;
+}
+
+void
+lpc32x0__eval_clocks (const ClockRegs_t *regs_p, uint64_t oscHz, Clocks_t *clk_p)
+{
+	uint64_t armPll;
+
+	clk_p->regs = *regs_p;
+	if (oscHz == 0)
+		oscHz = lpc32x0__osc_hz();
+
+	clk_p->osc = (regs_p->oscCtrl & 1)? 0 : oscHz;
+	clk_p->rtc = CLK_RTC_HZ;
+	if (regs_p->pll397Ctrl & (1 << 1))
+		clk_p->pll397 = 0;
+	else if (regs_p->pll397Ctrl & (1 << 9))
+		clk_p->pll397 = clk_p->rtc;
+	else
+		clk_p->pll397 = clk_p->rtc * PLL397_MULT;
+	clk_p->sysclk = (regs_p->sysclkCtrl & 1)? clk_p->pll397 : clk_p->osc;
+
+	clk_p->hclkPll = pll_out(regs_p->hclkpllCtrl, clk_p->sysclk, &clk_p->hclkPllCco);
+	if (regs_p->pwrCtrl & (1 << 2)) {
+		armPll = clk_p->hclkPll;
+		clk_p->armClk = armPll;
+		clk_p->hclk = divide(armPll, hclkDiv[regs_p->hclkdivCtrl & 3]);
+		clk_p->periphClk = divide(armPll, ((regs_p->hclkdivCtrl >> 2) & 0x1f) + 1);
+	}
+	else {
+		armPll = clk_p->sysclk;
+		clk_p->armClk = clk_p->sysclk;
+		clk_p->hclk = clk_p->sysclk;
+		clk_p->periphClk = clk_p->sysclk;
+	}
+	if (regs_p->pwrCtrl & (1 << 10)) {
+		clk_p->armClk = clk_p->periphClk;
+		clk_p->hclk = clk_p->periphClk;
+	}
+	switch ((regs_p->hclkdivCtrl >> 7) & 3) {
+		case 1:
+			clk_p->ddramClk = armPll;
+			break;
+		case 2:
+			clk_p->ddramClk = divide(armPll, 2);
+			break;
+		default:
+			clk_p->ddramClk = 0;
+			break;
+	}
+
+	// USB_CTRL[17] gates the USB PLL's input, USB_CTRL[18] its output
+	clk_p->usbPllIn = (regs_p->usbCtrl & (1 << 17))? divide(clk_p->sysclk, (regs_p->usbdivCtrl & 0xf) + 1) : 0;
+	clk_p->usbPll = pll_out(regs_p->usbCtrl, clk_p->usbPllIn, &clk_p->usbPllCco);
+	clk_p->usbClk = (regs_p->usbCtrl & (1 << 18))? clk_p->usbPll : 0;
+}
+
+static bool
+get_regs (Lpc32x0Ctx_t *ctx_p, ClockRegs_t *regs_p)
+{
+	return lpc32x0__ctx_get_reg(ctx_p, PWR_CTRL, &regs_p->pwrCtrl)
+		&& lpc32x0__ctx_get_reg(ctx_p, OSC_CTRL, &regs_p->oscCtrl)
+		&& lpc32x0__ctx_get_reg(ctx_p, SYSCLK_CTRL, &regs_p->sysclkCtrl)
+		&& lpc32x0__ctx_get_reg(ctx_p, PLL397_CTRL, &regs_p->pll397Ctrl)
+		&& lpc32x0__ctx_get_reg(ctx_p, HCLKPLL_CTRL, &regs_p->hclkpllCtrl)
+		&& lpc32x0__ctx_get_reg(ctx_p, HCLKDIV_CTRL, &regs_p->hclkdivCtrl)
+		&& lpc32x0__ctx_get_reg(ctx_p, USB_CTRL, &regs_p->usbCtrl)
+		&& lpc32x0__ctx_get_reg(ctx_p, USBDIV_CTRL, &regs_p->usbdivCtrl);
+}
+
+/*
+ * the clock tree from the live registers
+ * 'oscHz' is the main oscillator's frequency (0 for lpc32x0__osc_hz())
+ */
+bool
+lpc32x0__ctx_get_clocks (Lpc32x0Ctx_t *ctx_p, uint64_t oscHz, Clocks_t *clk_p)
+{
+	ClockRegs_t regs;
+
+	if ((ctx_p == NULL) || (clk_p == NULL) || !get_regs(ctx_p, &regs))
+		return false;
+	lpc32x0__eval_clocks(&regs, oscHz, clk_p);
+	return true;
+}
+
+bool
+lpc32x0__get_clocks (uint64_t oscHz, Clocks_t *clk_p)
+{
+	return lpc32x0__ctx_get_clocks(lpc32x0__default_ctx(), oscHz, clk_p);
+}
+
+// a register the image doesn't have is taken to be at its reset value
+static bool
+image_reg (const RegImage_t *image_p, uint32_t addr, bool needed, uint32_t *val_p)
+{
+	size_t cnt;
+	RegisterDescription_t **regs_pp;
+
+	if (lpc32x0__image_get(image_p, addr, val_p))
+		return true;
+	regs_pp = lpc32x0__find_reg(addr, &cnt);
+	if (needed || (regs_pp == NULL)) {
+		printf("%s has no %s\n", lpc32x0__image_name(image_p), (regs_pp != NULL)? regs_pp[0]->name_p : "?");
+		return false;
+	}
+	*val_p = regs_pp[0]->resetState;
+	return true;
+}
+
+/*
+ * the clock tree from an image (e.g. a capture); it needs the RUN mode,
+ * SYSCLK, HCLK PLL and divider registers, the others default to their
+ * reset values
+ */
+bool
+lpc32x0__image_clocks (const RegImage_t *image_p, uint64_t oscHz, Clocks_t *clk_p)
+{
+	ClockRegs_t regs;
+
+	if ((image_p == NULL) || (clk_p == NULL))
+		return false;
+	if (!image_reg(image_p, PWR_CTRL, true, &regs.pwrCtrl)
+			|| !image_reg(image_p, OSC_CTRL, false, &regs.oscCtrl)
+			|| !image_reg(image_p, SYSCLK_CTRL, true, &regs.sysclkCtrl)
+			|| !image_reg(image_p, PLL397_CTRL, false, &regs.pll397Ctrl)
+			|| !image_reg(image_p, HCLKPLL_CTRL, true, &regs.hclkpllCtrl)
+			|| !image_reg(image_p, HCLKDIV_CTRL, true, &regs.hclkdivCtrl)
+			|| !image_reg(image_p, USB_CTRL, false, &regs.usbCtrl)
+			|| !image_reg(image_p, USBDIV_CTRL, false, &regs.usbdivCtrl))
+		return false;
+	lpc32x0__eval_clocks(&regs, oscHz, clk_p);
+	return true;
+}
+
+static void
+print_hz (const char *name_p, uint64_t hz)
+{
+	if (hz == 0)
+		printf("  %-16s %18s", name_p, "stopped");
+	else
+		printf("  %-16s %7" PRIu64 ".%06" PRIu64 " MHz", name_p, hz / 1000000, hz % 1000000);
+}
+
+static void
+print_pll (const char *name_p, uint32_t ctrl, uint64_t out, uint64_t cco)
+{
+	Pll_t pll;
+
+	pll_fields(ctrl, &pll);
+	print_hz(name_p, out);
+	if (!pll.power) {
+		printf("  powered down\n");
+		return;
+	}
+	if (pll.bypass && pll.direct)
+		printf("  bypassed");
+	else if (pll.bypass)
+		printf("  bypassed, / %u", 2 * pll.p);
+	else if (pll.direct)
+		printf("  direct, M=%u N=%u", pll.m, pll.n);
+	else
+		printf("  %s, M=%u N=%u P=%u, CCO %" PRIu64 ".%06" PRIu64 " MHz",
+				pll.feedback? "integer" : "non-integer", pll.m, pll.n, pll.p,
+				cco / 1000000, cco % 1000000);
+	printf(", %s\n", pll.locked? "locked" : "not locked");
+}
+
+void
+lpc32x0__print_clocks (const Clocks_t *clk_p)
+{
+	const ClockRegs_t *regs_p = &clk_p->regs;
+	bool run = regs_p->pwrCtrl & (1 << 2);
+	bool periphRun = regs_p->pwrCtrl & (1 << 10);
+
+	printf("clocks:\n");
+	print_hz("main oscillator", clk_p->osc);
+	printf("\n");
+	print_hz("RTC", clk_p->rtc);
+	printf("\n");
+	print_hz("PLL397", clk_p->pll397);
+	printf("%s\n", (clk_p->pll397 == clk_p->rtc)? "  bypassed" : "");
+	print_hz("SYSCLK", clk_p->sysclk);
+	printf("  %s\n", (regs_p->sysclkCtrl & 1)? "PLL397" : "main oscillator");
+	print_pll("HCLK PLL", regs_p->hclkpllCtrl, clk_p->hclkPll, clk_p->hclkPllCco);
+
+	print_hz("ARM_CLK", clk_p->armClk);
+	if (periphRun)
+		printf("  PERIPH_CLK\n");
+	else
+		printf("  %s\n", run? "HCLK PLL (RUN mode)" : "SYSCLK (direct RUN mode)");
+	print_hz("HCLK", clk_p->hclk);
+	if (periphRun)
+		printf("  PERIPH_CLK\n");
+	else if (run && (hclkDiv[regs_p->hclkdivCtrl & 3] != 0))
+		printf("  HCLK PLL / %u\n", hclkDiv[regs_p->hclkdivCtrl & 3]);
+	else if (run)
+		printf("  HCLK divider not used\n");
+	else
+		printf("  SYSCLK\n");
+	print_hz("PERIPH_CLK", clk_p->periphClk);
+	if (run)
+		printf("  HCLK PLL / %u\n", ((regs_p->hclkdivCtrl >> 2) & 0x1f) + 1);
+	else
+		printf("  SYSCLK\n");
+	print_hz("DDRAM_CLK", clk_p->ddramClk);
+	if (clk_p->ddramClk != 0)
+		printf("  %s%s\n", run? "HCLK PLL" : "SYSCLK", (((regs_p->hclkdivCtrl >> 7) & 3) == 2)? " / 2" : "");
+	else
+		printf("\n");
+
+	print_hz("USB PLL input", clk_p->usbPllIn);
+	if (clk_p->usbPllIn != 0)
+		printf("  SYSCLK / %u\n", (regs_p->usbdivCtrl & 0xf) + 1);
+	else
+		printf("\n");
+	print_pll("USB PLL", regs_p->usbCtrl, clk_p->usbPll, clk_p->usbPllCco);
+	print_hz("USB clock", clk_p->usbClk);
+	printf("\n");
+}
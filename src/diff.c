@@ -0,0 +1,383 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * register images and the differences between them
+ *
+ * an image holds one value per known register, stored at the register's
+ * position in the sorted address index (see lpc32x0__reg_index()), so
+ * loading a capture is one index lookup per word and comparing any number
+ * of images is a single pass over the index
+ *
+ * for every register whose value isn't the same in all the images that
+ * have it, the distinct values are numbered and listed with the images
+ * that have them, followed by the decoded lines that differ:
+ *
+ *   0x4000401c USBDIV_CTRL     USB PLL pre-divier settings
+ *   	 1: 0x0000000b  clk.u-boot-2018.07
+ *   	 2: 0x0000000c  clk.linux-2.6.27.8
+ *   		  [3:0] USB_RATE: controls USB pre-clock divider
+ *   	 1:		0b1011.............................12
+ *   	 2:		0b1100.............................13
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "registers.h"
+
+struct reg_image {
+	char *name_p;
+	size_t slots;
+	uint32_t *vals_p;
+	bool *present_p;
+	size_t unknown;
+};
+
+RegImage_t *
+lpc32x0__image_new (const char *name_p)
+{
+	RegImage_t *image_p;
+
+	image_p = calloc(1, sizeof(*image_p));
+	if (image_p == NULL) {
+		perror("calloc()");
+		return NULL;
+	}
+	if (lpc32x0__reg_index(&image_p->slots) == NULL) {
+		free(image_p);
+		return NULL;
+	}
+	image_p->name_p = strdup(name_p);
+	image_p->vals_p = calloc(image_p->slots, sizeof(*image_p->vals_p));
+	image_p->present_p = calloc(image_p->slots, sizeof(*image_p->present_p));
+	if ((image_p->name_p == NULL) || (image_p->vals_p == NULL) || (image_p->present_p == NULL)) {
+		perror("calloc()");
+		lpc32x0__image_free(image_p);
+		return NULL;
+	}
+	return image_p;
+}
+
+void
+lpc32x0__image_free (RegImage_t *image_p)
+{
+	if (image_p == NULL)
+		return;
+	free(image_p->name_p);
+	free(image_p->vals_p);
+	free(image_p->present_p);
+	free(image_p);
+}
+
+const char *
+lpc32x0__image_name (const RegImage_t *image_p)
+{
+	return image_p->name_p;
+}
+
+/*
+ * returns false if 'addr' isn't a known register
+ */
+bool
+lpc32x0__image_set (RegImage_t *image_p, uint32_t addr, uint32_t val)
+{
+	size_t cnt, slot;
+	RegisterDescription_t **regs_pp;
+
+	regs_pp = lpc32x0__find_reg(addr, &cnt);
+	if (regs_pp == NULL) {
+		++image_p->unknown;
+		return false;
+	}
+	slot = (size_t)(regs_pp - lpc32x0__reg_index(&cnt));
+	image_p->vals_p[slot] = val;
+	image_p->present_p[slot] = true;
+	return true;
+}
+
+bool
+lpc32x0__image_get (const RegImage_t *image_p, uint32_t addr, uint32_t *val_p)
+{
+	size_t cnt, slot;
+	RegisterDescription_t **regs_pp;
+
+	regs_pp = lpc32x0__find_reg(addr, &cnt);
+	if (regs_pp == NULL)
+		return false;
+	slot = (size_t)(regs_pp - lpc32x0__reg_index(&cnt));
+	if (!image_p->present_p[slot])
+		return false;
+	*val_p = image_p->vals_p[slot];
+	return true;
+}
+
+static void
+image_word (uint32_t addr, uint32_t val, void *arg_p)
+{
+	lpc32x0__image_set(arg_p, addr, val);
+}
+
+/*
+ * load a capture (anything lpc32x0__parse_capture() understands) into the
+ * image; later words for the same register replace earlier ones
+ */
+bool
+lpc32x0__image_load (RegImage_t *image_p, int fd)
+{
+	return lpc32x0__parse_capture(fd, image_word, image_p, NULL);
+}
+
+// values are numbered, unless they're given labels
+static void
+print_group_label (size_t group, const char * const *labels_pp)
+{
+	if (labels_pp != NULL)
+		printf("\t%3s", labels_pp[group]);
+	else
+		printf("\t%2zu:", group + 1);
+}
+
+/*
+ * a decoded field's value line, as lpc32x0__print_decoded() lays it out but
+ * one tab in to make room for the group's label
+ */
+static void
+print_value_line (const DecodedReg_t *dec_p, size_t i)
+{
+	unsigned b, bits;
+	char line[36] = "0b.................................";
+	char buf[128];
+	const FieldDescription_t *field_p = dec_p->fields[i].field_p;
+
+	printf("\t\t");
+	if (!(field_p->flags & fieldNoBits)) {
+		bits = (unsigned)(field_p->high - field_p->low) + 1;
+		for (b=0; b<bits; ++b)
+			line[2 + b] = (dec_p->fields[i].value & (1u << (bits - 1 - b)))? '1' : '0';
+		fputs(line, stdout);
+	}
+	if ((field_p->flags & fieldNoHeader) && !(field_p->flags & fieldNoRange)) {
+		if (field_p->high == field_p->low)
+			printf("[%u] ", field_p->high);
+		else
+			printf("[%u:%u] ", field_p->high, field_p->low);
+	}
+	printf("%s\n", lpc32x0__field_text(&dec_p->fields[i], buf, sizeof(buf)));
+}
+
+static void
+print_heading (const FieldDescription_t *field_p)
+{
+	char bits[12];
+
+	if (field_p->flags & fieldNoRange)
+		bits[0] = 0;
+	else if (field_p->high == field_p->low)
+		snprintf(bits, sizeof(bits), "[%u]", field_p->high);
+	else
+		snprintf(bits, sizeof(bits), "[%u:%u]", field_p->high, field_p->low);
+	printf(ITEMFMT, bits, field_p->name_p);
+}
+
+// the bits a field's text depends on
+static uint32_t
+field_key (const DecodedReg_t *dec_p, size_t i)
+{
+	const FieldDescription_t *field_p = dec_p->fields[i].field_p;
+
+	if (field_p->flags & fieldQualified)
+		return dec_p->fields[i].value | (get_field(dec_p->val, field_p->qualBit, field_p->qualBit) << 31);
+	return dec_p->fields[i].value;
+}
+
+/*
+ * print the decoded fields that differ between the values in 'vals_p', each
+ * under the heading it belongs to (the field's own header, or the header of
+ * the group a header-less field is in)
+ * every value is decoded by the same table so the fields line up one to one
+ */
+static void
+diff_fields (const RegisterDescription_t *reg_p, const uint32_t *vals_p, size_t groups, const char * const *labels_pp)
+{
+	size_t g, i, heading, printedHeading;
+	DecodedReg_t *dec_p;
+
+	dec_p = malloc(groups * sizeof(*dec_p));
+	if (dec_p == NULL) {
+		perror("malloc()");
+		return;
+	}
+	for (g=0; g<groups; ++g)
+		if (!lpc32x0__decode_reg(reg_p, vals_p[g], &dec_p[g]))
+			goto done;
+
+	heading = printedHeading = dec_p[0].cnt;
+	for (i=0; i<dec_p[0].cnt; ++i) {
+		if (!(dec_p[0].fields[i].field_p->flags & fieldNoHeader))
+			heading = i;
+		if (dec_p[0].fields[i].field_p->flags & fieldHeaderOnly)
+			continue;
+		for (g=1; g<groups; ++g)
+			if (field_key(&dec_p[g], i) != field_key(&dec_p[0], i))
+				break;
+		if (g == groups)
+			continue;
+
+		if ((heading != dec_p[0].cnt) && (heading != printedHeading)) {
+			print_heading(dec_p[0].fields[heading].field_p);
+			printedHeading = heading;
+		}
+		for (g=0; g<groups; ++g) {
+			print_group_label(g, labels_pp);
+			print_value_line(&dec_p[g], i);
+		}
+	}
+
+done:
+	free(dec_p);
+}
+
+typedef struct {
+	uint32_t val;
+	size_t image;
+	size_t run;
+} SlotValue_t;
+
+static int
+slot_value_cmp (const void *a_p, const void *b_p)
+{
+	const SlotValue_t *a = a_p;
+	const SlotValue_t *b = b_p;
+
+	if (a->val != b->val)
+		return (a->val < b->val)? -1 : 1;
+	return (a->image < b->image)? -1 : (a->image > b->image);
+}
+
+// runs of equal values, in the order of the first image that has each
+static int
+slot_run_cmp (const void *a_p, const void *b_p)
+{
+	const SlotValue_t *a = a_p;
+	const SlotValue_t *b = b_p;
+
+	return (a->image < b->image)? -1 : (a->image > b->image);
+}
+
+/*
+ * print every register whose value differs between the images that have
+ * it; with 'fields' the decoded lines that differ are shown too
+ * returns the number of registers that differ
+ */
+size_t
+lpc32x0__diff_images (RegImage_t * const *images_pp, size_t cnt, bool fields)
+{
+	size_t slot, slots, i, g, groups, have, diffs = 0;
+	size_t *groupOf_p, *rank_p;
+	uint32_t *vals_p;
+	SlotValue_t *sorted_p, *runs_p;
+	RegisterDescription_t *reg_p;
+	RegisterDescription_t **index_pp;
+
+	index_pp = lpc32x0__reg_index(&slots);
+	if ((index_pp == NULL) || (cnt == 0))
+		return 0;
+
+	groupOf_p = malloc(cnt * sizeof(*groupOf_p));
+	vals_p = malloc(cnt * sizeof(*vals_p));
+	sorted_p = malloc(cnt * sizeof(*sorted_p));
+	runs_p = malloc(cnt * sizeof(*runs_p));
+	rank_p = malloc(cnt * sizeof(*rank_p));
+	if ((groupOf_p == NULL) || (vals_p == NULL) || (sorted_p == NULL) || (runs_p == NULL) || (rank_p == NULL)) {
+		perror("malloc()");
+		goto out;
+	}
+
+	for (slot=0; slot<slots; ++slot) {
+		// aliases of the same address are decoded by the first description
+		if ((slot > 0) && (index_pp[slot]->addr == index_pp[slot-1]->addr))
+			continue;
+
+		/*
+		 * sort the images' values so equal ones are adjacent, then
+		 * number the runs in the order the images are given
+		 */
+		have = 0;
+		for (i=0; i<cnt; ++i) {
+			groupOf_p[i] = cnt;
+			if (!images_pp[i]->present_p[slot])
+				continue;
+			sorted_p[have].val = images_pp[i]->vals_p[slot];
+			sorted_p[have++].image = i;
+		}
+		qsort(sorted_p, have, sizeof(*sorted_p), slot_value_cmp);
+		groups = 0;
+		for (i=0; i<have; ++i) {
+			if ((i == 0) || (sorted_p[i].val != sorted_p[i-1].val)) {
+				runs_p[groups] = sorted_p[i];
+				runs_p[groups].run = groups;
+				++groups;
+			}
+			groupOf_p[sorted_p[i].image] = groups - 1;
+		}
+		if (groups < 2)
+			continue;
+		qsort(runs_p, groups, sizeof(*runs_p), slot_run_cmp);
+		for (g=0; g<groups; ++g) {
+			vals_p[g] = runs_p[g].val;
+			rank_p[runs_p[g].run] = g;
+		}
+		for (i=0; i<cnt; ++i)
+			if (groupOf_p[i] != cnt)
+				groupOf_p[i] = rank_p[groupOf_p[i]];
+
+		++diffs;
+		reg_p = index_pp[slot];
+		printf("0x%08x %-15s %s\n", reg_p->addr, reg_p->name_p, reg_p->desc_p);
+		for (g=0; g<groups; ++g) {
+			printf("\t%2zu: 0x%08x ", g + 1, vals_p[g]);
+			for (i=0; i<cnt; ++i)
+				if (groupOf_p[i] == g)
+					printf(" %s", images_pp[i]->name_p);
+			printf("\n");
+		}
+		if (have != cnt) {
+			printf("\t  -: ---------- ");
+			for (i=0; i<cnt; ++i)
+				if (groupOf_p[i] == cnt)
+					printf(" %s", images_pp[i]->name_p);
+			printf("\n");
+		}
+		if (fields)
+			diff_fields(reg_p, vals_p, groups, NULL);
+		printf("\n");
+	}
+
+out:
+	free(groupOf_p);
+	free(vals_p);
+	free(sorted_p);
+	free(runs_p);
+	free(rank_p);
+	return diffs;
+}
+
+/*
+ * print the decoded lines that changed between 'before' and 'after', marked
+ * with '-' and '+'
+ */
+void
+lpc32x0__print_field_delta (const RegisterDescription_t *reg_p, uint32_t before, uint32_t after)
+{
+	uint32_t vals[2] = {before, after};
+	static const char * const labels[2] = {"-", "+"};
+
+	if (before != after)
+		diff_fields(reg_p, vals, 2, labels);
+}
@@ -8,308 +8,197 @@
 
 #include "registers.h"
 
-static char *p0state[] = {
-	"P0.0 / I2S1 RX_CLK",
-	"P0.1 / I2S1 RX_WS",
-	"P0.2 / I2S0 RX_SDA | LCDVD[4]",
-	"P0.3 / I2S0 RX_CLK | LCDVD[5]",
-	"P0.4 / I2S0 RS_WS | LCDVD[6]",
-	"P0.5 / I2S0 TX_SDA | LCDVD[7]",
-	"P0.6 / I2S0 TX_CLK | LCDVD[12]",
-	"P0.7 / I2S0 TX_WS | LCDVD[13]",
+static const FieldDescription_t gpio__p0state[] = {
+	{.high=7,  .low=7,  .name_p="P0.7 / I2S0 TX_WS | LCDVD[13]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=6,  .low=6,  .name_p="P0.6 / I2S0 TX_CLK | LCDVD[12]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=5,  .low=5,  .name_p="P0.5 / I2S0 TX_SDA | LCDVD[7]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=4,  .low=4,  .name_p="P0.4 / I2S0 RS_WS | LCDVD[6]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=3,  .low=3,  .name_p="P0.3 / I2S0 RX_CLK | LCDVD[5]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=2,  .low=2,  .name_p="P0.2 / I2S0 RX_SDA | LCDVD[4]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=1,  .low=1,  .name_p="P0.1 / I2S1 RX_WS", .flags=fieldNoHeader|fieldNoRange},
+	{.high=0,  .low=0,  .name_p="P0.0 / I2S1 RX_CLK", .flags=fieldNoHeader|fieldNoRange|fieldEOL},
+	{.name_p=NULL},
 };
 
-static void
-gpio__p0state (uint32_t val)
-{
-	int i;
-
-	for (i=7; i>-1; --i) {
-		print_field(val, i, i);
-		printf("%s\n", p0state[i]);
-	}
-}
-
-static void
-gpio__p0dirstate (uint32_t val)
-{
-	int i;
-	char buf[10];
-	uint32_t field;
-
-	for (i=7; i>-1; --i) {
-		sprintf(buf, "[%d]", i);
-		printf(ITEMFMT, buf, p0state[i]);
-		field = print_field(val, i, i);
-		if (field == 1)
-			printf("output\n");
-		else
-			printf("input\n");
-	}
-}
-
-static char *p1state[] = {
-	"EMC_A[0] / P1.0",
-	"EMC_A[1] / P1.1",
-	"EMC_A[2] / P1.2",
-	"EMC_A[3] / P1.3",
-	"EMC_A[4] / P1.4",
-	"EMC_A[5] / P1.5",
-	"EMC_A[6] / P1.6",
-	"EMC_A[7] / P1.7",
-	"EMC_A[8] / P1.8",
-	"EMC_A[9] / P1.9",
-	"EMC_A[10] / P1.10",
-	"EMC_A[11] / P1.11",
-	"EMC_A[12] / P1.12",
-	"EMC_A[13] / P1.13",
-	"EMC_A[14] / P1.14",
-	"EMC_A[15] / P1.15",
-	"EMC_A[16] / P1.16",
-	"EMC_A[17] / P1.17",
-	"EMC_A[18] / P1.18",
-	"EMC_A[19] / P1.19",
-	"EMC_A[20] / P1.20",
-	"EMC_A[21] / P1.21",
-	"EMC_A[22] / P1.22",
-	"EMC_A[23] / P1.23",
+static const char * const direction[] = {"input", "output"};
+
+static const FieldDescription_t gpio__p0dirstate[] = {
+	{.high=7,  .low=7,  .name_p="P0.7 / I2S0 TX_WS | LCDVD[13]", FIELDTEXT(direction)},
+	{.high=6,  .low=6,  .name_p="P0.6 / I2S0 TX_CLK | LCDVD[12]", FIELDTEXT(direction)},
+	{.high=5,  .low=5,  .name_p="P0.5 / I2S0 TX_SDA | LCDVD[7]", FIELDTEXT(direction)},
+	{.high=4,  .low=4,  .name_p="P0.4 / I2S0 RS_WS | LCDVD[6]", FIELDTEXT(direction)},
+	{.high=3,  .low=3,  .name_p="P0.3 / I2S0 RX_CLK | LCDVD[5]", FIELDTEXT(direction)},
+	{.high=2,  .low=2,  .name_p="P0.2 / I2S0 RX_SDA | LCDVD[4]", FIELDTEXT(direction)},
+	{.high=1,  .low=1,  .name_p="P0.1 / I2S1 RX_WS", FIELDTEXT(direction)},
+	{.high=0,  .low=0,  .name_p="P0.0 / I2S1 RX_CLK", FIELDTEXT(direction), .flags=fieldEOL},
+	{.name_p=NULL},
 };
-static void
-gpio__p1state (uint32_t val)
-{
-	int i;
-
-	for (i=23; i>-1; --i) {
-		print_field(val, i, i);
-		printf("EMC_A[%d] / P1.%d\n", i, i);
-	}
-}
-
-static void
-gpio__p1dirstate (uint32_t val)
-{
-	int i;
-	char buf[10];
-	uint32_t field;
-
-	for (i=23; i>-1; --i) {
-		sprintf(buf, "[%d]", i);
-		printf(ITEMFMT, buf, p1state[i]);
-		field = print_field(val, i, i);
-		if (field == 1)
-			printf("output\n");
-		else
-			printf("input\n");
-	}
-}
 
-static char *p23state[] = {
-	"EMC_D[19] / P2.0",
-	"EMC_D[20] / P2.1",
-	"EMC_D[21] / P2.2",
-	"EMC_D[22] / P2.3",
-	"EMC_D[23] / P2.4",
-	"EMC_D[24] / P2.5",
-	"EMC_D[25] / P2.6",
-	"EMC_D[26] / P2.7",
-	"EMC_D[27] / P2.8",
-	"EMC_D[28] / P2.9",
-	"EMC_D[29] / P2.10",
-	"EMC_D[30] / P2.11",
-	"EMC_D[31] / P2.12",
-	"(reserved)",
-	"(reserved)",
-	"(reserved)",
-	"(reserved)",
-	"(reserved)",
-	"(reserved)",
-	"(reserved)",
-	"(reserved)",
-	"(reserved)",
-	"(reserved)",
-	"(reserved)",
-	"(reserved)",
-	"GPIO_0",
-	"GPIO_1",
-	"GPIO_2",
-	"GPIO_3",
-	"GPIO_4",
-	"GPIO_5",
+static const FieldDescription_t gpio__p1state[] = {
+	{.high=23, .low=23, .name_p="EMC_A[23] / P1.23", .flags=fieldNoHeader|fieldNoRange},
+	{.high=22, .low=22, .name_p="EMC_A[22] / P1.22", .flags=fieldNoHeader|fieldNoRange},
+	{.high=21, .low=21, .name_p="EMC_A[21] / P1.21", .flags=fieldNoHeader|fieldNoRange},
+	{.high=20, .low=20, .name_p="EMC_A[20] / P1.20", .flags=fieldNoHeader|fieldNoRange},
+	{.high=19, .low=19, .name_p="EMC_A[19] / P1.19", .flags=fieldNoHeader|fieldNoRange},
+	{.high=18, .low=18, .name_p="EMC_A[18] / P1.18", .flags=fieldNoHeader|fieldNoRange},
+	{.high=17, .low=17, .name_p="EMC_A[17] / P1.17", .flags=fieldNoHeader|fieldNoRange},
+	{.high=16, .low=16, .name_p="EMC_A[16] / P1.16", .flags=fieldNoHeader|fieldNoRange},
+	{.high=15, .low=15, .name_p="EMC_A[15] / P1.15", .flags=fieldNoHeader|fieldNoRange},
+	{.high=14, .low=14, .name_p="EMC_A[14] / P1.14", .flags=fieldNoHeader|fieldNoRange},
+	{.high=13, .low=13, .name_p="EMC_A[13] / P1.13", .flags=fieldNoHeader|fieldNoRange},
+	{.high=12, .low=12, .name_p="EMC_A[12] / P1.12", .flags=fieldNoHeader|fieldNoRange},
+	{.high=11, .low=11, .name_p="EMC_A[11] / P1.11", .flags=fieldNoHeader|fieldNoRange},
+	{.high=10, .low=10, .name_p="EMC_A[10] / P1.10", .flags=fieldNoHeader|fieldNoRange},
+	{.high=9,  .low=9,  .name_p="EMC_A[9] / P1.9", .flags=fieldNoHeader|fieldNoRange},
+	{.high=8,  .low=8,  .name_p="EMC_A[8] / P1.8", .flags=fieldNoHeader|fieldNoRange},
+	{.high=7,  .low=7,  .name_p="EMC_A[7] / P1.7", .flags=fieldNoHeader|fieldNoRange},
+	{.high=6,  .low=6,  .name_p="EMC_A[6] / P1.6", .flags=fieldNoHeader|fieldNoRange},
+	{.high=5,  .low=5,  .name_p="EMC_A[5] / P1.5", .flags=fieldNoHeader|fieldNoRange},
+	{.high=4,  .low=4,  .name_p="EMC_A[4] / P1.4", .flags=fieldNoHeader|fieldNoRange},
+	{.high=3,  .low=3,  .name_p="EMC_A[3] / P1.3", .flags=fieldNoHeader|fieldNoRange},
+	{.high=2,  .low=2,  .name_p="EMC_A[2] / P1.2", .flags=fieldNoHeader|fieldNoRange},
+	{.high=1,  .low=1,  .name_p="EMC_A[1] / P1.1", .flags=fieldNoHeader|fieldNoRange},
+	{.high=0,  .low=0,  .name_p="EMC_A[0] / P1.0", .flags=fieldNoHeader|fieldNoRange|fieldEOL},
+	{.name_p=NULL},
 };
 
-static void
-gpio__p2state (uint32_t val)
-{
-	int i;
-
-	for (i=12; i>-1; --i) {
-		print_field(val, i, i);
-		printf("%s\n", p23state[i]);
-	}
-}
-
-static void
-gpio__p23dirstate (uint32_t val)
-{
-	int i;
-	char buf[10];
-	uint32_t field;
+static const FieldDescription_t gpio__p1dirstate[] = {
+	{.high=23, .low=23, .name_p="EMC_A[23] / P1.23", FIELDTEXT(direction)},
+	{.high=22, .low=22, .name_p="EMC_A[22] / P1.22", FIELDTEXT(direction)},
+	{.high=21, .low=21, .name_p="EMC_A[21] / P1.21", FIELDTEXT(direction)},
+	{.high=20, .low=20, .name_p="EMC_A[20] / P1.20", FIELDTEXT(direction)},
+	{.high=19, .low=19, .name_p="EMC_A[19] / P1.19", FIELDTEXT(direction)},
+	{.high=18, .low=18, .name_p="EMC_A[18] / P1.18", FIELDTEXT(direction)},
+	{.high=17, .low=17, .name_p="EMC_A[17] / P1.17", FIELDTEXT(direction)},
+	{.high=16, .low=16, .name_p="EMC_A[16] / P1.16", FIELDTEXT(direction)},
+	{.high=15, .low=15, .name_p="EMC_A[15] / P1.15", FIELDTEXT(direction)},
+	{.high=14, .low=14, .name_p="EMC_A[14] / P1.14", FIELDTEXT(direction)},
+	{.high=13, .low=13, .name_p="EMC_A[13] / P1.13", FIELDTEXT(direction)},
+	{.high=12, .low=12, .name_p="EMC_A[12] / P1.12", FIELDTEXT(direction)},
+	{.high=11, .low=11, .name_p="EMC_A[11] / P1.11", FIELDTEXT(direction)},
+	{.high=10, .low=10, .name_p="EMC_A[10] / P1.10", FIELDTEXT(direction)},
+	{.high=9,  .low=9,  .name_p="EMC_A[9] / P1.9", FIELDTEXT(direction)},
+	{.high=8,  .low=8,  .name_p="EMC_A[8] / P1.8", FIELDTEXT(direction)},
+	{.high=7,  .low=7,  .name_p="EMC_A[7] / P1.7", FIELDTEXT(direction)},
+	{.high=6,  .low=6,  .name_p="EMC_A[6] / P1.6", FIELDTEXT(direction)},
+	{.high=5,  .low=5,  .name_p="EMC_A[5] / P1.5", FIELDTEXT(direction)},
+	{.high=4,  .low=4,  .name_p="EMC_A[4] / P1.4", FIELDTEXT(direction)},
+	{.high=3,  .low=3,  .name_p="EMC_A[3] / P1.3", FIELDTEXT(direction)},
+	{.high=2,  .low=2,  .name_p="EMC_A[2] / P1.2", FIELDTEXT(direction)},
+	{.high=1,  .low=1,  .name_p="EMC_A[1] / P1.1", FIELDTEXT(direction)},
+	{.high=0,  .low=0,  .name_p="EMC_A[0] / P1.0", FIELDTEXT(direction), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	for (i=30; i>24; --i) {
-		sprintf(buf, "[%d]", i);
-		printf(ITEMFMT, buf, p23state[i]);
-		field = print_field(val, i, i);
-		if (field == 1)
-			printf("output\n");
-		else
-			printf("input\n");
-	}
-	for (i=12; i>-1; --i) {
-		sprintf(buf, "[%d]", i);
-		printf(ITEMFMT, buf, p23state[i]);
-		field = print_field(val, i, i);
-		if (field == 1)
-			printf("output\n");
-		else
-			printf("input\n");
-	}
+static const FieldDescription_t gpio__p2state[] = {
+	{.high=12, .low=12, .name_p="EMC_D[31] / P2.12", .flags=fieldNoHeader|fieldNoRange},
+	{.high=11, .low=11, .name_p="EMC_D[30] / P2.11", .flags=fieldNoHeader|fieldNoRange},
+	{.high=10, .low=10, .name_p="EMC_D[29] / P2.10", .flags=fieldNoHeader|fieldNoRange},
+	{.high=9,  .low=9,  .name_p="EMC_D[28] / P2.9", .flags=fieldNoHeader|fieldNoRange},
+	{.high=8,  .low=8,  .name_p="EMC_D[27] / P2.8", .flags=fieldNoHeader|fieldNoRange},
+	{.high=7,  .low=7,  .name_p="EMC_D[26] / P2.7", .flags=fieldNoHeader|fieldNoRange},
+	{.high=6,  .low=6,  .name_p="EMC_D[25] / P2.6", .flags=fieldNoHeader|fieldNoRange},
+	{.high=5,  .low=5,  .name_p="EMC_D[24] / P2.5", .flags=fieldNoHeader|fieldNoRange},
+	{.high=4,  .low=4,  .name_p="EMC_D[23] / P2.4", .flags=fieldNoHeader|fieldNoRange},
+	{.high=3,  .low=3,  .name_p="EMC_D[22] / P2.3", .flags=fieldNoHeader|fieldNoRange},
+	{.high=2,  .low=2,  .name_p="EMC_D[21] / P2.2", .flags=fieldNoHeader|fieldNoRange},
+	{.high=1,  .low=1,  .name_p="EMC_D[20] / P2.1", .flags=fieldNoHeader|fieldNoRange},
+	{.high=0,  .low=0,  .name_p="EMC_D[19] / P2.0", .flags=fieldNoHeader|fieldNoRange|fieldEOL},
+	{.name_p=NULL},
+};
 
-}
+static const FieldDescription_t gpio__p23dirstate[] = {
+	{.high=30, .low=30, .name_p="GPIO_5", FIELDTEXT(direction)},
+	{.high=29, .low=29, .name_p="GPIO_4", FIELDTEXT(direction)},
+	{.high=28, .low=28, .name_p="GPIO_3", FIELDTEXT(direction)},
+	{.high=27, .low=27, .name_p="GPIO_2", FIELDTEXT(direction)},
+	{.high=26, .low=26, .name_p="GPIO_1", FIELDTEXT(direction)},
+	{.high=25, .low=25, .name_p="GPIO_0", FIELDTEXT(direction)},
+	{.high=12, .low=12, .name_p="EMC_D[31] / P2.12", FIELDTEXT(direction)},
+	{.high=11, .low=11, .name_p="EMC_D[30] / P2.11", FIELDTEXT(direction)},
+	{.high=10, .low=10, .name_p="EMC_D[29] / P2.10", FIELDTEXT(direction)},
+	{.high=9,  .low=9,  .name_p="EMC_D[28] / P2.9", FIELDTEXT(direction)},
+	{.high=8,  .low=8,  .name_p="EMC_D[27] / P2.8", FIELDTEXT(direction)},
+	{.high=7,  .low=7,  .name_p="EMC_D[26] / P2.7", FIELDTEXT(direction)},
+	{.high=6,  .low=6,  .name_p="EMC_D[25] / P2.6", FIELDTEXT(direction)},
+	{.high=5,  .low=5,  .name_p="EMC_D[24] / P2.5", FIELDTEXT(direction)},
+	{.high=4,  .low=4,  .name_p="EMC_D[23] / P2.4", FIELDTEXT(direction)},
+	{.high=3,  .low=3,  .name_p="EMC_D[22] / P2.3", FIELDTEXT(direction)},
+	{.high=2,  .low=2,  .name_p="EMC_D[21] / P2.2", FIELDTEXT(direction)},
+	{.high=1,  .low=1,  .name_p="EMC_D[20] / P2.1", FIELDTEXT(direction)},
+	{.high=0,  .low=0,  .name_p="EMC_D[19] / P2.0", FIELDTEXT(direction), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-gpio__p3instate (uint32_t val)
-{
-	print_field(val, 31, 29);
-	printf("(reserved)\n");
-	print_field(val, 28, 28);
-	printf("GPI_28 / U3_RI\n");
-	print_field(val, 27, 27);
-	printf("GPI_27 / SPI2_DATIN / MISO1 | LCDVD[21]\n");
-	print_field(val, 26, 26);
-	printf("(reserved)");
-	print_field(val, 25, 25);
-	printf("GPI_25 / SPI1_DATIN / MISO0 / MCFB2\n");
-	print_field(val, 24, 24);
-	printf("GPIO_5 / SSEL0 / MCFB0\n");
-	print_field(val, 23, 23);
-	printf("GPI_23 / U7_RX / CAP0.0 | LCDVD[10]\n");
-	print_field(val, 22, 22);
-	printf("GPI_22 / U7_HCTS / CAP0.1 | LCDCLKIN\n");
-	print_field(val, 21, 21);
-	printf("GPI_21 / U6_IRRX\n");
-	print_field(val, 20, 20);
-	printf("GPI_20 / U5_RX\n");
-	print_field(val, 19, 19);
-	printf("GPI_19 / U4_RX\n");
-	print_field(val, 18, 18);
-	printf("GPI_18 / U3_RX\n");
-	print_field(val, 17, 17);
-	printf("GPI_17 / U2_RX | U3_DSR\n");
-	print_field(val, 16, 16);
-	printf("GPI_16 / U2_HCTS | U3_CTS\n");
-	print_field(val, 15, 15);
-	printf("GPI_15 / U1_RX | CAP1.0\n");
-	print_field(val, 14, 14);
-	printf("GPI_4 / SSEL1 | LCDVD[22]\n");
-	print_field(val, 13, 13);
-	printf("GPI_3 / KEY_ROW7 | ENET_MDIO\n");
-	print_field(val, 12, 12);
-	printf("GPI2 / KEY_ROW6 | ENET_MDC\n");
-	print_field(val, 11, 11);
-	printf("GPIO_1\n");
-	print_field(val, 10, 10);
-	printf("GPIO_0\n");
-	print_field(val, 9, 9);
-	printf("GPI_9 / KEY_COL7 | ENET_COL\n");
-	print_field(val, 8, 8);
-	printf("GPI_8 / KEY_COL6 / SPI2_BUSY | ENET_RX_DV\n");
-	print_field(val, 7, 7);
-	printf("GPI_7\n");
-	print_field(val, 6, 6);
-	printf("GPI_6 / HSTIM_CAP | ENET_RXD2\n");
-	print_field(val, 5, 5);
-	printf("GPI_5 / U3_DCD\n");
-	print_field(val, 4, 4);
-	printf("GPI_4 / SPI1_BUSY\n");
-	print_field(val, 3, 3);
-	printf("GPI_3\n");
-	print_field(val, 2, 2);
-	printf("GPI_2 / CAP2.0 | ENET_RXD3\n");
-	print_field(val, 1, 1);
-	printf("GPI_1 / SERVICE_N\n");
-	print_field(val, 0, 0);
-	printf("GPI_0 / I2S1RX_SDA\n");
-}
+static const FieldDescription_t gpio__p3instate[] = {
+	{.high=31, .low=29, .name_p="(reserved)", .flags=fieldNoHeader|fieldNoRange},
+	{.high=28, .low=28, .name_p="GPI_28 / U3_RI", .flags=fieldNoHeader|fieldNoRange},
+	{.high=27, .low=27, .name_p="GPI_27 / SPI2_DATIN / MISO1 | LCDVD[21]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=26, .low=26, .name_p="(reserved)", .flags=fieldNoHeader|fieldNoRange},
+	{.high=25, .low=25, .name_p="GPI_25 / SPI1_DATIN / MISO0 / MCFB2", .flags=fieldNoHeader|fieldNoRange},
+	{.high=24, .low=24, .name_p="GPIO_5 / SSEL0 / MCFB0", .flags=fieldNoHeader|fieldNoRange},
+	{.high=23, .low=23, .name_p="GPI_23 / U7_RX / CAP0.0 | LCDVD[10]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=22, .low=22, .name_p="GPI_22 / U7_HCTS / CAP0.1 | LCDCLKIN", .flags=fieldNoHeader|fieldNoRange},
+	{.high=21, .low=21, .name_p="GPI_21 / U6_IRRX", .flags=fieldNoHeader|fieldNoRange},
+	{.high=20, .low=20, .name_p="GPI_20 / U5_RX", .flags=fieldNoHeader|fieldNoRange},
+	{.high=19, .low=19, .name_p="GPI_19 / U4_RX", .flags=fieldNoHeader|fieldNoRange},
+	{.high=18, .low=18, .name_p="GPI_18 / U3_RX", .flags=fieldNoHeader|fieldNoRange},
+	{.high=17, .low=17, .name_p="GPI_17 / U2_RX | U3_DSR", .flags=fieldNoHeader|fieldNoRange},
+	{.high=16, .low=16, .name_p="GPI_16 / U2_HCTS | U3_CTS", .flags=fieldNoHeader|fieldNoRange},
+	{.high=15, .low=15, .name_p="GPI_15 / U1_RX | CAP1.0", .flags=fieldNoHeader|fieldNoRange},
+	{.high=14, .low=14, .name_p="GPI_4 / SSEL1 | LCDVD[22]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=13, .low=13, .name_p="GPI_3 / KEY_ROW7 | ENET_MDIO", .flags=fieldNoHeader|fieldNoRange},
+	{.high=12, .low=12, .name_p="GPI2 / KEY_ROW6 | ENET_MDC", .flags=fieldNoHeader|fieldNoRange},
+	{.high=11, .low=11, .name_p="GPIO_1", .flags=fieldNoHeader|fieldNoRange},
+	{.high=10, .low=10, .name_p="GPIO_0", .flags=fieldNoHeader|fieldNoRange},
+	{.high=9,  .low=9,  .name_p="GPI_9 / KEY_COL7 | ENET_COL", .flags=fieldNoHeader|fieldNoRange},
+	{.high=8,  .low=8,  .name_p="GPI_8 / KEY_COL6 / SPI2_BUSY | ENET_RX_DV", .flags=fieldNoHeader|fieldNoRange},
+	{.high=7,  .low=7,  .name_p="GPI_7", .flags=fieldNoHeader|fieldNoRange},
+	{.high=6,  .low=6,  .name_p="GPI_6 / HSTIM_CAP | ENET_RXD2", .flags=fieldNoHeader|fieldNoRange},
+	{.high=5,  .low=5,  .name_p="GPI_5 / U3_DCD", .flags=fieldNoHeader|fieldNoRange},
+	{.high=4,  .low=4,  .name_p="GPI_4 / SPI1_BUSY", .flags=fieldNoHeader|fieldNoRange},
+	{.high=3,  .low=3,  .name_p="GPI_3", .flags=fieldNoHeader|fieldNoRange},
+	{.high=2,  .low=2,  .name_p="GPI_2 / CAP2.0 | ENET_RXD3", .flags=fieldNoHeader|fieldNoRange},
+	{.high=1,  .low=1,  .name_p="GPI_1 / SERVICE_N", .flags=fieldNoHeader|fieldNoRange},
+	{.high=0,  .low=0,  .name_p="GPI_0 / I2S1RX_SDA", .flags=fieldNoHeader|fieldNoRange|fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-gpio__p3outstate (uint32_t val)
-{
-	print_field(val, 31, 31);
-	printf("(reserved)\n");
-	print_field(val, 30, 30);
-	printf("GPIO_5 / SSEL0 / MCFB0\n");
-	print_field(val, 29, 29);
-	printf("GPIO_4 / SSEL1 | LCDVD[22]\n");
-	print_field(val, 28, 28);
-	printf("GPIO_3 / KEY_ROW7 | ENET_MDIO\n");
-	print_field(val, 27, 27);
-	printf("GPIO_2 / KEY_ROW6 | ENET_MDC\n");
-	print_field(val, 26, 26);
-	printf("GPIO_1\n");
-	print_field(val, 25, 25);
-	printf("GPIO_0\n");
-	print_field(val, 24, 24);
-	printf("(reserved)\n");
-	print_field(val, 23, 23);
-	printf("GPO_23 / U2_HRTS | U3_RTS\n");
-	print_field(val, 22, 22);
-	printf("GPO_22 / U7_HRTS / LCDVD[22]\n");
-	print_field(val, 21, 21);
-	printf("GPO_21 / U4_TX | LCDVD[3]\n");
-	print_field(val, 20, 20);
-	printf("GPO_20\n");
-	print_field(val, 19, 19);
-	printf("GPO_19\n");
-	print_field(val, 18, 18);
-	printf("GPO_18 / MC0A | LCDLP\n");
-	print_field(val, 17, 17);
-	printf("GPO_17\n");
-	print_field(val, 16, 16);
-	printf("GPO_16 / MC0B | LCDLP\n");
-	print_field(val, 15, 15);
-	printf("GPO_15 / MC1A | LCDFP\n");
-	print_field(val, 14, 14);
-	printf("GPO_14\n");
-	print_field(val, 13, 13);
-	printf("GPO_13 / MC1B | LCDDCLK\n");
-	print_field(val, 12, 12);
-	printf("GPO_12 / KC2A | LCDLE\n");
-	print_field(val, 11, 11);
-	printf("GPO_11\n");
-	print_field(val, 10, 10);
-	printf("GPO_10 / MC2B | LCDPWR\n");
-	print_field(val, 9, 9);
-	printf("GPO_9 | LCDVD[9]\n");
-	print_field(val, 8, 8);
-	printf("GPO_8 | LCDVD[8]\n");
-	print_field(val, 7, 7);
-	printf("GPO_7 | LCDVD[2]\n");
-	print_field(val, 6, 6);
-	printf("GPO_6 | LCDVD[18]\n");
-	print_field(val, 5, 5);
-	printf("GPO_5\n");
-	print_field(val, 4, 4);
-	printf("GPO_4\n");
-	print_field(val, 3, 3);
-	printf("GPO_3 | LCDVD[1]\n");
-	print_field(val, 2, 2);
-	printf("GPO_2 / T1_MAT.0 | LCDVD[0]\n");
-	print_field(val, 1, 1);
-	printf("GPO_1\n");
-	print_field(val, 0, 0);
-	printf("GPO_0 | TST_CLK1\n");
-	
-}
+static const FieldDescription_t gpio__p3outstate[] = {
+	{.high=31, .low=31, .name_p="(reserved)", .flags=fieldNoHeader|fieldNoRange},
+	{.high=30, .low=30, .name_p="GPIO_5 / SSEL0 / MCFB0", .flags=fieldNoHeader|fieldNoRange},
+	{.high=29, .low=29, .name_p="GPIO_4 / SSEL1 | LCDVD[22]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=28, .low=28, .name_p="GPIO_3 / KEY_ROW7 | ENET_MDIO", .flags=fieldNoHeader|fieldNoRange},
+	{.high=27, .low=27, .name_p="GPIO_2 / KEY_ROW6 | ENET_MDC", .flags=fieldNoHeader|fieldNoRange},
+	{.high=26, .low=26, .name_p="GPIO_1", .flags=fieldNoHeader|fieldNoRange},
+	{.high=25, .low=25, .name_p="GPIO_0", .flags=fieldNoHeader|fieldNoRange},
+	{.high=24, .low=24, .name_p="(reserved)", .flags=fieldNoHeader|fieldNoRange},
+	{.high=23, .low=23, .name_p="GPO_23 / U2_HRTS | U3_RTS", .flags=fieldNoHeader|fieldNoRange},
+	{.high=22, .low=22, .name_p="GPO_22 / U7_HRTS / LCDVD[22]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=21, .low=21, .name_p="GPO_21 / U4_TX | LCDVD[3]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=20, .low=20, .name_p="GPO_20", .flags=fieldNoHeader|fieldNoRange},
+	{.high=19, .low=19, .name_p="GPO_19", .flags=fieldNoHeader|fieldNoRange},
+	{.high=18, .low=18, .name_p="GPO_18 / MC0A | LCDLP", .flags=fieldNoHeader|fieldNoRange},
+	{.high=17, .low=17, .name_p="GPO_17", .flags=fieldNoHeader|fieldNoRange},
+	{.high=16, .low=16, .name_p="GPO_16 / MC0B | LCDLP", .flags=fieldNoHeader|fieldNoRange},
+	{.high=15, .low=15, .name_p="GPO_15 / MC1A | LCDFP", .flags=fieldNoHeader|fieldNoRange},
+	{.high=14, .low=14, .name_p="GPO_14", .flags=fieldNoHeader|fieldNoRange},
+	{.high=13, .low=13, .name_p="GPO_13 / MC1B | LCDDCLK", .flags=fieldNoHeader|fieldNoRange},
+	{.high=12, .low=12, .name_p="GPO_12 / KC2A | LCDLE", .flags=fieldNoHeader|fieldNoRange},
+	{.high=11, .low=11, .name_p="GPO_11", .flags=fieldNoHeader|fieldNoRange},
+	{.high=10, .low=10, .name_p="GPO_10 / MC2B | LCDPWR", .flags=fieldNoHeader|fieldNoRange},
+	{.high=9,  .low=9,  .name_p="GPO_9 | LCDVD[9]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=8,  .low=8,  .name_p="GPO_8 | LCDVD[8]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=7,  .low=7,  .name_p="GPO_7 | LCDVD[2]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=6,  .low=6,  .name_p="GPO_6 | LCDVD[18]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=5,  .low=5,  .name_p="GPO_5", .flags=fieldNoHeader|fieldNoRange},
+	{.high=4,  .low=4,  .name_p="GPO_4", .flags=fieldNoHeader|fieldNoRange},
+	{.high=3,  .low=3,  .name_p="GPO_3 | LCDVD[1]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=2,  .low=2,  .name_p="GPO_2 / T1_MAT.0 | LCDVD[0]", .flags=fieldNoHeader|fieldNoRange},
+	{.high=1,  .low=1,  .name_p="GPO_1", .flags=fieldNoHeader|fieldNoRange},
+	{.high=0,  .low=0,  .name_p="GPO_0 | TST_CLK1", .flags=fieldNoHeader|fieldNoRange|fieldEOL},
+	{.name_p=NULL},
+};
 
 RegisterDescription_t gpio[] = {
 	/* port 0 */
@@ -332,9 +221,9 @@ RegisterDescription_t gpio[] = {
 	{0x4002801c, 0, "P2_INP_STATE", "Port 2 input pin state", accessRead, gpio__p2state},
 	{0x40028020, 0, "P2_OUTP_SET", "Port 2 output pin set", accessWrite, NULL},
 	{0x40028024, 0, "P2_OUTP_CLR", "Port 2 ouptut pin clear", accessWrite, NULL},
-	{0x40028010, 0, "P2_DIR_SET", "Port 2/3 direction set", accessWrite, gpio__p23dirstate},
+	{0x40028010, 0, "P2_DIR_SET", "Port 2/3 direction set", accessWrite, NULL},
 	{0x40028014, 0, "P2_DIR_CLR", "Port 2/3 direction clear", accessWrite, NULL},
-	{0x40028018, 0, "P2_DIR_STATE", "Port 2/3 direction state", accessRead, NULL},
+	{0x40028018, 0, "P2_DIR_STATE", "Port 2/3 direction state", accessRead, gpio__p23dirstate},
 	/* port 3 */
 	{0x40028000, 0, "P3_INP_STATE", "Port 3 input pin state", accessRead, gpio__p3instate},
 	{0x40028004, 0, "P3_OUTP_SET", "Port 3 output pin set", accessWrite, NULL},
@@ -9,350 +9,174 @@
 
 #include "registers.h"
 
-static void
-lcd__lcdtimh (uint32_t val)
-{
-	printf(ITEMFMT, "[31:24]", "HBP - horizontal back porch");
-	printf("\t\t\t0x%x\n", get_field(val, 31, 24));
-
-	printf(ITEMFMT, "[23:16]", "HFP - horizontal front porch");
-	printf("\t\t\t0x%x\n", get_field(val, 23, 16));
-
-	printf(ITEMFMT, "[15:8]", "HSW - horizontal synchronization pulse width");
-	printf("\t\t\t0x%x\n", get_field(val, 15, 8));
-
-	printf(ITEMFMT, "[7:2]", "PPL - pixels per line");
-	printf("\t\t\t0x%x\n", get_field(val, 7, 2));
-}
-
-static void
-lcd__lcdtimv (uint32_t val)
-{
-	printf(ITEMFMT, "[31:24]", "VBP - vertial back porch");
-	printf("\t\t\t0x%x\n", get_field(val, 31, 24));
-
-	printf(ITEMFMT, "[23:16]", "VFP - vertical front porch");
-	printf("\t\t\t0x%x\n", get_field(val, 23, 16));
-
-	printf(ITEMFMT, "[15:10]", "VSW - vertical synchronization pulse width");
-	printf("\t\t\t0x%x\n", get_field(val, 15, 0));
-
-	printf(ITEMFMT, "[9:0]", "LLP - lines per panel");
-	printf("\t\t\t0x%x\n", get_field(val, 9, 0));
-}
-
-static void
-lcd__lcdpol (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[31:27]", "PCD_HI - panel clock divider, upper five bits");
-	printf("\t\t\t0x%x\n", get_field(val, 31, 27));
-
-	printf(ITEMFMT, "[26]", "BCD - bypass pixel clock divider");
-	field = print_field(val, 26, 26);
-	printf("%sbypass pixel clock divider logic\n", field == 0? "don't " : "");
-
-	printf(ITEMFMT, "[25:16]", "CPL - clocks per line");
-	printf("\t\t\t0x%x\n", get_field(val, 25, 16));
-
-	printf(ITEMFMT, "[14]", "IOE - invert output enable");
-	field = print_field(val, 14, 14);
-	printf("LCDENAB output pin is active %s in TFT mode\n", field == 0? "HIGH" : "LOW");
-
-	printf(ITEMFMT, "[13]", "IPC - invert panel clock");
-	field = print_field(val, 13, 13);
-	printf("data is driven on the LCD data lines on the %s edge of LCDDCLK\n", field == 0? "rising" : "falling");
-
-	printf(ITEMFMT, "[12]", "IHS - invert horizontal synchronization");
-	field = print_field(val, 12, 12);
-	printf("LCDLP pin is active %s and inactive %s\n",
-			field == 0? "HIGH" : "LOW",
-			field == 0? "LOW" : "HIGH");
-
-	printf(ITEMFMT, "[11]", "IVS - invert vertical synchronization");
-	field = print_field(val, 11, 11);
-	printf("LCDFP pin is active %s and inactive %s\n",
-			field == 0? "HIGH" : "LOW",
-			field == 0? "LOW" : "HIGH");
-
-	printf(ITEMFMT, "[10:6]", "ACB - AC bian pin frequency");
-	printf("\t\t\t0x%x\n", get_field(val, 10, 6));
-
-	printf(ITEMFMT, "[5]", "CLKSEL");
-	field = print_field(val, 5, 5);
-	printf("the clock source for the LCD block is %s\n", field == 0? "HCLK" : "LCDCLKIN");
-
-	printf(ITEMFMT, "[4:0]", "PCD_LO - panel clock divider, lower five bits");
-	printf("\t\t\t0x%x\n", get_field(val, 4, 0));
-}
-
-static void
-lcd__lcdle (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[16]", "LEE - LCD line end enable");
-	field = print_field(val, 16, 16);
-	if (field == 0)
-		printf("LCDLE disabled (held LOW)");
-	else
-		printf("LCDLE signal active");
-	printf("\n");
-
-	printf(ITEMFMT, "[6:0]", "LED - line end delay");
-	printf("\t\t\t0x%x\n", get_field(val, 6, 0));
-}
-
-static void
-lcd__lcdupbase (uint32_t val)
-{
-	printf(ITEMFMT, "[31:3]", "LCDUPBASE - LCD upper panel base address");
-	printf("\t\t\t0x%08x\n", get_field(val, 31, 3));
-}
-
-static void
-lcd__lcdlpbase (uint32_t val)
-{
-	printf(ITEMFMT, "[31:3]", "LCDLPBASE - LCD lower panel base address");
-	printf("\t\t\t0x%08x\n", get_field(val, 31, 3));
-}
-
-static void
-lcd__lcdctrl (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[16]", "WATERMARK - LCD DMA FIFO watermark level");
-	field = print_field(val, 16, 16);
-	printf("LCD DMA request generated with %u or more empty locations\n", field == 0? 4 : 8);
-
-	printf(ITEMFMT, "[13:12]", "LcdVComp - LCD vertical compare interrupt, generate VComp interrupt at...");
-	field = print_field(val, 13, 12);
-	switch (field) {
-		case 0:
-			printf("start of vertical synchronization");
-			break;
-		case 1:
-			printf("start of back porch");
-			break;
-		case 2:
-			printf("start of active video");
-			break;
-		case 3:
-			printf("start of front porch");
-			break;
-		default:
-			printf("?");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[11]", "LcdPwr - LCD power enable");
-	field = print_field(val, 11, 11);
-	if (field == 0)
-		printf("power not gated through LCD, LCDV[23:0] disabled");
-	else
-		printf("power gated through LCD, LCDV[23:0] enabled");
-	printf("\n");
-
-	printf(ITEMFMT, "[10]", "BEPO - big-endian pixel ordering within a byte");
-	field = print_field(val, 10, 10);
-	if (field == 0)
-		printf("little-endian pixel ordering");
-	else
-		printf("big-endian pixel ordering");
-	printf("\n");
-
-	printf(ITEMFMT, "[9]", "BEBO - big-endian byte order in memory");
-	field = print_field(val, 9, 9);
-	if (field == 0)
-		printf("little-endian byte order");
-	else
-		printf("big-endian byte order");
-	printf("\n");
-
-	printf(ITEMFMT, "[8]", "BGR - colour format selection");
-	field = print_field(val, 8, 8);
-	if (field == 0)
-		printf("RGB: normal output");
-	else
-		printf("BGR: red and blue are swapped");
-	printf("\n");
-
-	printf(ITEMFMT, "[7]", "LcdDual - single or dual LCD panel selection");
-	field = print_field(val, 7, 7);
-	printf("%s-panel\n", field == 0? "single" : "dual");
-
-	printf(ITEMFMT, "[6]", "LcdMono8 - monochrome LCD interface width");
-	field = print_field(val, 6, 6);
-	printf("monochrome LCD uses %s-bit interface\n", field == 0? "4" : "8");
-
-	printf(ITEMFMT, "[5]", "LcdTFT - LCD panel TFT type selection");
-	field = print_field(val, 5, 5);
-	if (field == 0)
-		printf("LCD is an STN display, use gray scaler");
-	else
-		printf("LCD is a TFT display, do not use gray scaler");
-	printf("\n");
-
-	printf(ITEMFMT, "[4]", "LcdBW - STN LCD monochrome/colour selection");
-	field = print_field(val, 4, 4);
-	printf("STN LCD is %s\n", field == 0? "colour" : "monochrome");
-
-	printf(ITEMFMT, "[3:1]", "LcdBpp - LCD bits per pixel");
-	field = print_field(val, 3, 1);
-	switch (field) {
-		case 0:
-			printf("1 bpp");
-			break;
-		case 1:
-			printf("2 bpp");
-			break;
-		case 2:
-			printf("4 bpp");
-			break;
-		case 3:
-			printf("8 bpp");
-			break;
-		case 4:
-			printf("16 bpp");
-			break;
-		case 5:
-			printf("24 bpp (TFT panel only)");
-			break;
-		case 6:
-			printf("16 bpp, 5:6:5 mode");
-			break;
-		case 7:
-			printf("12 bpp, 4:4:4 mode");
-			break;
-		default:
-			printf("?");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "LcdEn - LCD enable control bit");
-	field = print_field(val, 0, 0);
-	printf("LCD %sabled\n", field == 0? "dis" : "en");
-}
-
-static void
-generic_int (uint32_t val)
-{
-	printf("\t\t\t%u - AHB master bus error\n", get_field(val, 4, 4));
-	printf("\t\t\t%u - vertical compare interrupt\n", get_field(val, 3, 3));
-	printf("\t\t\t%u - LCD next address base update raw interrupt\n", get_field(val, 2, 2));
-	printf("\t\t\t%u - FIFO underflow interrupt\n", get_field(val, 1, 1));
-}
-
-static void lcd__lcdintmsk (uint32_t val) { generic_int(val); }
-static void lcd__lcdintraw (uint32_t val) { generic_int(val); }
-static void lcd__lcdintstat (uint32_t val) { generic_int(val); }
-static void lcd__lcdintclr (uint32_t val) { generic_int(val); }
-
-static void
-lcd__lcdupcurr (uint32_t val)
-{
-	printf(ITEMFMT, "[31:0]", "LCDUPCURR - LCD upper panel current address");
-	printf("\t\t\t0x%08x\n", val);
-}
-
-static void
-lcd__lcdlpcurr (uint32_t val)
-{
-	printf(ITEMFMT, "[31:0]", "LCDLPCURR - LCD lower pannel current address");
-	printf("\t\t\t0x%08x\n", val);
-}
-
-static void
-lcd__crsrctrl (uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t lcd__lcdtimh[] = {
+	{.high=31, .low=24, .name_p="HBP - horizontal back porch", .fmt_p="0x%x", .flags=fieldNoBits},
+	{.high=23, .low=16, .name_p="HFP - horizontal front porch", .fmt_p="0x%x", .flags=fieldNoBits},
+	{.high=15, .low=8,  .name_p="HSW - horizontal synchronization pulse width", .fmt_p="0x%x", .flags=fieldNoBits},
+	{.high=7,  .low=2,  .name_p="PPL - pixels per line", .fmt_p="0x%x", .flags=fieldNoBits|fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[5:4]", "");
-	print_field(val, 5, 4);
-	printf("cursor number\n");
+static const FieldDescription_t lcd__lcdtimv[] = {
+	{.high=31, .low=24, .name_p="VBP - vertial back porch", .fmt_p="0x%x", .flags=fieldNoBits},
+	{.high=23, .low=16, .name_p="VFP - vertical front porch", .fmt_p="0x%x", .flags=fieldNoBits},
+	{.high=15, .low=10, .name_p="VSW - vertical synchronization pulse width", .fmt_p="0x%x", .flags=fieldNoBits},
+	{.high=9,  .low=0,  .name_p="LLP - lines per panel", .fmt_p="0x%x", .flags=fieldNoBits|fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "cursor enable");
-	field = print_field(val, 0, 0);
-	printf("cursor is%s displayed\n", field == 0? " not" : "");
-}
+static const char * const bcd[] = {"don't bypass pixel clock divider logic", "bypass pixel clock divider logic"};
+static const char * const ioe[] = {"LCDENAB output pin is active HIGH in TFT mode", "LCDENAB output pin is active LOW in TFT mode"};
+static const char * const ipc[] = {
+	"data is driven on the LCD data lines on the rising edge of LCDDCLK",
+	"data is driven on the LCD data lines on the falling edge of LCDDCLK",
+};
+static const char * const ihs[] = {"LCDLP pin is active HIGH and inactive LOW", "LCDLP pin is active LOW and inactive HIGH"};
+static const char * const ivs[] = {"LCDFP pin is active HIGH and inactive LOW", "LCDFP pin is active LOW and inactive HIGH"};
+static const char * const clksel[] = {"the clock source for the LCD block is HCLK", "the clock source for the LCD block is LCDCLKIN"};
+
+static const FieldDescription_t lcd__lcdpol[] = {
+	{.high=31, .low=27, .name_p="PCD_HI - panel clock divider, upper five bits", .fmt_p="0x%x", .flags=fieldNoBits},
+	{.high=26, .low=26, .name_p="BCD - bypass pixel clock divider", FIELDTEXT(bcd)},
+	{.high=25, .low=16, .name_p="CPL - clocks per line", .fmt_p="0x%x", .flags=fieldNoBits},
+	{.high=14, .low=14, .name_p="IOE - invert output enable", FIELDTEXT(ioe)},
+	{.high=13, .low=13, .name_p="IPC - invert panel clock", FIELDTEXT(ipc)},
+	{.high=12, .low=12, .name_p="IHS - invert horizontal synchronization", FIELDTEXT(ihs)},
+	{.high=11, .low=11, .name_p="IVS - invert vertical synchronization", FIELDTEXT(ivs)},
+	{.high=10, .low=6,  .name_p="ACB - AC bian pin frequency", .fmt_p="0x%x", .flags=fieldNoBits},
+	{.high=5,  .low=5,  .name_p="CLKSEL", FIELDTEXT(clksel)},
+	{.high=4,  .low=0,  .name_p="PCD_LO - panel clock divider, lower five bits", .fmt_p="0x%x", .flags=fieldNoBits|fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-lcd__crsrcfg (uint32_t val)
-{
-	uint32_t field;
+static const char * const lee[] = {"LCDLE disabled (held LOW)", "LCDLE signal active"};
 
-	printf(ITEMFMT, "[1]", "frame sync");
-	field = print_field(val, 1, 1);
-	printf("cursor coordinates are %s to the frame sync pulse\n", field == 0? "asynchronous" : "synchronized");
+static const FieldDescription_t lcd__lcdle[] = {
+	{.high=16, .low=16, .name_p="LEE - LCD line end enable", FIELDTEXT(lee)},
+	{.high=6,  .low=0,  .name_p="LED - line end delay", .fmt_p="0x%x", .flags=fieldNoBits|fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "cursor size");
-	field = print_field(val, 0, 0);
-	printf("%s pixel cursor\n", field == 0? "32x32" : "64x64");
-}
+static const FieldDescription_t lcd__lcdupbase[] = {
+	{.high=31, .low=3, .name_p="LCDUPBASE - LCD upper panel base address", .fmt_p="0x%08x", .flags=fieldNoBits|fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-pal_config (uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t lcd__lcdlpbase[] = {
+	{.high=31, .low=3, .name_p="LCDLPBASE - LCD lower panel base address", .fmt_p="0x%08x", .flags=fieldNoBits|fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[23:16]", "blue");
-	field = print_field(val, 23, 16);
-	printf("0x%x\n", field);
+static const char * const watermark[] = {
+	"LCD DMA request generated with 4 or more empty locations",
+	"LCD DMA request generated with 8 or more empty locations",
+};
+static const char * const vcomp[] = {
+	"start of vertical synchronization",
+	"start of back porch",
+	"start of active video",
+	"start of front porch",
+};
+static const char * const lcdPwr[] = {
+	"power not gated through LCD, LCDV[23:0] disabled",
+	"power gated through LCD, LCDV[23:0] enabled",
+};
+static const char * const bepo[] = {"little-endian pixel ordering", "big-endian pixel ordering"};
+static const char * const bebo[] = {"little-endian byte order", "big-endian byte order"};
+static const char * const bgr[] = {"RGB: normal output", "BGR: red and blue are swapped"};
+static const char * const lcdDual[] = {"single-panel", "dual-panel"};
+static const char * const lcdMono8[] = {"monochrome LCD uses 4-bit interface", "monochrome LCD uses 8-bit interface"};
+static const char * const lcdTft[] = {"LCD is an STN display, use gray scaler", "LCD is a TFT display, do not use gray scaler"};
+static const char * const lcdBw[] = {"STN LCD is colour", "STN LCD is monochrome"};
+static const char * const lcdBpp[] = {
+	"1 bpp",
+	"2 bpp",
+	"4 bpp",
+	"8 bpp",
+	"16 bpp",
+	"24 bpp (TFT panel only)",
+	"16 bpp, 5:6:5 mode",
+	"12 bpp, 4:4:4 mode",
+};
+static const char * const lcdEn[] = {"LCD disabled", "LCD enabled"};
+
+static const FieldDescription_t lcd__lcdctrl[] = {
+	{.high=16, .low=16, .name_p="WATERMARK - LCD DMA FIFO watermark level", FIELDTEXT(watermark)},
+	{.high=13, .low=12, .name_p="LcdVComp - LCD vertical compare interrupt, generate VComp interrupt at...", FIELDTEXT(vcomp)},
+	{.high=11, .low=11, .name_p="LcdPwr - LCD power enable", FIELDTEXT(lcdPwr)},
+	{.high=10, .low=10, .name_p="BEPO - big-endian pixel ordering within a byte", FIELDTEXT(bepo)},
+	{.high=9,  .low=9,  .name_p="BEBO - big-endian byte order in memory", FIELDTEXT(bebo)},
+	{.high=8,  .low=8,  .name_p="BGR - colour format selection", FIELDTEXT(bgr)},
+	{.high=7,  .low=7,  .name_p="LcdDual - single or dual LCD panel selection", FIELDTEXT(lcdDual)},
+	{.high=6,  .low=6,  .name_p="LcdMono8 - monochrome LCD interface width", FIELDTEXT(lcdMono8)},
+	{.high=5,  .low=5,  .name_p="LcdTFT - LCD panel TFT type selection", FIELDTEXT(lcdTft)},
+	{.high=4,  .low=4,  .name_p="LcdBW - STN LCD monochrome/colour selection", FIELDTEXT(lcdBw)},
+	{.high=3,  .low=1,  .name_p="LcdBpp - LCD bits per pixel", FIELDTEXT(lcdBpp)},
+	{.high=0,  .low=0,  .name_p="LcdEn - LCD enable control bit", FIELDTEXT(lcdEn), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[15:8]", "green");
-	field = print_field(val, 15, 8);
-	printf("0x%x\n", field);
+static const FieldDescription_t lcd__generic_int[] = {
+	{.high=4, .low=4, .name_p="AHB master bus error", .fmt_p="%d - AHB master bus error", .flags=fieldNoBits|fieldNoHeader|fieldNoRange},
+	{.high=3, .low=3, .name_p="vertical compare interrupt", .fmt_p="%d - vertical compare interrupt", .flags=fieldNoBits|fieldNoHeader|fieldNoRange},
+	{.high=2, .low=2, .name_p="LCD next address base update raw interrupt", .fmt_p="%d - LCD next address base update raw interrupt", .flags=fieldNoBits|fieldNoHeader|fieldNoRange},
+	{.high=1, .low=1, .name_p="FIFO underflow interrupt", .fmt_p="%d - FIFO underflow interrupt", .flags=fieldNoBits|fieldNoHeader|fieldNoRange|fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[7:0]", "red");
-	field = print_field(val, 7, 0);
-	printf("0x%x\n", field);
-}
+static const FieldDescription_t lcd__lcdupcurr[] = {
+	{.high=31, .low=0, .name_p="LCDUPCURR - LCD upper panel current address", .fmt_p="0x%08x", .flags=fieldNoBits|fieldEOL},
+	{.name_p=NULL},
+};
 
-static void lcd__crsrpal0 (uint32_t val) { pal_config(val); }
-static void lcd__crsrpal1 (uint32_t val) { pal_config(val); }
+static const FieldDescription_t lcd__lcdlpcurr[] = {
+	{.high=31, .low=0, .name_p="LCDLPCURR - LCD lower pannel current address", .fmt_p="0x%08x", .flags=fieldNoBits|fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-lcd__crsrxy (uint32_t val)
-{
-	uint32_t field;
+static const char * const crsrOn[] = {"cursor is not displayed", "cursor is displayed"};
 
-	printf(ITEMFMT, "[25:16]", "Y");
-	field = print_field(val, 25, 16);
-	printf("0x%x\n", field);
+static const FieldDescription_t lcd__crsrctrl[] = {
+	{.high=5, .low=4, .name_p="cursor number", .fmt_p="%u"},
+	{.high=0, .low=0, .name_p="cursor enable", FIELDTEXT(crsrOn), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[9:0]", "X");
-	field = print_field(val, 9, 0);
-	printf("0x%x\n", field);
-}
+static const char * const frameSync[] = {
+	"cursor coordinates are asynchronous to the frame sync pulse",
+	"cursor coordinates are synchronized to the frame sync pulse",
+};
+static const char * const crsrSize[] = {"32x32 pixel cursor", "64x64 pixel cursor"};
 
-static void
-lcd__crsrclip (uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t lcd__crsrcfg[] = {
+	{.high=1, .low=1, .name_p="frame sync", FIELDTEXT(frameSync)},
+	{.high=0, .low=0, .name_p="cursor size", FIELDTEXT(crsrSize), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[13:8]", "cursor clip position for Y direction");
-	field = print_field(val, 13, 8);
-	printf("0x%x\n", field);
+static const FieldDescription_t lcd__pal_config[] = {
+	{.high=23, .low=16, .name_p="blue", .fmt_p="0x%x"},
+	{.high=15, .low=8,  .name_p="green", .fmt_p="0x%x"},
+	{.high=7,  .low=0,  .name_p="red", .fmt_p="0x%x", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[5:0]", "cursor clip position for X direction");
-	field = print_field(val, 5, 0);
-	printf("0x%x\n", field);
-}
+static const FieldDescription_t lcd__crsrxy[] = {
+	{.high=25, .low=16, .name_p="Y", .fmt_p="0x%x"},
+	{.high=9,  .low=0,  .name_p="X", .fmt_p="0x%x", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-crsr_int (uint32_t val)
-{
-	printf("\t\t\t%u - cursor interrupt\n", get_field(val, 0, 0));
-}
+static const FieldDescription_t lcd__crsrclip[] = {
+	{.high=13, .low=8, .name_p="cursor clip position for Y direction", .fmt_p="0x%x"},
+	{.high=5,  .low=0, .name_p="cursor clip position for X direction", .fmt_p="0x%x", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void lcd__crsrintmsk (uint32_t val) { crsr_int(val); }
-static void lcd__crsrintclr (uint32_t val) { crsr_int(val); }
-static void lcd__crsrintraw (uint32_t val) { crsr_int(val); }
-static void lcd__crsrintstat (uint32_t val) { crsr_int(val); }
+static const FieldDescription_t lcd__crsr_int[] = {
+	{.high=0, .low=0, .name_p="cursor interrupt", .fmt_p="%d - cursor interrupt", .flags=fieldNoBits|fieldNoHeader|fieldNoRange|fieldEOL},
+	{.name_p=NULL},
+};
 
 RegisterDescription_t lcd[] = {
 	{0x40004054, 0, "LCD_CFG", "LCD configuration and clocking control", accessRW, NULL},
@@ -363,21 +187,21 @@ RegisterDescription_t lcd[] = {
 	{0x31040010, 0, "LCD_UPBASE", "upper panel frame base address register", accessRW, lcd__lcdupbase},
 	{0x31040014, 0, "LCD_LPBASE", "lower panel frame base address register", accessRW, lcd__lcdlpbase},
 	{0x31040018, 0, "LCD_CTRL", "LCD control register", accessRW, lcd__lcdctrl},
-	{0x3104001c, 0, "LCD_INTMSK", "interrupt mask register", accessRW, lcd__lcdintmsk},
-	{0x31040020, 0, "LCD_INTRAW", "raw interrupt status register", accessRead, lcd__lcdintraw},
-	{0x31040024, 0, "LCD_INTSTAT", "masked interrupt status register", accessRead, lcd__lcdintstat},
-	{0x31040028, 0, "LCD_INTCLR", "interrupt clear register", accessWrite, lcd__lcdintclr},
+	{0x3104001c, 0, "LCD_INTMSK", "interrupt mask register", accessRW, lcd__generic_int},
+	{0x31040020, 0, "LCD_INTRAW", "raw interrupt status register", accessRead, lcd__generic_int},
+	{0x31040024, 0, "LCD_INTSTAT", "masked interrupt status register", accessRead, lcd__generic_int},
+	{0x31040028, 0, "LCD_INTCLR", "interrupt clear register", accessWrite, lcd__generic_int},
 	{0x3104002c, 0, "LCD_UPCURR", "upper panel current address value register", accessRead, lcd__lcdupcurr},
 	{0x31040030, 0, "LCD_LPCURR", "lower panel current address value register", accessRead, lcd__lcdlpcurr},
 	{0x31040c00, 0, "CRSR_CTRL", "cursor control register", accessRW, lcd__crsrctrl},
 	{0x31040c04, 0, "CRSR_CFG", "cursor configuration register", accessRW, lcd__crsrcfg},
-	{0x31040c08, 0, "CRSR_PAL0", "cursor palette register 0", accessRW, lcd__crsrpal0},
-	{0x31040c0c, 0, "CRSR_PAL1", "cursor palette register 1", accessRW, lcd__crsrpal1},
+	{0x31040c08, 0, "CRSR_PAL0", "cursor palette register 0", accessRW, lcd__pal_config},
+	{0x31040c0c, 0, "CRSR_PAL1", "cursor palette register 1", accessRW, lcd__pal_config},
 	{0x31040c10, 0, "CRSR_XY", "cursor XY position register", accessRW, lcd__crsrxy},
 	{0x31040c14, 0, "CRSR_CLIP", "cursor clip position register", accessRW, lcd__crsrclip},
-	{0x31040c20, 0, "CRSR_INTMSK", "cursor interrupt mask register", accessRW, lcd__crsrintmsk},
-	{0x31040c24, 0, "CRSR_INTCLR", "cursor interrupt clear register", accessWrite, lcd__crsrintclr},
-	{0x31040c28, 0, "CRSR_INTRAW", "cursor raw interrupt status register", accessRead, lcd__crsrintraw},
-	{0x31040c2c, 0, "CRSR_INTSTAT", "cursor masked interrupt status register", accessRead, lcd__crsrintstat},
+	{0x31040c20, 0, "CRSR_INTMSK", "cursor interrupt mask register", accessRW, lcd__crsr_int},
+	{0x31040c24, 0, "CRSR_INTCLR", "cursor interrupt clear register", accessWrite, lcd__crsr_int},
+	{0x31040c28, 0, "CRSR_INTRAW", "cursor raw interrupt status register", accessRead, lcd__crsr_int},
+	{0x31040c2c, 0, "CRSR_INTSTAT", "cursor masked interrupt status register", accessRead, lcd__crsr_int},
 };
 size_t lcdSZ = (sizeof(lcd)/sizeof(lcd[0]));
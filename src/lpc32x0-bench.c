@@ -0,0 +1,913 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "registers.h"
+
+extern AllRegisters_t AllRegisters_G[];
+extern size_t AllRegistersSZ;
+
+static void usage (char *pgm_p);
+static RegisterDescription_t *linear_find_reg (uint32_t addr);
+static void bench_lookup (unsigned loops);
+static int bench_decode (char *capture_p, unsigned loops);
+static void bench_parse (char *capture_p);
+static int bench_suite (unsigned samples);
+static int bench_flash (uint32_t len, const char *dma_p);
+
+// keeps the compiler from optimizing the lookups away
+static volatile uintptr_t sink_G;
+
+int
+main (int argc, char *argv[])
+{
+	int c;
+	unsigned loops = 1000;
+	char *capture_p = NULL;
+	char *parse_p = NULL;
+	bool suite = false;
+	uint32_t flashLen = 0;
+	char *dma_p = NULL;
+	struct option longOpts[] = {
+		{"help", no_argument, NULL, 'h'},
+		{"loops", required_argument, NULL, 'l'},
+		{"capture", required_argument, NULL, 'c'},
+		{"parse", required_argument, NULL, 'p'},
+		{"suite", no_argument, NULL, 's'},
+		{"flash", required_argument, NULL, 'f'},
+		{"dma", required_argument, NULL, 'd'},
+		{NULL, 0, NULL, 0},
+	};
+
+	while (1) {
+		c = getopt_long(argc, argv, "hl:c:p:sf:d:", longOpts, NULL);
+		if (c == -1)
+			break;
+		switch (c) {
+			case 'h':
+				usage(argv[0]);
+				return 0;
+			case 'l':
+				if ((sscanf(optarg, "%u", &loops) != 1) || (loops == 0)) {
+					printf("can't convert '%s' to a loop count\n", optarg);
+					return 1;
+				}
+				break;
+			case 'c':
+				capture_p = optarg;
+				break;
+			case 'p':
+				parse_p = optarg;
+				break;
+			case 's':
+				suite = true;
+				break;
+			case 'f':
+				if ((sscanf(optarg, "%u", &flashLen) != 1) || (flashLen == 0) || (flashLen > 65535)) {
+					printf("can't convert '%s' to a length\n", optarg);
+					return 1;
+				}
+				break;
+			case 'd':
+				dma_p = optarg;
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+
+	if (suite)
+		return bench_suite(loops);
+	if (flashLen != 0)
+		return bench_flash(flashLen, dma_p);
+	if (parse_p != NULL)
+		bench_parse(parse_p);
+	else if (capture_p != NULL)
+		return bench_decode(capture_p, loops);
+	else
+		bench_lookup(loops);
+	return 0;
+}
+
+static void
+usage (char *pgm_p)
+{
+	printf("usage:\n");
+	if (pgm_p != NULL)
+		printf("%s [<options>]\n", pgm_p);
+	printf("  where:\n");
+	printf("    options:\n");
+	printf("      -h|--help        print usage information and exit successfully\n");
+	printf("      -l|--loops <n>   number of passes over every known register,\n");
+	printf("                       or over the capture (default: 1000)\n");
+	printf("      -c|--capture <f> time verbose decodes of the registers in capture file <f>\n");
+	printf("                       (lpc32x0-offline format) instead of register lookups\n");
+	printf("      -p|--parse <f>   time parsing capture file <f> without decoding it\n");
+	printf("      -s|--suite       run the register access, mapping, decoder and set dump\n");
+	printf("                       benchmarks and print the results as JSON; -l is the\n");
+	printf("                       number of samples of each\n");
+	printf("      -f|--flash <n>   time reading <n> (at most 65535) bytes of the SPI flash\n");
+	printf("                       with the old byte loops (by address with get_reg and\n");
+	printf("                       by handle) and the burst engine, at each SPI1 clock rate\n");
+	printf("      -d|--dma <addr>  with -f, also read by GPDMA into a buffer at physical\n");
+	printf("                       address <addr> (IRAM, or SDRAM Linux doesn't use)\n");
+}
+
+/*
+ * this is how registers.c used to find a register: walk every entry of
+ * every set until the address matches
+ */
+static RegisterDescription_t *
+linear_find_reg (uint32_t addr)
+{
+	size_t i, idx;
+
+	for (idx=0; idx<AllRegistersSZ; ++idx)
+		for (i=0; i<*(AllRegisters_G[idx].sz_p); ++i)
+			if (AllRegisters_G[idx].reg_p[i].addr == addr)
+				return &AllRegisters_G[idx].reg_p[i];
+	return NULL;
+}
+
+/*
+ * look up every address of every set 'loops' times, once with the old
+ * table walk and once with the sorted index, and make sure both agree
+ */
+static void
+bench_lookup (unsigned loops)
+{
+	unsigned loop;
+	size_t i, idx, cnt, total;
+	uint64_t start, linearNs, indexNs;
+	RegisterDescription_t **regs_pp;
+
+	total = 0;
+	for (idx=0; idx<AllRegistersSZ; ++idx) {
+		for (i=0; i<*(AllRegisters_G[idx].sz_p); ++i) {
+			regs_pp = lpc32x0__find_reg(AllRegisters_G[idx].reg_p[i].addr, &cnt);
+			if ((regs_pp == NULL) || (regs_pp[0] != linear_find_reg(AllRegisters_G[idx].reg_p[i].addr))) {
+				printf("index mismatch for %s (%08x)\n",
+						AllRegisters_G[idx].reg_p[i].name_p,
+						AllRegisters_G[idx].reg_p[i].addr);
+				exit(1);
+			}
+			++total;
+		}
+	}
+
+	start = lpc32x0__now_ns();
+	for (loop=0; loop<loops; ++loop)
+		for (idx=0; idx<AllRegistersSZ; ++idx)
+			for (i=0; i<*(AllRegisters_G[idx].sz_p); ++i)
+				sink_G = (uintptr_t)linear_find_reg(AllRegisters_G[idx].reg_p[i].addr);
+	linearNs = lpc32x0__now_ns() - start;
+
+	start = lpc32x0__now_ns();
+	for (loop=0; loop<loops; ++loop)
+		for (idx=0; idx<AllRegistersSZ; ++idx)
+			for (i=0; i<*(AllRegisters_G[idx].sz_p); ++i)
+				sink_G = (uintptr_t)lpc32x0__find_reg(AllRegisters_G[idx].reg_p[i].addr, &cnt);
+	indexNs = lpc32x0__now_ns() - start;
+
+	total *= loops;
+	printf("register lookup (%zu lookups):\n", total);
+	printf("  table walk    %10.1f ns/lookup\n", (double)linearNs / (double)total);
+	printf("  sorted index  %10.1f ns/lookup\n", (double)indexNs / (double)total);
+	if (indexNs != 0)
+		printf("  speedup       %10.1fx\n", (double)linearNs / (double)indexNs);
+}
+
+/*
+ * decode every register in the capture 'loops' times in a child process
+ * whose stdout goes to /dev/null, using the given stdout buffering mode
+ * returns the wall time in ns, or 0 on error
+ */
+static uint64_t
+time_decode (uint32_t *addrs_p, uint32_t *vals_p, size_t cnt, unsigned loops, bool buffered)
+{
+	pid_t pid;
+	int status;
+	size_t i;
+	unsigned loop;
+	uint64_t start;
+
+	fflush(stdout);
+	start = lpc32x0__now_ns();
+	pid = fork();
+	if (pid == -1) {
+		perror("fork()");
+		return 0;
+	}
+	if (pid == 0) {
+		if (freopen("/dev/null", "w", stdout) == NULL)
+			_exit(1);
+		if (buffered)
+			lpc32x0__buffer_output();
+		else
+			setvbuf(stdout, NULL, _IOLBF, 0);
+		for (loop=0; loop<loops; ++loop)
+			for (i=0; i<cnt; ++i)
+				lpc32x0__print_reg(addrs_p[i], vals_p[i], true);
+		exit(0);
+	}
+	if ((waitpid(pid, &status, 0) == -1) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+		return 0;
+	return lpc32x0__now_ns() - start;
+}
+
+// the known registers found in a capture
+typedef struct {
+	uint32_t *addrs_p;
+	uint32_t *vals_p;
+	size_t cnt;
+	size_t max;
+	bool failed;
+} DecodeWords_t;
+
+static void
+decode_word (uint32_t addr, uint32_t val, void *arg_p)
+{
+	size_t cnt, max;
+	uint32_t *tmp_p;
+	DecodeWords_t *words_p = arg_p;
+
+	if (words_p->failed || (lpc32x0__find_reg(addr, &cnt) == NULL))
+		return;
+	if (words_p->cnt == words_p->max) {
+		max = (words_p->max == 0)? 256 : words_p->max * 2;
+		tmp_p = realloc(words_p->addrs_p, max * sizeof(*tmp_p));
+		if (tmp_p == NULL)
+			goto fail;
+		words_p->addrs_p = tmp_p;
+		tmp_p = realloc(words_p->vals_p, max * sizeof(*tmp_p));
+		if (tmp_p == NULL)
+			goto fail;
+		words_p->vals_p = tmp_p;
+		words_p->max = max;
+	}
+	words_p->addrs_p[words_p->cnt] = addr;
+	words_p->vals_p[words_p->cnt] = val;
+	++words_p->cnt;
+	return;
+
+fail:
+	perror("realloc()");
+	words_p->failed = true;
+}
+
+/*
+ * lpc32x0-dump -v spends most of its time formatting; compare line buffered
+ * output (what a serial console or ssh session gets) against the library's
+ * output buffer, on the known registers found in a capture (read the way
+ * lpc32x0-offline reads it)
+ */
+static int
+bench_decode (char *capture_p, unsigned loops)
+{
+	int fd, ret = 1;
+	DecodeWords_t words = {0};
+	uint64_t lineNs, bufNs;
+
+	fd = open(capture_p, O_RDONLY);
+	if (fd == -1) {
+		perror(capture_p);
+		return 1;
+	}
+	if (!lpc32x0__parse_capture(fd, decode_word, &words, NULL) || words.failed)
+		goto done;
+	if (words.cnt == 0) {
+		printf("%s: no known registers found\n", capture_p);
+		goto done;
+	}
+
+	lineNs = time_decode(words.addrs_p, words.vals_p, words.cnt, loops, false);
+	bufNs = time_decode(words.addrs_p, words.vals_p, words.cnt, loops, true);
+	if ((lineNs == 0) || (bufNs == 0))
+		goto done;
+	printf("verbose decode of %s (%zu registers x %u):\n", capture_p, words.cnt, loops);
+	printf("  line buffered   %10.3f ms/pass\n", (double)lineNs / 1e6 / loops);
+	printf("  output buffer   %10.3f ms/pass\n", (double)bufNs / 1e6 / loops);
+	ret = 0;
+
+done:
+	close(fd);
+	free(words.addrs_p);
+	free(words.vals_p);
+	return ret;
+}
+
+static void
+count_word (unused uint32_t addr, uint32_t val, void *arg_p)
+{
+	*(uint32_t*)arg_p ^= val;
+}
+
+/*
+ * time the capture parser alone against the fgets()/sscanf() loop
+ * lpc32x0-offline used to have
+ */
+static void
+bench_parse (char *capture_p)
+{
+	int fd, cvt;
+	FILE *file_p;
+	char line[256];
+	uint32_t addr, val[4], sum = 0;
+	size_t lines = 0;
+	uint64_t start, scanfNs, parseNs;
+	CaptureStats_t stats;
+
+	file_p = fopen(capture_p, "r");
+	if (file_p == NULL) {
+		perror(capture_p);
+		return;
+	}
+	start = lpc32x0__now_ns();
+	while (fgets(line, sizeof(line), file_p) != NULL) {
+		cvt = sscanf(line, "%x: %x %x %x %x", &addr, &val[0], &val[1], &val[2], &val[3]);
+		if (cvt > 1)
+			sum ^= val[0];
+		++lines;
+	}
+	scanfNs = lpc32x0__now_ns() - start;
+	fclose(file_p);
+
+	fd = open(capture_p, O_RDONLY);
+	if (fd == -1) {
+		perror(capture_p);
+		return;
+	}
+	start = lpc32x0__now_ns();
+	if (!lpc32x0__parse_capture(fd, count_word, &sum, &stats)) {
+		close(fd);
+		return;
+	}
+	parseNs = lpc32x0__now_ns() - start;
+	close(fd);
+	sink_G = sum;
+
+	printf("parse of %s (%zu lines, %zu words, %zu bytes):\n", capture_p, stats.lines, stats.words, stats.bytes);
+	if ((scanfNs == 0) || (parseNs == 0))
+		return;
+	printf("  fgets/sscanf    %12.0f lines/s\n", (double)lines * 1e9 / (double)scanfNs);
+	printf("  capture parser  %12.0f lines/s  %8.1f MB/s\n",
+			(double)stats.lines * 1e9 / (double)parseNs,
+			(double)stats.bytes * 1e3 / (double)parseNs);
+}
+
+/*
+ * SPI flash reads
+ *
+ * this is how lpc32x0-spi used to move bytes: a poll of SPI1_STAT before
+ * every byte sent, and two (and maybe a write of SPI1_CON) before every
+ * byte received; first through lpc32x0__get_reg()/lpc32x0__set_reg(),
+ * which look the register up on every access, as it did before it had
+ * handles, then through handles
+ * the receive loop can leave shift_off set, after which another frame
+ * count never starts, so reads are limited to one frame count
+ */
+#define FLASH_CON_RATES 4 // SPI1_CON rate 0 ... 3, HCLK/2 ... HCLK/8
+#define FLASH_CON(rate) (0x800e80 | (rate))
+#define FLASH_DMA_CHANNEL 7
+
+typedef enum {
+	flashGetReg,
+	flashByte,
+	flashBurst,
+	flashDma,
+	flashMethods,
+} FlashMethod_e;
+
+static const char * const flashMethods_G[] = {"get_reg", "byte", "burst", "dma"};
+
+static uint32_t
+get_reg (uint32_t addr)
+{
+	uint32_t val = 0;
+
+	lpc32x0__get_reg(addr, &val);
+	return val;
+}
+
+static void
+get_reg_tx (const SpiXfer_t *spi_p, const uint8_t *data_p, uint32_t len)
+{
+	uint32_t frameLen;
+
+	lpc32x0__set_reg(SPI1_CON, spi_p->conBase | 0x8000);
+	while (len) {
+		frameLen = (len > 65535)? 65535 : len;
+		lpc32x0__set_reg(SPI1_FRM, frameLen);
+		len -= frameLen;
+		while (frameLen--) {
+			while (get_reg(SPI1_STAT) & 0x04)
+				;
+			lpc32x0__set_reg(SPI1_DAT, *data_p++);
+		}
+		while ((get_reg(SPI1_STAT) & 0x01) == 0)
+			;
+		lpc32x0__set_reg(SPI1_STAT, 0x100);
+	}
+}
+
+static void
+get_reg_rx (const SpiXfer_t *spi_p, uint8_t *data_p, uint32_t len)
+{
+	uint32_t frameLen;
+
+	lpc32x0__set_reg(SPI1_CON, spi_p->conBase);
+	while (len) {
+		frameLen = (len > 65535)? 65535 : len;
+		len -= frameLen;
+		lpc32x0__set_reg(SPI1_FRM, frameLen);
+		(void)get_reg(SPI1_DAT);
+		while (frameLen--) {
+			while (get_reg(SPI1_STAT) & 0x01)
+				;
+			if (get_reg(SPI1_STAT) & 0x08)
+				lpc32x0__set_reg(SPI1_CON, spi_p->conBase | 0x2000);
+			*data_p++ = (uint8_t)get_reg(SPI1_DAT);
+		}
+		lpc32x0__set_reg(SPI1_STAT, 0x100);
+	}
+}
+
+static void
+byte_tx (const SpiXfer_t *spi_p, const uint8_t *data_p, uint32_t len)
+{
+	uint32_t frameLen;
+
+	lpc32x0__write(&spi_p->con, spi_p->conBase | 0x8000);
+	while (len) {
+		frameLen = (len > 65535)? 65535 : len;
+		lpc32x0__write(&spi_p->frm, frameLen);
+		len -= frameLen;
+		while (frameLen--) {
+			while (lpc32x0__read(&spi_p->stat) & 0x04)
+				;
+			lpc32x0__write(&spi_p->dat, *data_p++);
+		}
+		while ((lpc32x0__read(&spi_p->stat) & 0x01) == 0)
+			;
+		lpc32x0__write(&spi_p->stat, 0x100);
+	}
+}
+
+static void
+byte_rx (const SpiXfer_t *spi_p, uint8_t *data_p, uint32_t len)
+{
+	uint32_t frameLen;
+
+	lpc32x0__write(&spi_p->con, spi_p->conBase);
+	while (len) {
+		frameLen = (len > 65535)? 65535 : len;
+		len -= frameLen;
+		lpc32x0__write(&spi_p->frm, frameLen);
+		(void)lpc32x0__read(&spi_p->dat);
+		while (frameLen--) {
+			while (lpc32x0__read(&spi_p->stat) & 0x01)
+				;
+			if (lpc32x0__read(&spi_p->stat) & 0x08)
+				lpc32x0__write(&spi_p->con, spi_p->conBase | 0x2000);
+			*data_p++ = (uint8_t)lpc32x0__read(&spi_p->dat);
+		}
+		lpc32x0__write(&spi_p->stat, 0x100);
+	}
+}
+
+/*
+ * read 'len' bytes from the start of the on-board flash, with the old byte
+ * loops (by address or by handle), the burst engine or the DMA; returns the
+ * wall time in ns, and the sim's stats if it's the sim
+ */
+static uint64_t
+time_flash_read (SpiXfer_t *spi_p, const FieldHandle_t *cs_p, const SpiDma_t *dma_p, uint8_t *data_p, uint32_t len, FlashMethod_e method, SpiSimStats_t *sim_p)
+{
+	uint64_t start;
+	SpiSimStats_t before;
+	static const uint8_t command[] = {0x0b, 0, 0, 0, 0}; // FAST_READ 0
+
+	if (!lpc32x0__get_spi_sim_stats(&before))
+		memset(&before, 0, sizeof(before));
+	start = lpc32x0__now_ns();
+	lpc32x0__write_field(cs_p, 0);
+	switch (method) {
+		case flashGetReg:
+			get_reg_tx(spi_p, command, sizeof(command));
+			get_reg_rx(spi_p, data_p, len);
+			break;
+		case flashByte:
+			byte_tx(spi_p, command, sizeof(command));
+			byte_rx(spi_p, data_p, len);
+			break;
+		case flashBurst:
+			lpc32x0__spi_xfer(spi_p, command, sizeof(command), data_p, len);
+			break;
+		default:
+			lpc32x0__spi_tx(spi_p, command, sizeof(command));
+			if (!lpc32x0__spi_dma_rx(spi_p, dma_p, data_p, len))
+				memset(data_p, 0, len);
+			break;
+	}
+	lpc32x0__write_field(cs_p, 1);
+	start = lpc32x0__now_ns() - start;
+
+	if (lpc32x0__get_spi_sim_stats(sim_p)) {
+		sim_p->cycles -= before.cycles;
+		sim_p->accesses -= before.accesses;
+	}
+	else
+		memset(sim_p, 0, sizeof(*sim_p));
+	return start;
+}
+
+static void
+print_flash_result (const char *name_p, uint32_t len, uint64_t ns, const SpiSimStats_t *sim_p)
+{
+	printf("  %-7s %12.0f bytes/s", name_p, ns? (double)len * 1e9 / (double)ns : 0.0);
+	if (sim_p->cycles != 0)
+		printf("  simulated %12.0f bytes/s, %8.2f accesses/byte",
+				(double)len * sim_p->hclk / (double)sim_p->cycles,
+				(double)sim_p->accesses / (double)len);
+	printf("\n");
+}
+
+/*
+ * compare the byte loops, by address and by handle, with the burst engine
+ * (and the DMA, given a buffer for it at physical address 'dma_p') at each
+ * SPI1 clock rate lpc32x0-spi can use; they all have to read the same bytes
+ */
+static int
+bench_flash (uint32_t len, const char *dma_p)
+{
+	unsigned rate, csBit, method, methods = flashDma;
+	uint32_t val, dmaPhys;
+	uint64_t ns;
+	uint8_t *data_p[flashMethods] = {NULL};
+	char *end_p;
+	int ret = 1;
+	SpiXfer_t spi;
+	FieldHandle_t cs;
+	SpiDma_t dma = {0};
+	SpiSimStats_t sim;
+
+	for (method=0; method<flashMethods; ++method) {
+		data_p[method] = malloc(len);
+		if (data_p[method] == NULL) {
+			perror("malloc()");
+			goto out;
+		}
+	}
+	if (dma_p != NULL) {
+		dmaPhys = (uint32_t)strtoul(dma_p, &end_p, 0);
+		if ((*dma_p == 0) || (*end_p != 0)) {
+			printf("can't convert '%s' to an address\n", dma_p);
+			goto out;
+		}
+		if (!lpc32x0__spi_dma_open(FLASH_DMA_CHANNEL, dmaPhys, (lpc32x0__spi_dma_need(len) + 0xfff) & ~(size_t)0xfff, &dma))
+			goto out;
+		methods = flashMethods;
+	}
+	if (!lpc32x0__resolve_spi(FLASH_CON(0), &spi) || !lpc32x0__get_reg(P3_INP_STATE, &val)) {
+		printf("can't resolve the SPI1 registers\n");
+		goto out;
+	}
+	// the on-board flash, see lpc32x0-spi.c
+	csBit = (val & P3_INP_BOOTSTICK)? P3_OUTP_CS_GPIO4 : P3_OUTP_CS_GPIO5;
+	if (!lpc32x0__resolve_field_bits(P3_OUTP_STATE, csBit, csBit, &cs)) {
+		printf("can't resolve the chip select\n");
+		goto out;
+	}
+
+	lpc32x0__set_reg(P2_MUX_CLR, 0x30);
+	lpc32x0__set_reg(P2_DIR_SET, 0x60000000);
+	lpc32x0__write_field(&cs, 1);
+	lpc32x0__set_reg(SPI_CTRL, 0x03);
+	lpc32x0__set_reg(SPI1_GLOBAL, 0x03);
+	lpc32x0__set_reg(SPI1_GLOBAL, 0x01);
+
+	ret = 0;
+	for (rate=0; rate<FLASH_CON_RATES; ++rate) {
+		spi.conBase = FLASH_CON(rate);
+		printf("flash read of %u bytes, SPI1_CLK = HCLK/%u:\n", len, (rate + 1) * 2);
+		for (method=0; method<methods; ++method) {
+			ns = time_flash_read(&spi, &cs, &dma, data_p[method], len, (FlashMethod_e)method, &sim);
+			print_flash_result(flashMethods_G[method], len, ns, &sim);
+			if (memcmp(data_p[flashGetReg], data_p[method], len) != 0) {
+				printf("  the %s read differs\n", flashMethods_G[method]);
+				ret = 1;
+			}
+		}
+	}
+
+	lpc32x0__set_reg(SPI1_GLOBAL, 0x00);
+	lpc32x0__set_reg(SPI_CTRL, 0x00);
+out:
+	lpc32x0__spi_dma_close(&dma);
+	for (method=0; method<flashMethods; ++method)
+		free(data_p[method]);
+	return ret;
+}
+
+/*
+ * the benchmark suite
+ *
+ * every benchmark takes 'samples' samples, each the average over a batch
+ * of operations (so the clock's own cost doesn't swamp fast operations),
+ * and reports the min, median and 99th percentile in ns per operation
+ *
+ * the results are printed as JSON on the original stdout; stdout itself
+ * goes to /dev/null (with the library's output buffer) so the decoders and
+ * set dumps only pay for formatting
+ */
+typedef struct {
+	const char *bus_p;
+	uint32_t addr;
+} BusTarget_t;
+
+// registers that are harmless to read, and to write back unchanged
+static const BusTarget_t busTargets_G[] = {
+	{"APB", 0x40004050}, // SYSCLK_CTRL
+	{"AHB", 0x20088000}, // SPI1_GLOBAL
+	{"AHB", 0x31000030}, // DMACConfig
+};
+
+#define BATCH_ACCESS 100
+#define BATCH_REMAP  10
+#define BATCH_DECODE 10
+
+static FILE *json_pG;
+static bool firstResult_G = true;
+static double *samples_pG;
+static unsigned sampleCnt_G;
+
+static int
+double_cmp (const void *a_p, const void *b_p)
+{
+	double a = *(const double*)a_p;
+	double b = *(const double*)b_p;
+
+	return (a < b)? -1 : (a > b)? 1 : 0;
+}
+
+static void
+json_string (const char *str_p)
+{
+	fputc('"', json_pG);
+	for (; *str_p; ++str_p) {
+		if ((*str_p == '"') || (*str_p == '\\'))
+			fprintf(json_pG, "\\%c", *str_p);
+		else if ((unsigned char)*str_p < 0x20)
+			fprintf(json_pG, "\\u%04x", (unsigned char)*str_p);
+		else
+			fputc(*str_p, json_pG);
+	}
+	fputc('"', json_pG);
+}
+
+static void
+json_start (const char *bench_p, const char *target_p, const char *bus_p, uint32_t addr)
+{
+	fprintf(json_pG, "%s\n    {\"bench\": ", firstResult_G? "" : ",");
+	firstResult_G = false;
+	json_string(bench_p);
+	fprintf(json_pG, ", \"target\": ");
+	json_string(target_p);
+	if (bus_p != NULL) {
+		fprintf(json_pG, ", \"bus\": ");
+		json_string(bus_p);
+	}
+	if (addr != 0)
+		fprintf(json_pG, ", \"addr\": \"0x%08x\"", addr);
+}
+
+static void
+json_skipped (const char *bench_p, const char *reason_p)
+{
+	json_start(bench_p, "", NULL, 0);
+	fprintf(json_pG, ", \"skipped\": ");
+	json_string(reason_p);
+	fprintf(json_pG, "}");
+}
+
+// report the samples taken so far, each 'batch' operations
+static void
+json_result (const char *bench_p, const char *target_p, const char *bus_p, uint32_t addr, unsigned batch)
+{
+	size_t p99;
+
+	qsort(samples_pG, sampleCnt_G, sizeof(*samples_pG), double_cmp);
+	p99 = ((sampleCnt_G * 99) + 99) / 100;
+	if (p99 > 0)
+		--p99;
+
+	json_start(bench_p, target_p, bus_p, addr);
+	fprintf(json_pG, ", \"unit\": \"ns\", \"samples\": %u, \"batch\": %u, "
+			"\"min\": %.1f, \"median\": %.1f, \"p99\": %.1f}",
+			sampleCnt_G, batch,
+			samples_pG[0], samples_pG[sampleCnt_G / 2], samples_pG[p99]);
+}
+
+static void
+add_sample (uint64_t ns, unsigned batch)
+{
+	samples_pG[sampleCnt_G++] = (double)ns / (double)batch;
+}
+
+static const char *
+reg_name (uint32_t addr)
+{
+	size_t cnt;
+	RegisterDescription_t **regs_pp;
+
+	regs_pp = lpc32x0__find_reg(addr, &cnt);
+	return (regs_pp != NULL)? regs_pp[0]->name_p : "?";
+}
+
+/*
+ * lpc32x0__ctx_get_reg()/set_reg() on a register of each bus; the set
+ * writes back the value that was read
+ */
+static void
+bench_access (Lpc32x0Ctx_t *ctx_p, unsigned samples)
+{
+	size_t t;
+	unsigned i, j;
+	uint32_t val;
+	uint64_t start;
+
+	for (t=0; t<(sizeof(busTargets_G)/sizeof(busTargets_G[0])); ++t) {
+		if (!lpc32x0__ctx_get_reg(ctx_p, busTargets_G[t].addr, &val)) {
+			json_skipped("get_reg", "register can't be read");
+			continue;
+		}
+
+		sampleCnt_G = 0;
+		for (i=0; i<samples; ++i) {
+			start = lpc32x0__now_ns();
+			for (j=0; j<BATCH_ACCESS; ++j)
+				lpc32x0__ctx_get_reg(ctx_p, busTargets_G[t].addr, &val);
+			add_sample(lpc32x0__now_ns() - start, BATCH_ACCESS);
+		}
+		json_result("get_reg", reg_name(busTargets_G[t].addr), busTargets_G[t].bus_p, busTargets_G[t].addr, BATCH_ACCESS);
+
+		sampleCnt_G = 0;
+		for (i=0; i<samples; ++i) {
+			start = lpc32x0__now_ns();
+			for (j=0; j<BATCH_ACCESS; ++j)
+				lpc32x0__ctx_set_reg(ctx_p, busTargets_G[t].addr, val);
+			add_sample(lpc32x0__now_ns() - start, BATCH_ACCESS);
+		}
+		json_result("set_reg", reg_name(busTargets_G[t].addr), busTargets_G[t].bus_p, busTargets_G[t].addr, BATCH_ACCESS);
+	}
+}
+
+/*
+ * the mapping cache: a hit that isn't the most recent window (alternating
+ * between two pages), and a full remap (the page is unmapped and mapped
+ * again)
+ */
+static void
+bench_mapping (Lpc32x0Ctx_t *ctx_p, unsigned samples)
+{
+	unsigned i, j;
+	uint32_t val;
+	uint64_t start;
+	uint32_t a = busTargets_G[0].addr;
+	uint32_t b = busTargets_G[2].addr;
+
+	sampleCnt_G = 0;
+	for (i=0; i<samples; ++i) {
+		start = lpc32x0__now_ns();
+		for (j=0; j<BATCH_ACCESS; j+=2) {
+			lpc32x0__ctx_get_reg(ctx_p, a, &val);
+			lpc32x0__ctx_get_reg(ctx_p, b, &val);
+		}
+		add_sample(lpc32x0__now_ns() - start, BATCH_ACCESS);
+	}
+	json_result("map_hit", "alternating pages", NULL, 0, BATCH_ACCESS);
+
+	sampleCnt_G = 0;
+	for (i=0; i<samples; ++i) {
+		start = lpc32x0__now_ns();
+		for (j=0; j<BATCH_REMAP; ++j) {
+			lpc32x0__ctx_drop_mappings(ctx_p);
+			lpc32x0__ctx_get_reg(ctx_p, a, &val);
+		}
+		add_sample(lpc32x0__now_ns() - start, BATCH_REMAP);
+	}
+	json_result("remap", "munmap+mmap", NULL, 0, BATCH_REMAP);
+}
+
+// every register's decoder, on the register's reset value
+static void
+bench_decoders (unsigned samples)
+{
+	size_t r, cnt;
+	unsigned i, j;
+	uint64_t start;
+	RegisterDescription_t *reg_p;
+	RegisterDescription_t **index_pp;
+
+	index_pp = lpc32x0__reg_index(&cnt);
+	for (r=0; r<cnt; ++r) {
+		reg_p = index_pp[r];
+		if (reg_p->fields_p == NULL)
+			continue;
+		if ((r > 0) && (index_pp[r-1]->addr == reg_p->addr))
+			continue;
+
+		sampleCnt_G = 0;
+		for (i=0; i<samples; ++i) {
+			start = lpc32x0__now_ns();
+			for (j=0; j<BATCH_DECODE; ++j)
+				lpc32x0__print_fields(reg_p, reg_p->resetState);
+			add_sample(lpc32x0__now_ns() - start, BATCH_DECODE);
+		}
+		json_result("decode", reg_p->name_p, NULL, reg_p->addr, BATCH_DECODE);
+	}
+}
+
+// what "lpc32x0-dump -s <set>" and "-s <set> -v" do
+static void
+bench_set_dumps (Lpc32x0Ctx_t *ctx_p, unsigned samples)
+{
+	size_t idx;
+	unsigned i;
+	int verbose;
+	uint64_t start;
+
+	for (verbose=0; verbose<2; ++verbose)
+		for (idx=0; idx<AllRegistersSZ; ++idx) {
+			sampleCnt_G = 0;
+			for (i=0; i<samples; ++i) {
+				start = lpc32x0__now_ns();
+				lpc32x0__ctx_get_and_print_reg_set_by_name(ctx_p, AllRegisters_G[idx].name_p, verbose);
+				fflush(stdout);
+				add_sample(lpc32x0__now_ns() - start, 1);
+			}
+			json_result(verbose? "set_dump_verbose" : "set_dump", AllRegisters_G[idx].name_p, NULL, 0, 1);
+		}
+}
+
+static int
+bench_suite (unsigned samples)
+{
+	int jsonFd;
+	Lpc32x0Ctx_t *ctx_p;
+
+	fflush(stdout);
+	jsonFd = dup(STDOUT_FILENO);
+	json_pG = (jsonFd == -1)? NULL : fdopen(jsonFd, "w");
+	samples_pG = malloc(samples * sizeof(*samples_pG));
+	if ((json_pG == NULL) || (samples_pG == NULL)) {
+		perror("bench_suite()");
+		return 1;
+	}
+	if (freopen("/dev/null", "w", stdout) == NULL) {
+		perror("/dev/null");
+		return 1;
+	}
+	lpc32x0__buffer_output();
+
+	fprintf(json_pG, "{\n  \"tool\": \"lpc32x0-bench\",\n  \"samples\": %u,\n  \"results\": [", samples);
+
+	ctx_p = lpc32x0__ctx_open();
+	if (ctx_p != NULL) {
+		bench_access(ctx_p, samples);
+		bench_mapping(ctx_p, samples);
+	}
+	else {
+		json_skipped("get_reg", "can't open /dev/mem");
+		json_skipped("set_reg", "can't open /dev/mem");
+		json_skipped("map_hit", "can't open /dev/mem");
+		json_skipped("remap", "can't open /dev/mem");
+	}
+
+	bench_decoders(samples);
+
+	if (ctx_p != NULL)
+		bench_set_dumps(ctx_p, samples);
+	else
+		json_skipped("set_dump", "can't open /dev/mem");
+
+	fprintf(json_pG, "\n  ]\n}\n");
+	lpc32x0__ctx_close(ctx_p);
+	fclose(json_pG);
+	free(samples_pG);
+	return 0;
+}
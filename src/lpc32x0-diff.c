@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <getopt.h>
+
+#include "registers.h"
+
+static void usage (char *pgm_p);
+
+int
+main (int argc, char *argv[])
+{
+	int c, fd;
+	int ret = 2;
+	bool fields = true;
+	size_t i, cnt = 0, diffs;
+	RegImage_t **images_pp = NULL;
+	struct option longOpts[] = {
+		{"help", no_argument, NULL, 'h'},
+		{"quiet", no_argument, NULL, 'q'},
+		{NULL, 0, NULL, 0},
+	};
+
+	lpc32x0__buffer_output();
+
+	while (1) {
+		c = getopt_long(argc, argv, "hq", longOpts, NULL);
+		if (c == -1)
+			break;
+		switch (c) {
+			case 'h':
+				usage(argv[0]);
+				return 0;
+			case 'q':
+				fields = false;
+				break;
+			default:
+				usage(argv[0]);
+				return 2;
+		}
+	}
+
+	if ((argc - optind) < 2) {
+		printf("at least 2 captures are needed\n");
+		usage(argv[0]);
+		return 2;
+	}
+
+	images_pp = calloc((size_t)(argc - optind), sizeof(*images_pp));
+	if (images_pp == NULL) {
+		perror("calloc()");
+		return 2;
+	}
+	for (; optind<argc; ++optind) {
+		if (strcmp(argv[optind], "-") == 0)
+			fd = STDIN_FILENO;
+		else {
+			fd = open(argv[optind], O_RDONLY);
+			if (fd == -1) {
+				perror(argv[optind]);
+				goto out;
+			}
+		}
+		images_pp[cnt] = lpc32x0__image_new(argv[optind]);
+		if (images_pp[cnt] == NULL) {
+			close(fd);
+			goto out;
+		}
+		++cnt;
+		if (!lpc32x0__image_load(images_pp[cnt-1], fd)) {
+			printf("can't load '%s'\n", argv[optind]);
+			close(fd);
+			goto out;
+		}
+		if (fd != STDIN_FILENO)
+			close(fd);
+	}
+
+	diffs = lpc32x0__diff_images(images_pp, cnt, fields);
+	printf("%zu register%s differ%s across %zu captures\n",
+			diffs, (diffs == 1)? "" : "s", (diffs == 1)? "s" : "", cnt);
+	ret = (diffs == 0)? 0 : 1;
+
+out:
+	for (i=0; i<cnt; ++i)
+		lpc32x0__image_free(images_pp[i]);
+	free(images_pp);
+	return ret;
+}
+
+static void
+usage (char *pgm_p)
+{
+	printf("usage:\n");
+	if (pgm_p != NULL)
+		printf("%s [<options>] <capture> <capture> [<capture>...]\n", pgm_p);
+	printf("  where:\n");
+	printf("    options:\n");
+	printf("      -h|--help    print usage information and exit successfully\n");
+	printf("      -q|--quiet   only list the values that differ, not the fields\n");
+	printf("    <capture>      a file in any format lpc32x0-offline understands\n");
+	printf("                   (or a binary snapshot), '-' for stdin\n");
+	printf("  exits with 0 if the captures agree, 1 if they differ, 2 on error\n");
+}
@@ -10,6 +10,8 @@
 #include <stdbool.h>
 #include <inttypes.h>
 #include <errno.h>
+#include <time.h>
+#include <signal.h>
 #include <unistd.h>
 #include <getopt.h>
 
@@ -19,6 +21,16 @@ extern AllRegisters_t AllRegisters_G[];
 extern size_t AllRegistersSZ;
 
 static void usage(char *pgm_p);
+static bool add_set (char *setName_p, bool watching);
+static bool add_reg (uint32_t addr);
+static int write_raw (char *rawFile_p);
+static int watch (double interval, unsigned long count, bool verbose);
+static int check_sdram (const char *part_p, uint64_t oscHz);
+
+// registers collected for --raw and --watch
+static RegValue_t *raw_pG = NULL;
+static size_t rawCnt_G = 0;
+static size_t rawMax_G = 0;
 
 int
 main (int argc, char *argv[])
@@ -28,19 +40,40 @@ main (int argc, char *argv[])
 	char *nextTok_p;
 	char *regSet_p = NULL;
 	char *reg_p = NULL;
+	char *rawFile_p = NULL;
+	bool collect = false;
+	bool doWatch = false;
+	double interval = 0;
+	unsigned long count = 0;
+	bool doCount = false;
 	bool doSet = false;
 	bool doReg = false;
 	bool verbose = false;
+	bool doClocks = false;
+	bool doSdram = false;
+	char *part_p = NULL;
+	uint64_t oscHz = 0;
+	size_t i;
 	struct option longOpts[] = {
 		{"verbose", no_argument, NULL, 'v'},
 		{"help", no_argument, NULL, 'h'},
 		{"set", required_argument, NULL, 's'},
 		{"reg", required_argument, NULL, 'r'},
+		{"raw", required_argument, NULL, 'R'},
+		{"watch", required_argument, NULL, 'w'},
+		{"count", required_argument, NULL, 'c'},
+		{"stats", no_argument, NULL, 'S'},
+		{"clocks", no_argument, NULL, 'C'},
+		{"osc", required_argument, NULL, 'o'},
+		{"sdram", no_argument, NULL, 'D'},
+		{"part", required_argument, NULL, 'p'},
 		{NULL, 0, NULL, 0},
 	};
 
+	lpc32x0__buffer_output();
+
 	while (1) {
-		c = getopt_long(argc, argv, "vhs:r:", longOpts, NULL);
+		c = getopt_long(argc, argv, "vhs:r:R:w:c:SCo:Dp:", longOpts, NULL);
 		if (c == -1)
 			break;
 		switch (c) {
@@ -67,9 +100,67 @@ main (int argc, char *argv[])
 					return -1;
 				}
 				break;
+
+			case 'R':
+				rawFile_p = optarg;
+				break;
+
+			case 'w':
+				doWatch = true;
+				if ((sscanf(optarg, "%lf", &interval) != 1) || (interval < 0)) {
+					printf("can't convert '%s' to an interval\n", optarg);
+					return -1;
+				}
+				break;
+
+			case 'c':
+				doCount = true;
+				if (sscanf(optarg, "%lu", &count) != 1) {
+					printf("can't convert '%s' to a sample count\n", optarg);
+					return -1;
+				}
+				break;
+
+			case 'S':
+				if (!lpc32x0__stats_start("-"))
+					return -1;
+				break;
+
+			case 'C':
+				doClocks = true;
+				break;
+
+			case 'o':
+				if ((sscanf(optarg, "%" SCNu64, &oscHz) != 1) || (oscHz == 0)) {
+					printf("can't convert '%s' to a frequency\n", optarg);
+					return -1;
+				}
+				break;
+
+			case 'D':
+				doSdram = true;
+				break;
+
+			case 'p':
+				part_p = optarg;
+				break;
 		}
 	}
 
+	if (doWatch && (rawFile_p != NULL)) {
+		printf("--raw and --watch can't be used together\n");
+		return -1;
+	}
+	if (doCount && !doWatch) {
+		printf("--count can only be used with --watch\n");
+		return -1;
+	}
+	collect = doWatch || (rawFile_p != NULL);
+	if ((doClocks || doSdram) && collect) {
+		printf("--clocks and --sdram can't be used with --raw or --watch\n");
+		return -1;
+	}
+
 	if (doSet) {
 		if (regSet_p == NULL) {
 			printf("internal error\n");
@@ -78,7 +169,12 @@ main (int argc, char *argv[])
 
 		nextTok_p = strtok(regSet_p, " ,");
 		while (nextTok_p != NULL) {
-			lpc32x0__get_and_print_reg_set_by_name(nextTok_p, verbose);
+			if (collect) {
+				if (!add_set(nextTok_p, doWatch))
+					goto badexit;
+			}
+			else
+				lpc32x0__get_and_print_reg_set_by_name(nextTok_p, verbose);
 			nextTok_p = strtok(NULL, " ,");
 		}
 	}
@@ -98,19 +194,52 @@ main (int argc, char *argv[])
 				printf("can't convert '%s' to register\n", nextTok_p);
 			else {
 				addr = (uint32_t)tmp;
-				if (lpc32x0__get_reg(addr, &val))
+				if (collect) {
+					if (!add_reg(addr))
+						goto badexit;
+				}
+				else if (lpc32x0__get_reg(addr, &val))
 					lpc32x0__print_reg(addr, val, true);
 			}
 			nextTok_p = strtok(NULL, " ,");
 		}
 	}
 
+	if (doClocks) {
+		Clocks_t clocks;
+
+		if (!lpc32x0__get_clocks(oscHz, &clocks)) {
+			printf("can't read the clock registers\n");
+			goto badexit;
+		}
+		lpc32x0__print_clocks(&clocks);
+	}
+
+	if (doSdram) {
+		retVal = check_sdram(part_p, oscHz);
+		if (retVal != 0)
+			goto badexit;
+	}
+
 	// dump all registers
-	if ((!doSet) && (!doReg))
-		lpc32x0__get_and_print_all_regs(verbose);
+	if ((!doSet) && (!doReg) && (!doClocks) && (!doSdram)) {
+		if (collect) {
+			for (i=0; i<AllRegistersSZ; ++i)
+				if (!add_set(AllRegisters_G[i].name_p, doWatch))
+					goto badexit;
+		}
+		else
+			lpc32x0__get_and_print_all_regs(verbose);
+	}
 
-	retVal = 0;
+	if (rawFile_p != NULL)
+		retVal = write_raw(rawFile_p);
+	else if (doWatch)
+		retVal = watch(interval, count, verbose);
+	else
+		retVal = 0;
 badexit:
+	free(raw_pG);
 	if (regSet_p != NULL)
 		free(regSet_p);
 	if (reg_p != NULL)
@@ -121,7 +250,8 @@ badexit:
 static void
 usage (char *pgm_p)
 {
-	size_t i;
+	size_t i, partCnt;
+	const SdramPart_t *parts_p;
 
 	printf("usage:\n");
 	if (pgm_p != NULL)
@@ -132,7 +262,277 @@ usage (char *pgm_p)
 	printf("      -v|--verbose   print register value and sub-field values\n");
 	printf("      -r|--reg <reg> specify register(s) by address\n");
 	printf("      -s|--set <set> specify set(s) of registers by name\n");
+	printf("      -R|--raw <file> don't decode anything, write a binary snapshot of\n");
+	printf("                     the selected registers to <file> (see lpc32x0-offline)\n");
+	printf("      -w|--watch <s> sample the selected registers every <s> seconds\n");
+	printf("                     (e.g. 0.001, 0 for as fast as possible) and print\n");
+	printf("                     the ones that change, until interrupted\n");
+	printf("      -c|--count <n> with --watch, stop after <n> samples\n");
+	printf("      -S|--stats     print per-register access statistics at exit\n");
+	printf("      -C|--clocks    print the frequency of every clock in the clock tree\n");
+	printf("      -o|--osc <Hz>  with --clocks or --sdram, the main oscillator's frequency\n");
+	printf("                     (default: %" PRIu64 ")\n", lpc32x0__osc_hz());
+	printf("      -D|--sdram     print the SDRAM timings in ns\n");
+	printf("      -p|--part <p>  with --sdram, check the timings against SDRAM part <p>,\n");
+	printf("                     a file or one of:\n");
+	parts_p = lpc32x0__sdram_parts(&partCnt);
+	for (i=0; i<partCnt; ++i)
+		printf("                       %s\n", parts_p[i].name);
 	printf("      register set names are:\n");
 	for (i=0; i<AllRegistersSZ; ++i)
 		printf("        %s\n", AllRegisters_G[i].name_p);
 }
+
+static bool
+grow_raw (size_t extra)
+{
+	size_t max;
+	RegValue_t *tmp_p;
+
+	if ((rawCnt_G + extra) <= rawMax_G)
+		return true;
+	max = rawMax_G? rawMax_G : 256;
+	while (max < (rawCnt_G + extra))
+		max *= 2;
+	tmp_p = realloc(raw_pG, max * sizeof(*raw_pG));
+	if (tmp_p == NULL) {
+		perror("realloc()");
+		return false;
+	}
+	raw_pG = tmp_p;
+	rawMax_G = max;
+	return true;
+}
+
+/*
+ * a set to be watched is only collected, watch() reads it; its data and
+ * FIFO registers are left out, sampling them would take the data from
+ * whatever is using them, so they have to be named with --reg
+ */
+static bool
+add_set (char *setName_p, bool watching)
+{
+	size_t i, j;
+	ssize_t cnt;
+	const RegisterDescription_t *reg_p;
+
+	for (i=0; i<AllRegistersSZ; ++i) {
+		if (strcmp(AllRegisters_G[i].name_p, setName_p) != 0)
+			continue;
+		if (!grow_raw(*(AllRegisters_G[i].sz_p)))
+			return false;
+		if (watching) {
+			for (j=0; j<*(AllRegisters_G[i].sz_p); ++j) {
+				reg_p = &AllRegisters_G[i].reg_p[j];
+				if (reg_p->access & accessPop) {
+					printf("not watching %s, reading it takes its data (name it with --reg)\n", reg_p->name_p);
+					continue;
+				}
+				raw_pG[rawCnt_G].addr = reg_p->addr;
+				raw_pG[rawCnt_G].val = 0;
+				++rawCnt_G;
+			}
+			return true;
+		}
+		cnt = lpc32x0__read_reg_set(setName_p, &raw_pG[rawCnt_G], rawMax_G - rawCnt_G);
+		if (cnt < 0) {
+			printf("can't read set '%s'\n", setName_p);
+			return false;
+		}
+		rawCnt_G += (size_t)cnt;
+		return true;
+	}
+	printf("unknown set '%s'\n", setName_p);
+	return false;
+}
+
+static bool
+add_reg (uint32_t addr)
+{
+	uint32_t val;
+
+	if (!lpc32x0__get_reg(addr, &val)) {
+		printf("can't get register at addr 0x%08x\n", addr);
+		return true;
+	}
+	if (!grow_raw(1))
+		return false;
+	raw_pG[rawCnt_G].addr = addr;
+	raw_pG[rawCnt_G].val = val;
+	++rawCnt_G;
+	return true;
+}
+
+static int
+write_raw (char *rawFile_p)
+{
+	FILE *file_p;
+
+	file_p = fopen(rawFile_p, "wb");
+	if (file_p == NULL) {
+		perror(rawFile_p);
+		return -1;
+	}
+	if (!lpc32x0__write_snapshot(file_p, raw_pG, rawCnt_G)) {
+		printf("can't write snapshot to %s\n", rawFile_p);
+		fclose(file_p);
+		return -1;
+	}
+	if (fclose(file_p) != 0) {
+		perror(rawFile_p);
+		return -1;
+	}
+	return 0;
+}
+
+static volatile sig_atomic_t stop_G = 0;
+
+static void
+stop_watching (unused int sig)
+{
+	stop_G = 1;
+}
+
+// a register that changed during a sample, decoded once the sample is done
+typedef struct {
+	uint64_t ns;
+	size_t idx;
+	uint32_t before;
+	uint32_t after;
+} WatchChange_t;
+
+/*
+ * the collected registers are resolved to handles, which keeps their pages
+ * mapped, then sampled on a fixed schedule; a sample that runs past the
+ * next deadline counts the deadlines it missed and the schedule skips ahead
+ * rather than trying to catch up
+ * a sample only reads the registers and records what changed, so the reads
+ * stay close together; the changes are decoded and printed after it
+ */
+static int
+watch (double interval, unsigned long count, bool verbose)
+{
+	size_t i, cnt, changed;
+	uint32_t val;
+	uint64_t start, now, next, period, late;
+	unsigned long samples = 0, missed = 0, changes = 0;
+	double elapsed;
+	RegHandle_t *handles_p;
+	WatchChange_t *changes_p;
+	struct timespec ts;
+	struct sigaction sa;
+
+	handles_p = malloc((rawCnt_G? rawCnt_G : 1) * sizeof(*handles_p));
+	changes_p = malloc((rawCnt_G? rawCnt_G : 1) * sizeof(*changes_p));
+	if ((handles_p == NULL) || (changes_p == NULL)) {
+		perror("malloc()");
+		free(handles_p);
+		free(changes_p);
+		return -1;
+	}
+	cnt = 0;
+	for (i=0; i<rawCnt_G; ++i) {
+		if (!lpc32x0__resolve_reg(raw_pG[i].addr, &handles_p[cnt])) {
+			printf("can't map register at addr 0x%08x\n", raw_pG[i].addr);
+			free(handles_p);
+			free(changes_p);
+			return -1;
+		}
+		if ((handles_p[cnt].access & accessRead) == 0)
+			continue;
+		raw_pG[cnt].addr = raw_pG[i].addr;
+		raw_pG[cnt].val = lpc32x0__read(&handles_p[cnt]);
+		lpc32x0__print_reg(raw_pG[cnt].addr, raw_pG[cnt].val, verbose);
+		++cnt;
+	}
+	printf("watching %zu registers every %g s\n", cnt, interval);
+	fflush(stdout);
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = stop_watching;
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+
+	period = (uint64_t)(interval * 1e9);
+	start = next = lpc32x0__now_ns();
+	while (!stop_G && ((count == 0) || (samples < count))) {
+		if (period != 0) {
+			next += period;
+			now = lpc32x0__now_ns();
+			if (now > next) {
+				// skip the deadlines this sample already ran past
+				late = ((now - next) / period) + 1;
+				missed += late;
+				next += late * period;
+			}
+			ts.tv_sec = (time_t)(next / 1000000000ull);
+			ts.tv_nsec = (long)(next % 1000000000ull);
+			while ((clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) && !stop_G)
+				;
+			if (stop_G)
+				break;
+		}
+
+		++samples;
+		changed = 0;
+		for (i=0; i<cnt; ++i) {
+			val = lpc32x0__read(&handles_p[i]);
+			if (val == raw_pG[i].val)
+				continue;
+			changes_p[changed].ns = lpc32x0__now_ns();
+			changes_p[changed].idx = i;
+			changes_p[changed].before = raw_pG[i].val;
+			changes_p[changed].after = val;
+			++changed;
+			raw_pG[i].val = val;
+		}
+		if (changed == 0)
+			continue;
+
+		changes += changed;
+		for (i=0; i<changed; ++i) {
+			printf("[%12.6f] 0x%08x %-15s 0x%08x -> 0x%08x\n",
+					(double)(changes_p[i].ns - start) / 1e9,
+					raw_pG[changes_p[i].idx].addr,
+					handles_p[changes_p[i].idx].desc_p->name_p,
+					changes_p[i].before, changes_p[i].after);
+			lpc32x0__print_field_delta(handles_p[changes_p[i].idx].desc_p,
+					changes_p[i].before, changes_p[i].after);
+		}
+		fflush(stdout);
+	}
+
+	elapsed = (double)(lpc32x0__now_ns() - start) / 1e9;
+	printf("%lu samples in %.3f s (%.1f samples/s), %lu changes, %lu missed deadlines\n",
+			samples, elapsed, (elapsed > 0)? (double)samples / elapsed : 0.0,
+			changes, missed);
+	free(handles_p);
+	free(changes_p);
+	return 0;
+}
+
+/*
+ * returns 1 if any of the timings violates the part's, -1 on error
+ */
+static int
+check_sdram (const char *part_p, uint64_t oscHz)
+{
+	Clocks_t clocks;
+	SdramRegs_t regs;
+	SdramPart_t part;
+	const SdramPart_t *found_p = NULL;
+
+	if (part_p != NULL) {
+		found_p = lpc32x0__find_sdram_part(part_p);
+		if (found_p == NULL) {
+			if (!lpc32x0__load_sdram_part(part_p, &part))
+				return -1;
+			found_p = &part;
+		}
+	}
+	if (!lpc32x0__get_clocks(oscHz, &clocks) || !lpc32x0__get_sdram_regs(&regs)) {
+		printf("can't read the clock and EMC registers\n");
+		return -1;
+	}
+	return (lpc32x0__check_sdram(&regs, &clocks, found_p) != 0)? 1 : 0;
+}
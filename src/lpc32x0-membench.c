@@ -0,0 +1,511 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * memory bandwidth and latency
+ *
+ * each region is mapped like the registers are (/dev/mem, see backend.c)
+ * and timed with:
+ *   read     summing every word
+ *   write    storing every word
+ *   copy     copying the first half of the region to the second half
+ *   latency  following a chain of pointers, one per MEMBENCH_STRIDE bytes,
+ *            in a random order so neither the cache nor the SDRAM's open
+ *            rows help
+ * each test runs 'loops' times and the fastest pass is reported
+ *
+ * /dev/mem maps memory the kernel doesn't manage (e.g. SDRAM past mem=)
+ * uncached, so those numbers are what the EMC itself does; memory the
+ * kernel does manage can't be mapped at all on most kernels
+ * every test but the read test overwrites the region
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+#include <getopt.h>
+
+#include "registers.h"
+
+#define MEMBENCH_SIZE   (1024 * 1024)
+#define MEMBENCH_LOOPS  8
+#define MEMBENCH_STRIDE 32 // the ARM926's cache line
+
+#define EMC_DYNAMIC_READCONFIG 0x31080028
+#define EMC_DYNAMIC_CONFIG(cs) (0x31080100 + ((cs) * 0x20))
+#define EMC_DYNAMIC_RASCAS(cs) (0x31080104 + ((cs) * 0x20))
+#define EMC_STATIC_CONFIG(cs)  (0x31080200 + ((cs) * 0x20))
+#define EMC_STATIC_REGS        7 // EMCStaticConfig<n> ... EMCStaticWaitTurn<n>
+
+typedef enum {
+	regionIram,
+	regionDynamic,
+	regionStatic,
+	regionOther,
+} RegionKind_e;
+
+typedef struct {
+	const char *name_p;
+	uint32_t base;
+	uint32_t size; // 0 if it isn't known
+	RegionKind_e kind;
+	unsigned cs;
+} Region_t;
+
+/*
+ * iram is the 128KiB every part has, the LPC3250's other 128KiB can be given
+ * as an address
+ */
+static const Region_t regions_G[] = {
+	{"iram", IRAM_BASE, IRAM_SIZE / 2, regionIram, 0},
+	{"sdram0", SDRAM_BASE, SDRAM_SIZE / 2, regionDynamic, 0},
+	{"sdram1", SDRAM_BASE + (SDRAM_SIZE / 2), SDRAM_SIZE / 2, regionDynamic, 1},
+	{"cs0", 0xe0000000, 0x1000000, regionStatic, 0},
+	{"cs1", 0xe1000000, 0x1000000, regionStatic, 1},
+	{"cs2", 0xe2000000, 0x1000000, regionStatic, 2},
+	{"cs3", 0xe3000000, 0x1000000, regionStatic, 3},
+};
+#define REGIONS (sizeof(regions_G)/sizeof(regions_G[0]))
+
+typedef struct {
+	double readMBs;
+	double writeMBs;
+	double copyMBs;
+	double latencyNs;
+} Result_t;
+
+static void usage (char *pgm_p);
+static bool parse_region (const char *arg_p, Region_t *region_p, uint32_t *addr_p);
+static bool parse_size (const char *arg_p, size_t *size_p);
+static bool clamp_size (const Region_t *region_p, uint32_t addr, size_t *size_p);
+static void print_config (const Region_t *region_p, const Clocks_t *clk_p, bool verbose);
+static bool bench_region (uint32_t addr, size_t size, unsigned loops, bool readOnly, Result_t *res_p);
+
+// keeps the compiler from optimizing the reads away
+static volatile uint32_t sink_G;
+
+int
+main (int argc, char *argv[])
+{
+	int c, i, ret = 0;
+	bool readOnly = true, verbose = false, quiet = false;
+	unsigned loops = MEMBENCH_LOOPS;
+	size_t size = MEMBENCH_SIZE, regionSize;
+	uint64_t oscHz = 0;
+	uint32_t addr;
+	Region_t region;
+	Clocks_t clocks;
+	Result_t res;
+	struct option longOpts[] = {
+		{"help", no_argument, NULL, 'h'},
+		{"size", required_argument, NULL, 's'},
+		{"loops", required_argument, NULL, 'l'},
+		{"write", no_argument, NULL, 'W'},
+		{"osc", required_argument, NULL, 'o'},
+		{"verbose", no_argument, NULL, 'v'},
+		{"quiet", no_argument, NULL, 'q'},
+		{NULL, 0, NULL, 0},
+	};
+
+	lpc32x0__buffer_output();
+
+	while (1) {
+		c = getopt_long(argc, argv, "hs:l:Wo:vq", longOpts, NULL);
+		if (c == -1)
+			break;
+		switch (c) {
+			case 'h':
+				usage(argv[0]);
+				return 0;
+			case 's':
+				if (!parse_size(optarg, &size))
+					return 1;
+				break;
+			case 'l':
+				if ((sscanf(optarg, "%u", &loops) != 1) || (loops == 0)) {
+					printf("can't convert '%s' to a loop count\n", optarg);
+					return 1;
+				}
+				break;
+			case 'W':
+				readOnly = false;
+				break;
+			case 'o':
+				if ((sscanf(optarg, "%" SCNu64, &oscHz) != 1) || (oscHz == 0)) {
+					printf("can't convert '%s' to a frequency\n", optarg);
+					return 1;
+				}
+				break;
+			case 'v':
+				verbose = true;
+				break;
+			case 'q':
+				quiet = true;
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+
+	if (optind == argc) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	if (!quiet) {
+		if (!lpc32x0__get_clocks(oscHz, &clocks))
+			return 1;
+		lpc32x0__print_clocks(&clocks);
+	}
+
+	for (i=optind; i<argc; ++i) {
+		if (!parse_region(argv[i], &region, &addr))
+			return 1;
+		regionSize = size;
+		if (!clamp_size(&region, addr, &regionSize)) {
+			ret = 1;
+			continue;
+		}
+		if (!quiet) {
+			printf("\n");
+			print_config(&region, &clocks, verbose);
+		}
+		if (!bench_region(addr, regionSize, loops, readOnly, &res)) {
+			ret = 1;
+			continue;
+		}
+		printf("%s 0x%08x, %zu bytes, best of %u:\n", region.name_p, addr, regionSize, loops);
+		printf("  read    %10.2f MB/s\n", res.readMBs);
+		if (readOnly)
+			continue;
+		printf("  write   %10.2f MB/s\n", res.writeMBs);
+		printf("  copy    %10.2f MB/s\n", res.copyMBs);
+		printf("  latency %10.2f ns\n", res.latencyNs);
+	}
+	return ret;
+}
+
+static void
+usage (char *pgm_p)
+{
+	size_t i;
+
+	printf("usage:\n");
+	if (pgm_p != NULL)
+		printf("%s [<options>] <region>[+<offset>] ...\n", pgm_p);
+	printf("  where:\n");
+	printf("    options:\n");
+	printf("      -h|--help         print usage information and exit successfully\n");
+	printf("      -s|--size <n>     bytes of each region to use, with an optional k or M\n");
+	printf("                        suffix (default: %dM, or up to the region's end)\n", MEMBENCH_SIZE / (1024 * 1024));
+	printf("      -l|--loops <n>    passes of each test, the fastest is reported\n");
+	printf("                        (default: %d)\n", MEMBENCH_LOOPS);
+	printf("      -W|--write        also run the write, copy and latency tests, which\n");
+	printf("                        overwrite the memory (default: only read it)\n");
+	printf("      -o|--osc <Hz>     the main oscillator's frequency (default: %" PRIu64 ")\n", lpc32x0__osc_hz());
+	printf("      -v|--verbose      decode the EMC registers' fields\n");
+	printf("      -q|--quiet        don't print the clocks and EMC configuration\n");
+	printf("    <region>            one of:\n");
+	for (i=0; i<REGIONS; ++i)
+		printf("                          %-7s 0x%08x %6uKiB\n", regions_G[i].name_p, regions_G[i].base, regions_G[i].size / 1024);
+	printf("                        or a physical address\n");
+	printf("    <offset>            where to start in the region (page aligned)\n");
+	printf("  with -W the memory is overwritten, make sure nothing (e.g. Linux) is using it\n");
+}
+
+static bool
+parse_region (const char *arg_p, Region_t *region_p, uint32_t *addr_p)
+{
+	size_t i, len;
+	unsigned long val;
+	char *end_p;
+	const char *plus_p;
+
+	plus_p = strchr(arg_p, '+');
+	len = (plus_p != NULL)? (size_t)(plus_p - arg_p) : strlen(arg_p);
+	for (i=0; i<REGIONS; ++i)
+		if ((strlen(regions_G[i].name_p) == len) && (strncmp(regions_G[i].name_p, arg_p, len) == 0))
+			break;
+	if (i < REGIONS)
+		*region_p = regions_G[i];
+	else {
+		val = strtoul(arg_p, &end_p, 0);
+		if ((end_p != arg_p + len) || (len == 0) || (val > 0xffffffffUL)) {
+			printf("unknown region '%s'\n", arg_p);
+			return false;
+		}
+		region_p->name_p = "memory";
+		region_p->base = (uint32_t)val;
+		region_p->size = 0;
+		region_p->kind = regionOther;
+		region_p->cs = 0;
+	}
+
+	*addr_p = region_p->base;
+	if (plus_p != NULL) {
+		val = strtoul(plus_p + 1, &end_p, 0);
+		if ((*end_p != 0) || (plus_p[1] == 0) || (val > (0xffffffffUL - region_p->base))) {
+			printf("can't convert '%s' to an offset\n", plus_p + 1);
+			return false;
+		}
+		*addr_p += (uint32_t)val;
+	}
+	return true;
+}
+
+static bool
+parse_size (const char *arg_p, size_t *size_p)
+{
+	unsigned long val;
+	char *end_p;
+
+	val = strtoul(arg_p, &end_p, 0);
+	if ((*end_p == 'k') || (*end_p == 'K')) {
+		val *= 1024;
+		++end_p;
+	}
+	else if (*end_p == 'M') {
+		val *= 1024 * 1024;
+		++end_p;
+	}
+	// the copy test needs two halves holding a whole number of unrolled loops
+	if ((*end_p != 0) || (val < (2 * MEMBENCH_STRIDE)) || ((val % (2 * MEMBENCH_STRIDE)) != 0)) {
+		printf("can't use '%s' as a size (a multiple of %d bytes)\n", arg_p, 2 * MEMBENCH_STRIDE);
+		return false;
+	}
+	*size_p = val;
+	return true;
+}
+
+/*
+ * don't run off the end of a named region: a size that doesn't fit is cut
+ * down to what's left of it past 'addr'
+ */
+static bool
+clamp_size (const Region_t *region_p, uint32_t addr, size_t *size_p)
+{
+	size_t left;
+
+	if (region_p->size == 0)
+		return true;
+	left = 0;
+	if ((addr - region_p->base) < region_p->size)
+		left = region_p->size - (addr - region_p->base);
+	left -= left % (2 * MEMBENCH_STRIDE);
+	if (left == 0) {
+		printf("0x%08x is past the end of %s\n", addr, region_p->name_p);
+		return false;
+	}
+	if (*size_p > left) {
+		printf("%s: only %zu bytes past 0x%08x, using those\n", region_p->name_p, left, addr);
+		*size_p = left;
+	}
+	return true;
+}
+
+static void
+print_reg (uint32_t addr, bool verbose)
+{
+	uint32_t val;
+
+	if (lpc32x0__get_reg(addr, &val))
+		lpc32x0__print_reg(addr, val, verbose);
+}
+
+/*
+ * what the numbers depend on: the SDRAM timings for a dynamic chip select,
+ * the wait states for a static one
+ */
+static void
+print_config (const Region_t *region_p, const Clocks_t *clk_p, bool verbose)
+{
+	unsigned i;
+	SdramRegs_t sdram;
+
+	switch (region_p->kind) {
+		case regionDynamic:
+			printf("%s configuration:\n", region_p->name_p);
+			print_reg(EMC_DYNAMIC_CONFIG(region_p->cs), verbose);
+			print_reg(EMC_DYNAMIC_RASCAS(region_p->cs), verbose);
+			print_reg(EMC_DYNAMIC_READCONFIG, verbose);
+			if (lpc32x0__get_sdram_regs(&sdram))
+				lpc32x0__check_sdram(&sdram, clk_p, NULL);
+			break;
+		case regionStatic:
+			printf("%s configuration:\n", region_p->name_p);
+			for (i=0; i<EMC_STATIC_REGS; ++i)
+				print_reg(EMC_STATIC_CONFIG(region_p->cs) + (i * 4), verbose);
+			break;
+		default:
+			break;
+	}
+}
+
+static uint64_t
+time_read (volatile uint32_t *mem_p, size_t words)
+{
+	size_t i;
+	uint32_t sum = 0;
+	uint64_t t0;
+
+	t0 = lpc32x0__now_ns();
+	for (i=0; i<words; i+=8)
+		sum += mem_p[i] + mem_p[i+1] + mem_p[i+2] + mem_p[i+3]
+			+ mem_p[i+4] + mem_p[i+5] + mem_p[i+6] + mem_p[i+7];
+	t0 = lpc32x0__now_ns() - t0;
+	sink_G = sum;
+	return t0;
+}
+
+static uint64_t
+time_write (volatile uint32_t *mem_p, size_t words, uint32_t val)
+{
+	size_t i;
+	uint64_t t0;
+
+	t0 = lpc32x0__now_ns();
+	for (i=0; i<words; i+=8) {
+		mem_p[i] = val;
+		mem_p[i+1] = val;
+		mem_p[i+2] = val;
+		mem_p[i+3] = val;
+		mem_p[i+4] = val;
+		mem_p[i+5] = val;
+		mem_p[i+6] = val;
+		mem_p[i+7] = val;
+	}
+	return lpc32x0__now_ns() - t0;
+}
+
+static uint64_t
+time_copy (volatile uint32_t *dst_p, volatile uint32_t *src_p, size_t words)
+{
+	size_t i;
+	uint64_t t0;
+
+	t0 = lpc32x0__now_ns();
+	for (i=0; i<words; i+=8) {
+		dst_p[i] = src_p[i];
+		dst_p[i+1] = src_p[i+1];
+		dst_p[i+2] = src_p[i+2];
+		dst_p[i+3] = src_p[i+3];
+		dst_p[i+4] = src_p[i+4];
+		dst_p[i+5] = src_p[i+5];
+		dst_p[i+6] = src_p[i+6];
+		dst_p[i+7] = src_p[i+7];
+	}
+	return lpc32x0__now_ns() - t0;
+}
+
+static uint32_t
+xorshift (uint32_t *state_p)
+{
+	*state_p ^= *state_p << 13;
+	*state_p ^= *state_p >> 17;
+	*state_p ^= *state_p << 5;
+	return *state_p;
+}
+
+/*
+ * one link per stride, each holding the word index of the next, visiting
+ * every link once in a random (but repeatable) order
+ */
+static bool
+make_chain (volatile uint32_t *mem_p, size_t links)
+{
+	size_t i, j;
+	uint32_t tmp, seed = 0x2545f491;
+	uint32_t *order_p;
+
+	order_p = malloc(links * sizeof(*order_p));
+	if (order_p == NULL) {
+		perror("malloc()");
+		return false;
+	}
+	for (i=0; i<links; ++i)
+		order_p[i] = (uint32_t)i;
+	for (i=links-1; i>0; --i) {
+		j = xorshift(&seed) % (i + 1);
+		tmp = order_p[i];
+		order_p[i] = order_p[j];
+		order_p[j] = tmp;
+	}
+	for (i=0; i<links; ++i)
+		mem_p[order_p[i] * (MEMBENCH_STRIDE / 4)] = order_p[(i + 1) % links] * (MEMBENCH_STRIDE / 4);
+	free(order_p);
+	return true;
+}
+
+static uint64_t
+time_chase (volatile uint32_t *mem_p, size_t links)
+{
+	size_t i;
+	uint32_t idx = 0;
+	uint64_t t0;
+
+	t0 = lpc32x0__now_ns();
+	for (i=0; i<links; ++i)
+		idx = mem_p[idx];
+	t0 = lpc32x0__now_ns() - t0;
+	sink_G = idx;
+	return t0;
+}
+
+static double
+mb_per_s (size_t bytes, uint64_t ns)
+{
+	return ns? ((double)bytes * 1e3) / (double)ns : 0.0;
+}
+
+static bool
+bench_region (uint32_t addr, size_t size, unsigned loops, bool readOnly, Result_t *res_p)
+{
+	unsigned loop;
+	size_t words = size / 4;
+	uint64_t ns, best[4] = {UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX};
+	volatile uint32_t *mem_p;
+
+	mem_p = lpc32x0__map_mem(addr, size);
+	if (mem_p == NULL)
+		return false;
+
+	for (loop=0; loop<loops; ++loop) {
+		ns = time_read(mem_p, words);
+		if (ns < best[0])
+			best[0] = ns;
+		if (readOnly)
+			continue;
+		ns = time_write(mem_p, words, loop);
+		if (ns < best[1])
+			best[1] = ns;
+		ns = time_copy(mem_p + (words / 2), mem_p, words / 2);
+		if (ns < best[2])
+			best[2] = ns;
+	}
+
+	if (!readOnly) {
+		if (!make_chain(mem_p, size / MEMBENCH_STRIDE)) {
+			lpc32x0__unmap_mem((void*)mem_p, size);
+			return false;
+		}
+		for (loop=0; loop<loops; ++loop) {
+			ns = time_chase(mem_p, size / MEMBENCH_STRIDE);
+			if (ns < best[3])
+				best[3] = ns;
+		}
+	}
+	lpc32x0__unmap_mem((void*)mem_p, size);
+
+	res_p->readMBs = mb_per_s(size, best[0]);
+	res_p->writeMBs = mb_per_s(size, best[1]);
+	res_p->copyMBs = mb_per_s(size / 2, best[2]);
+	res_p->latencyNs = (double)best[3] / (double)(size / MEMBENCH_STRIDE);
+	return true;
+}
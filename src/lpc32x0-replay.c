@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+
+#include "registers.h"
+
+typedef struct {
+	const RegisterDescription_t *reg_p;
+	unsigned long reads;
+	unsigned long writes;
+	uint64_t ns;
+} Profile_t;
+
+static void usage (char *pgm_p);
+static void print_trace (const TraceRecord_t *recs_p, size_t cnt);
+static int profile (const TraceRecord_t *recs_p, size_t cnt);
+static int replay (const TraceRecord_t *recs_p, size_t cnt, bool timing, bool check, bool writesOnly);
+
+int
+main (int argc, char *argv[])
+{
+	int c, ret;
+	bool doPrint = false, doProfile = false;
+	bool timing = false, check = false, writesOnly = false;
+	size_t cnt;
+	uint64_t when;
+	time_t whenT;
+	FILE *file_p;
+	TraceRecord_t *recs_p;
+	struct option longOpts[] = {
+		{"help", no_argument, NULL, 'h'},
+		{"print", no_argument, NULL, 'p'},
+		{"summary", no_argument, NULL, 's'},
+		{"timing", no_argument, NULL, 't'},
+		{"check", no_argument, NULL, 'c'},
+		{"writes-only", no_argument, NULL, 'w'},
+		{"stats", no_argument, NULL, 'S'},
+		{NULL, 0, NULL, 0},
+	};
+
+	lpc32x0__buffer_output();
+
+	while (1) {
+		c = getopt_long(argc, argv, "hpstcwS", longOpts, NULL);
+		if (c == -1)
+			break;
+		switch (c) {
+			case 'h':
+				usage(argv[0]);
+				return 0;
+			case 'p':
+				doPrint = true;
+				break;
+			case 's':
+				doProfile = true;
+				break;
+			case 't':
+				timing = true;
+				break;
+			case 'c':
+				check = true;
+				break;
+			case 'w':
+				writesOnly = true;
+				break;
+			case 'S':
+				if (!lpc32x0__stats_start("-"))
+					return 1;
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+
+	if ((argc - optind) != 1) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	if (strcmp(argv[optind], "-") == 0)
+		file_p = stdin;
+	else {
+		file_p = fopen(argv[optind], "rb");
+		if (file_p == NULL) {
+			perror(argv[optind]);
+			return 1;
+		}
+	}
+	recs_p = lpc32x0__read_trace(file_p, &cnt, &when);
+	if (file_p != stdin)
+		fclose(file_p);
+	if (recs_p == NULL)
+		return 1;
+
+	whenT = (time_t)when;
+	printf("trace started %s", ctime(&whenT));
+	printf("%zu accesses over %.6f s\n", cnt, cnt? (double)recs_p[cnt-1].ns / 1e9 : 0.0);
+
+	if (doPrint || doProfile) {
+		if (doPrint)
+			print_trace(recs_p, cnt);
+		ret = doProfile? profile(recs_p, cnt) : 0;
+	}
+	else
+		ret = replay(recs_p, cnt, timing, check, writesOnly);
+	free(recs_p);
+	return ret;
+}
+
+static void
+usage (char *pgm_p)
+{
+	printf("usage:\n");
+	if (pgm_p != NULL)
+		printf("%s [<options>] <trace>\n", pgm_p);
+	printf("  where:\n");
+	printf("    options:\n");
+	printf("      -h|--help         print usage information and exit successfully\n");
+	printf("      -p|--print        print the accesses instead of replaying them\n");
+	printf("      -s|--summary      print which registers the time went to instead\n");
+	printf("                        of replaying the accesses\n");
+	printf("      -t|--timing       keep the recorded spacing between accesses\n");
+	printf("                        (default: as fast as possible)\n");
+	printf("      -c|--check        compare the values read with the recorded ones\n");
+	printf("      -w|--writes-only  only replay the writes\n");
+	printf("      -S|--stats        print per-register access statistics at exit\n");
+	printf("    <trace>             recorded with LPC32X0_TRACE=<trace> (or '-' for stdin)\n");
+	printf("  the accesses are replayed on /dev/mem, or the simulator if LPC32X0_SIM is set\n");
+}
+
+static const char *
+reg_name (uint32_t addr)
+{
+	size_t cnt;
+	RegisterDescription_t **regs_pp;
+
+	regs_pp = lpc32x0__find_reg(addr, &cnt);
+	return (regs_pp != NULL)? regs_pp[0]->name_p : "?";
+}
+
+static void
+print_trace (const TraceRecord_t *recs_p, size_t cnt)
+{
+	size_t i;
+	uint32_t addr;
+
+	for (i=0; i<cnt; ++i) {
+		addr = recs_p[i].addr & ~(uint32_t)TRACE_WRITE;
+		printf("[%12.6f] %c 0x%08x %-15s 0x%08x\n",
+				(double)recs_p[i].ns / 1e9,
+				(recs_p[i].addr & TRACE_WRITE)? 'W' : 'R',
+				addr, reg_name(addr), recs_p[i].val);
+	}
+}
+
+static int
+profile_cmp (const void *a_p, const void *b_p)
+{
+	const Profile_t *a = a_p;
+	const Profile_t *b = b_p;
+
+	if (a->ns != b->ns)
+		return (a->ns > b->ns)? -1 : 1;
+	if ((a->reads + a->writes) != (b->reads + b->writes))
+		return ((a->reads + a->writes) > (b->reads + b->writes))? -1 : 1;
+	return 0;
+}
+
+/*
+ * each access is charged the time until the next one, so a register polled
+ * in a loop is charged the whole loop
+ * accesses to addresses that aren't known registers are lumped together
+ */
+static int
+profile (const TraceRecord_t *recs_p, size_t cnt)
+{
+	size_t i, slot, slots, regCnt;
+	uint32_t addr;
+	uint64_t total;
+	Profile_t *prof_p, *p;
+	RegisterDescription_t **index_pp, **regs_pp;
+
+	index_pp = lpc32x0__reg_index(&slots);
+	if (index_pp == NULL)
+		return 1;
+	prof_p = calloc(slots + 1, sizeof(*prof_p));
+	if (prof_p == NULL) {
+		perror("calloc()");
+		return 1;
+	}
+	for (slot=0; slot<slots; ++slot)
+		prof_p[slot].reg_p = index_pp[slot];
+
+	for (i=0; i<cnt; ++i) {
+		addr = recs_p[i].addr & ~(uint32_t)TRACE_WRITE;
+		regs_pp = lpc32x0__find_reg(addr, &regCnt);
+		p = &prof_p[(regs_pp != NULL)? (size_t)(regs_pp - index_pp) : slots];
+		if (recs_p[i].addr & TRACE_WRITE)
+			++p->writes;
+		else
+			++p->reads;
+		if ((i + 1) < cnt)
+			p->ns += recs_p[i+1].ns - recs_p[i].ns;
+	}
+
+	total = cnt? recs_p[cnt-1].ns - recs_p[0].ns : 0;
+	qsort(prof_p, slots + 1, sizeof(*prof_p), profile_cmp);
+	printf("   reads   writes   time (ms)   time%%  register\n");
+	for (i=0; i<=slots; ++i) {
+		p = &prof_p[i];
+		if ((p->reads + p->writes) == 0)
+			continue;
+		printf("%8lu %8lu %11.3f %6.1f%%  ", p->reads, p->writes, (double)p->ns / 1e6,
+				total? (100.0 * (double)p->ns) / (double)total : 0.0);
+		if (p->reg_p != NULL)
+			printf("0x%08x %s\n", p->reg_p->addr, p->reg_p->name_p);
+		else
+			printf("(unknown addresses)\n");
+	}
+	free(prof_p);
+	return 0;
+}
+
+/*
+ * with 'check', reads that return something other than what was recorded
+ * are reported (e.g. a status register polled a different number of times);
+ * that isn't an error, the replay carries on
+ */
+static int
+replay (const TraceRecord_t *recs_p, size_t cnt, bool timing, bool check, bool writesOnly)
+{
+	size_t i;
+	uint32_t addr, val;
+	uint64_t start, target;
+	unsigned long reads = 0, writes = 0, differ = 0, failed = 0;
+	double secs;
+	struct timespec ts;
+
+	start = lpc32x0__now_ns();
+	for (i=0; i<cnt; ++i) {
+		addr = recs_p[i].addr & ~(uint32_t)TRACE_WRITE;
+		if (!(recs_p[i].addr & TRACE_WRITE) && writesOnly)
+			continue;
+
+		if (timing) {
+			target = start + recs_p[i].ns;
+			ts.tv_sec = (time_t)(target / 1000000000ull);
+			ts.tv_nsec = (long)(target % 1000000000ull);
+			while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+				;
+		}
+
+		if (recs_p[i].addr & TRACE_WRITE) {
+			if (lpc32x0__set_reg(addr, recs_p[i].val))
+				++writes;
+			else
+				++failed;
+			continue;
+		}
+
+		if (!lpc32x0__get_reg(addr, &val)) {
+			++failed;
+			continue;
+		}
+		++reads;
+		if (check && (val != recs_p[i].val)) {
+			++differ;
+			printf("[%12.6f] 0x%08x %-15s recorded 0x%08x, read 0x%08x\n",
+					(double)recs_p[i].ns / 1e9, addr, reg_name(addr),
+					recs_p[i].val, val);
+		}
+	}
+	secs = (double)(lpc32x0__now_ns() - start) / 1e9;
+
+	printf("replayed %lu reads and %lu writes in %.6f s", reads, writes, secs);
+	if (check)
+		printf(", %lu reads differed", differ);
+	if (failed != 0)
+		printf(", %lu accesses failed", failed);
+	printf("\n");
+	return (failed != 0)? 1 : 0;
+}
@@ -7,40 +7,106 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
 #include <errno.h>
+#include <time.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <getopt.h>
+#include <pthread.h>
 
 #include "registers.h"
 
+static bool resolve_handles (void);
 static void spi_init (void);
 static void spi_reset (void);
 static void spi_deinit (void);
 static bool bootstick_present (void);
 static void cs_high (void);
 static void cs_low (void);
-static void spi_tx (uint8_t *data_p, uint32_t len);
-static void spi_rx (uint8_t *data_p, uint32_t len);
 static void spi_readflash (uint8_t *data_p, uint32_t addr, uint32_t len);
-static void spi_getid (void);
+static bool spi_dumpflash (uint32_t addr, uint32_t len, const char *file_p);
+static bool spi_writeflash (const char *file_p);
+static void spi_getid (uint64_t oscHz, int rate);
+static size_t fast_read_command (uint8_t *command_p, uint32_t addr);
 static void print_buf (uint32_t len);
+static void print_sim_time (const SpiSimStats_t *before_p, uint32_t len);
 
 static uint8_t buf_G[256];
 static bool verbose_G = false;
 static bool bootstick_G = false;
+static bool time_G = false;
+
+// SPI1_CON: unidirectional SPI1_DATIO, mode 0, 8 bits, master, HCLK/8;
+// the rate (SPI1_CON[6:0]) is then picked for the flash (see spi_getid())
+#define SPI1_CON_FLASH 0x800e83
+#define SPI1_CON_RATE  0x7f
+
+// --read moves the flash a chunk at a time
+#define SPI_CHUNK 0x10000
+
+#define CMD_PP   0x02
+#define CMD_RDSR 0x05
+#define CMD_WREN 0x06
+#define CMD_FAST 0x0b
+#define CMD_SFDP 0x5a
+#define CMD_RDID 0x9f
+
+#define SR_WIP 0x01
+#define SR_WEL 0x02
+#define SR_BP  0x1c
+
+// the longest FAST_READ: command, address and up to 32 dummy clocks
+#define FAST_READ_MAX 8
+
+// SFDP reads 8 dummy clocks after the address; the basic table is near the start
+#define SFDP_LEN 256
+
+// a flash that can't be identified is read as if it were what my board has,
+// but its size isn't trusted and it isn't written
+static const uint8_t defaultFlashId_G[] = {0x20, 0x20, 0x15}; // M25P16
+static SpiFlashPart_t flash_G;
+static bool flashKnown_G = false;
+
+// reads by GPDMA (--dma) use the lowest priority channel and a buffer
+// that holds a chunk and its linked-list items
+#define SPI_DMA_CHANNEL 7
+#define SPI_DMA_SIZE    0x11000
+
+// registers used on the hot path, resolved once at startup
+static RegHandle_t p3InpState_G;
+static SpiXfer_t spi_G;
+static SpiDma_t dma_G;
+
+// the chip select, a single store to P3_OUTP_SET/P3_OUTP_CLR
+static FieldHandle_t cs_G;
 
 int
 main (int argc, char *argv[])
 {
-	int c;
+	int c, ret = 0;
+	unsigned csBit;
+	uint32_t dmaPhys = 0, readAddr = 0, readLen = 0;
+	bool dma = false, dump = false;
+	uint64_t oscHz = 0;
+	int rate = -1;
+	char *end_p, *output_p = NULL, *image_p = NULL;
 	struct option longOpts[] = {
 		{"verbose", no_argument, NULL, 'v'},
 		{"bootstick", no_argument, NULL, 'b'},
+		{"time", no_argument, NULL, 't'},
+		{"stats", no_argument, NULL, 'S'},
+		{"dma", required_argument, NULL, 'd'},
+		{"read", required_argument, NULL, 'r'},
+		{"output", required_argument, NULL, 'o'},
+		{"write", required_argument, NULL, 'w'},
+		{"osc", required_argument, NULL, 'O'},
+		{"rate", required_argument, NULL, 'R'},
 		{NULL, 0, NULL, 0},
 	};
 
 	while (1) {
-		c = getopt_long(argc, argv, "vb", longOpts, NULL);
+		c = getopt_long(argc, argv, "vbtSd:r:o:w:O:R:", longOpts, NULL);
 		if (c == -1)
 			break;
 		switch (c) {
@@ -48,22 +114,131 @@ main (int argc, char *argv[])
 				verbose_G = true;
 				break;
 			case 'b':
-				if (!bootstick_present()) {
-					fprintf(stderr, "no bootstick present\n");
+				bootstick_G = true;
+				break;
+			case 't':
+				time_G = true;
+				break;
+			case 'S':
+				if (!lpc32x0__stats_start("-"))
+					return 1;
+				break;
+			case 'd':
+				dmaPhys = (uint32_t)strtoul(optarg, &end_p, 0);
+				if ((*optarg == 0) || (*end_p != 0)) {
+					fprintf(stderr, "can't convert '%s' to an address\n", optarg);
+					return 1;
+				}
+				dma = true;
+				break;
+			case 'r':
+				readAddr = (uint32_t)strtoul(optarg, &end_p, 0);
+				if ((*optarg == 0) || (*end_p != 0)) {
+					fprintf(stderr, "can't convert '%s' to an offset\n", optarg);
+					return 1;
+				}
+				dump = true;
+				break;
+			case 'o':
+				output_p = optarg;
+				break;
+			case 'w':
+				image_p = optarg;
+				break;
+			case 'O':
+				if ((sscanf(optarg, "%" SCNu64, &oscHz) != 1) || (oscHz == 0)) {
+					fprintf(stderr, "can't convert '%s' to a frequency\n", optarg);
+					return 1;
+				}
+				break;
+			case 'R':
+				if ((sscanf(optarg, "%d", &rate) != 1) || (rate < 0) || (rate > SPI1_CON_RATE)) {
+					fprintf(stderr, "can't convert '%s' to a rate (0 ... %d)\n", optarg, SPI1_CON_RATE);
 					return 1;
 				}
-				bootstick_G = true;
 				break;
 		}
 	}
+	if (dump && (image_p != NULL)) {
+		fprintf(stderr, "--read and --write can't be used together\n");
+		return 1;
+	}
+
+	// --read <offset> <length>: the length is left over after the options
+	if (dump) {
+		if (optind >= argc) {
+			fprintf(stderr, "--read needs an offset and a length\n");
+			return 1;
+		}
+		readLen = (uint32_t)strtoul(argv[optind], &end_p, 0);
+		if ((*argv[optind] == 0) || (*end_p != 0) || (readLen == 0)) {
+			fprintf(stderr, "can't convert '%s' to a length\n", argv[optind]);
+			return 1;
+		}
+		// the flash takes 3 address bytes
+		if ((readAddr > 0xffffff) || (readLen > (0x1000000 - readAddr))) {
+			fprintf(stderr, "0x%x bytes at 0x%x is past the end of a 24-bit address\n", readLen, readAddr);
+			return 1;
+		}
+		if (output_p == NULL) {
+			fprintf(stderr, "--read needs an output file (-o)\n");
+			return 1;
+		}
+	}
+
+	// after the options, so --stats sees the handles
+	if (!resolve_handles()) {
+		fprintf(stderr, "can't resolve SPI1/GPIO registers\n");
+		return 1;
+	}
+	if (bootstick_G && !bootstick_present()) {
+		fprintf(stderr, "no bootstick present\n");
+		return 1;
+	}
+
+	// the bootstick can't come or go while we run, so pick the chip select
+	// (GPIO_4 or GPIO_5) once
+	csBit = (bootstick_present() && !bootstick_G)? P3_OUTP_CS_GPIO4 : P3_OUTP_CS_GPIO5;
+	if (!lpc32x0__resolve_field_bits(P3_OUTP_STATE, csBit, csBit, &cs_G)) {
+		fprintf(stderr, "can't resolve the chip select\n");
+		return 1;
+	}
+	if (dma && !lpc32x0__spi_dma_open(SPI_DMA_CHANNEL, dmaPhys, SPI_DMA_SIZE, &dma_G)) {
+		fprintf(stderr, "can't set up DMA at 0x%08x\n", dmaPhys);
+		return 1;
+	}
 
 	spi_init();
-	spi_getid();
+	spi_getid(oscHz, rate);
 	spi_reset();
-	spi_readflash(buf_G, 0, sizeof(buf_G));
+	if ((image_p != NULL) && !flashKnown_G) {
+		fprintf(stderr, "won't --write a flash that can't be identified\n");
+		ret = 1;
+	}
+	else if (dump) {
+		if (!spi_dumpflash(readAddr, readLen, output_p))
+			ret = 1;
+	}
+	else if (image_p != NULL) {
+		if (!spi_writeflash(image_p))
+			ret = 1;
+	}
+	else
+		spi_readflash(buf_G, 0, sizeof(buf_G));
 	spi_deinit();
+	lpc32x0__spi_dma_close(&dma_G);
 
-	return 0;
+	return ret;
+}
+
+static bool
+resolve_handles (void)
+{
+	if (!lpc32x0__resolve_reg(P3_INP_STATE, &p3InpState_G))
+		return false;
+	if (!lpc32x0__resolve_spi(SPI1_CON_FLASH, &spi_G))
+		return false;
+	return true;
 }
 
 static void
@@ -156,10 +331,7 @@ spi_deinit (void)
 static bool
 bootstick_present (void)
 {
-	uint32_t val;
-
-	lpc32x0__get_reg(P3_INP_STATE, &val);
-	if (val & 0x08)
+	if (lpc32x0__read(&p3InpState_G) & P3_INP_BOOTSTICK)
 		return true;
 	return false;
 }
@@ -167,135 +339,582 @@ bootstick_present (void)
 static void
 cs_high (void)
 {
-	if (bootstick_present() && !bootstick_G)
-		lpc32x0__set_reg(P3_OUTP_SET, 0x20000000);
-	else
-		lpc32x0__set_reg(P3_OUTP_SET, 0x40000000);
+	lpc32x0__write_field(&cs_G, 1);
 }
 
 static void
 cs_low (void)
 {
-	if (bootstick_present() && !bootstick_G)
-		lpc32x0__set_reg(P3_OUTP_CLR, 0x20000000);
-	else
-		lpc32x0__set_reg(P3_OUTP_CLR, 0x40000000);
+	lpc32x0__write_field(&cs_G, 0);
 }
 
 static void
-spi_tx (uint8_t *data_p, uint32_t len)
+spi_readflash (uint8_t *data_p, uint32_t addr, uint32_t len)
 {
-	uint32_t val, frameLen;
+	uint8_t command[FAST_READ_MAX];
+	size_t commandLen;
+	struct timespec start, end;
+	double secs;
+	SpiSimStats_t simStats;
+	bool sim;
 
 	if (data_p == NULL)
 		return;
 	if (len == 0)
 		return;
 
-	// SPI1_CON - xmit, shift enabled
-	lpc32x0__set_reg(SPI1_CON, 0x808e83);
+	memset(buf_G, 0, sizeof(buf_G));
+	commandLen = fast_read_command(command, addr);
 
-	while (len) {
-		if (len > 65535)
-			frameLen = 65535;
-		else
-			frameLen = len;
-		// SPI1_FRM
-		lpc32x0__set_reg(SPI1_FRM, frameLen);
-		len -= frameLen;
-
-		while (frameLen--) {
-			lpc32x0__get_reg(SPI1_STAT, &val);
-			while (val & 0x04)
-				lpc32x0__get_reg(SPI1_STAT, &val);
-			lpc32x0__set_reg(SPI1_DAT, *data_p++);
-		}
+	sim = lpc32x0__get_spi_sim_stats(&simStats);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	cs_low();
+	if (dma_G.buf_p != NULL) {
+		lpc32x0__spi_tx(&spi_G, command, commandLen);
+		if (!lpc32x0__spi_dma_rx(&spi_G, &dma_G, data_p, len))
+			memset(data_p, 0, len);
+	}
+	else
+		lpc32x0__spi_xfer(&spi_G, command, commandLen, data_p, len);
+	cs_high();
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_buf(len);
 
-		lpc32x0__get_reg(SPI1_STAT, &val);
-		while ((val & 0x01) == 0)
-			lpc32x0__get_reg(SPI1_STAT, &val);
-		lpc32x0__set_reg(SPI1_STAT, 0x100);
+	if (time_G) {
+		secs = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);
+		printf("read %u bytes in %.6f s (%.0f bytes/s)\n", len, secs, secs > 0.0? (double)len / secs : 0.0);
+		if (sim)
+			print_sim_time(&simStats, len);
 	}
 }
 
+/*
+ * on the sim backend, how long the read would have taken on the board
+ */
 static void
-spi_rx (uint8_t *data_p, uint32_t len)
+print_sim_time (const SpiSimStats_t *before_p, uint32_t len)
 {
-	uint32_t val, frameLen;
+	double secs;
+	SpiSimStats_t after;
 
-	if (data_p == NULL)
-		return;
-	if (len == 0)
+	if (!lpc32x0__get_spi_sim_stats(&after))
 		return;
+	secs = (double)(after.cycles - before_p->cycles) / after.hclk;
+	printf("simulated: %" PRIu64 " HCLK cycles at %u Hz, %.6f s (%.0f bytes/s), %lu register accesses, %lu empty polls\n",
+			after.cycles - before_p->cycles, after.hclk, secs,
+			secs > 0.0? (double)len / secs : 0.0,
+			after.accesses - before_p->accesses,
+			after.emptyPolls - before_p->emptyPolls);
+}
+
+/*
+ * --read
+ *
+ * the flash is read with one FAST_READ, a chunk at a time, into one of two
+ * buffers, while a writer thread writes the other one out; so writing
+ * chunk N overlaps the SPI read of chunk N+1, and the transfer only waits
+ * for the file when it's slower than the flash
+ */
+typedef struct {
+	uint8_t data[SPI_CHUNK];
+	uint32_t len;
+	bool full;
+} DumpBuf_t;
+
+typedef struct {
+	int fd;
+	bool failed;
+	bool done;
+	unsigned long waits;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	DumpBuf_t buf[2];
+} Dump_t;
 
-	// SPI1_CON - rcve, shift enabled
-	lpc32x0__set_reg(SPI1_CON, 0x800e83);
+/*
+ * after a failed write the rest of the chunks are only marked empty, so
+ * the read carries on to the end and spi_dumpflash() reports the failure
+ */
+static void *
+dump_writer (void *arg_p)
+{
+	unsigned i = 0;
+	Dump_t *dump_p = arg_p;
+	DumpBuf_t *buf_p;
 
-	while (len) {
-		if (len > 65535)
-			frameLen = 65535;
+	while (1) {
+		buf_p = &dump_p->buf[i];
+		pthread_mutex_lock(&dump_p->lock);
+		while (!buf_p->full && !dump_p->done)
+			pthread_cond_wait(&dump_p->cond, &dump_p->lock);
+		pthread_mutex_unlock(&dump_p->lock);
+		if (!buf_p->full)
+			break;
+
+		if (!dump_p->failed && !lpc32x0__write_all(dump_p->fd, buf_p->data, buf_p->len)) {
+			perror("write()");
+			dump_p->failed = true;
+		}
+
+		pthread_mutex_lock(&dump_p->lock);
+		buf_p->full = false;
+		pthread_cond_broadcast(&dump_p->cond);
+		pthread_mutex_unlock(&dump_p->lock);
+		i ^= 1;
+	}
+	return NULL;
+}
+
+static bool
+spi_dumpflash (uint32_t addr, uint32_t len, const char *file_p)
+{
+	uint8_t command[FAST_READ_MAX];
+	size_t commandLen;
+	uint32_t done, chunk;
+	unsigned i = 0;
+	int ret;
+	bool ok = true, sim, progress;
+	struct timespec start, end;
+	double secs;
+	SpiSimStats_t simStats;
+	pthread_t thread;
+	Dump_t *dump_p;
+	DumpBuf_t *buf_p;
+
+	if (flashKnown_G && ((addr >= flash_G.size) || (len > (flash_G.size - addr)))) {
+		fprintf(stderr, "0x%x bytes at 0x%x is past the end of the %u byte flash\n", len, addr, flash_G.size);
+		return false;
+	}
+
+	dump_p = calloc(1, sizeof(*dump_p));
+	if (dump_p == NULL) {
+		perror("calloc()");
+		return false;
+	}
+	dump_p->fd = open(file_p, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (dump_p->fd == -1) {
+		perror(file_p);
+		free(dump_p);
+		return false;
+	}
+	pthread_mutex_init(&dump_p->lock, NULL);
+	pthread_cond_init(&dump_p->cond, NULL);
+	ret = pthread_create(&thread, NULL, dump_writer, dump_p);
+	if (ret != 0) {
+		errno = ret;
+		perror("pthread_create()");
+		close(dump_p->fd);
+		free(dump_p);
+		return false;
+	}
+
+	commandLen = fast_read_command(command, addr);
+
+	// progress only goes to a terminal
+	progress = isatty(STDOUT_FILENO);
+	sim = lpc32x0__get_spi_sim_stats(&simStats);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	cs_low();
+	lpc32x0__spi_tx(&spi_G, command, commandLen);
+	for (done=0; done<len; done+=chunk) {
+		chunk = ((len - done) > SPI_CHUNK)? SPI_CHUNK : len - done;
+		buf_p = &dump_p->buf[i];
+		pthread_mutex_lock(&dump_p->lock);
+		if (buf_p->full) {
+			++dump_p->waits;
+			while (buf_p->full)
+				pthread_cond_wait(&dump_p->cond, &dump_p->lock);
+		}
+		pthread_mutex_unlock(&dump_p->lock);
+
+		// the flash keeps going for as long as it's selected
+		if (dma_G.buf_p != NULL) {
+			if (!lpc32x0__spi_dma_rx(&spi_G, &dma_G, buf_p->data, chunk)) {
+				ok = false;
+				break;
+			}
+		}
 		else
-			frameLen = len;
-		len -= frameLen;
-		// SPI1_FRM
-		lpc32x0__set_reg(SPI1_FRM, frameLen);
+			lpc32x0__spi_rx(&spi_G, buf_p->data, chunk);
+
+		pthread_mutex_lock(&dump_p->lock);
+		buf_p->len = chunk;
+		buf_p->full = true;
+		pthread_cond_broadcast(&dump_p->cond);
+		pthread_mutex_unlock(&dump_p->lock);
+		i ^= 1;
+		if (progress) {
+			printf("\rread %u of %u bytes (%u%%)", done + chunk, len, (unsigned)(((uint64_t)(done + chunk) * 100) / len));
+			fflush(stdout);
+		}
+	}
+	cs_high();
+	if (progress)
+		printf("\n");
+
+	pthread_mutex_lock(&dump_p->lock);
+	dump_p->done = true;
+	pthread_cond_broadcast(&dump_p->cond);
+	pthread_mutex_unlock(&dump_p->lock);
+	pthread_join(thread, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	if ((close(dump_p->fd) == -1) || dump_p->failed)
+		ok = false;
+	if (ok) {
+		secs = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);
+		printf("read %u bytes at 0x%06x to %s in %.3f s (%.2f MB/s)\n", len, addr, file_p, secs,
+				secs > 0.0? (double)len / secs / 1e6 : 0.0);
+		if (dump_p->waits != 0)
+			printf("waited %lu times for the file\n", dump_p->waits);
+		if (sim)
+			print_sim_time(&simStats, len);
+	}
+	else
+		fprintf(stderr, "read of %s failed\n", file_p);
+	pthread_cond_destroy(&dump_p->cond);
+	pthread_mutex_destroy(&dump_p->lock);
+	free(dump_p);
+	return ok;
+}
+
+/*
+ * --write
+ *
+ * only what differs is rewritten: each sector the image covers is read
+ * back and compared with what it should hold (the image, with the old
+ * contents past its end); a sector that matches is skipped, one where the
+ * image only clears bits has just the differing pages programmed, and any
+ * other is erased and has its pages that aren't all 0xff programmed
+ * everything written is read back again at the end
+ */
+static uint8_t
+flash_status (void)
+{
+	uint8_t command = CMD_RDSR, status;
+
+	cs_low();
+	lpc32x0__spi_xfer(&spi_G, &command, 1, &status, 1);
+	cs_high();
+	return status;
+}
+
+/*
+ * program and erase go on after the chip select is raised
+ * returns false if WIP is still set after 'us' microseconds, the part's
+ * longest time for it, e.g. if the part is stuck or MISO reads 0xff
+ */
+static bool
+flash_wait (uint64_t us)
+{
+	struct timespec start, now;
+	uint64_t elapsed;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	do {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		elapsed = (uint64_t)(now.tv_sec - start.tv_sec) * 1000000 + (uint64_t)((now.tv_nsec - start.tv_nsec) / 1000);
+		if ((flash_status() & SR_WIP) == 0)
+			return true;
+	} while (elapsed <= us);
+	return false;
+}
+
+static bool
+flash_write_enable (void)
+{
+	uint8_t command = CMD_WREN;
+
+	cs_low();
+	lpc32x0__spi_tx(&spi_G, &command, 1);
+	cs_high();
+	return (flash_status() & SR_WEL) != 0;
+}
 
-		// dummy read?
-		lpc32x0__get_reg(SPI1_DAT, &val);
+static bool
+flash_read (uint32_t addr, uint8_t *data_p, uint32_t len)
+{
+	bool ok = true;
+	uint8_t command[FAST_READ_MAX];
+
+	cs_low();
+	lpc32x0__spi_tx(&spi_G, command, fast_read_command(command, addr));
+	if (dma_G.buf_p != NULL)
+		ok = lpc32x0__spi_dma_rx(&spi_G, &dma_G, data_p, len);
+	else
+		lpc32x0__spi_rx(&spi_G, data_p, len);
+	cs_high();
+	return ok;
+}
+
+static bool
+flash_erase_sector (uint32_t addr)
+{
+	uint8_t command[4] = {flash_G.eraseCmd, (addr >> 16) & 0xff, (addr >> 8) & 0xff, addr & 0xff};
+
+	if (!flash_write_enable()) {
+		fprintf(stderr, "\nsector 0x%06x: can't write enable the flash\n", addr);
+		return false;
+	}
+	cs_low();
+	lpc32x0__spi_tx(&spi_G, command, sizeof(command));
+	cs_high();
+	if (!flash_wait((uint64_t)flash_G.eraseMs * 1000)) {
+		fprintf(stderr, "\nsector 0x%06x: erase didn't finish in %u ms\n", addr, flash_G.eraseMs);
+		return false;
+	}
+	return true;
+}
+
+static bool
+flash_program_page (uint32_t addr, const uint8_t *data_p)
+{
+	uint8_t command[4] = {CMD_PP, (addr >> 16) & 0xff, (addr >> 8) & 0xff, addr & 0xff};
+
+	if (!flash_write_enable()) {
+		fprintf(stderr, "\npage 0x%06x: can't write enable the flash\n", addr);
+		return false;
+	}
+	cs_low();
+	lpc32x0__spi_tx(&spi_G, command, sizeof(command));
+	lpc32x0__spi_tx(&spi_G, data_p, flash_G.pageSize);
+	cs_high();
+	if (!flash_wait(flash_G.programUs)) {
+		fprintf(stderr, "\npage 0x%06x: program didn't finish in %u us\n", addr, flash_G.programUs);
+		return false;
+	}
+	return true;
+}
 
-		while (frameLen--) {
-			lpc32x0__get_reg(SPI1_STAT, &val);
-			while (val & 0x01)
-				lpc32x0__get_reg(SPI1_STAT, &val);
+static uint8_t *
+load_image (const char *file_p, uint32_t *len_p)
+{
+	FILE *f_p;
+	long len;
+	uint8_t *image_p;
+
+	f_p = fopen(file_p, "rb");
+	if (f_p == NULL) {
+		perror(file_p);
+		return NULL;
+	}
+	if ((fseek(f_p, 0, SEEK_END) == -1) || ((len = ftell(f_p)) == -1) || (fseek(f_p, 0, SEEK_SET) == -1)) {
+		perror(file_p);
+		fclose(f_p);
+		return NULL;
+	}
+	if ((len == 0) || (len > (long)flash_G.size)) {
+		fprintf(stderr, "%s: %ld bytes doesn't fit the %u byte flash\n", file_p, len, flash_G.size);
+		fclose(f_p);
+		return NULL;
+	}
+	image_p = malloc((size_t)len);
+	if (image_p == NULL) {
+		perror("malloc()");
+		fclose(f_p);
+		return NULL;
+	}
+	if (fread(image_p, 1, (size_t)len, f_p) != (size_t)len) {
+		fprintf(stderr, "%s: short read\n", file_p);
+		free(image_p);
+		fclose(f_p);
+		return NULL;
+	}
+	fclose(f_p);
+	*len_p = (uint32_t)len;
+	return image_p;
+}
 
-			lpc32x0__get_reg(SPI1_STAT, &val);
-			if (val & 0x08)
-				lpc32x0__set_reg(SPI1_CON, 0x802E83);
+/*
+ * program what's different in 'want_p' into the sector at 'addr', which
+ * holds 'have_p'; returns false, having said why, if the flash wouldn't take
+ * it
+ */
+static bool
+update_sector (uint32_t addr, const uint8_t *have_p, const uint8_t *want_p, unsigned *erased_p, unsigned *pages_p)
+{
+	uint32_t i, page;
+	bool erase = false;
 
-			lpc32x0__get_reg(SPI1_DAT, &val);
-			*data_p++ = val;
+	// programming can only clear bits
+	for (i=0; i<flash_G.sectorSize; ++i)
+		if ((have_p[i] & want_p[i]) != want_p[i]) {
+			erase = true;
+			break;
 		}
 
-		// SPI1_STAT - clear interrupt
-		lpc32x0__set_reg(SPI1_STAT, 0x100);
+	if (erase) {
+		if (!flash_erase_sector(addr))
+			return false;
+		++*erased_p;
 	}
+	for (page=0; page<flash_G.sectorSize; page+=flash_G.pageSize) {
+		if (erase) {
+			// an erased page is all 0xff already
+			for (i=0; (i<flash_G.pageSize) && (want_p[page + i] == 0xff); ++i)
+				;
+			if (i == flash_G.pageSize)
+				continue;
+		}
+		else if (memcmp(have_p + page, want_p + page, flash_G.pageSize) == 0)
+			continue;
+		if (!flash_program_page(addr + page, want_p + page))
+			return false;
+		++*pages_p;
+	}
+	return true;
 }
 
-static void
-spi_readflash (uint8_t *data_p, uint32_t addr, uint32_t len)
+static bool
+spi_writeflash (const char *file_p)
 {
-	uint8_t command[5];
+	uint8_t *image_p, *have_p = NULL, *want_p = NULL, status;
+	uint32_t len, addr, cnt;
+	unsigned sectors, skipped = 0, erased = 0, pages = 0;
+	bool ok = false, progress;
+	struct timespec start, end;
+	double secs;
+
+	image_p = load_image(file_p, &len);
+	if (image_p == NULL)
+		return false;
+	have_p = malloc(flash_G.sectorSize);
+	want_p = malloc(flash_G.sectorSize);
+	if ((have_p == NULL) || (want_p == NULL)) {
+		perror("malloc()");
+		goto out;
+	}
 
-	if (data_p == NULL)
-		return;
-	if (len == 0)
-		return;
+	status = flash_status();
+	if (status & SR_BP) {
+		fprintf(stderr, "the flash is write protected (status 0x%02x)\n", status);
+		goto out;
+	}
 
-	memset(buf_G, 0, sizeof(buf_G));
-	command[0] = 0x0b;
-	command[1] = (addr >> 16) & 0xff;
-	command[2] = (addr >> 8) & 0xff;
-	command[3] = addr & 0xff;
-	command[4] = 0;
+	progress = isatty(STDOUT_FILENO);
+	sectors = (len + flash_G.sectorSize - 1) / flash_G.sectorSize;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (addr=0; addr<len; addr+=flash_G.sectorSize) {
+		if (progress) {
+			printf("\rsector %u of %u", (addr / flash_G.sectorSize) + 1, sectors);
+			fflush(stdout);
+		}
+		if (!flash_read(addr, have_p, flash_G.sectorSize))
+			goto out;
+		// what's past the end of the image stays as it was
+		cnt = ((len - addr) > flash_G.sectorSize)? flash_G.sectorSize : len - addr;
+		memcpy(want_p, have_p, flash_G.sectorSize);
+		memcpy(want_p, image_p + addr, cnt);
+		if (memcmp(have_p, want_p, flash_G.sectorSize) == 0) {
+			++skipped;
+			continue;
+		}
+		if (!update_sector(addr, have_p, want_p, &erased, &pages))
+			goto out;
+	}
+	if (progress)
+		printf("\n");
+
+	// verify
+	for (addr=0; addr<len; addr+=cnt) {
+		cnt = ((len - addr) > flash_G.sectorSize)? flash_G.sectorSize : len - addr;
+		if (!flash_read(addr, have_p, cnt))
+			goto out;
+		if (memcmp(have_p, image_p + addr, cnt) != 0) {
+			fprintf(stderr, "verify failed in the sector at 0x%06x\n", addr);
+			goto out;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	secs = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);
+	printf("wrote %s (%u bytes): %u of %u sectors unchanged, %u erased, %u pages programmed, verified, in %.3f s\n",
+			file_p, len, skipped, sectors, erased, pages, secs);
+	ok = true;
+
+out:
+	free(image_p);
+	free(have_p);
+	free(want_p);
+	return ok;
+}
+
+/*
+ * FAST_READ at 'addr', with the part's dummy clocks
+ */
+static size_t
+fast_read_command (uint8_t *command_p, uint32_t addr)
+{
+	size_t len = 4 + (flash_G.fastReadDummy / 8);
+
+	command_p[0] = CMD_FAST;
+	command_p[1] = (addr >> 16) & 0xff;
+	command_p[2] = (addr >> 8) & 0xff;
+	command_p[3] = addr & 0xff;
+	memset(&command_p[4], 0, len - 4);
+	return len;
+}
+
+static bool
+read_sfdp (SpiFlashPart_t *part_p)
+{
+	uint8_t command[5] = {CMD_SFDP, 0, 0, 0, 0};
+	uint8_t sfdp[SFDP_LEN];
 
 	cs_low();
-	spi_tx(command, 5);
-	spi_rx(data_p, len);
+	lpc32x0__spi_xfer(&spi_G, command, sizeof(command), sfdp, sizeof(sfdp));
 	cs_high();
-	print_buf(len);
+	return lpc32x0__parse_spi_flash_sfdp(sfdp, sizeof(sfdp), part_p);
 }
 
+/*
+ * read the JEDEC ID and work out what the flash is, from the table of
+ * parts or its SFDP, then run SPI1 at the fastest clock it takes at the
+ * current HCLK (or at 'rate', if it's given)
+ * a flash that can't be identified is read like an M25P16, but the clock
+ * is left at HCLK/8 and flashKnown_G stays false
+ */
 static void
-spi_getid (void)
+spi_getid (uint64_t oscHz, int rate)
 {
 	uint8_t command;
+	const SpiFlashPart_t *part_p;
+	Clocks_t clocks;
 
 	memset(buf_G, 0, sizeof(buf_G));
-	command = 0x9f;
+	command = CMD_RDID;
 
 	cs_low();
-	spi_tx(&command, 1);
-	spi_rx(buf_G, 3);
+	lpc32x0__spi_xfer(&spi_G, &command, 1, buf_G, 3);
 	cs_high();
 	print_buf(3);
+
+	flashKnown_G = true;
+	part_p = lpc32x0__find_spi_flash(buf_G);
+	if (part_p != NULL)
+		flash_G = *part_p;
+	else if (read_sfdp(&flash_G))
+		memcpy(flash_G.id, buf_G, sizeof(flash_G.id));
+	else {
+		flash_G = *lpc32x0__find_spi_flash(defaultFlashId_G);
+		flashKnown_G = false;
+	}
+	if (flashKnown_G)
+		printf("flash: %s, %u KiB, %u KiB erase (0x%02x), %u byte pages, fast read up to %u MHz\n",
+				flash_G.name, flash_G.size / 1024, flash_G.sectorSize / 1024, flash_G.eraseCmd,
+				flash_G.pageSize, flash_G.fastReadHz / 1000000);
+	else
+		printf("flash: unknown, reading it like an %s\n", flash_G.name);
+
+	if (rate < 0) {
+		if (!flashKnown_G || !lpc32x0__get_clocks(oscHz, &clocks) || (clocks.hclk == 0))
+			rate = (int)(SPI1_CON_FLASH & SPI1_CON_RATE);
+		else
+			rate = (int)lpc32x0__spi_rate(clocks.hclk, flash_G.fastReadHz);
+	}
+	spi_G.conBase = (spi_G.conBase & ~(uint32_t)SPI1_CON_RATE) | (uint32_t)rate;
+	if (lpc32x0__get_clocks(oscHz, &clocks) && (clocks.hclk != 0))
+		printf("SPI1_CLK: HCLK/%d, %.3f MHz\n", (rate + 1) * 2, (double)clocks.hclk / ((rate + 1) * 2) / 1e6);
+	else
+		printf("SPI1_CLK: HCLK/%d\n", (rate + 1) * 2);
 }
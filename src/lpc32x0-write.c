@@ -4,12 +4,18 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include <getopt.h>
 
 #include "registers.h"
 
 static void usage (char *pgm_p);
+static int batch (char *batchFile_p, bool skipUnchanged);
+static bool write_field (char *arg_p, bool skipUnchanged, bool *skipped_p);
+static bool write_field_args (int argc, char *argv[]);
 
 int
 main (int argc, char *argv[])
@@ -18,22 +24,51 @@ main (int argc, char *argv[])
 	int ret=1;
 	int addr, value;
 	uint32_t before, after;
+	char *batchFile_p = NULL;
+	bool skipUnchanged = false;
 	struct option longOpts[] = {
 		{"help", no_argument, NULL, 'h'},
+		{"batch", required_argument, NULL, 'b'},
+		{"skip-unchanged", no_argument, NULL, 'u'},
+		{"stats", no_argument, NULL, 'S'},
 		{NULL, 0, NULL, 0},
 	};
 
 	while (1) {
-		c = getopt_long(argc, argv, "h", longOpts, NULL);
+		c = getopt_long(argc, argv, "hb:uS", longOpts, NULL);
 		if (c == -1)
 			break;
 		switch (c) {
 			case 'h':
 				usage(argv[0]);
 				return 0;
+			case 'b':
+				batchFile_p = optarg;
+				break;
+			case 'u':
+				skipUnchanged = true;
+				break;
+			case 'S':
+				if (!lpc32x0__stats_start("-"))
+					return 1;
+				break;
 		}
 	}
 
+	if (batchFile_p != NULL) {
+		if (argc != optind) {
+			printf("no <addr> <value> with --batch\n");
+			usage(argv[0]);
+			return 1;
+		}
+		return batch(batchFile_p, skipUnchanged);
+	}
+
+	// a field: <reg>[<bits>]=<value>, maybe split up by the shell at blanks
+	for (c=optind; c<argc; ++c)
+		if (strchr(argv[c], '=') != NULL)
+			return write_field_args(argc - optind, &argv[optind])? 0 : 1;
+
 	// there should be 2 arguments left over
 	if (argc != (optind+2)) {
 		printf("incorrect number of cmdline arguments\n");
@@ -81,4 +116,267 @@ usage (char *pgm_p)
 	printf("set the contents of a register at <addr> to a given <value>\n");
 	printf("usage:\n");
 	printf("  %s <addr> <value>\n", pgm_p);
+	printf("  %s <reg>[<bits>]=<value>\n", pgm_p);
+	printf("  %s [-u|--skip-unchanged] -b|--batch <file>\n", pgm_p);
+	printf("  (any of which can take -S|--stats)\n");
+	printf("  where:\n");
+	printf("    -b|--batch <file>     apply the writes in <file> ('-' for stdin), one\n");
+	printf("                          '<addr> <value> [<mask>]' per line, in order; with a\n");
+	printf("                          mask only those bits are changed ('#' starts a comment);\n");
+	printf("                          a line can also be '<reg>[<bits>]=<value>'; lines are\n");
+	printf("                          at most 254 characters\n");
+	printf("    -u|--skip-unchanged   don't write registers that already hold the value\n");
+	printf("    -S|--stats            print per-register access statistics at exit\n");
+	printf("    <reg>[<bits>]=<value> set just the field <bits> (<bit>, <high>:<low> or a\n");
+	printf("                          field name) of <reg> (a name or an address), e.g.\n");
+	printf("                          P3_OUTP_STATE[30]=1 (blanks around the '=' are fine);\n");
+	printf("                          registers with SET/CLR registers are changed through\n");
+	printf("                          those, others are read-modify-written\n");
+}
+
+// drop the blanks at the end of 'str_p'
+static void
+trim_end (char *str_p)
+{
+	size_t len = strlen(str_p);
+
+	while ((len > 0) && ((str_p[len-1] == ' ') || (str_p[len-1] == '\t')))
+		str_p[--len] = 0;
+}
+
+/*
+ * write "<reg>[<bits>]=<value>" and print a one-line summary
+ * there can be blanks around the '=', and a '#' comment after the value
+ */
+static bool
+write_field (char *arg_p, bool skipUnchanged, bool *skipped_p)
+{
+	char *eq_p, *val_p, *end_p;
+	unsigned long value;
+	uint32_t before = 0, after;
+	bool readable;
+	FieldHandle_t field;
+
+	if (skipped_p != NULL)
+		*skipped_p = false;
+	arg_p += strspn(arg_p, " \t");
+	arg_p[strcspn(arg_p, "\r\n#")] = 0;
+	eq_p = strchr(arg_p, '=');
+	if (eq_p == NULL)
+		return false;
+	*eq_p = 0;
+	trim_end(arg_p);
+	val_p = eq_p + 1 + strspn(eq_p + 1, " \t");
+	trim_end(val_p);
+
+	value = strtoul(val_p, &end_p, 0);
+	if ((end_p == val_p) || (*end_p != 0)) {
+		printf("can't convert '%s' to a value\n", val_p);
+		return false;
+	}
+	if (!lpc32x0__resolve_field(arg_p, &field)) {
+		printf("can't resolve field '%s'\n", arg_p);
+		return false;
+	}
+	if (value > (field.mask >> field.low)) {
+		printf("0x%lx doesn't fit in %s\n", value, arg_p);
+		return false;
+	}
+
+	readable = ((field.reg.access & accessRead) != 0);
+	if (readable) {
+		before = lpc32x0__read_field(&field);
+		if (skipUnchanged && (before == value)) {
+			printf("  %-24s 0x%x unchanged\n", arg_p, before);
+			if (skipped_p != NULL)
+				*skipped_p = true;
+			return true;
+		}
+	}
+	lpc32x0__write_field(&field, (uint32_t)value);
+
+	if (readable) {
+		after = lpc32x0__read_field(&field);
+		printf("  %-24s 0x%x -> 0x%x", arg_p, before, after);
+	}
+	else
+		printf("  %-24s <- 0x%lx", arg_p, value);
+	if (field.setClr)
+		printf(" (%s/%s)\n", field.set.desc_p->name_p, field.clr.desc_p->name_p);
+	else
+		printf(" (read-modify-write)\n");
+	return true;
+}
+
+/*
+ * a field write given as more than one argument, e.g. the shell's
+ * "P3_OUTP_STATE[29]", "=", "1" for "P3_OUTP_STATE[29] = 1"
+ */
+static bool
+write_field_args (int argc, char *argv[])
+{
+	int i;
+	bool ret;
+	size_t len = 1;
+	char *arg_p;
+
+	for (i=0; i<argc; ++i)
+		len += strlen(argv[i]) + 1;
+	arg_p = malloc(len);
+	if (arg_p == NULL) {
+		perror("malloc()");
+		return false;
+	}
+	*arg_p = 0;
+	for (i=0; i<argc; ++i) {
+		strcat(arg_p, argv[i]);
+		strcat(arg_p, " ");
+	}
+	ret = write_field(arg_p, false, NULL);
+	free(arg_p);
+	return ret;
+}
+
+/*
+ * parse the next number on the line; false at the end of the line
+ */
+static bool
+next_number (char **p_p, uint32_t *val_p)
+{
+	char *end_p;
+	unsigned long val;
+
+	*p_p += strspn(*p_p, " \t\r\n");
+	if ((**p_p == 0) || (**p_p == '#'))
+		return false;
+	val = strtoul(*p_p, &end_p, 0);
+	if ((end_p == *p_p) || ((*end_p != 0) && (strchr(" \t\r\n#", *end_p) == NULL)) || (val > 0xffffffff)) {
+		*val_p = 0;
+		*p_p = NULL;
+		return false;
+	}
+	*val_p = (uint32_t)val;
+	*p_p = end_p;
+	return true;
+}
+
+/*
+ * all the writes are applied by this one process, so /dev/mem is opened
+ * once and the library's mapping cache keeps the pages mapped between
+ * writes; each write gets a single summary line instead of full decodes
+ * the first bad line stops the batch
+ */
+static int
+batch (char *batchFile_p, bool skipUnchanged)
+{
+	FILE *file_p;
+	char buf[256];
+	char *p;
+	unsigned lineNo = 0, writes = 0, skipped = 0;
+	uint32_t addr, value, mask, extra, before, after;
+	bool readable, masked, skip;
+	size_t i, cnt;
+	uint64_t start;
+	RegisterDescription_t **regs_pp;
+	int c, ret = 1;
+
+	if (strcmp(batchFile_p, "-") == 0)
+		file_p = stdin;
+	else {
+		file_p = fopen(batchFile_p, "r");
+		if (file_p == NULL) {
+			perror(batchFile_p);
+			return 1;
+		}
+	}
+
+	start = lpc32x0__now_ns();
+	while (fgets(buf, sizeof(buf), file_p) != NULL) {
+		++lineNo;
+		// a line that doesn't fit would be taken as two
+		if (strchr(buf, '\n') == NULL) {
+			c = getc(file_p);
+			if ((c != EOF) && (c != '\n')) {
+				printf("line %u: longer than %zu characters\n", lineNo, sizeof(buf) - 2);
+				goto out;
+			}
+		}
+		p = buf;
+		if ((strchr(buf, '[') != NULL) && (strchr(buf, '=') != NULL)
+				&& ((strchr(buf, '#') == NULL) || (strchr(buf, '#') > strchr(buf, '=')))) {
+			if (!write_field(buf, skipUnchanged, &skip)) {
+				printf("line %u: bad field write\n", lineNo);
+				goto out;
+			}
+			if (skip)
+				++skipped;
+			else
+				++writes;
+			continue;
+		}
+		if (!next_number(&p, &addr)) {
+			if (p == NULL)
+				goto badline;
+			continue;
+		}
+		if (!next_number(&p, &value))
+			goto badline;
+		mask = 0xffffffff;
+		masked = next_number(&p, &mask);
+		if (p == NULL)
+			goto badline;
+		// nothing else is allowed on the line
+		if (next_number(&p, &extra) || (p == NULL))
+			goto badline;
+
+		regs_pp = lpc32x0__find_reg(addr, &cnt);
+		if (regs_pp == NULL) {
+			printf("line %u: no register at 0x%08x\n", lineNo, addr);
+			goto out;
+		}
+		readable = false;
+		for (i=0; i<cnt; ++i)
+			if (regs_pp[i]->access & accessRead)
+				readable = true;
+		if (masked && !readable) {
+			printf("line %u: %s (%08x) can't be read, so it can't be masked\n",
+					lineNo, regs_pp[0]->name_p, addr);
+			goto out;
+		}
+
+		if (readable) {
+			if (!lpc32x0__get_reg(addr, &before)) {
+				printf("line %u: can't get register at addr 0x%08x\n", lineNo, addr);
+				goto out;
+			}
+			value = (before & ~mask) | (value & mask);
+			if (skipUnchanged && (before == value)) {
+				printf("  %-15s (%08x) 0x%08x unchanged\n", regs_pp[0]->name_p, addr, before);
+				++skipped;
+				continue;
+			}
+		}
+
+		if (!lpc32x0__set_reg(addr, value)) {
+			printf("line %u: can't set register 0x%08x to 0x%08x\n", lineNo, addr, value);
+			goto out;
+		}
+		++writes;
+
+		if (readable && lpc32x0__get_reg(addr, &after))
+			printf("  %-15s (%08x) 0x%08x -> 0x%08x\n", regs_pp[0]->name_p, addr, before, after);
+		else
+			printf("  %-15s (%08x) <- 0x%08x\n", regs_pp[0]->name_p, addr, value);
+	}
+	ret = 0;
+	goto out;
+
+badline:
+	printf("line %u: expected '<addr> <value> [<mask>]'\n", lineNo);
+out:
+	printf("%u write%s, %u skipped in %.3f ms\n", writes, (writes == 1)? "" : "s", skipped,
+			(double)(lpc32x0__now_ns() - start) / 1e6);
+	if (file_p != stdin)
+		fclose(file_p);
+	return ret;
 }
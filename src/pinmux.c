@@ -6,501 +6,270 @@
 #include <stdio.h>
 #include "registers.h"
 
-static void
-pinmux__uartctrl (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[11]", "UART3_MD_CTRL");
-	field = print_field(val, 11, 11);
-	if (field == 0)
-		printf("UART3 does not use modem control pins");
-	else
-		printf("UART3 uses modem control pins");
-	printf("\n");
-
-	printf(ITEMFMT, "[10]", "HDPX_INV");
-	field = print_field(val, 10, 10);
-	if (field == 0)
-		printf("IRRX6 is not inverted");
-	else
-		printf("IRRX6 is inverted");
-	printf("\n");
-
-	printf(ITEMFMT, "[9]", "HDPX_EN");
-	field = print_field(val, 9, 9);
-	if (field == 0)
-		printf("IRRX6 is not disabled by TXD");
-	else
-		printf("IRRX6 is masked while TXD is low");
-	printf("\n");
-
-	printf(ITEMFMT, "[8:6]", "(reserved)");
-	field = print_field(val, 8, 6);
-	printf("\n");
-
-	printf(ITEMFMT, "[5]", "UART6_IRDA");
-	field = print_field(val, 5, 5);
-	if (field == 0)
-		printf("UART6 uses the IrDA modem");
-	else
-		printf("UART6 bypasses the IrDA modem");
-	printf("\n");
-
-	printf(ITEMFMT, "[4]", "IRTX6_INV");
-	field = print_field(val, 4, 4);
-	if (field == 0)
-		printf("IRTX6 is not inverted");
-	else
-		printf("IRTX6 is inverted");
-	printf("\n");
-
-	printf(ITEMFMT, "[3]", "IRRX6_INV");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("IRRX6 is not inverted");
-	else
-		printf("IRRX6 is inverted");
-	printf("\n");
-
-	printf(ITEMFMT, "[2]", "IR_RxLength");
-	field = print_field(val, 2, 2);
-	if (field == 0)
-		printf("the IrDA expects Rx pulses 3/16 of the selected bit period");
-	else
-		printf("the IrDA expects Rx pulses 3/16 of a 115.2kbps bit period");
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "IR_TxLength");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("the IrDA Tx uses 3/16 of the selected bit period");
-	else
-		printf("the IrDA Tx uses 3/16 of a 115.2kbps bit period");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "UART5_MODE");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("UART5 TX/RX is only routed to the U5_TX and U5_RX pins");
-	else
-		printf("UART5 TX/RX function is also routed to the USB D+ and D- pins");
-}
-
-static void
-pinmux__ms (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[31:11]", "(reserved)");
-	print_field(val, 31, 11);
-	printf("\n");
-
-	printf(ITEMFMT, "[10]", "disable SD card pins");
-	field = print_field(val, 10, 10);
-	if (field == 1)
-		printf("disable SD card pins");
-	else
-		printf("enable SD card pins");
-	printf("\n");
-
-	printf(ITEMFMT, "[9]", "enables clock and pull-ups");
-	field = print_field(val, 9, 9);
-	if (field == 0)
-		printf("MSSDIO pull-up and clock disabled");
-	else
-		printf("MSSDIO pull-up and clock enabled");
-	printf("\n");
-
-	printf(ITEMFMT, "[8]", "MSSDIO2 and MSSDIO3 pad control");
-	field = print_field(val, 8, 8);
-	if (field == 0)
-		printf("MSSDIO2 and 3 pad has pull-up enabled");
-	else
-		printf("MSSDIO2 and 3 pad has no pull-up");
-	printf("\n");
-
-	printf(ITEMFMT, "[7]", "MSSDIO1 pad control");
-	field = print_field(val, 7, 7);
-	if (field == 0)
-		printf("MSSDIO1 pad has pull-up enabled");
-	else
-		printf("MDDSIO1 pad has no pull-up");
-	printf("\n");
-
-	printf(ITEMFMT, "[6]", "MSSDIO0/MSBS pad control");
-	field = print_field(val, 6, 6);
-	if (field == 0)
-		printf("MSSDIO0 pad has pull-up enabled");
-	else
-		printf("MSSDIO0 pad has no pull-up");
-	printf("\n");
-
-	printf(ITEMFMT, "[5]", "SD card clock control");
-	field = print_field(val, 5, 5);
-	if (field == 0)
-		printf("clocks disabled");
-	else
-		printf("clocks enabled");
-	printf("\n");
-
-	printf(ITEMFMT, "[4]", "(reserved)");
-	print_field(val, 4, 4);
-	printf("\n");
-
-	printf(ITEMFMT, "[3:0]", "clock divider ratio");
-	field = print_field(val, 3, 0);
-	if (field == 0)
-		printf("MSSDCLK stopped, divider in low power mode");
-	else
-		printf("MSSDCLK = ARM PLL output clock divided by %d", field);
-	printf("\n");
-}
-
-static void
-pinmux__state (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[31:16]", "(reserved)");
-	print_field(val, 31, 16);
-	printf("\n");
-
-	printf(ITEMFMT, "[15]", "U7_TX / MAT1.1 | LCDVD[11]");
-	field = print_field(val, 15, 15);
-	if (field == 1)
-		printf("MAT1.1");
-	else
-		printf("U7_TX");
-	printf(", unless LCD is enabled in which case LCDVD[11]\n");
-
-	printf(ITEMFMT, "[14:13]", "(reserved)");
-	print_field(val, 14, 13);
-	printf("\n");
-
-	printf(ITEMFMT, "[12]", "SPI1_CLK / SCK0");
-	field = print_field(val, 12, 12);
-	if (field == 1)
-		printf("SCK0");
-	else
-		printf("SPI1_CLK");
-	printf("\n");
-
-	printf(ITEMFMT, "[11]", "(reserved)");
-	print_field(val, 11, 11);
-	printf("\n");
-
-	printf(ITEMFMT, "[10]", "SPI1_DATIN / MISO0 / MCFB2");
-	field = print_field(val, 10, 10);
-	if (field == 1)
-		printf("MISO0, unless TIMCLK_CTRL1[6] == 1");
-	else
-		printf("SPI1_DATIN");
-	printf("\n");
-
-	printf(ITEMFMT, "[9]", "SPI1_DATIO / MOSI0 / MCFB1");
-	field = print_field(val, 9, 9);
-	if (field == 1)
-		printf("MOSI0, unless TIMCLK_CTRL1[6] == 1");
-	else
-		printf("SPI1_DATIO");
-	printf("\n");
-
-	printf(ITEMFMT, "[8]", "SPI2_CLK / SCK1 | LCDVD[23]");
-	field = print_field(val, 8, 8);
-	if (field == 1)
-		printf("SCK1");
-	else
-		printf("SPI2_CLK");
-	printf(", unless LCD is enabled in which case LCDVD[12]\n");
-
-	printf(ITEMFMT, "[7]", "(reserved)");
-	print_field(val, 7, 7);
-	printf("\n");
-
-	printf(ITEMFMT, "[6]", "SPI2_DATIN / MISO1 | LCDVD[21]");
-	field = print_field(val, 6, 6);
-	if (field == 1)
-		printf("MISO1");
-	else
-		printf("SPI2_DATIN");
-	printf(", unless LCD is enabled in which case LCDVD[21]\n");
-
-	printf(ITEMFMT, "[5]", "SPI2_DATIO / MOSI1 | LCDVD[20]");
-	field = print_field(val, 5, 5);
-	if (field == 1)
-		printf("MOSI1");
-	else
-		printf("SPI2_DATIO");
-	printf(", unless LCD is enabled in which case LCDVD[20]\n");
-
-	printf(ITEMFMT, "[4]", "I2S1TX_WS / CAP3.0");
-	field = print_field(val, 4, 4);
-	if (field == 1)
-		printf("CAP3.0");
-	else
-		printf("I2S1TX_WS");
-	printf("\n");
-
-	printf(ITEMFMT, "[3]", "I2S1TX_CLK / MAT3.0");
-	field = print_field(val, 3, 3);
-	if (field == 1)
-		printf("CAP3.0");
-	else
-		printf("I2S1TX_CLK");
-	printf("\n");
-
-	printf(ITEMFMT, "[2]", "I2S1TX_SDA / MAT3.1");
-	field = print_field(val, 2, 2);
-	if (field == 1)
-		printf("MAT3.1");
-	else
-		printf("I2S1TX_SDA");
-	printf("\n");
-
-	printf(ITEMFMT, "[1:0]", "(reserved)");
-	print_field(val, 1, 0);
-}
-
-static void
-pinmux__p0state (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[31:8]", "(reserved)");
-	print_field(val, 31, 8);
-	printf("\n");
-
-	printf(ITEMFMT, "[7]", "P0.7 / L2S0TX_WS | LCDVD[13]");
-	field = print_field(val, 7, 7);
-	if (field == 1)
-		printf("I2S0TX_WS");
-	else
-		printf("P0.7");
-	printf(", unless LCD is enabled in which case LCDVD[13]\n");
-
-	printf(ITEMFMT, "[6]", "P0.6 / I2S0TX_CLK | LCDVD[12]");
-	field = print_field(val, 6, 6);
-	if (field == 1)
-		printf("I2S0TX_CLK");
-	else
-		printf("P0.6");
-	printf(", unless LCD is enabled in which case LCDVD[12]\n");
-
-	printf(ITEMFMT, "[5]", "P0.5 / I2S0TX_SDA | LCDVD[7]");
-	field = print_field(val, 5, 5);
-	if (field == 1)
-		printf("I2S0TX_SDA");
-	else
-		printf("P0.5");
-	printf(", unless LCD is enabled in which case LCDVD[7]\n");
-
-	printf(ITEMFMT, "[4]", "P0.4 / I2S0RX_WS | LCDVD[6]");
-	field = print_field(val, 4, 4);
-	if (field == 1)
-		printf("I2S0RX_WS");
-	else
-		printf("P0.4");
-	printf(", unless LCD is enabled in which case LCDVD[6]\n");
-
-	printf(ITEMFMT, "[3]", "P0.3 / I2S0RX_CLK | LCDVD[5]");
-	field = print_field(val, 3, 3);
-	if (field == 1)
-		printf("I2S0RX_CLK");
-	else
-		printf("P0.3");
-	printf(", unless LCD is enabled in which case LCDVD[5]\n");
-
-	printf(ITEMFMT, "[2]", "P0.2 / I2S0RX_SDA | LCDVD[4]");
-	field = print_field(val, 2, 2);
-	if (field == 1)
-		printf("I2S0RX_SDA");
-	else
-		printf("P0.2");
-	printf(", unless LCD is enabled in which case LCDVD[4]\n");
-
-	printf(ITEMFMT, "[1]", "P0.1 / I2S1RX_WS");
-	field = print_field(val, 1, 1);
-	if (field == 1)
-		printf("I2S1RX_WS");
-	else
-		printf("P0.1");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "P0.0 / I2S1RX_CLK");
-	field = print_field(val, 0, 0);
-	if (field == 1)
-		printf("I2S1RX_CLK");
-	else
-		printf("P0.0");
-	printf("\n");
-}
-
-static void
-pinmux__p1state (uint32_t val)
-{
-	int i;
-	uint32_t field;
-	char buf1[32];
-	char buf2[32];
-
-	printf(ITEMFMT, "[31:24]", "(reserved)");
-	print_field(val, 31, 24);
-	printf("\n");
-
-	for (i=23; i>-1; --i) {
-		sprintf(buf1, "[%d]", i);
-		sprintf(buf2, "EMC_A[%02d] / P1.%d", i, i);
-		printf(ITEMFMT, buf1, buf2);
-		field = print_field(val, i, i);
-		if (field == 1)
-			printf("P1.%d", i);
-		else
-			printf("EMC_A[%02d]", i);
-		printf("\n");
-	}
-}
-
-static void
-pinmux__p2state (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[31:6]", "(reserved)");
-	print_field(val, 31, 6);
-	printf("\n");
-
-	printf(ITEMFMT, "[5]", "GPIO_5 / SSEL0 / MCFB0");
-	field = print_field(val, 5, 5);
-	if (field == 1)
-		printf("SSEL0, unless TIMCLK_CTRL1[6] == 1 in which case MCFB0");
-	else
-		printf("GPIO_5");
-	printf("\n");
-
-	printf(ITEMFMT, "[4]", "GPIO_4 / SSEL1 | LCDVD[22]");
-	field = print_field(val, 4, 4);
-	if (field == 1)
-		printf("SSEL1");
-	else
-		printf("GPIO_4");
-	printf(", unless LCD is enabled in which case LCDVD[22]\n");
-
-	printf(ITEMFMT, "[3]", "EMC_D_SEL");
-	field = print_field(val, 3, 3);
-	if (field == 1)
-		printf("EMC_D[31:19] pins are connected to the GPIO block");
-	printf("\n");
-
-	printf(ITEMFMT, "[2]", "GPO_21 / U4_TX | LCDVD[3]");
-	field = print_field(val, 2, 2);
-	if (field == 1)
-		printf("U4_TX");
-	else
-		printf("GPO_21");
-	printf(", unless LCD is enabled in which case LCDVD[3]\n");
-
-	printf(ITEMFMT, "[1]", "GPIO_3 / KEY_ROW7 | ENET_MDIO");
-	field = print_field(val, 1, 1);
-	if (field == 1)
-		printf("KEY_ROW7");
-	else
-		printf("GPIO_3");
-	printf(", unless ethernet MAC is enabled in which case ENET_MDIO\n");
-
-	printf(ITEMFMT, "[0]", "GPIO_2 / KEY_ROW6 | ENET_MDC");
-	field = print_field(val, 0, 0);
-	if (field == 1)
-		printf("KEY_ROW6");
-	else
-		printf("GPIO_2");
-	printf(", unless ethernet MAC is enabled in which case ENET_MDC\n");
-}
-
-static void
-pinmux__p3state (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[31:19]", "(reserved)");
-	print_field(val, 31, 19);
-	printf("\n");
-
-	printf(ITEMFMT, "[18]", "GPO_18 / MC0A / LCDLP");
-	field = print_field(val, 18, 18);
-	if (field == 1)
-		printf("MC0A if TIMCLK_CTRL1[6] == 1");
-	else
-		printf("GPO_18");
-	printf(", unless LCD is enabled in which case LCDVD[0]\n");
-
-	printf(ITEMFMT, "[17]", "(reserved)");
-	print_field(val, 17, 17);
-	printf("\n");
-
-	printf(ITEMFMT, "[16]", "GPO_16 / MC0B / LCDENAB / LCDM");
-	field = print_field(val, 16, 16);
-	if (field == 1)
-		printf("MC0B if TIMCLK_CTRL[6] == 1");
-	else
-		printf("GPO_16");
-	printf(", unless LCD is enabled in which case LCDENAB / LCDM\n");
+static const char * const md[] = {"UART3 does not use modem control pins", "UART3 uses modem control pins"};
+static const char * const hdpxInv[] = {"IRRX6 is not inverted", "IRRX6 is inverted"};
+static const char * const hdpxEn[] = {"IRRX6 is not disabled by TXD", "IRRX6 is masked while TXD is low"};
+static const char * const irda[] = {"UART6 uses the IrDA modem", "UART6 bypasses the IrDA modem"};
+static const char * const irtxInv[] = {"IRTX6 is not inverted", "IRTX6 is inverted"};
+static const char * const rxLength[] = {
+	"the IrDA expects Rx pulses 3/16 of the selected bit period",
+	"the IrDA expects Rx pulses 3/16 of a 115.2kbps bit period",
+};
+static const char * const txLength[] = {
+	"the IrDA Tx uses 3/16 of the selected bit period",
+	"the IrDA Tx uses 3/16 of a 115.2kbps bit period",
+};
+static const char * const uart5Mode[] = {
+	"UART5 TX/RX is only routed to the U5_TX and U5_RX pins",
+	"UART5 TX/RX function is also routed to the USB D+ and D- pins",
+};
 
-	printf(ITEMFMT, "[15]", "GPO_15 / MC1A / LCDFP");
-	field = print_field(val, 15, 15);
-	if (field == 1)
-		printf("MC1A if TIMCLK_CTRL1[6] == 1");
-	else
-		printf("GPO_15");
-	printf(", unless LCD is enabled in which case LCDFP\n");
+static const FieldDescription_t pinmux__uartctrl[] = {
+	{.high=11, .low=11, .name_p="UART3_MD_CTRL", FIELDTEXT(md)},
+	{.high=10, .low=10, .name_p="HDPX_INV", FIELDTEXT(hdpxInv)},
+	{.high=9,  .low=9,  .name_p="HDPX_EN", FIELDTEXT(hdpxEn)},
+	{.high=8,  .low=6,  .name_p="(reserved)"},
+	{.high=5,  .low=5,  .name_p="UART6_IRDA", FIELDTEXT(irda)},
+	{.high=4,  .low=4,  .name_p="IRTX6_INV", FIELDTEXT(irtxInv)},
+	{.high=3,  .low=3,  .name_p="IRRX6_INV", FIELDTEXT(hdpxInv)},
+	{.high=2,  .low=2,  .name_p="IR_RxLength", FIELDTEXT(rxLength)},
+	{.high=1,  .low=1,  .name_p="IR_TxLength", FIELDTEXT(txLength)},
+	{.high=0,  .low=0,  .name_p="UART5_MODE", FIELDTEXT(uart5Mode)},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[14]", "(reserved)");
-	print_field(val, 14, 14);
-	printf("\n");
+static const char * const sdPins[] = {"enable SD card pins", "disable SD card pins"};
+static const char * const mssdio[] = {"MSSDIO pull-up and clock disabled", "MSSDIO pull-up and clock enabled"};
+static const char * const mssdio23[] = {"MSSDIO2 and 3 pad has pull-up enabled", "MSSDIO2 and 3 pad has no pull-up"};
+static const char * const mssdio1[] = {"MSSDIO1 pad has pull-up enabled", "MDDSIO1 pad has no pull-up"};
+static const char * const mssdio0[] = {"MSSDIO0 pad has pull-up enabled", "MSSDIO0 pad has no pull-up"};
+static const char * const sdClock[] = {"clocks disabled", "clocks enabled"};
+static const char * const msDiv[] = {"MSSDCLK stopped, divider in low power mode"};
+
+static const FieldDescription_t pinmux__ms[] = {
+	{.high=31, .low=11, .name_p="(reserved)"},
+	{.high=10, .low=10, .name_p="disable SD card pins", FIELDTEXT(sdPins)},
+	{.high=9,  .low=9,  .name_p="enables clock and pull-ups", FIELDTEXT(mssdio)},
+	{.high=8,  .low=8,  .name_p="MSSDIO2 and MSSDIO3 pad control", FIELDTEXT(mssdio23)},
+	{.high=7,  .low=7,  .name_p="MSSDIO1 pad control", FIELDTEXT(mssdio1)},
+	{.high=6,  .low=6,  .name_p="MSSDIO0/MSBS pad control", FIELDTEXT(mssdio0)},
+	{.high=5,  .low=5,  .name_p="SD card clock control", FIELDTEXT(sdClock)},
+	{.high=4,  .low=4,  .name_p="(reserved)"},
+	{.high=3,  .low=0,  .name_p="clock divider ratio", FIELDTEXT(msDiv), .fmt_p="MSSDCLK = ARM PLL output clock divided by %d", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[13]", "GPO_13 / MC1B / LCDDCLK");
-	field = print_field(val, 13, 13);
-	if (field == 1)
-		printf("MC1B if TIMCLK_CTRL1[6] == 1");
-	else
-		printf("GPO_13");
-	printf(", unless LCD is enabled in which case LCDDCLK\n");
+static const char * const u7tx[] = {
+	"U7_TX, unless LCD is enabled in which case LCDVD[11]",
+	"MAT1.1, unless LCD is enabled in which case LCDVD[11]",
+};
+static const char * const sck0[] = {"SPI1_CLK", "SCK0"};
+static const char * const miso0[] = {"SPI1_DATIN", "MISO0, unless TIMCLK_CTRL1[6] == 1"};
+static const char * const mosi0[] = {"SPI1_DATIO", "MOSI0, unless TIMCLK_CTRL1[6] == 1"};
+static const char * const sck1[] = {
+	"SPI2_CLK, unless LCD is enabled in which case LCDVD[12]",
+	"SCK1, unless LCD is enabled in which case LCDVD[12]",
+};
+static const char * const miso1[] = {
+	"SPI2_DATIN, unless LCD is enabled in which case LCDVD[21]",
+	"MISO1, unless LCD is enabled in which case LCDVD[21]",
+};
+static const char * const mosi1[] = {
+	"SPI2_DATIO, unless LCD is enabled in which case LCDVD[20]",
+	"MOSI1, unless LCD is enabled in which case LCDVD[20]",
+};
+static const char * const cap30[] = {"I2S1TX_WS", "CAP3.0"};
+static const char * const mat30[] = {"I2S1TX_CLK", "MAT3.0"};
+static const char * const mat31[] = {"I2S1TX_SDA", "MAT3.1"};
+
+static const FieldDescription_t pinmux__state[] = {
+	{.high=31, .low=16, .name_p="(reserved)"},
+	{.high=15, .low=15, .name_p="U7_TX / MAT1.1 | LCDVD[11]", FIELDTEXT(u7tx)},
+	{.high=14, .low=13, .name_p="(reserved)"},
+	{.high=12, .low=12, .name_p="SPI1_CLK / SCK0", FIELDTEXT(sck0)},
+	{.high=11, .low=11, .name_p="(reserved)"},
+	{.high=10, .low=10, .name_p="SPI1_DATIN / MISO0 / MCFB2", FIELDTEXT(miso0)},
+	{.high=9,  .low=9,  .name_p="SPI1_DATIO / MOSI0 / MCFB1", FIELDTEXT(mosi0)},
+	{.high=8,  .low=8,  .name_p="SPI2_CLK / SCK1 | LCDVD[23]", FIELDTEXT(sck1)},
+	{.high=7,  .low=7,  .name_p="(reserved)"},
+	{.high=6,  .low=6,  .name_p="SPI2_DATIN / MISO1 | LCDVD[21]", FIELDTEXT(miso1)},
+	{.high=5,  .low=5,  .name_p="SPI2_DATIO / MOSI1 | LCDVD[20]", FIELDTEXT(mosi1)},
+	{.high=4,  .low=4,  .name_p="I2S1TX_WS / CAP3.0", FIELDTEXT(cap30)},
+	{.high=3,  .low=3,  .name_p="I2S1TX_CLK / MAT3.0", FIELDTEXT(mat30)},
+	{.high=2,  .low=2,  .name_p="I2S1TX_SDA / MAT3.1", FIELDTEXT(mat31)},
+	{.high=1,  .low=0,  .name_p="(reserved)"},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[12]", "GPO_12 / MC2A / LCDLE");
-	field = print_field(val, 12, 12);
-	if (field == 1)
-		printf("KC2A if TIMCLK_CTRL1[6] == 1");
-	else
-		printf("GPO_12");
-	printf(", unless LCD is enabled in which case LCDLE\n");
+static const char * const p0_7[] = {
+	"P0.7, unless LCD is enabled in which case LCDVD[13]",
+	"I2S0TX_WS, unless LCD is enabled in which case LCDVD[13]",
+};
+static const char * const p0_6[] = {
+	"P0.6, unless LCD is enabled in which case LCDVD[12]",
+	"I2S0TX_CLK, unless LCD is enabled in which case LCDVD[12]",
+};
+static const char * const p0_5[] = {
+	"P0.5, unless LCD is enabled in which case LCDVD[7]",
+	"I2S0TX_SDA, unless LCD is enabled in which case LCDVD[7]",
+};
+static const char * const p0_4[] = {
+	"P0.4, unless LCD is enabled in which case LCDVD[6]",
+	"I2S0RX_WS, unless LCD is enabled in which case LCDVD[6]",
+};
+static const char * const p0_3[] = {
+	"P0.3, unless LCD is enabled in which case LCDVD[5]",
+	"I2S0RX_CLK, unless LCD is enabled in which case LCDVD[5]",
+};
+static const char * const p0_2[] = {
+	"P0.2, unless LCD is enabled in which case LCDVD[4]",
+	"I2S0RX_SDA, unless LCD is enabled in which case LCDVD[4]",
+};
+static const char * const p0_1[] = {"P0.1", "I2S1RX_WS"};
+static const char * const p0_0[] = {"P0.0", "I2S1RX_CLK"};
+
+static const FieldDescription_t pinmux__p0state[] = {
+	{.high=31, .low=8, .name_p="(reserved)"},
+	{.high=7, .low=7, .name_p="P0.7 / L2S0TX_WS | LCDVD[13]", FIELDTEXT(p0_7)},
+	{.high=6, .low=6, .name_p="P0.6 / I2S0TX_CLK | LCDVD[12]", FIELDTEXT(p0_6)},
+	{.high=5, .low=5, .name_p="P0.5 / I2S0TX_SDA | LCDVD[7]", FIELDTEXT(p0_5)},
+	{.high=4, .low=4, .name_p="P0.4 / I2S0RX_WS | LCDVD[6]", FIELDTEXT(p0_4)},
+	{.high=3, .low=3, .name_p="P0.3 / I2S0RX_CLK | LCDVD[5]", FIELDTEXT(p0_3)},
+	{.high=2, .low=2, .name_p="P0.2 / I2S0RX_SDA | LCDVD[4]", FIELDTEXT(p0_2)},
+	{.high=1, .low=1, .name_p="P0.1 / I2S1RX_WS", FIELDTEXT(p0_1)},
+	{.high=0, .low=0, .name_p="P0.0 / I2S1RX_CLK", FIELDTEXT(p0_0), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[11]", "(reserved)");
-	print_field(val, 11, 11);
-	printf("\n");
+static const char * const p1_23[] = {"EMC_A[23]", "P1.23"};
+static const char * const p1_22[] = {"EMC_A[22]", "P1.22"};
+static const char * const p1_21[] = {"EMC_A[21]", "P1.21"};
+static const char * const p1_20[] = {"EMC_A[20]", "P1.20"};
+static const char * const p1_19[] = {"EMC_A[19]", "P1.19"};
+static const char * const p1_18[] = {"EMC_A[18]", "P1.18"};
+static const char * const p1_17[] = {"EMC_A[17]", "P1.17"};
+static const char * const p1_16[] = {"EMC_A[16]", "P1.16"};
+static const char * const p1_15[] = {"EMC_A[15]", "P1.15"};
+static const char * const p1_14[] = {"EMC_A[14]", "P1.14"};
+static const char * const p1_13[] = {"EMC_A[13]", "P1.13"};
+static const char * const p1_12[] = {"EMC_A[12]", "P1.12"};
+static const char * const p1_11[] = {"EMC_A[11]", "P1.11"};
+static const char * const p1_10[] = {"EMC_A[10]", "P1.10"};
+static const char * const p1_9[] = {"EMC_A[09]", "P1.9"};
+static const char * const p1_8[] = {"EMC_A[08]", "P1.8"};
+static const char * const p1_7[] = {"EMC_A[07]", "P1.7"};
+static const char * const p1_6[] = {"EMC_A[06]", "P1.6"};
+static const char * const p1_5[] = {"EMC_A[05]", "P1.5"};
+static const char * const p1_4[] = {"EMC_A[04]", "P1.4"};
+static const char * const p1_3[] = {"EMC_A[03]", "P1.3"};
+static const char * const p1_2[] = {"EMC_A[02]", "P1.2"};
+static const char * const p1_1[] = {"EMC_A[01]", "P1.1"};
+static const char * const p1_0[] = {"EMC_A[00]", "P1.0"};
+
+static const FieldDescription_t pinmux__p1state[] = {
+	{.high=31, .low=24, .name_p="(reserved)"},
+	{.high=23, .low=23, .name_p="EMC_A[23] / P1.23", FIELDTEXT(p1_23)},
+	{.high=22, .low=22, .name_p="EMC_A[22] / P1.22", FIELDTEXT(p1_22)},
+	{.high=21, .low=21, .name_p="EMC_A[21] / P1.21", FIELDTEXT(p1_21)},
+	{.high=20, .low=20, .name_p="EMC_A[20] / P1.20", FIELDTEXT(p1_20)},
+	{.high=19, .low=19, .name_p="EMC_A[19] / P1.19", FIELDTEXT(p1_19)},
+	{.high=18, .low=18, .name_p="EMC_A[18] / P1.18", FIELDTEXT(p1_18)},
+	{.high=17, .low=17, .name_p="EMC_A[17] / P1.17", FIELDTEXT(p1_17)},
+	{.high=16, .low=16, .name_p="EMC_A[16] / P1.16", FIELDTEXT(p1_16)},
+	{.high=15, .low=15, .name_p="EMC_A[15] / P1.15", FIELDTEXT(p1_15)},
+	{.high=14, .low=14, .name_p="EMC_A[14] / P1.14", FIELDTEXT(p1_14)},
+	{.high=13, .low=13, .name_p="EMC_A[13] / P1.13", FIELDTEXT(p1_13)},
+	{.high=12, .low=12, .name_p="EMC_A[12] / P1.12", FIELDTEXT(p1_12)},
+	{.high=11, .low=11, .name_p="EMC_A[11] / P1.11", FIELDTEXT(p1_11)},
+	{.high=10, .low=10, .name_p="EMC_A[10] / P1.10", FIELDTEXT(p1_10)},
+	{.high=9,  .low=9,  .name_p="EMC_A[09] / P1.9", FIELDTEXT(p1_9)},
+	{.high=8,  .low=8,  .name_p="EMC_A[08] / P1.8", FIELDTEXT(p1_8)},
+	{.high=7,  .low=7,  .name_p="EMC_A[07] / P1.7", FIELDTEXT(p1_7)},
+	{.high=6,  .low=6,  .name_p="EMC_A[06] / P1.6", FIELDTEXT(p1_6)},
+	{.high=5,  .low=5,  .name_p="EMC_A[05] / P1.5", FIELDTEXT(p1_5)},
+	{.high=4,  .low=4,  .name_p="EMC_A[04] / P1.4", FIELDTEXT(p1_4)},
+	{.high=3,  .low=3,  .name_p="EMC_A[03] / P1.3", FIELDTEXT(p1_3)},
+	{.high=2,  .low=2,  .name_p="EMC_A[02] / P1.2", FIELDTEXT(p1_2)},
+	{.high=1,  .low=1,  .name_p="EMC_A[01] / P1.1", FIELDTEXT(p1_1)},
+	{.high=0,  .low=0,  .name_p="EMC_A[00] / P1.0", FIELDTEXT(p1_0), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[10]", "GPO_10 / MC2B / LCDPWR");
-	field = print_field(val, 10, 10);
-	if (field == 1)
-		printf("MC2B if TIMCLK_CTRL1[6] == 1");
-	else
-		printf("GPO_10");
-	printf(", unless LCD is enabled in which case LCDPWR\n");
+static const char * const ssel0[] = {"GPIO_5", "SSEL0, unless TIMCLK_CTRL1[6] == 1 in which case MCFB0"};
+static const char * const ssel1[] = {
+	"GPIO_4, unless LCD is enabled in which case LCDVD[22]",
+	"SSEL1, unless LCD is enabled in which case LCDVD[22]",
+};
+static const char * const emcDSel[] = {"", "EMC_D[31:19] pins are connected to the GPIO block"};
+static const char * const u4tx[] = {
+	"GPO_21, unless LCD is enabled in which case LCDVD[3]",
+	"U4_TX, unless LCD is enabled in which case LCDVD[3]",
+};
+static const char * const keyRow7[] = {
+	"GPIO_3, unless ethernet MAC is enabled in which case ENET_MDIO",
+	"KEY_ROW7, unless ethernet MAC is enabled in which case ENET_MDIO",
+};
+static const char * const keyRow6[] = {
+	"GPIO_2, unless ethernet MAC is enabled in which case ENET_MDC",
+	"KEY_ROW6, unless ethernet MAC is enabled in which case ENET_MDC",
+};
 
-	printf(ITEMFMT, "[9:3]", "(reserved)");
-	print_field(val, 9, 3);
-	printf("\n");
+static const FieldDescription_t pinmux__p2state[] = {
+	{.high=31, .low=6, .name_p="(reserved)"},
+	{.high=5,  .low=5, .name_p="GPIO_5 / SSEL0 / MCFB0", FIELDTEXT(ssel0)},
+	{.high=4,  .low=4, .name_p="GPIO_4 / SSEL1 | LCDVD[22]", FIELDTEXT(ssel1)},
+	{.high=3,  .low=3, .name_p="EMC_D_SEL", FIELDTEXT(emcDSel)},
+	{.high=2,  .low=2, .name_p="GPO_21 / U4_TX | LCDVD[3]", FIELDTEXT(u4tx)},
+	{.high=1,  .low=1, .name_p="GPIO_3 / KEY_ROW7 | ENET_MDIO", FIELDTEXT(keyRow7)},
+	{.high=0,  .low=0, .name_p="GPIO_2 / KEY_ROW6 | ENET_MDC", FIELDTEXT(keyRow6), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[2]", "GPO_2 / MAT1.0 | LCDVD[0]");
-	field = print_field(val, 2, 2);
-	if (field == 1)
-		printf("MAT1.0");
-	else
-		printf("GPO_2");
-	printf(", unless LCD is enabled in which case LCDVD[0]\n");
+static const char * const mc0a[] = {
+	"GPO_18, unless LCD is enabled in which case LCDVD[0]",
+	"MC0A if TIMCLK_CTRL1[6] == 1, unless LCD is enabled in which case LCDVD[0]",
+};
+static const char * const mc0b[] = {
+	"GPO_16, unless LCD is enabled in which case LCDENAB / LCDM",
+	"MC0B if TIMCLK_CTRL[6] == 1, unless LCD is enabled in which case LCDENAB / LCDM",
+};
+static const char * const mc1a[] = {
+	"GPO_15, unless LCD is enabled in which case LCDFP",
+	"MC1A if TIMCLK_CTRL1[6] == 1, unless LCD is enabled in which case LCDFP",
+};
+static const char * const mc1b[] = {
+	"GPO_13, unless LCD is enabled in which case LCDDCLK",
+	"MC1B if TIMCLK_CTRL1[6] == 1, unless LCD is enabled in which case LCDDCLK",
+};
+static const char * const mc2a[] = {
+	"GPO_12, unless LCD is enabled in which case LCDLE",
+	"KC2A if TIMCLK_CTRL1[6] == 1, unless LCD is enabled in which case LCDLE",
+};
+static const char * const mc2b[] = {
+	"GPO_10, unless LCD is enabled in which case LCDPWR",
+	"MC2B if TIMCLK_CTRL1[6] == 1, unless LCD is enabled in which case LCDPWR",
+};
+static const char * const mat10[] = {
+	"GPO_2, unless LCD is enabled in which case LCDVD[0]",
+	"MAT1.0, unless LCD is enabled in which case LCDVD[0]",
+};
 
-	printf(ITEMFMT, "[1:0]", "(reserved)");
-	print_field(val, 1, 0);
-}
+static const FieldDescription_t pinmux__p3state[] = {
+	{.high=31, .low=19, .name_p="(reserved)"},
+	{.high=18, .low=18, .name_p="GPO_18 / MC0A / LCDLP", FIELDTEXT(mc0a)},
+	{.high=17, .low=17, .name_p="(reserved)"},
+	{.high=16, .low=16, .name_p="GPO_16 / MC0B / LCDENAB / LCDM", FIELDTEXT(mc0b)},
+	{.high=15, .low=15, .name_p="GPO_15 / MC1A / LCDFP", FIELDTEXT(mc1a)},
+	{.high=14, .low=14, .name_p="(reserved)"},
+	{.high=13, .low=13, .name_p="GPO_13 / MC1B / LCDDCLK", FIELDTEXT(mc1b)},
+	{.high=12, .low=12, .name_p="GPO_12 / MC2A / LCDLE", FIELDTEXT(mc2a)},
+	{.high=11, .low=11, .name_p="(reserved)"},
+	{.high=10, .low=10, .name_p="GPO_10 / MC2B / LCDPWR", FIELDTEXT(mc2b)},
+	{.high=9,  .low=3,  .name_p="(reserved)"},
+	{.high=2,  .low=2,  .name_p="GPO_2 / MAT1.0 | LCDVD[0]", FIELDTEXT(mat10)},
+	{.high=1,  .low=0,  .name_p="(reserved)"},
+	{.name_p=NULL},
+};
 
 RegisterDescription_t pinmux[] = {
 	{0x40004090, 0, "MAC_CLK_CTRL", "Ethernet MAC clock control", accessRW, NULL},
@@ -8,21 +8,25 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <time.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <unistd.h>
-#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
 #include "registers.h"
+#include "sim.h"
+#include "trace.h"
+#include "stats.h"
 
 void
 print_access (Access_e access)
 {
 	if (access & accessRead)
-		printf("R");
+		putchar('R');
 	if (access & accessWrite)
-		printf("W");
+		putchar('W');
 }
 
 /*
@@ -47,14 +51,21 @@ get_field (uint32_t val, unsigned high, unsigned low)
 	return ((val & mask) >> low);
 }
 
+/*
+ * a field's bits are printed as "\t\t\t0b<bits>" padded with dots to a fixed
+ * width; the line is built in place from a template and written in one go
+ * since this is called for every field of every verbose decode
+ */
+#define FIELDLINE_PREFIX "\t\t\t0b"
+#define FIELDLINE_WIDTH  (3 + 35)
+static const char fieldLineTemplate_G[FIELDLINE_WIDTH + 1] = FIELDLINE_PREFIX ".................................";
+
 uint32_t
 print_field (uint32_t val, unsigned high, unsigned low)
 {
-	uint32_t bits;
-	uint32_t i;
-	uint32_t mask1bit;
-	char buf[40];
-	size_t pos;
+	unsigned i, bits;
+	char buf[FIELDLINE_WIDTH];
+	char *bits_p;
 
 	// preconds
 	if (high < low)
@@ -65,22 +76,117 @@ print_field (uint32_t val, unsigned high, unsigned low)
 	bits = (high - low) + 1;
 	val = get_field(val, high, low);
 
-	memset(buf, '.', sizeof(buf));
-	buf[0] = '0';
-	buf[1] = 'b';
-	pos = 2;
-	for (i=0,mask1bit=(1<<(bits-1)); i<bits; ++i,mask1bit>>=1) {
-		if (val&mask1bit)
-			buf[pos++] = '1';
-		else
-			buf[pos++] = '0';
-	}
-	buf[35] = 0;
+	memcpy(buf, fieldLineTemplate_G, sizeof(buf));
+	bits_p = &buf[sizeof(FIELDLINE_PREFIX) - 1];
+	for (i=0; i<bits; ++i)
+		bits_p[i] = (val & (1u << (bits - 1 - i)))? '1' : '0';
 
-	printf("\t\t\t%s", buf);
+	fwrite(buf, 1, sizeof(buf), stdout);
 	return val;
 }
 
+/*
+ * stdout is line buffered when it's a terminal (e.g. a serial console) and a
+ * verbose decode is thousands of short lines; switch stdout to a large,
+ * fully-buffered output buffer so it's written in big chunks
+ * this must be called before anything is written to stdout, and output then
+ * only appears when the buffer fills, on fflush(stdout), or at exit
+ */
+static char outBuf_G[64 * 1024];
+
+void
+lpc32x0__buffer_output (void)
+{
+	setvbuf(stdout, outBuf_G, _IOFBF, sizeof(outBuf_G));
+}
+
+/*
+ * decode 'val' according to the field table of 'reg_p'
+ * nothing is printed or allocated; returns false if the register has no
+ * field table
+ */
+bool
+lpc32x0__decode_reg (const RegisterDescription_t *reg_p, uint32_t val, DecodedReg_t *dec_p)
+{
+	unsigned idx;
+	const FieldDescription_t *field_p;
+	DecodedField_t *out_p;
+
+	if ((reg_p == NULL) || (dec_p == NULL))
+		return false;
+
+	dec_p->reg_p = reg_p;
+	dec_p->val = val;
+	dec_p->cnt = 0;
+	if (reg_p->fields_p == NULL)
+		return false;
+
+	for (field_p=reg_p->fields_p; (field_p->name_p != NULL) && (dec_p->cnt < MAX_FIELDS); ++field_p) {
+		out_p = &dec_p->fields[dec_p->cnt++];
+		out_p->field_p = field_p;
+		out_p->value = get_field(val, field_p->high, field_p->low);
+		out_p->text_p = NULL;
+
+		idx = out_p->value;
+		if (field_p->flags & fieldQualified)
+			idx += get_field(val, field_p->qualBit, field_p->qualBit) << (field_p->high - field_p->low + 1);
+		if ((idx < field_p->textSZ) && (field_p->text_pp[idx] != NULL))
+			out_p->text_p = field_p->text_pp[idx];
+		else if (field_p->fmt_p == NULL)
+			out_p->text_p = (field_p->flags & fieldNoHeader)? field_p->name_p : "";
+	}
+	return true;
+}
+
+/*
+ * the text of a decoded field; formulas are formatted into 'buf_p'
+ */
+const char *
+lpc32x0__field_text (const DecodedField_t *field_p, char *buf_p, size_t bufSZ)
+{
+	if (field_p->text_p != NULL)
+		return field_p->text_p;
+	snprintf(buf_p, bufSZ, field_p->field_p->fmt_p, (int)field_p->value + field_p->field_p->offset);
+	return buf_p;
+}
+
+void
+lpc32x0__print_decoded (const DecodedReg_t *dec_p)
+{
+	size_t i;
+	char bits[12];
+	char buf[128];
+	const FieldDescription_t *field_p;
+
+	for (i=0; i<dec_p->cnt; ++i) {
+		field_p = dec_p->fields[i].field_p;
+		// a header ends its own line
+		if ((i != 0) && !(dec_p->fields[i-1].field_p->flags & fieldHeaderOnly))
+			printf("\n");
+		if (field_p->flags & fieldNoRange)
+			bits[0] = 0;
+		else if (field_p->high == field_p->low)
+			snprintf(bits, sizeof(bits), "[%u]", field_p->high);
+		else
+			snprintf(bits, sizeof(bits), "[%u:%u]", field_p->high, field_p->low);
+		if (!(field_p->flags & fieldNoHeader))
+			printf(ITEMFMT, bits, field_p->name_p);
+		if (field_p->flags & fieldHeaderOnly)
+			continue;
+		if (field_p->flags & fieldNoBits)
+			printf("\t\t\t");
+		else
+			print_field(dec_p->val, field_p->high, field_p->low);
+		if ((field_p->flags & fieldNoHeader) && (bits[0] != 0))
+			printf("%s ", bits);
+		fputs(lpc32x0__field_text(&dec_p->fields[i], buf, sizeof(buf)), stdout);
+		if ((i == (dec_p->cnt - 1)) && (field_p->flags & fieldEOL))
+			printf("\n");
+		if ((i == (dec_p->cnt - 1)) && (field_p->flags & fieldBlankLine))
+			printf("\n");
+	}
+}
+
 extern RegisterDescription_t clkpower[];
 extern size_t clkpowerSZ;
 extern RegisterDescription_t gpdma[];
@@ -138,156 +244,1019 @@ AllRegisters_t AllRegisters_G[] = {
 };
 size_t AllRegistersSZ = sizeof(AllRegisters_G)/sizeof(AllRegisters_G[0]);
 
-// let's reuse these between invocations
-// this is not thread safe!
-static int memFd_G = -1;
-static void *map_pG = NULL;
-static uint32_t curBase_G = 0;
+/*
+ * lookup index: every description from every set in AllRegisters_G, sorted
+ * by address
+ *
+ * some registers are described in more than one set (e.g. SPI_CTRL is in
+ * both "clkpwr" and "spi", LCDCLK_CTRL and LCD_CFG share an address) so an
+ * address can have a run of several entries; within a run the entries are
+ * kept in AllRegisters_G order so the first one found is the same one the
+ * old table walk would have found
+ *
+ * the index is built once, on first use, and never changes afterwards so it
+ * is shared by all contexts
+ */
+typedef struct {
+	RegisterDescription_t *reg_p;
+	size_t order;
+} IndexEntry_t;
+
+static RegisterDescription_t **regIndex_pG = NULL;
+static size_t regIndexSZ_G = 0;
+static pthread_once_t regIndexOnce_G = PTHREAD_ONCE_INIT;
+
+static int
+index_entry_cmp (const void *a_p, const void *b_p)
+{
+	const IndexEntry_t *a = a_p;
+	const IndexEntry_t *b = b_p;
+
+	if (a->reg_p->addr != b->reg_p->addr)
+		return (a->reg_p->addr < b->reg_p->addr)? -1 : 1;
+	if (a->order != b->order)
+		return (a->order < b->order)? -1 : 1;
+	return 0;
+}
 
 static void
-cleanup (void)
+build_index_once (void)
 {
-	if (memFd_G != -1) {
-		close(memFd_G);
-		memFd_G = -1;
+	size_t i, idx, cnt;
+	IndexEntry_t *entries_p;
+
+	cnt = 0;
+	for (idx=0; idx<AllRegistersSZ; ++idx)
+		cnt += *(AllRegisters_G[idx].sz_p);
+
+	entries_p = malloc(cnt * sizeof(*entries_p));
+	regIndex_pG = malloc(cnt * sizeof(*regIndex_pG));
+	if ((entries_p == NULL) || (regIndex_pG == NULL)) {
+		perror("malloc()");
+		free(entries_p);
+		free(regIndex_pG);
+		regIndex_pG = NULL;
+		return;
 	}
-	if (map_pG != NULL) {
-		munmap(map_pG, 0x00001000);
-		map_pG = NULL;
+
+	cnt = 0;
+	for (idx=0; idx<AllRegistersSZ; ++idx) {
+		for (i=0; i<*(AllRegisters_G[idx].sz_p); ++i) {
+			entries_p[cnt].reg_p = &AllRegisters_G[idx].reg_p[i];
+			entries_p[cnt].order = cnt;
+			++cnt;
+		}
 	}
+	qsort(entries_p, cnt, sizeof(*entries_p), index_entry_cmp);
+
+	for (i=0; i<cnt; ++i)
+		regIndex_pG[i] = entries_p[i].reg_p;
+	regIndexSZ_G = cnt;
+	free(entries_p);
+}
+
+static bool
+build_index (void)
+{
+	pthread_once(&regIndexOnce_G, build_index_once);
+	return (regIndex_pG != NULL);
+}
+
+/*
+ * the whole index, sorted by address; a register's position in it can be
+ * used as a dense key (see diff.c)
+ */
+RegisterDescription_t **
+lpc32x0__reg_index (size_t *cnt_p)
+{
+	*cnt_p = 0;
+	if (!build_index())
+		return NULL;
+	*cnt_p = regIndexSZ_G;
+	return regIndex_pG;
+}
+
+/*
+ * find all the descriptions of the register at 'addr'
+ * returns a pointer to the first one and sets *cnt_p to the number of
+ * consecutive descriptions that share the address, or returns NULL if
+ * the address isn't described by any set
+ */
+RegisterDescription_t **
+lpc32x0__find_reg (uint32_t addr, size_t *cnt_p)
+{
+	size_t lo, hi, mid, end;
+
+	if (cnt_p != NULL)
+		*cnt_p = 0;
+	if (!build_index())
+		return NULL;
+
+	// lower bound
+	lo = 0;
+	hi = regIndexSZ_G;
+	while (lo < hi) {
+		mid = lo + ((hi - lo) / 2);
+		if (regIndex_pG[mid]->addr < addr)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if ((lo == regIndexSZ_G) || (regIndex_pG[lo]->addr != addr))
+		return NULL;
+
+	for (end=lo+1; (end<regIndexSZ_G) && (regIndex_pG[end]->addr == addr); ++end)
+		;
+	if (cnt_p != NULL)
+		*cnt_p = end - lo;
+	return &regIndex_pG[lo];
+}
+
+/*
+ * contexts
+ *
+ * a context owns a backend (/dev/mem, or a simulated image; see backend.c)
+ * and a cache of mapping windows;
+ * every 4KiB page that gets touched stays mapped for the life of the context
+ * since tools tend to bounce between a handful of peripherals (e.g. SPI1 and
+ * SPI2, SSP0 and SSP1) and remapping one window each time the page changes
+ * costs two syscalls and a TLB flush for nearly every access
+ *
+ * the most recently used window is checked first, then the rest of the
+ * windows; if all MAP_WINDOWS are in use the oldest one is dropped, unless
+ * it is pinned because a register handle points into it
+ *
+ * contexts aren't locked; threads that want to access registers concurrently
+ * should each open their own context
+ * the lpc32x0__* functions that don't take a context use a default one which
+ * is opened on first use and closed at exit; if LPC32X0_TRACE is set the
+ * default context traces its accesses to that file (see trace.c), and if
+ * LPC32X0_STATS is set it counts them and writes the counts to that file
+ * ("-" for stdout) at exit (see stats.c)
+ *
+ * the counting is compiled in only if LPC32X0_STATS is defined (see the
+ * cmake option); when it is, a context that isn't counting pays a test per
+ * lpc32x0__get_reg()/set_reg() and nothing per handle access
+ */
+#define MAP_PAGESZ  0x00001000
+#define MAP_WINDOWS 32
+
+#ifdef LPC32X0_STATS
+#define STATS_ON(ctx_p) ((ctx_p)->stats_p != NULL)
+#else
+#define STATS_ON(ctx_p) ((void)(ctx_p), false)
+#endif
+
+typedef struct {
+	uint32_t base;
+	void *map_p;
+	bool pinned;
+} MapWindow_t;
+
+struct lpc32x0_ctx {
+	const Lpc32x0Backend_t *backend_p;
+	const char *backendArg_p;
+	void *backendState_p;
+	MapWindow_t windows[MAP_WINDOWS];
+	size_t windowCnt;
+	size_t nextEvict;
+	MapWindow_t *lastWindow_p;
+	MapStats_t mapStats;
+	Trace_t *trace_p;
+	AccessStats_t *stats_p;
+	char *statsFile_p;
+	RegHook_t instrHook;
+};
+
+static Lpc32x0Ctx_t defaultCtx_G;
+
+static inline uint64_t
+stats_clock (Lpc32x0Ctx_t *ctx_p)
+{
+	struct timespec ts;
+
+	if (!STATS_ON(ctx_p))
+		return 0;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+static void
+write_stats (Lpc32x0Ctx_t *ctx_p)
+{
+	FILE *file_p;
+
+	if (strcmp(ctx_p->statsFile_p, "-") == 0) {
+		stats_print(ctx_p->stats_p, stdout);
+		fflush(stdout);
+		return;
+	}
+	file_p = fopen(ctx_p->statsFile_p, "w");
+	if (file_p == NULL) {
+		perror(ctx_p->statsFile_p);
+		return;
+	}
+	stats_print(ctx_p->stats_p, file_p);
+	if (fclose(file_p) != 0)
+		perror(ctx_p->statsFile_p);
+}
+
+static void
+ctx_release (Lpc32x0Ctx_t *ctx_p)
+{
+	size_t i;
+
+	trace_close(ctx_p->trace_p);
+	ctx_p->trace_p = NULL;
+	if (ctx_p->stats_p != NULL) {
+		if (ctx_p->statsFile_p != NULL)
+			write_stats(ctx_p);
+		stats_close(ctx_p->stats_p);
+		ctx_p->stats_p = NULL;
+	}
+	free(ctx_p->statsFile_p);
+	ctx_p->statsFile_p = NULL;
+
+	for (i=0; i<ctx_p->windowCnt; ++i) {
+		(*ctx_p->backend_p->unmap_fp)(ctx_p->backendState_p, ctx_p->windows[i].map_p, MAP_PAGESZ);
+		++ctx_p->mapStats.unmaps;
+	}
+	ctx_p->windowCnt = 0;
+	ctx_p->nextEvict = 0;
+	ctx_p->lastWindow_p = NULL;
+
+	if (ctx_p->backendState_p != NULL) {
+		(*ctx_p->backend_p->close_fp)(ctx_p->backendState_p);
+		ctx_p->backendState_p = NULL;
+	}
+}
+
+static void
+cleanup (void)
+{
+	ctx_release(&defaultCtx_G);
+}
+
+/*
+ * the backend used when none is chosen: the simulator if LPC32X0_SIM is
+ * set (to an image file, or empty for an anonymous image), else /dev/mem
+ */
+static void
+choose_backend (Lpc32x0Ctx_t *ctx_p)
+{
+	if (ctx_p->backend_p != NULL)
+		return;
+	ctx_p->backendArg_p = getenv("LPC32X0_SIM");
+	if (ctx_p->backendArg_p != NULL)
+		ctx_p->backend_p = &lpc32x0__sim_backend;
+	else
+		ctx_p->backend_p = &lpc32x0__devmem_backend;
 }
 
 static bool
-open_dev_mem (void)
+load_sim_capture (Lpc32x0Ctx_t *ctx_p)
 {
-	if (memFd_G == -1) {
-		memFd_G = open("/dev/mem", O_RDWR | O_SYNC);
-		if (memFd_G == -1) {
-			perror("open(/dev/mem)");
+	int fd;
+	bool ret;
+	const char *capture_p;
+
+	capture_p = getenv("LPC32X0_SIM_CAPTURE");
+	if ((ctx_p->backend_p != &lpc32x0__sim_backend) || (capture_p == NULL))
+		return true;
+
+	fd = open(capture_p, O_RDONLY);
+	if (fd == -1) {
+		perror(capture_p);
+		return false;
+	}
+	ret = lpc32x0__ctx_load_capture(ctx_p, fd);
+	close(fd);
+	return ret;
+}
+
+static bool
+open_backend (Lpc32x0Ctx_t *ctx_p)
+{
+	if (ctx_p->backendState_p == NULL) {
+		choose_backend(ctx_p);
+		ctx_p->backendState_p = (*ctx_p->backend_p->open_fp)(ctx_p->backendArg_p);
+		if (ctx_p->backendState_p == NULL)
 			return false;
-		}
-		atexit(cleanup);
+		if (ctx_p == &defaultCtx_G)
+			atexit(cleanup);
+		if (!load_sim_capture(ctx_p))
+			return false;
+		if ((ctx_p == &defaultCtx_G) && (getenv("LPC32X0_TRACE") != NULL))
+			if (!lpc32x0__ctx_trace_start(ctx_p, getenv("LPC32X0_TRACE")))
+				return false;
+		if ((ctx_p == &defaultCtx_G) && (getenv("LPC32X0_STATS") != NULL) && (ctx_p->stats_p == NULL))
+			if (!lpc32x0__ctx_stats_start(ctx_p, getenv("LPC32X0_STATS")))
+				return false;
 	}
 	return true;
 }
 
-static bool
-set_mapping (uint32_t addr)
-{
-	uint32_t newBase;
-
-	// set/reset base mapping
-	newBase = addr & 0xfffff000;
-	if (curBase_G != newBase) {
-		curBase_G = newBase;
-		if (map_pG != NULL)
-			munmap(map_pG, 0x00001000);
-		map_pG = mmap(NULL, 0x1000, PROT_READ | PROT_WRITE, MAP_SHARED, memFd_G, curBase_G);
-		if (map_pG == MAP_FAILED) {
-			perror("mmap()");
+/*
+ * open a context on the given backend; 'arg_p' is passed to the backend
+ * (e.g. the sim backend's image file)
+ */
+Lpc32x0Ctx_t *
+lpc32x0__ctx_open_backend (const Lpc32x0Backend_t *backend_p, const char *arg_p)
+{
+	Lpc32x0Ctx_t *ctx_p;
+
+	ctx_p = calloc(1, sizeof(*ctx_p));
+	if (ctx_p == NULL) {
+		perror("calloc()");
+		return NULL;
+	}
+	ctx_p->backend_p = backend_p;
+	ctx_p->backendArg_p = arg_p;
+	if (!open_backend(ctx_p)) {
+		ctx_release(ctx_p);
+		free(ctx_p);
+		return NULL;
+	}
+	return ctx_p;
+}
+
+Lpc32x0Ctx_t *
+lpc32x0__ctx_open (void)
+{
+	return lpc32x0__ctx_open_backend(NULL, NULL);
+}
+
+void
+lpc32x0__ctx_close (Lpc32x0Ctx_t *ctx_p)
+{
+	if ((ctx_p == NULL) || (ctx_p == &defaultCtx_G))
+		return;
+	ctx_release(ctx_p);
+	free(ctx_p);
+}
+
+/*
+ * choose the default context's backend; only possible before its first use
+ */
+bool
+lpc32x0__set_backend (const Lpc32x0Backend_t *backend_p, const char *arg_p)
+{
+	if (defaultCtx_G.backendState_p != NULL)
+		return false;
+	defaultCtx_G.backend_p = backend_p;
+	defaultCtx_G.backendArg_p = arg_p;
+	return true;
+}
+
+Lpc32x0Ctx_t *
+lpc32x0__default_ctx (void)
+{
+	return &defaultCtx_G;
+}
+
+/*
+ * returns a pointer to the register at 'addr' within its (possibly new)
+ * mapping window, or NULL if the page can't be mapped
+ * if 'pin' is set the window will never be dropped from the cache
+ */
+static volatile uint32_t *
+set_mapping (Lpc32x0Ctx_t *ctx_p, uint32_t addr, bool pin)
+{
+	size_t i, tries;
+	uint32_t base;
+	void *map_p;
+	MapWindow_t *window_p;
+
+	base = addr & ~(uint32_t)(MAP_PAGESZ - 1);
+	window_p = ctx_p->lastWindow_p;
+	if ((window_p == NULL) || (window_p->base != base)) {
+		window_p = NULL;
+		for (i=0; i<ctx_p->windowCnt; ++i)
+			if (ctx_p->windows[i].base == base) {
+				window_p = &ctx_p->windows[i];
+				break;
+			}
+	}
+
+	if (window_p == NULL) {
+		map_p = (*ctx_p->backend_p->map_fp)(ctx_p->backendState_p, base, MAP_PAGESZ);
+		if (map_p == NULL)
+			return NULL;
+		++ctx_p->mapStats.maps;
+		if (STATS_ON(ctx_p))
+			stats_map(ctx_p->stats_p, addr);
+
+		if (ctx_p->windowCnt < MAP_WINDOWS)
+			window_p = &ctx_p->windows[ctx_p->windowCnt++];
+		else {
+			for (tries=0; tries<MAP_WINDOWS; ++tries) {
+				window_p = &ctx_p->windows[ctx_p->nextEvict];
+				ctx_p->nextEvict = (ctx_p->nextEvict + 1) % MAP_WINDOWS;
+				if (!window_p->pinned)
+					break;
+			}
+			if (window_p->pinned) {
+				printf("all %d mapping windows are pinned\n", MAP_WINDOWS);
+				(*ctx_p->backend_p->unmap_fp)(ctx_p->backendState_p, map_p, MAP_PAGESZ);
+				++ctx_p->mapStats.unmaps;
+				return NULL;
+			}
+			(*ctx_p->backend_p->unmap_fp)(ctx_p->backendState_p, window_p->map_p, MAP_PAGESZ);
+			++ctx_p->mapStats.unmaps;
+		}
+		window_p->base = base;
+		window_p->map_p = map_p;
+		window_p->pinned = false;
+	}
+	else
+		++ctx_p->mapStats.hits;
+
+	if (pin)
+		window_p->pinned = true;
+
+	ctx_p->lastWindow_p = window_p;
+	return (volatile uint32_t*)((uintptr_t)window_p->map_p + (addr & (MAP_PAGESZ - 1)));
+}
+
+/*
+ * unmap every window that isn't pinned; the next access to one of those
+ * pages maps it again
+ */
+void
+lpc32x0__ctx_drop_mappings (Lpc32x0Ctx_t *ctx_p)
+{
+	size_t i, kept = 0;
+
+	for (i=0; i<ctx_p->windowCnt; ++i) {
+		if (ctx_p->windows[i].pinned) {
+			ctx_p->windows[kept++] = ctx_p->windows[i];
+			continue;
+		}
+		(*ctx_p->backend_p->unmap_fp)(ctx_p->backendState_p, ctx_p->windows[i].map_p, MAP_PAGESZ);
+		++ctx_p->mapStats.unmaps;
+	}
+	ctx_p->windowCnt = kept;
+	ctx_p->nextEvict = 0;
+	ctx_p->lastWindow_p = NULL;
+}
+
+/*
+ * the backend's hook for the register at 'addr', if it models it
+ */
+static const RegHook_t *
+find_hook (Lpc32x0Ctx_t *ctx_p, uint32_t addr)
+{
+	if (ctx_p->backend_p->hook_fp == NULL)
+		return NULL;
+	return (*ctx_p->backend_p->hook_fp)(ctx_p->backendState_p, addr);
+}
+
+/*
+ * handles resolved while the context is tracing or counting use these: the
+ * access goes to the backend's hook or the image, then is recorded and/or
+ * counted
+ */
+static uint32_t
+instr_read (void *dev_p, uint32_t addr)
+{
+	uint32_t val = 0xffffffff;
+	uint64_t t0, t1;
+	volatile uint32_t *reg_p;
+	const RegHook_t *hook_p;
+	Lpc32x0Ctx_t *ctx_p = dev_p;
+
+	hook_p = find_hook(ctx_p, addr);
+	reg_p = (hook_p == NULL)? set_mapping(ctx_p, addr, false) : NULL;
+	t0 = stats_clock(ctx_p);
+	if (hook_p != NULL)
+		val = (*hook_p->read_fp)(hook_p->dev_p, addr);
+	else if (reg_p != NULL)
+		val = *reg_p;
+	t1 = stats_clock(ctx_p);
+	if (ctx_p->trace_p != NULL)
+		trace_record(ctx_p->trace_p, addr, val, false);
+	if (STATS_ON(ctx_p))
+		stats_access(ctx_p->stats_p, addr, false, 0, 0, t1 - t0);
+	return val;
+}
+
+static void
+instr_write (void *dev_p, uint32_t addr, uint32_t val)
+{
+	uint64_t t0, t1;
+	volatile uint32_t *reg_p;
+	const RegHook_t *hook_p;
+	Lpc32x0Ctx_t *ctx_p = dev_p;
+
+	hook_p = find_hook(ctx_p, addr);
+	reg_p = (hook_p == NULL)? set_mapping(ctx_p, addr, false) : NULL;
+	t0 = stats_clock(ctx_p);
+	if (hook_p != NULL)
+		(*hook_p->write_fp)(hook_p->dev_p, addr, val);
+	else if (reg_p != NULL)
+		*reg_p = val;
+	t1 = stats_clock(ctx_p);
+	if (ctx_p->trace_p != NULL)
+		trace_record(ctx_p->trace_p, addr, val, true);
+	if (STATS_ON(ctx_p))
+		stats_access(ctx_p->stats_p, addr, true, 0, 0, t1 - t0);
+}
+
+static void
+init_instr_hook (Lpc32x0Ctx_t *ctx_p)
+{
+	ctx_p->instrHook.read_fp = instr_read;
+	ctx_p->instrHook.write_fp = instr_write;
+	ctx_p->instrHook.dev_p = ctx_p;
+}
+
+/*
+ * trace the context's accesses to 'file_p' (see trace.c), until
+ * lpc32x0__ctx_trace_stop() or the context is closed
+ * handles resolved before the trace is started aren't traced; handles
+ * resolved while tracing cost a function call per access, even after the
+ * trace is stopped
+ */
+bool
+lpc32x0__ctx_trace_start (Lpc32x0Ctx_t *ctx_p, const char *file_p)
+{
+	if ((ctx_p == NULL) || (file_p == NULL) || (ctx_p->trace_p != NULL))
+		return false;
+	init_instr_hook(ctx_p);
+	ctx_p->trace_p = trace_open(file_p);
+	return (ctx_p->trace_p != NULL);
+}
+
+/*
+ * returns false if the trace couldn't be written completely
+ */
+bool
+lpc32x0__ctx_trace_stop (Lpc32x0Ctx_t *ctx_p)
+{
+	bool ret;
+
+	if ((ctx_p == NULL) || (ctx_p->trace_p == NULL))
+		return false;
+	ret = trace_close(ctx_p->trace_p);
+	ctx_p->trace_p = NULL;
+	return ret;
+}
+
+/*
+ * count the context's accesses per register (see stats.c); if 'file_p' is
+ * given the counts are written to it ("-" for stdout) when the context is
+ * closed, the default context's at exit
+ * as with tracing, only handles resolved after this are counted
+ * fails if the library was built without LPC32X0_STATS
+ */
+bool
+lpc32x0__ctx_stats_start (Lpc32x0Ctx_t *ctx_p, const char *file_p)
+{
+#ifdef LPC32X0_STATS
+	if ((ctx_p == NULL) || (ctx_p->stats_p != NULL))
+		return false;
+	if (file_p != NULL) {
+		ctx_p->statsFile_p = strdup(file_p);
+		if (ctx_p->statsFile_p == NULL) {
+			perror("strdup()");
 			return false;
 		}
 	}
+	init_instr_hook(ctx_p);
+	ctx_p->stats_p = stats_open();
+	return (ctx_p->stats_p != NULL);
+#else
+	(void)ctx_p;
+	(void)file_p;
+	printf("built without access statistics (LPC32X0_STATS)\n");
+	return false;
+#endif
+}
+
+bool
+lpc32x0__ctx_print_stats (Lpc32x0Ctx_t *ctx_p, FILE *file_p)
+{
+	if ((ctx_p == NULL) || (ctx_p->stats_p == NULL) || (file_p == NULL))
+		return false;
+	stats_print(ctx_p->stats_p, file_p);
+	return true;
+}
+
+static void
+store_word (uint32_t addr, uint32_t val, void *arg_p)
+{
+	size_t cnt;
+	volatile uint32_t *reg_p;
+
+	if (lpc32x0__find_reg(addr, &cnt) == NULL)
+		return;
+	reg_p = set_mapping(arg_p, addr, false);
+	if (reg_p != NULL)
+		*reg_p = val;
+}
+
+/*
+ * store the value of every known register found in a capture, without any
+ * access checks, to seed a simulated image; refused on /dev/mem
+ * registers the backend models keep their modelled state
+ */
+bool
+lpc32x0__ctx_load_capture (Lpc32x0Ctx_t *ctx_p, int fd)
+{
+	if (!open_backend(ctx_p))
+		return false;
+	if (ctx_p->backend_p == &lpc32x0__devmem_backend) {
+		printf("captures can only be loaded into a simulated image\n");
+		return false;
+	}
+	if (!lpc32x0__parse_capture(fd, store_word, ctx_p, NULL))
+		return false;
+	// the sim's models run at the capture's clocks
+	if (ctx_p->backend_p == &lpc32x0__sim_backend)
+		return sim_reclock(ctx_p->backendState_p);
 	return true;
 }
 
+void
+lpc32x0__ctx_get_map_stats (Lpc32x0Ctx_t *ctx_p, MapStats_t *stats_p)
+{
+	if ((ctx_p != NULL) && (stats_p != NULL))
+		*stats_p = ctx_p->mapStats;
+}
+
+/*
+ * false if the context isn't using the sim backend
+ */
 bool
-lpc32x0__get_reg (uint32_t addr, uint32_t *regRet_p)
+lpc32x0__ctx_get_spi_sim_stats (Lpc32x0Ctx_t *ctx_p, SpiSimStats_t *stats_p)
 {
-	size_t i, idx;
-	uint32_t offset;
+	if ((ctx_p == NULL) || (stats_p == NULL) || !open_backend(ctx_p))
+		return false;
+	if (ctx_p->backend_p != &lpc32x0__sim_backend)
+		return false;
+	return sim_get_spi_stats(ctx_p->backendState_p, stats_p);
+}
 
-	if (!open_dev_mem())
+bool
+lpc32x0__ctx_get_reg (Lpc32x0Ctx_t *ctx_p, uint32_t addr, uint32_t *regRet_p)
+{
+	size_t i, cnt;
+	uint64_t t0, t1, t2;
+	volatile uint32_t *reg_p = NULL;
+	const RegHook_t *hook_p;
+	RegisterDescription_t **regs_pp;
+
+	if (!open_backend(ctx_p))
 		return false;
 
 	*regRet_p = 0xffffffff;
-	for (idx=0; idx<AllRegistersSZ; ++idx) {
-		for (i=0; i<*(AllRegisters_G[idx].sz_p); ++i) {
-			if (AllRegisters_G[idx].reg_p[i].addr == addr) {
-				// check for readability
-				if (!(AllRegisters_G[idx].reg_p[i].access & accessRead)) {
-					printf("  %s (%08x) - skip non-readable\n", AllRegisters_G[idx].reg_p[i].name_p, addr);
-					continue;
-				}
-
-				if (!set_mapping(addr))
-					return false;
-				offset = addr & 0x00000fff;
-				*regRet_p = *(uint32_t*)((unsigned long)(map_pG) | (unsigned long)(offset));
-				return true;
-			}
+	t0 = stats_clock(ctx_p);
+	regs_pp = lpc32x0__find_reg(addr, &cnt);
+	t1 = stats_clock(ctx_p);
+	for (i=0; i<cnt; ++i) {
+		// check for readability
+		if (!(regs_pp[i]->access & accessRead)) {
+			printf("  %s (%08x) - skip non-readable\n", regs_pp[i]->name_p, addr);
+			continue;
 		}
+
+		hook_p = find_hook(ctx_p, addr);
+		if (hook_p == NULL) {
+			reg_p = set_mapping(ctx_p, addr, false);
+			if (reg_p == NULL)
+				return false;
+		}
+		t2 = stats_clock(ctx_p);
+		if (hook_p != NULL)
+			*regRet_p = (*hook_p->read_fp)(hook_p->dev_p, addr);
+		else
+			*regRet_p = *reg_p;
+		if (ctx_p->trace_p != NULL)
+			trace_record(ctx_p->trace_p, addr, *regRet_p, false);
+		if (STATS_ON(ctx_p))
+			stats_access(ctx_p->stats_p, addr, false, t1 - t0, t2 - t1, stats_clock(ctx_p) - t2);
+		return true;
 	}
 	return false;
 }
 
 bool
-lpc32x0__set_reg (uint32_t addr, uint32_t val)
+lpc32x0__ctx_set_reg (Lpc32x0Ctx_t *ctx_p, uint32_t addr, uint32_t val)
 {
-	size_t i, idx;
-	uint32_t offset;
+	size_t i, cnt;
+	uint64_t t0, t1, t2;
+	volatile uint32_t *reg_p = NULL;
+	const RegHook_t *hook_p;
+	RegisterDescription_t **regs_pp;
 
-	if (!open_dev_mem())
+	if (!open_backend(ctx_p))
 		return false;
 
-	for (idx=0; idx<AllRegistersSZ; ++idx) {
+	t0 = stats_clock(ctx_p);
+	regs_pp = lpc32x0__find_reg(addr, &cnt);
+	t1 = stats_clock(ctx_p);
+	for (i=0; i<cnt; ++i) {
+		// check for writeability
+		if (!(regs_pp[i]->access & accessWrite)) {
+			printf("  %s (%08x) - skip non-writeable\n", regs_pp[i]->name_p, addr);
+			continue;
+		}
+
+		hook_p = find_hook(ctx_p, addr);
+		if (hook_p == NULL) {
+			reg_p = set_mapping(ctx_p, addr, false);
+			if (reg_p == NULL)
+				return false;
+		}
+		t2 = stats_clock(ctx_p);
+		if (hook_p != NULL)
+			(*hook_p->write_fp)(hook_p->dev_p, addr, val);
+		else
+			*reg_p = val;
+		if (ctx_p->trace_p != NULL)
+			trace_record(ctx_p->trace_p, addr, val, true);
+		if (STATS_ON(ctx_p))
+			stats_access(ctx_p->stats_p, addr, true, t1 - t0, t2 - t1, stats_clock(ctx_p) - t2);
+		return true;
+	}
+	return false;
+}
+
+/*
+ * resolve the register at 'addr' once so it can be accessed repeatedly
+ * through lpc32x0__read()/lpc32x0__write() without any table searches
+ * the handle's access is the union of all the descriptions of the register
+ * and its mapping stays valid for the life of the context
+ */
+bool
+lpc32x0__ctx_resolve_reg (Lpc32x0Ctx_t *ctx_p, uint32_t addr, RegHandle_t *handle_p)
+{
+	size_t i, cnt;
+	RegisterDescription_t **regs_pp;
+
+	if (handle_p == NULL)
+		return false;
+	if (!open_backend(ctx_p))
+		return false;
+
+	regs_pp = lpc32x0__find_reg(addr, &cnt);
+	if (regs_pp == NULL)
+		return false;
+
+	handle_p->addr = addr;
+	handle_p->desc_p = regs_pp[0];
+	handle_p->access = 0;
+	for (i=0; i<cnt; ++i)
+		handle_p->access |= regs_pp[i]->access;
+	if ((ctx_p->trace_p != NULL) || STATS_ON(ctx_p))
+		handle_p->hook_p = &ctx_p->instrHook;
+	else
+		handle_p->hook_p = find_hook(ctx_p, addr);
+	handle_p->reg_p = set_mapping(ctx_p, addr, true);
+	if (handle_p->reg_p == NULL)
+		return false;
+	return true;
+}
+
+static RegisterDescription_t *
+find_reg_by_name (const char *name_p, size_t len)
+{
+	size_t i, idx;
+	RegisterDescription_t *reg_p;
+
+	for (idx=0; idx<AllRegistersSZ; ++idx)
 		for (i=0; i<*(AllRegisters_G[idx].sz_p); ++i) {
-			if (AllRegisters_G[idx].reg_p[i].addr == addr) {
-				// check for writeability
-				if (!(AllRegisters_G[idx].reg_p[i].access & accessWrite)) {
-					printf("  %s (%08x) - skip non-writeable\n", AllRegisters_G[idx].reg_p[i].name_p, addr);
-					continue;
-				}
-
-				if (!set_mapping(addr))
-					return false;
-				offset = addr & 0x00000fff;
-				*(uint32_t*)((unsigned long)(map_pG) | (unsigned long)(offset)) = val;
-				return true;
-			}
+			reg_p = &AllRegisters_G[idx].reg_p[i];
+			if ((strncmp(reg_p->name_p, name_p, len) == 0) && (reg_p->name_p[len] == 0))
+				return reg_p;
 		}
+	return NULL;
+}
+
+bool
+lpc32x0__ctx_resolve_reg_by_name (Lpc32x0Ctx_t *ctx_p, const char *name_p, RegHandle_t *handle_p)
+{
+	RegisterDescription_t *reg_p;
+
+	if (name_p == NULL)
+		return false;
+
+	reg_p = find_reg_by_name(name_p, strlen(name_p));
+	if (reg_p == NULL)
+		return false;
+	return lpc32x0__ctx_resolve_reg(ctx_p, reg_p->addr, handle_p);
+}
+
+/*
+ * look for the "*_SET" and "*_CLR" registers that go with a "*_STATE"
+ * register
+ */
+static bool
+resolve_set_clr (Lpc32x0Ctx_t *ctx_p, FieldHandle_t *field_p)
+{
+	char name[32];
+	size_t len;
+	RegisterDescription_t *set_p, *clr_p;
+
+	len = strlen(field_p->reg.desc_p->name_p);
+	if ((len < 6) || (len >= sizeof(name)) || (strcmp(field_p->reg.desc_p->name_p + len - 6, "_STATE") != 0))
+		return false;
+
+	memcpy(name, field_p->reg.desc_p->name_p, len - 6);
+	strcpy(name + len - 6, "_SET");
+	set_p = find_reg_by_name(name, strlen(name));
+	strcpy(name + len - 6, "_CLR");
+	clr_p = find_reg_by_name(name, strlen(name));
+	if ((set_p == NULL) || (clr_p == NULL) || !(set_p->access & accessWrite) || !(clr_p->access & accessWrite))
+		return false;
+
+	if (!lpc32x0__ctx_resolve_reg(ctx_p, set_p->addr, &field_p->set))
+		return false;
+	if (!lpc32x0__ctx_resolve_reg(ctx_p, clr_p->addr, &field_p->clr))
+		return false;
+	return true;
+}
+
+/*
+ * resolve bits [high:low] of the register at 'addr'
+ * fails if the field can be neither set/cleared nor read-modify-written
+ */
+bool
+lpc32x0__ctx_resolve_field_bits (Lpc32x0Ctx_t *ctx_p, uint32_t addr, unsigned high, unsigned low, FieldHandle_t *field_p)
+{
+	if ((field_p == NULL) || (high > 31) || (low > high))
+		return false;
+	memset(field_p, 0, sizeof(*field_p));
+	if (!lpc32x0__ctx_resolve_reg(ctx_p, addr, &field_p->reg))
+		return false;
+
+	field_p->high = (uint8_t)high;
+	field_p->low = (uint8_t)low;
+	field_p->mask = (uint32_t)((0xffffffffull >> (31 - high)) & (0xffffffffull << low));
+	field_p->setClr = resolve_set_clr(ctx_p, field_p);
+	if (!field_p->setClr && ((field_p->reg.access & accessRW) != accessRW))
+		return false;
+	return true;
+}
+
+/*
+ * resolve a field given as "<reg>[<bits>]", where <reg> is a register name
+ * or address and <bits> is "<bit>", "<high>:<low>", or the name of a field
+ * in the register's field table, e.g.
+ *   P3_OUTP_STATE[30]  0x20088000[1:0]  SPI1_GLOBAL[enable]
+ */
+bool
+lpc32x0__ctx_resolve_field (Lpc32x0Ctx_t *ctx_p, const char *spec_p, FieldHandle_t *field_p)
+{
+	const char *open_p, *close_p;
+	char *end_p;
+	unsigned long addr, high, low;
+	size_t cnt;
+	RegisterDescription_t *reg_p;
+	RegisterDescription_t **regs_pp;
+	const FieldDescription_t *desc_p;
+
+	if (spec_p == NULL)
+		return false;
+	open_p = strchr(spec_p, '[');
+	close_p = strchr(spec_p, ']');
+	if ((open_p == NULL) || (close_p == NULL) || (close_p < open_p) || (close_p[1] != 0))
+		return false;
+
+	reg_p = find_reg_by_name(spec_p, (size_t)(open_p - spec_p));
+	if (reg_p == NULL) {
+		addr = strtoul(spec_p, &end_p, 0);
+		if ((end_p != open_p) || (addr > 0xffffffff))
+			return false;
+		regs_pp = lpc32x0__find_reg((uint32_t)addr, &cnt);
+		if (regs_pp == NULL)
+			return false;
+		reg_p = regs_pp[0];
 	}
+
+	// a bit or bit range
+	high = strtoul(open_p + 1, &end_p, 10);
+	if (end_p != (open_p + 1)) {
+		low = high;
+		if (*end_p == ':')
+			low = strtoul(end_p + 1, &end_p, 10);
+		if (end_p != close_p)
+			return false;
+		return lpc32x0__ctx_resolve_field_bits(ctx_p, reg_p->addr, (unsigned)high, (unsigned)low, field_p);
+	}
+
+	// a named field
+	if (reg_p->fields_p == NULL)
+		return false;
+	for (desc_p=reg_p->fields_p; desc_p->name_p!=NULL; ++desc_p)
+		if ((strncmp(desc_p->name_p, open_p + 1, (size_t)(close_p - open_p - 1)) == 0)
+				&& (desc_p->name_p[close_p - open_p - 1] == 0))
+			return lpc32x0__ctx_resolve_field_bits(ctx_p, reg_p->addr, desc_p->high, desc_p->low, field_p);
 	return false;
 }
 
+/*
+ * print the decoded sub-fields of 'val', if the register has any
+ */
+void
+lpc32x0__print_fields (const RegisterDescription_t *reg_p, uint32_t val)
+{
+	DecodedReg_t dec;
+
+	if (lpc32x0__decode_reg(reg_p, val, &dec)) {
+		lpc32x0__print_decoded(&dec);
+		printf("\n");
+	}
+}
+
 bool
 lpc32x0__print_reg (uint32_t addr, uint32_t val, bool verbose)
 {
-	size_t i, idx;
+	size_t cnt;
+	RegisterDescription_t *reg_p;
+	RegisterDescription_t **regs_pp;
+
+	regs_pp = lpc32x0__find_reg(addr, &cnt);
+	if (regs_pp == NULL)
+		return false;
+
+	reg_p = regs_pp[0];
+	if (verbose) {
+		printf("0x%08x %-15s %s\n", reg_p->addr, reg_p->name_p, reg_p->desc_p);
+		printf("\ttype:  "); print_access(reg_p->access); printf("\n");
+		printf("\treset: 0x%08x\n", reg_p->resetState);
+		printf("\tvalue: 0x%08x\n", val);
+		lpc32x0__print_fields(reg_p, val);
+		printf("\n");
+	}
+	else {
+		printf("  %s (%08x) %*s 0x%08x\n",
+				reg_p->name_p,
+				reg_p->addr,
+				25-(int)strlen(reg_p->name_p), " ",
+				val);
+	}
+	return true;
+}
+
+/*
+ * read every readable register of a set into 'regs_p', quietly
+ * returns the number of registers read, or -1 if the set doesn't exist,
+ * 'regs_p' is too small, or a register can't be mapped
+ */
+ssize_t
+lpc32x0__ctx_read_reg_set (Lpc32x0Ctx_t *ctx_p, const char *regSetName_p, RegValue_t *regs_p, size_t max)
+{
+	size_t i, j, idx, cnt, found;
+	uint64_t t0, t1;
+	Access_e access;
+	volatile uint32_t *reg_p = NULL;
+	const RegHook_t *hook_p;
+	RegisterDescription_t **descs_pp;
 
 	for (idx=0; idx<AllRegistersSZ; ++idx) {
+		if (strcmp(AllRegisters_G[idx].name_p, regSetName_p) != 0)
+			continue;
+		if (!open_backend(ctx_p))
+			return -1;
+
+		found = 0;
 		for (i=0; i<*(AllRegisters_G[idx].sz_p); ++i) {
-			if (AllRegisters_G[idx].reg_p[i].addr == addr) {
-				if (verbose) {
-					printf("0x%08x %-15s %s\n",
-							AllRegisters_G[idx].reg_p[i].addr,
-							AllRegisters_G[idx].reg_p[i].name_p,
-							AllRegisters_G[idx].reg_p[i].desc_p);
-					printf("\ttype:  "); print_access(AllRegisters_G[idx].reg_p[i].access); printf("\n");
-					printf("\treset: 0x%08x\n", AllRegisters_G[idx].reg_p[i].resetState);
-					printf("\tvalue: 0x%08x\n", val);
-					if (AllRegisters_G[idx].reg_p[i].field_fp != NULL) {
-						(*AllRegisters_G[idx].reg_p[i].field_fp)(val);
-						printf("\n");
-					}
-					printf("\n");
-				}
-				else {
-					printf("  %s (%08x) %*s 0x%08x\n",
-							AllRegisters_G[idx].reg_p[i].name_p,
-							AllRegisters_G[idx].reg_p[i].addr,
-							25-(int)strlen(AllRegisters_G[idx].reg_p[i].name_p), " ",
-							val);
-				}
-				return true;
+			descs_pp = lpc32x0__find_reg(AllRegisters_G[idx].reg_p[i].addr, &cnt);
+			access = 0;
+			for (j=0; j<cnt; ++j)
+				access |= descs_pp[j]->access;
+			if (!(access & accessRead))
+				continue;
+
+			if (found == max)
+				return -1;
+			regs_p[found].addr = AllRegisters_G[idx].reg_p[i].addr;
+			t0 = stats_clock(ctx_p);
+			hook_p = find_hook(ctx_p, regs_p[found].addr);
+			if (hook_p == NULL) {
+				reg_p = set_mapping(ctx_p, regs_p[found].addr, false);
+				if (reg_p == NULL)
+					return -1;
 			}
+			t1 = stats_clock(ctx_p);
+			if (hook_p != NULL)
+				regs_p[found].val = (*hook_p->read_fp)(hook_p->dev_p, regs_p[found].addr);
+			else
+				regs_p[found].val = *reg_p;
+			if (ctx_p->trace_p != NULL)
+				trace_record(ctx_p->trace_p, regs_p[found].addr, regs_p[found].val, false);
+			if (STATS_ON(ctx_p))
+				stats_access(ctx_p->stats_p, regs_p[found].addr, false, 0, t1 - t0, stats_clock(ctx_p) - t1);
+			++found;
 		}
+		return (ssize_t)found;
 	}
-	return false;
+	return -1;
 }
 
 bool
-lpc32x0__get_and_print_reg_set_by_name (char *regSetName_p, bool verbose)
+lpc32x0__ctx_get_and_print_reg_set_by_name (Lpc32x0Ctx_t *ctx_p, char *regSetName_p, bool verbose)
 {
 	uint32_t val;
 	size_t i, idx;
@@ -297,7 +1266,7 @@ lpc32x0__get_and_print_reg_set_by_name (char *regSetName_p, bool verbose)
 			continue;
 		printf("%s:\n", regSetName_p);
 		for (i=0; i<*(AllRegisters_G[idx].sz_p); ++i) {
-			if (lpc32x0__get_reg(AllRegisters_G[idx].reg_p[i].addr, &val))
+			if (lpc32x0__ctx_get_reg(ctx_p, AllRegisters_G[idx].reg_p[i].addr, &val))
 				lpc32x0__print_reg(AllRegisters_G[idx].reg_p[i].addr, val, verbose);
 		}
 		return true;
@@ -306,13 +1275,160 @@ lpc32x0__get_and_print_reg_set_by_name (char *regSetName_p, bool verbose)
 }
 
 bool
-lpc32x0__get_and_print_all_regs (bool verbose)
+lpc32x0__ctx_get_and_print_all_regs (Lpc32x0Ctx_t *ctx_p, bool verbose)
 {
 	bool rtn = true;
 	size_t idx;
 
 	for (idx=0; idx<AllRegistersSZ; ++idx)
-		if (!lpc32x0__get_and_print_reg_set_by_name(AllRegisters_G[idx].name_p, verbose))
+		if (!lpc32x0__ctx_get_and_print_reg_set_by_name(ctx_p, AllRegisters_G[idx].name_p, verbose))
 			rtn = false;
 	return rtn;
 }
+
+/*
+ * map 'len' bytes of memory (SDRAM, IRAM, a static chip select) at the
+ * page aligned physical address 'base', outside the register windows;
+ * unlike registers the mapping is the caller's, it isn't cached or counted,
+ * and its accesses aren't traced
+ * returns NULL if it can't be mapped
+ */
+void *
+lpc32x0__ctx_map_mem (Lpc32x0Ctx_t *ctx_p, uint32_t base, size_t len)
+{
+	if (!open_backend(ctx_p))
+		return NULL;
+	if ((base & (MAP_PAGESZ - 1)) != 0) {
+		printf("0x%08x isn't page aligned\n", base);
+		return NULL;
+	}
+	if (ctx_p->backend_p->map_mem_fp != NULL)
+		return (*ctx_p->backend_p->map_mem_fp)(ctx_p->backendState_p, base, len);
+	return (*ctx_p->backend_p->map_fp)(ctx_p->backendState_p, base, len);
+}
+
+void
+lpc32x0__ctx_unmap_mem (Lpc32x0Ctx_t *ctx_p, void *map_p, size_t len)
+{
+	if (map_p == NULL)
+		return;
+	if (ctx_p->backend_p->unmap_mem_fp != NULL)
+		(*ctx_p->backend_p->unmap_mem_fp)(ctx_p->backendState_p, map_p, len);
+	else
+		(*ctx_p->backend_p->unmap_fp)(ctx_p->backendState_p, map_p, len);
+}
+
+/*
+ * wrappers which use the default context
+ */
+bool
+lpc32x0__get_reg (uint32_t addr, uint32_t *regRet_p)
+{
+	return lpc32x0__ctx_get_reg(&defaultCtx_G, addr, regRet_p);
+}
+
+bool
+lpc32x0__set_reg (uint32_t addr, uint32_t val)
+{
+	return lpc32x0__ctx_set_reg(&defaultCtx_G, addr, val);
+}
+
+bool
+lpc32x0__resolve_reg (uint32_t addr, RegHandle_t *handle_p)
+{
+	return lpc32x0__ctx_resolve_reg(&defaultCtx_G, addr, handle_p);
+}
+
+bool
+lpc32x0__resolve_reg_by_name (const char *name_p, RegHandle_t *handle_p)
+{
+	return lpc32x0__ctx_resolve_reg_by_name(&defaultCtx_G, name_p, handle_p);
+}
+
+bool
+lpc32x0__resolve_field_bits (uint32_t addr, unsigned high, unsigned low, FieldHandle_t *field_p)
+{
+	return lpc32x0__ctx_resolve_field_bits(&defaultCtx_G, addr, high, low, field_p);
+}
+
+bool
+lpc32x0__resolve_field (const char *spec_p, FieldHandle_t *field_p)
+{
+	return lpc32x0__ctx_resolve_field(&defaultCtx_G, spec_p, field_p);
+}
+
+void
+lpc32x0__get_map_stats (MapStats_t *stats_p)
+{
+	lpc32x0__ctx_get_map_stats(&defaultCtx_G, stats_p);
+}
+
+bool
+lpc32x0__get_spi_sim_stats (SpiSimStats_t *stats_p)
+{
+	return lpc32x0__ctx_get_spi_sim_stats(&defaultCtx_G, stats_p);
+}
+
+/*
+ * fails if the default context is already tracing (e.g. LPC32X0_TRACE)
+ */
+bool
+lpc32x0__trace_start (const char *file_p)
+{
+	if (!open_backend(&defaultCtx_G))
+		return false;
+	return lpc32x0__ctx_trace_start(&defaultCtx_G, file_p);
+}
+
+bool
+lpc32x0__trace_stop (void)
+{
+	return lpc32x0__ctx_trace_stop(&defaultCtx_G);
+}
+
+/*
+ * fails if the default context is already counting (e.g. LPC32X0_STATS)
+ */
+bool
+lpc32x0__stats_start (const char *file_p)
+{
+	if (!open_backend(&defaultCtx_G))
+		return false;
+	return lpc32x0__ctx_stats_start(&defaultCtx_G, file_p);
+}
+
+bool
+lpc32x0__print_stats (FILE *file_p)
+{
+	return lpc32x0__ctx_print_stats(&defaultCtx_G, file_p);
+}
+
+bool
+lpc32x0__get_and_print_reg_set_by_name (char *regSetName_p, bool verbose)
+{
+	return lpc32x0__ctx_get_and_print_reg_set_by_name(&defaultCtx_G, regSetName_p, verbose);
+}
+
+ssize_t
+lpc32x0__read_reg_set (const char *regSetName_p, RegValue_t *regs_p, size_t max)
+{
+	return lpc32x0__ctx_read_reg_set(&defaultCtx_G, regSetName_p, regs_p, max);
+}
+
+bool
+lpc32x0__get_and_print_all_regs (bool verbose)
+{
+	return lpc32x0__ctx_get_and_print_all_regs(&defaultCtx_G, verbose);
+}
+
+void *
+lpc32x0__map_mem (uint32_t base, size_t len)
+{
+	return lpc32x0__ctx_map_mem(&defaultCtx_G, base, len);
+}
+
+void
+lpc32x0__unmap_mem (void *map_p, size_t len)
+{
+	lpc32x0__ctx_unmap_mem(&defaultCtx_G, map_p, len);
+}
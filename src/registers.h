@@ -6,18 +6,70 @@
 #ifndef LPC32X0_REGISTERS_H
 #define LPC32X0_REGISTERS_H
 
+#include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <sys/types.h>
 
 #define unused __attribute__((unused))
 
 typedef enum {
 	accessRead  = 1,
 	accessWrite = 2,
+	accessPop   = 4, // a read takes data out of it (a data or FIFO register)
 } Access_e;
 #define accessRW (accessRead | accessWrite)
 
-typedef void (*ParseField_t)(uint32_t val);
+/*
+ * a register's sub-fields are described by a table of FieldDescription_t
+ * which lpc32x0__decode_reg() turns into a DecodedReg_t without printing
+ * anything
+ *
+ * a field's text is found by:
+ *   - text_pp[value], if value < textSZ and that entry isn't NULL
+ *     (if 'fieldQualified' is set the index is extended by the register bit
+ *     'qualBit', i.e. text_pp[value + (bit << width)])
+ *   - otherwise fmt_p printf()'ed with (value + offset), if fmt_p is set
+ *   - otherwise the field has no text (e.g. reserved fields), unless it's
+ *     flagged 'fieldNoHeader' in which case its name is its text
+ *
+ * the verbose text of a field is its header (bit range and name), its bits,
+ * then its text; fields are separated by newlines and the last field's line
+ * is only ended if it's flagged 'fieldEOL'
+ *   - 'fieldNoHeader' leaves out the header and puts the bit range in front
+ *     of the text instead (e.g. one line per bit of a status register)
+ *   - 'fieldNoBits' leaves out the bits (e.g. values shown in hex)
+ *   - 'fieldHeaderOnly' prints only the header, either to head the fields
+ *     that follow or for a register whose value means nothing when read
+ *   - 'fieldNoRange' leaves the bit range out of the header, or out of the
+ *     text of a 'fieldNoHeader' field
+ *   - 'fieldBlankLine' follows the last field's line with a blank line
+ * a table ends with an entry whose name_p is NULL
+ */
+typedef enum {
+	fieldQualified  = 1,
+	fieldEOL        = 2,
+	fieldNoHeader   = 4,
+	fieldNoBits     = 8,
+	fieldHeaderOnly = 16,
+	fieldNoRange    = 32,
+	fieldBlankLine  = 64,
+} FieldFlags_e;
+
+typedef struct {
+	uint8_t high;
+	uint8_t low;
+	const char *name_p;
+	const char * const *text_pp;
+	unsigned textSZ;
+	const char *fmt_p;
+	int offset;
+	uint8_t qualBit;
+	uint8_t flags;
+} FieldDescription_t;
+
+// e.g. {.high=1, .low=0, .name_p="mode", FIELDTEXT(modeText)}
+#define FIELDTEXT(t) .text_pp = (t), .textSZ = (sizeof(t)/sizeof((t)[0]))
 
 typedef struct {
 	uint32_t addr;
@@ -25,23 +77,472 @@ typedef struct {
 	char *name_p;
 	char *desc_p;
 	Access_e access;
-	ParseField_t field_fp;
+	const FieldDescription_t *fields_p;
 } RegisterDescription_t;
 
+typedef struct {
+	const FieldDescription_t *field_p;
+	uint32_t value;
+	const char *text_p; // NULL if the text comes from field_p->fmt_p
+} DecodedField_t;
+
+#define MAX_FIELDS 32
+typedef struct {
+	const RegisterDescription_t *reg_p;
+	uint32_t val;
+	size_t cnt;
+	DecodedField_t fields[MAX_FIELDS];
+} DecodedReg_t;
+
 typedef struct {
 	char *name_p;
 	size_t *sz_p;
 	RegisterDescription_t *reg_p;
 } AllRegisters_t;
 
+typedef struct {
+	uint32_t addr;
+	uint32_t val;
+} RegValue_t;
+
+typedef struct {
+	unsigned long maps;
+	unsigned long unmaps;
+	unsigned long hits;
+} MapStats_t;
+
+/*
+ * a register that a backend models behaviourally instead of as memory (e.g.
+ * the sim backend's SPI1, see spisim.c); accesses call the model
+ */
+typedef struct {
+	uint32_t (*read_fp) (void *dev_p, uint32_t addr);
+	void (*write_fp) (void *dev_p, uint32_t addr, uint32_t val);
+	void *dev_p;
+} RegHook_t;
+
+/*
+ * a register resolved by lpc32x0__resolve_reg*()
+ * reads and writes through a handle are a single load or store (or a call
+ * of the backend's hook, if it has one for the register; never on
+ * /dev/mem); no access checks are made, so check 'access' when the handle
+ * is resolved
+ */
+typedef struct {
+	uint32_t addr;
+	Access_e access;
+	RegisterDescription_t *desc_p;
+	volatile uint32_t *reg_p;
+	const RegHook_t *hook_p;
+} RegHandle_t;
+
+/*
+ * a bit field of a register, resolved by lpc32x0__resolve_field*()
+ * if the register is a "*_STATE" register with matching "*_SET" and "*_CLR"
+ * registers (the GPIO and pin mux blocks) a write is a store to SET and/or
+ * CLR, which doesn't disturb any other bit; otherwise it is a
+ * read-modify-write of the register itself
+ */
+typedef struct {
+	RegHandle_t reg;
+	RegHandle_t set;
+	RegHandle_t clr;
+	bool setClr;
+	uint8_t high;
+	uint8_t low;
+	uint32_t mask;
+} FieldHandle_t;
+
 void print_access(Access_e access);
 uint32_t print_field (uint32_t val, unsigned start, unsigned end);
 uint32_t get_field (uint32_t val, unsigned start, unsigned end);
+void lpc32x0__buffer_output (void);
+uint64_t lpc32x0__now_ns (void);
+void lpc32x0__put32 (uint8_t *buf_p, uint32_t val);
+uint32_t lpc32x0__get32 (const uint8_t *buf_p);
+bool lpc32x0__write_all (int fd, const uint8_t *buf_p, size_t len);
+RegisterDescription_t **lpc32x0__find_reg (uint32_t addr, size_t *cnt_p);
+RegisterDescription_t **lpc32x0__reg_index (size_t *cnt_p);
+bool lpc32x0__print_reg (uint32_t addr, uint32_t val, bool verbose);
+bool lpc32x0__decode_reg (const RegisterDescription_t *reg_p, uint32_t val, DecodedReg_t *dec_p);
+const char *lpc32x0__field_text (const DecodedField_t *field_p, char *buf_p, size_t bufSZ);
+void lpc32x0__print_decoded (const DecodedReg_t *dec_p);
+void lpc32x0__print_fields (const RegisterDescription_t *reg_p, uint32_t val);
+
+/*
+ * a context owns a backend (/dev/mem or a simulation) and its mappings; each thread that
+ * touches registers should use its own context
+ * the functions without a context argument use lpc32x0__default_ctx()
+ */
+typedef struct lpc32x0_ctx Lpc32x0Ctx_t;
+
+/*
+ * a backend maps the page at physical address 'base' into the process
+ * (see backend.c); 'open_fp' returns the backend's state, or NULL
+ * 'hook_fp' (optional) returns the hook for a register the backend models,
+ * or NULL if the register is plain memory
+ * 'map_mem_fp' and 'unmap_mem_fp' (optional) map memory rather than
+ * registers (see lpc32x0__ctx_map_mem()); without them 'map_fp' and
+ * 'unmap_fp' are used
+ */
+typedef struct {
+	const char *name_p;
+	void *(*open_fp) (const char *arg_p);
+	void (*close_fp) (void *state_p);
+	void *(*map_fp) (void *state_p, uint32_t base, size_t len);
+	void (*unmap_fp) (void *state_p, void *map_p, size_t len);
+	const RegHook_t *(*hook_fp) (void *state_p, uint32_t addr);
+	void *(*map_mem_fp) (void *state_p, uint32_t base, size_t len);
+	void (*unmap_mem_fp) (void *state_p, void *map_p, size_t len);
+} Lpc32x0Backend_t;
+
+/*
+ * what the sim backend's SPI1 model has done (see spisim.c); time is
+ * counted in HCLK cycles, each modelled register access costs a few and
+ * each frame costs its bits at the programmed SPI1 clock rate
+ */
+typedef struct {
+	uint64_t cycles;
+	uint32_t hclk;
+	unsigned long accesses;
+	unsigned long txFrames;
+	unsigned long rxFrames;
+	unsigned long dmaFrames;
+	unsigned long fullPolls;
+	unsigned long emptyPolls;
+	unsigned long overruns;
+	unsigned long selects;
+	unsigned long commands;
+	unsigned long programs;
+	unsigned long erases;
+} SpiSimStats_t;
+
+extern const Lpc32x0Backend_t lpc32x0__devmem_backend;
+extern const Lpc32x0Backend_t lpc32x0__sim_backend;
+
+Lpc32x0Ctx_t *lpc32x0__ctx_open (void);
+Lpc32x0Ctx_t *lpc32x0__ctx_open_backend (const Lpc32x0Backend_t *backend_p, const char *arg_p);
+bool lpc32x0__set_backend (const Lpc32x0Backend_t *backend_p, const char *arg_p);
+bool lpc32x0__ctx_load_capture (Lpc32x0Ctx_t *ctx_p, int fd);
+void lpc32x0__ctx_close (Lpc32x0Ctx_t *ctx_p);
+Lpc32x0Ctx_t *lpc32x0__default_ctx (void);
+bool lpc32x0__ctx_get_reg (Lpc32x0Ctx_t *ctx_p, uint32_t addr, uint32_t *regRet_p);
+bool lpc32x0__ctx_set_reg (Lpc32x0Ctx_t *ctx_p, uint32_t addr, uint32_t val);
+bool lpc32x0__ctx_resolve_reg (Lpc32x0Ctx_t *ctx_p, uint32_t addr, RegHandle_t *handle_p);
+bool lpc32x0__ctx_resolve_reg_by_name (Lpc32x0Ctx_t *ctx_p, const char *name_p, RegHandle_t *handle_p);
+bool lpc32x0__ctx_resolve_field_bits (Lpc32x0Ctx_t *ctx_p, uint32_t addr, unsigned high, unsigned low, FieldHandle_t *field_p);
+bool lpc32x0__ctx_resolve_field (Lpc32x0Ctx_t *ctx_p, const char *spec_p, FieldHandle_t *field_p);
+void lpc32x0__ctx_get_map_stats (Lpc32x0Ctx_t *ctx_p, MapStats_t *stats_p);
+void lpc32x0__ctx_drop_mappings (Lpc32x0Ctx_t *ctx_p);
+bool lpc32x0__ctx_get_spi_sim_stats (Lpc32x0Ctx_t *ctx_p, SpiSimStats_t *stats_p);
+bool lpc32x0__ctx_stats_start (Lpc32x0Ctx_t *ctx_p, const char *file_p);
+bool lpc32x0__ctx_print_stats (Lpc32x0Ctx_t *ctx_p, FILE *file_p);
+bool lpc32x0__ctx_get_and_print_reg_set_by_name (Lpc32x0Ctx_t *ctx_p, char *regSetName_p, bool verbose);
+ssize_t lpc32x0__ctx_read_reg_set (Lpc32x0Ctx_t *ctx_p, const char *regSetName_p, RegValue_t *regs_p, size_t max);
+bool lpc32x0__ctx_get_and_print_all_regs (Lpc32x0Ctx_t *ctx_p, bool verbose);
+void *lpc32x0__ctx_map_mem (Lpc32x0Ctx_t *ctx_p, uint32_t base, size_t len);
+void lpc32x0__ctx_unmap_mem (Lpc32x0Ctx_t *ctx_p, void *map_p, size_t len);
+
 bool lpc32x0__get_reg (uint32_t addr, uint32_t *regRet_p);
 bool lpc32x0__set_reg (uint32_t addr, uint32_t val);
-bool lpc32x0__print_reg (uint32_t addr, uint32_t val, bool verbose);
+bool lpc32x0__resolve_reg (uint32_t addr, RegHandle_t *handle_p);
+bool lpc32x0__resolve_reg_by_name (const char *name_p, RegHandle_t *handle_p);
+bool lpc32x0__resolve_field_bits (uint32_t addr, unsigned high, unsigned low, FieldHandle_t *field_p);
+bool lpc32x0__resolve_field (const char *spec_p, FieldHandle_t *field_p);
+void lpc32x0__get_map_stats (MapStats_t *stats_p);
+bool lpc32x0__get_spi_sim_stats (SpiSimStats_t *stats_p);
+bool lpc32x0__stats_start (const char *file_p);
+bool lpc32x0__print_stats (FILE *file_p);
 bool lpc32x0__get_and_print_reg_set_by_name (char *regSetName_p, bool verbose);
+ssize_t lpc32x0__read_reg_set (const char *regSetName_p, RegValue_t *regs_p, size_t max);
 bool lpc32x0__get_and_print_all_regs (bool verbose);
+void *lpc32x0__map_mem (uint32_t base, size_t len);
+void lpc32x0__unmap_mem (void *map_p, size_t len);
+
+/*
+ * binary snapshots of register values (see snapshot.c)
+ */
+#define SNAPSHOT_MAGIC   "\x89LPC32X0"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_HDRSZ   24
+
+bool lpc32x0__write_snapshot (FILE *file_p, const RegValue_t *regs_p, size_t cnt);
+bool lpc32x0__is_snapshot (const void *buf_p);
+bool lpc32x0__snapshot_header (const void *buf_p, size_t *cnt_p, uint64_t *when_p);
+RegValue_t *lpc32x0__read_snapshot (FILE *file_p, size_t *cnt_p, uint64_t *when_p);
+
+/*
+ * register access traces (see trace.c)
+ */
+#define TRACE_MAGIC   "\x89LPC32TR"
+#define TRACE_VERSION 1
+#define TRACE_HDRSZ   24
+#define TRACE_RECSZ   16
+#define TRACE_WRITE   0x1
+
+typedef struct {
+	uint64_t ns;
+	uint32_t addr;
+	uint32_t val;
+} TraceRecord_t;
+
+bool lpc32x0__ctx_trace_start (Lpc32x0Ctx_t *ctx_p, const char *file_p);
+bool lpc32x0__ctx_trace_stop (Lpc32x0Ctx_t *ctx_p);
+bool lpc32x0__trace_start (const char *file_p);
+bool lpc32x0__trace_stop (void);
+TraceRecord_t *lpc32x0__read_trace (FILE *file_p, size_t *cnt_p, uint64_t *when_p);
+
+/*
+ * register captures (see capture.c): gdb, U-Boot md.l, devmem and hexdump -C
+ * text, or a binary snapshot; 'word_fp' is called for every word found
+ */
+typedef void (*CaptureWord_t) (uint32_t addr, uint32_t val, void *arg_p);
+typedef struct {
+	size_t lines;
+	size_t words;
+	size_t bytes;
+} CaptureStats_t;
+
+bool lpc32x0__parse_capture (int fd, CaptureWord_t word_fp, void *arg_p, CaptureStats_t *stats_p);
+
+/*
+ * register images: one value per known register, e.g. loaded from a capture,
+ * and the differences between any number of them (see diff.c)
+ */
+typedef struct reg_image RegImage_t;
+
+RegImage_t *lpc32x0__image_new (const char *name_p);
+void lpc32x0__image_free (RegImage_t *image_p);
+const char *lpc32x0__image_name (const RegImage_t *image_p);
+bool lpc32x0__image_set (RegImage_t *image_p, uint32_t addr, uint32_t val);
+bool lpc32x0__image_get (const RegImage_t *image_p, uint32_t addr, uint32_t *val_p);
+bool lpc32x0__image_load (RegImage_t *image_p, int fd);
+size_t lpc32x0__diff_images (RegImage_t * const *images_pp, size_t cnt, bool fields);
+void lpc32x0__print_field_delta (const RegisterDescription_t *reg_p, uint32_t before, uint32_t after);
+
+/*
+ * the clock tree, evaluated from the clkpwr registers (see clocks.c)
+ * every clock is in Hz, 0 if it's stopped
+ * the main oscillator's frequency can't be read from the registers, it's
+ * passed in (0 for lpc32x0__osc_hz(), the board's: CLK_OSC_HZ unless
+ * $LPC32X0_OSC says otherwise)
+ */
+#define CLK_OSC_HZ 12000000
+#define CLK_RTC_HZ 32768
+
+typedef struct {
+	uint32_t pwrCtrl;
+	uint32_t oscCtrl;
+	uint32_t sysclkCtrl;
+	uint32_t pll397Ctrl;
+	uint32_t hclkpllCtrl;
+	uint32_t hclkdivCtrl;
+	uint32_t usbCtrl;
+	uint32_t usbdivCtrl;
+} ClockRegs_t;
+
+typedef struct {
+	ClockRegs_t regs;
+	uint64_t osc;
+	uint64_t rtc;
+	uint64_t pll397;
+	uint64_t sysclk;
+	uint64_t hclkPllCco;
+	uint64_t hclkPll;
+	uint64_t armClk;
+	uint64_t hclk;
+	uint64_t periphClk;
+	uint64_t ddramClk;
+	uint64_t usbPllIn;
+	uint64_t usbPllCco;
+	uint64_t usbPll;
+	uint64_t usbClk;
+} Clocks_t;
+
+uint64_t lpc32x0__osc_hz (void);
+void lpc32x0__eval_clocks (const ClockRegs_t *regs_p, uint64_t oscHz, Clocks_t *clk_p);
+bool lpc32x0__ctx_get_clocks (Lpc32x0Ctx_t *ctx_p, uint64_t oscHz, Clocks_t *clk_p);
+bool lpc32x0__get_clocks (uint64_t oscHz, Clocks_t *clk_p);
+bool lpc32x0__image_clocks (const RegImage_t *image_p, uint64_t oscHz, Clocks_t *clk_p);
+void lpc32x0__print_clocks (const Clocks_t *clk_p);
+
+/*
+ * the EMC's SDRAM timings in ns, checked against an SDRAM part (see sdram.c)
+ * a part's timings are minimums of 'ns' plus 'ck' clock cycles
+ */
+typedef enum {
+	sdramRP,
+	sdramRAS,
+	sdramSREX,
+	sdramWR,
+	sdramRC,
+	sdramRFC,
+	sdramXSR,
+	sdramRRD,
+	sdramMRD,
+	sdramCDLR,
+	sdramRCD,
+	sdramTimings,
+} SdramTiming_e;
+
+typedef struct {
+	double ns;
+	unsigned ck;
+	bool set;
+} SdramSpec_t;
+
+#define SDRAM_MAX_CL 16
+typedef struct {
+	char name[64];
+	SdramSpec_t t[sdramTimings];
+	double tREFI;
+	double clTck[SDRAM_MAX_CL]; // shortest tCK (ns) by CAS latency in half cycles, 0 if unsupported
+} SdramPart_t;
+
+typedef struct {
+	uint32_t refresh;
+	uint32_t timing[sdramRCD]; // EMCDynamictRP ... EMCDynamictCDLR
+	uint32_t config[2];
+	uint32_t rasCas[2];
+} SdramRegs_t;
+
+const SdramPart_t *lpc32x0__sdram_parts (size_t *cnt_p);
+const SdramPart_t *lpc32x0__find_sdram_part (const char *name_p);
+bool lpc32x0__load_sdram_part (const char *file_p, SdramPart_t *part_p);
+bool lpc32x0__ctx_get_sdram_regs (Lpc32x0Ctx_t *ctx_p, SdramRegs_t *regs_p);
+bool lpc32x0__get_sdram_regs (SdramRegs_t *regs_p);
+bool lpc32x0__image_sdram_regs (const RegImage_t *image_p, SdramRegs_t *regs_p);
+unsigned lpc32x0__check_sdram (const SdramRegs_t *regs_p, const Clocks_t *clk_p, const SdramPart_t *part_p);
+
+/*
+ * SPI1 transfers, a FIFO burst at a time (see spixfer.c)
+ * 'conBase' holds SPI1_CON's mode, bitnum, master and rate bits; the
+ * engine sets the direction, threshold and shift bits itself
+ */
+typedef struct {
+	RegHandle_t con;
+	RegHandle_t frm;
+	RegHandle_t stat;
+	RegHandle_t dat;
+	uint32_t conBase;
+} SpiXfer_t;
+
+bool lpc32x0__ctx_resolve_spi (Lpc32x0Ctx_t *ctx_p, uint32_t conBase, SpiXfer_t *spi_p);
+bool lpc32x0__resolve_spi (uint32_t conBase, SpiXfer_t *spi_p);
+void lpc32x0__spi_tx (const SpiXfer_t *spi_p, const uint8_t *data_p, size_t len);
+void lpc32x0__spi_rx (const SpiXfer_t *spi_p, uint8_t *data_p, size_t len);
+void lpc32x0__spi_xfer (const SpiXfer_t *spi_p, const uint8_t *tx_p, size_t txLen, uint8_t *rx_p, size_t rxLen);
+
+/*
+ * the memory a DMA buffer (or lpc32x0-membench) can use: IRAM (256KiB on the
+ * LPC3250, 128KiB on the others) and the two SDRAM chip select windows
+ */
+#define IRAM_BASE  0x08000000
+#define IRAM_SIZE  0x40000
+#define SDRAM_BASE 0x80000000
+#define SDRAM_SIZE 0x40000000
+
+/*
+ * SPI1 receives by GPDMA into a physically contiguous buffer, e.g. IRAM or
+ * SDRAM Linux doesn't use (see spidma.c)
+ */
+typedef struct {
+	Lpc32x0Ctx_t *ctx_p;
+	unsigned channel;
+	uint32_t phys;
+	size_t size;
+	volatile uint8_t *buf_p;
+	RegHandle_t srcAddr;
+	RegHandle_t destAddr;
+	RegHandle_t lli;
+	RegHandle_t control;
+	RegHandle_t config;
+	RegHandle_t rawIntTc;
+	RegHandle_t intTcClear;
+	RegHandle_t rawIntErr;
+	RegHandle_t intErrClear;
+	RegHandle_t timCtrl;
+	// what open changed, put back by close
+	uint32_t oldDmaClkCtrl;
+	uint32_t oldDmacConfig;
+	uint32_t oldSspCtrl;
+} SpiDma_t;
+
+bool lpc32x0__ctx_spi_dma_open (Lpc32x0Ctx_t *ctx_p, unsigned channel, uint32_t phys, size_t size, SpiDma_t *dma_p);
+bool lpc32x0__spi_dma_open (unsigned channel, uint32_t phys, size_t size, SpiDma_t *dma_p);
+void lpc32x0__spi_dma_close (SpiDma_t *dma_p);
+size_t lpc32x0__spi_dma_need (size_t len);
+size_t lpc32x0__spi_dma_max (const SpiDma_t *dma_p);
+bool lpc32x0__spi_dma_rx (const SpiXfer_t *spi_p, const SpiDma_t *dma_p, uint8_t *data_p, size_t len);
+
+/*
+ * an SPI-NOR flash's geometry and speed, from a table of parts by JEDEC ID
+ * or from its SFDP (see spiflash.c)
+ */
+#define SPI_FLASH_SFDP_HZ 50000000
+// the longest page program and sector erase, for a part that doesn't say
+#define SPI_FLASH_PP_US 5000
+#define SPI_FLASH_SE_MS 3000
+
+typedef struct {
+	char name[32];
+	uint8_t id[3];
+	uint32_t size;
+	uint32_t sectorSize;
+	uint8_t eraseCmd;
+	uint32_t pageSize;
+	uint32_t fastReadHz;
+	unsigned fastReadDummy; // clocks
+	unsigned programUs; // the longest page program
+	unsigned eraseMs; // the longest sector erase
+} SpiFlashPart_t;
+
+const SpiFlashPart_t *lpc32x0__spi_flash_parts (size_t *cnt_p);
+const SpiFlashPart_t *lpc32x0__find_spi_flash (const uint8_t *id_p);
+bool lpc32x0__parse_spi_flash_sfdp (const uint8_t *sfdp_p, size_t len, SpiFlashPart_t *part_p);
+unsigned lpc32x0__spi_rate (uint64_t hclk, uint32_t maxHz);
+
+static inline uint32_t
+lpc32x0__read (const RegHandle_t *handle_p)
+{
+	if (handle_p->hook_p != NULL)
+		return (*handle_p->hook_p->read_fp)(handle_p->hook_p->dev_p, handle_p->addr);
+	return *handle_p->reg_p;
+}
+
+static inline void
+lpc32x0__write (const RegHandle_t *handle_p, uint32_t val)
+{
+	if (handle_p->hook_p != NULL)
+		(*handle_p->hook_p->write_fp)(handle_p->hook_p->dev_p, handle_p->addr, val);
+	else
+		*handle_p->reg_p = val;
+}
+
+static inline uint32_t
+lpc32x0__read_field (const FieldHandle_t *field_p)
+{
+	return (lpc32x0__read(&field_p->reg) & field_p->mask) >> field_p->low;
+}
+
+/*
+ * a single bit (or any value that is all ones or all zeros) is one store
+ * through SET/CLR; other values need a store to each
+ */
+static inline void
+lpc32x0__write_field (const FieldHandle_t *field_p, uint32_t val)
+{
+	uint32_t bits = (val << field_p->low) & field_p->mask;
+
+	if (field_p->setClr) {
+		if (bits != 0)
+			lpc32x0__write(&field_p->set, bits);
+		if (bits != field_p->mask)
+			lpc32x0__write(&field_p->clr, field_p->mask & ~bits);
+	}
+	else
+		lpc32x0__write(&field_p->reg, (lpc32x0__read(&field_p->reg) & ~field_p->mask) | bits);
+}
 
 #define ITEMFMT "\t\t%7s %s\n"
 
@@ -50,12 +551,45 @@ bool lpc32x0__get_and_print_all_regs (bool verbose);
 #define P3_OUTP_SET  0x40028004
 #define P3_OUTP_CLR  0x40028008
 #define P3_INP_STATE 0x40028000
+#define P3_OUTP_STATE 0x4002800C
+#define P3_OUTP_CS_GPIO4 29
+#define P3_OUTP_CS_GPIO5 30
+#define P3_INP_BOOTSTICK 0x08
+
+#define HCLKDIV_CTRL 0x40004040
+#define PWR_CTRL     0x40004044
+#define PLL397_CTRL  0x40004048
+#define OSC_CTRL     0x4000404C
+#define SYSCLK_CTRL  0x40004050
+#define HCLKPLL_CTRL 0x40004058
+#define USBDIV_CTRL  0x4000401C
+#define USB_CTRL     0x40004064
 
 #define SPI_CTRL     0x400040C4
 #define SPI1_GLOBAL  0x20088000
 #define SPI1_CON     0x20088004
 #define SPI1_FRM     0x20088008
+#define SPI1_IER     0x2008800C
 #define SPI1_STAT    0x20088010
 #define SPI1_DAT     0x20088014
+#define SPI1_TIM_CTRL 0x20088400
+
+#define DMACLK_CTRL  0x400040E8
+#define SSP_CTRL     0x40004078
+#define DMAC_INTTCSTAT     0x31000004
+#define DMAC_INTTCCLEAR    0x31000008
+#define DMAC_INTERRSTAT    0x3100000C
+#define DMAC_INTERRCLR     0x31000010
+#define DMAC_RAWINTTCSTAT  0x31000014
+#define DMAC_RAWINTERRSTAT 0x31000018
+#define DMAC_ENBLDCHNS     0x3100001C
+#define DMAC_CONFIG        0x31000030
+#define DMAC_CHANNELS      8
+#define DMACC_SRCADDR(n)   (0x31000100 + ((n) * 0x20))
+#define DMACC_DESTADDR(n)  (0x31000104 + ((n) * 0x20))
+#define DMACC_LLI(n)       (0x31000108 + ((n) * 0x20))
+#define DMACC_CONTROL(n)   (0x3100010C + ((n) * 0x20))
+#define DMACC_CONFIG(n)    (0x31000110 + ((n) * 0x20))
+#define DMA_PERIPH_SPI1    11 // with SSP_CTRL[4] clear
 
 #endif
@@ -0,0 +1,410 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * SDRAM timing analysis
+ *
+ * the EMC's dynamic memory timings are counts of HCLK, which is also the
+ * SDRAM's clock (DDRAM_CLK, at twice HCLK, only times the DDR data); with
+ * the clock tree (see clocks.c) they're turned into nanoseconds and checked
+ * against an SDRAM part's datasheet timings
+ *
+ * each timing is reported as
+ *   ok         it meets the part's minimum with no cycle to spare
+ *   slack      it would still meet the minimum with fewer cycles, which
+ *              costs bandwidth for nothing
+ *   VIOLATED   it's shorter than the part's minimum
+ * the refresh interval is a maximum, so it's the other way round
+ *
+ * a part is one of the built-in profiles or read from a file of lines
+ *   # comment
+ *   name <name>
+ *   <timing> <ns>[+<n>ck]     (or <n>ck), e.g. "tWR 7.5+1ck", "tMRD 2ck"
+ *   tREFI <ns>                the longest allowed refresh interval
+ *   cl <latency> <ns>         the shortest clock period at a CAS latency
+ * where <timing> is tRP, tRAS, tSREX, tWR, tRC, tRFC, tXSR, tRRD, tMRD,
+ * tCDLR or tRCD; timings that aren't given aren't checked
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "registers.h"
+
+#define EMCDYNAMICREFRESH    0x31080024
+#define EMCDYNAMICCONFIG0    0x31080100
+#define EMCDYNAMICRASCAS0    0x31080104
+#define EMCDYNAMICCONFIG1    0x31080120
+#define EMCDYNAMICRASCAS1    0x31080124
+#define SDRAM_REFRESH_CYCLES 16
+
+typedef struct {
+	const char *name_p;
+	uint32_t addr;
+	uint32_t mask;
+} TimingReg_t;
+
+// in SdramTiming_e order; tRCD is the RAS latency, in the RAS/CAS registers
+static const TimingReg_t timingRegs[] = {
+	{"tRP",   0x31080030, 0x0f},
+	{"tRAS",  0x31080034, 0x0f},
+	{"tSREX", 0x31080038, 0x7f},
+	{"tWR",   0x31080044, 0x0f},
+	{"tRC",   0x31080048, 0x1f},
+	{"tRFC",  0x3108004c, 0x1f},
+	{"tXSR",  0x31080050, 0xff},
+	{"tRRD",  0x31080054, 0x0f},
+	{"tMRD",  0x31080058, 0x0f},
+	{"tCDLR", 0x3108005c, 0x0f},
+	{"tRCD",  0, 0x0f},
+};
+
+#define NS(n)      {.ns=(n), .set=true}
+#define NSCK(n, c) {.ns=(n), .ck=(c), .set=true}
+#define CK(c)      {.ck=(c), .set=true}
+
+/*
+ * typical datasheet values; check them against the part actually fitted
+ * clTck[] is indexed by the CAS latency in half cycles
+ */
+static const SdramPart_t builtinParts[] = {
+	{
+		.name = "MT48LC16M16A2-75",
+		.t = {
+			[sdramRP] = NS(20), [sdramRAS] = NS(44), [sdramWR] = NSCK(7.5, 1),
+			[sdramRC] = NS(66), [sdramRFC] = NS(66), [sdramXSR] = NS(75),
+			[sdramRRD] = NS(15), [sdramMRD] = CK(2), [sdramRCD] = NS(20),
+		},
+		.tREFI = 7812.5,
+		.clTck = {[4] = 10, [6] = 7.5},
+	},
+	{
+		.name = "MT48LC32M16A2-75",
+		.t = {
+			[sdramRP] = NS(20), [sdramRAS] = NS(44), [sdramWR] = NSCK(7.5, 1),
+			[sdramRC] = NS(66), [sdramRFC] = NS(66), [sdramXSR] = NS(75),
+			[sdramRRD] = NS(15), [sdramMRD] = CK(2), [sdramRCD] = NS(20),
+		},
+		.tREFI = 7812.5,
+		.clTck = {[4] = 10, [6] = 7.5},
+	},
+	{
+		.name = "MT46H32M16LF-6",
+		.t = {
+			[sdramRP] = NS(18), [sdramRAS] = NS(42), [sdramWR] = NS(15),
+			[sdramRC] = NS(60), [sdramRFC] = NS(72), [sdramXSR] = NS(112.5),
+			[sdramRRD] = NS(12), [sdramMRD] = CK(2), [sdramRCD] = NS(18),
+		},
+		.tREFI = 7812.5,
+		.clTck = {[4] = 12, [6] = 6},
+	},
+};
+static const size_t builtinPartsSZ = sizeof(builtinParts) / sizeof(builtinParts[0]);
+
+const SdramPart_t *
+lpc32x0__sdram_parts (size_t *cnt_p)
+{
+	*cnt_p = builtinPartsSZ;
+	return builtinParts;
+}
+
+const SdramPart_t *
+lpc32x0__find_sdram_part (const char *name_p)
+{
+	size_t i;
+
+	for (i=0; i<builtinPartsSZ; ++i)
+		if (strcmp(builtinParts[i].name, name_p) == 0)
+			return &builtinParts[i];
+	return NULL;
+}
+
+static bool
+parse_timing (const char *val_p, SdramSpec_t *spec_p)
+{
+	char *end_p;
+	double ns = 0;
+	unsigned long ck = 0;
+
+	ns = strtod(val_p, &end_p);
+	if (end_p == val_p)
+		return false;
+	if (strcmp(end_p, "ck") == 0) {
+		ck = strtoul(val_p, &end_p, 10);
+		if (strcmp(end_p, "ck") != 0)
+			return false;
+		ns = 0;
+	}
+	else if (*end_p == '+') {
+		val_p = end_p + 1;
+		ck = strtoul(val_p, &end_p, 10);
+		if ((end_p == val_p) || (strcmp(end_p, "ck") != 0))
+			return false;
+	}
+	else if (*end_p != 0)
+		return false;
+	if ((ns < 0) || (ck > 255))
+		return false;
+	spec_p->ns = ns;
+	spec_p->ck = (unsigned)ck;
+	spec_p->set = true;
+	return true;
+}
+
+/*
+ * read a part's timings from a file (see the top of this file)
+ * the part is named after the file unless it has a 'name' line
+ */
+bool
+lpc32x0__load_sdram_part (const char *file_p, SdramPart_t *part_p)
+{
+	char line[256], key[32], val[64];
+	unsigned lineNo = 0;
+	int n;
+	size_t i;
+	double cl, tck;
+	FILE *f_p;
+
+	f_p = fopen(file_p, "r");
+	if (f_p == NULL) {
+		perror(file_p);
+		return false;
+	}
+	memset(part_p, 0, sizeof(*part_p));
+	snprintf(part_p->name, sizeof(part_p->name), "%s", file_p);
+
+	while (fgets(line, sizeof(line), f_p) != NULL) {
+		++lineNo;
+		n = sscanf(line, "%31s %63s", key, val);
+		if ((n <= 0) || (key[0] == '#'))
+			continue;
+		if (n != 2)
+			goto bad;
+
+		if (strcmp(key, "name") == 0) {
+			snprintf(part_p->name, sizeof(part_p->name), "%s", val);
+			continue;
+		}
+		if (strcmp(key, "tREFI") == 0) {
+			if ((sscanf(val, "%lf", &part_p->tREFI) != 1) || (part_p->tREFI <= 0))
+				goto bad;
+			continue;
+		}
+		if (strcmp(key, "cl") == 0) {
+			if ((sscanf(line, "%*s %lf %lf", &cl, &tck) != 2) || (tck <= 0)
+					|| (cl < 1) || (cl > 7.5) || ((cl * 2) != (double)(unsigned)(cl * 2)))
+				goto bad;
+			part_p->clTck[(size_t)(cl * 2)] = tck;
+			continue;
+		}
+		for (i=0; i<sdramTimings; ++i)
+			if (strcmp(key, timingRegs[i].name_p) == 0)
+				break;
+		if ((i == sdramTimings) || !parse_timing(val, &part_p->t[i]))
+			goto bad;
+	}
+	fclose(f_p);
+	return true;
+
+bad:
+	printf("%s:%u: can't understand '%s'\n", file_p, lineNo, strtok(line, "\n"));
+	fclose(f_p);
+	return false;
+}
+
+static bool
+get_one (Lpc32x0Ctx_t *ctx_p, const RegImage_t *image_p, uint32_t addr, uint32_t *val_p)
+{
+	size_t cnt;
+	RegisterDescription_t **regs_pp;
+
+	if (image_p == NULL)
+		return lpc32x0__ctx_get_reg(ctx_p, addr, val_p);
+	if (lpc32x0__image_get(image_p, addr, val_p))
+		return true;
+	regs_pp = lpc32x0__find_reg(addr, &cnt);
+	printf("%s has no %s\n", lpc32x0__image_name(image_p), (regs_pp != NULL)? regs_pp[0]->name_p : "?");
+	return false;
+}
+
+// from the context, or the image if it isn't NULL
+static bool
+get_regs (Lpc32x0Ctx_t *ctx_p, const RegImage_t *image_p, SdramRegs_t *regs_p)
+{
+	size_t i;
+
+	for (i=0; i<sdramRCD; ++i)
+		if (!get_one(ctx_p, image_p, timingRegs[i].addr, &regs_p->timing[i]))
+			return false;
+	return get_one(ctx_p, image_p, EMCDYNAMICREFRESH, &regs_p->refresh)
+		&& get_one(ctx_p, image_p, EMCDYNAMICCONFIG0, &regs_p->config[0])
+		&& get_one(ctx_p, image_p, EMCDYNAMICRASCAS0, &regs_p->rasCas[0])
+		&& get_one(ctx_p, image_p, EMCDYNAMICCONFIG1, &regs_p->config[1])
+		&& get_one(ctx_p, image_p, EMCDYNAMICRASCAS1, &regs_p->rasCas[1]);
+}
+
+bool
+lpc32x0__ctx_get_sdram_regs (Lpc32x0Ctx_t *ctx_p, SdramRegs_t *regs_p)
+{
+	if ((ctx_p == NULL) || (regs_p == NULL))
+		return false;
+	return get_regs(ctx_p, NULL, regs_p);
+}
+
+bool
+lpc32x0__get_sdram_regs (SdramRegs_t *regs_p)
+{
+	return lpc32x0__ctx_get_sdram_regs(lpc32x0__default_ctx(), regs_p);
+}
+
+bool
+lpc32x0__image_sdram_regs (const RegImage_t *image_p, SdramRegs_t *regs_p)
+{
+	if ((image_p == NULL) || (regs_p == NULL))
+		return false;
+	return get_regs(NULL, image_p, regs_p);
+}
+
+// the fewest cycles of 'tck' ns that meet 'spec_p'
+static unsigned
+cycles_needed (const SdramSpec_t *spec_p, double tck)
+{
+	unsigned n;
+	// a hair of tolerance so e.g. 15ns at exactly 7.5ns/cycle is 2 cycles
+	double x = (spec_p->ns / tck) - 1e-9;
+
+	n = (x > 0)? (unsigned)x : 0;
+	if (x > n)
+		++n;
+	return n + spec_p->ck;
+}
+
+static void
+report_timing (const char *name_p, unsigned cycles, double tck, const SdramSpec_t *spec_p, unsigned *bad_p)
+{
+	unsigned need;
+
+	printf("  %-12s %6u %10.2f", name_p, cycles, cycles * tck);
+	if ((spec_p == NULL) || !spec_p->set) {
+		printf("\n");
+		return;
+	}
+	need = cycles_needed(spec_p, tck);
+	printf(" %10.2f  ", spec_p->ns + (spec_p->ck * tck));
+	if (cycles < need) {
+		printf("VIOLATED, needs %u cycles\n", need);
+		++*bad_p;
+	}
+	else if (cycles > need)
+		printf("slack, %u cycles would do\n", need);
+	else
+		printf("ok\n");
+}
+
+static void
+report_cas (const char *name_p, unsigned cl, double tck, const SdramPart_t *part_p, unsigned *bad_p)
+{
+	unsigned i;
+
+	// the ns are tCK, and the shortest tCK the part allows at this latency
+	printf("  %-12s %4u.%u %10.2f", name_p, cl / 2, (cl & 1)? 5 : 0, tck);
+	if (part_p == NULL) {
+		printf("\n");
+		return;
+	}
+	if ((cl >= SDRAM_MAX_CL) || (part_p->clTck[cl] == 0)) {
+		printf(" %10s  VIOLATED, the part has no such CAS latency\n", "-");
+		++*bad_p;
+		return;
+	}
+	printf(" %10.2f  ", part_p->clTck[cl]);
+	if (tck < (part_p->clTck[cl] - 1e-9)) {
+		printf("VIOLATED, the clock is too fast\n");
+		++*bad_p;
+		return;
+	}
+	for (i=1; i<cl; ++i)
+		if ((part_p->clTck[i] != 0) && (tck >= (part_p->clTck[i] - 1e-9))) {
+			printf("slack, CAS latency %u.%u would do\n", i / 2, (i & 1)? 5 : 0);
+			return;
+		}
+	printf("ok\n");
+}
+
+/*
+ * print the SDRAM timings in ns, checked against 'part_p' if it isn't NULL
+ * returns the number of violations
+ */
+unsigned
+lpc32x0__check_sdram (const SdramRegs_t *regs_p, const Clocks_t *clk_p, const SdramPart_t *part_p)
+{
+	bool ddr;
+	size_t i, cs;
+	unsigned cycles, most, bad = 0;
+	double tck, interval;
+	char name[16];
+
+	// EMCDynamicConfig0[2:0] is 0/2 for (low-power) SDR, 4/6 for DDR
+	ddr = (regs_p->config[0] >> 2) & 1;
+	if (clk_p->hclk == 0) {
+		printf("HCLK is stopped\n");
+		return 0;
+	}
+	tck = 1e9 / (double)clk_p->hclk;
+
+	printf("SDRAM timings, %s SDRAM at HCLK %.6f MHz (tCK %.2f ns)", ddr? "DDR" : "SDR",
+			(double)clk_p->hclk / 1e6, tck);
+	if (part_p != NULL)
+		printf(", checked against %s", part_p->name);
+	printf(":\n");
+	printf("  %-12s %6s %10s", "timing", "cycles", "ns");
+	printf((part_p != NULL)? " %10s\n" : "\n", "needs ns");
+
+	for (i=0; i<sdramRCD; ++i)
+		report_timing(timingRegs[i].name_p, (regs_p->timing[i] & timingRegs[i].mask) + 1, tck,
+				(part_p != NULL)? &part_p->t[i] : NULL, &bad);
+
+	// chip select 1 is only reported if it's configured
+	for (cs=0; cs<2; ++cs) {
+		if ((cs == 1) && (regs_p->config[1] == 0))
+			break;
+		snprintf(name, sizeof(name), "tRCD (CS%zu)", cs);
+		report_timing(name, regs_p->rasCas[cs] & timingRegs[sdramRCD].mask, tck,
+				(part_p != NULL)? &part_p->t[sdramRCD] : NULL, &bad);
+		snprintf(name, sizeof(name), "CL (CS%zu)", cs);
+		report_cas(name, (regs_p->rasCas[cs] >> 7) & 0xf, tck, part_p, &bad);
+	}
+
+	cycles = (regs_p->refresh & 0x7ff) * SDRAM_REFRESH_CYCLES;
+	if (cycles == 0) {
+		printf("  %-12s %6s\n", "refresh", "off");
+		if ((part_p != NULL) && (part_p->tREFI != 0)) {
+			printf("  refresh is off: VIOLATED\n");
+			++bad;
+		}
+		return bad;
+	}
+	interval = cycles * tck;
+	printf("  %-12s %6u %10.2f", "refresh", cycles, interval);
+	if ((part_p == NULL) || (part_p->tREFI == 0)) {
+		printf("\n");
+		return bad;
+	}
+	// the longest interval the register can hold that's still short enough
+	most = (unsigned)(part_p->tREFI / (tck * SDRAM_REFRESH_CYCLES)) * SDRAM_REFRESH_CYCLES;
+	printf(" %10.2f  ", part_p->tREFI);
+	if (cycles > most) {
+		printf("VIOLATED, at most %u cycles\n", most);
+		++bad;
+	}
+	else if (cycles < most)
+		printf("slack, %u cycles would do\n", most);
+	else
+		printf("ok\n");
+	return bad;
+}
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+#ifndef LPC32X0_SIM_H
+#define LPC32X0_SIM_H
+
+#include "registers.h"
+
+/*
+ * the sim backend's behavioural models (see spisim.c)
+ */
+typedef struct spi_sim SpiSim_t;
+
+/*
+ * the memory the models' DMA reaches: 'find_fp' returns where the 'len'
+ * bytes at physical address 'addr' are mapped, or NULL
+ */
+typedef struct {
+	void *(*find_fp) (void *arg_p, uint32_t addr, size_t len);
+	void *arg_p;
+} SimMem_t;
+
+SpiSim_t *spisim_open (volatile uint32_t *p3_p, uint32_t hclk, const char *flash_p, const char *bootstick_p, const SimMem_t *mem_p);
+void spisim_close (SpiSim_t *spi_p);
+const RegHook_t *spisim_hook (SpiSim_t *spi_p, uint32_t addr);
+void spisim_get_stats (SpiSim_t *spi_p, SpiSimStats_t *stats_p);
+void spisim_set_hclk (SpiSim_t *spi_p, uint32_t hclk);
+
+bool sim_get_spi_stats (void *state_p, SpiSimStats_t *stats_p);
+bool sim_reclock (void *state_p);
+
+#endif /* LPC32X0_SIM_H */
@@ -9,274 +9,131 @@
 
 #include "registers.h"
 
-static void
-slc__slcdata (uint32_t val)
-{
-	print_field(val, 7, 0);
-	printf("[7:0] NAND flash read or write data\n");
-}
-
-static void
-slc__slcaddr (uint32_t val)
-{
-	print_field(val, 7, 0);
-	printf("[7:0] NAND flash read or write address\n");
-}
-
-static void
-slc__slccmd (uint32_t val)
-{
-	print_field(val, 7, 0);
-	printf("[7:0] NAND flash command\n");
-}
-
-static void
-slc__slcstop (uint32_t val)
-{
-	print_field(val, 7, 0);
-	printf("[7:0] a write to this register causes the SLC flash controller to suspend all command/address sequences\n");
-}
-
-static void
-slc__slcctrl (uint32_t val)
-{
-	print_field(val, 2, 2);
-	printf("[2] writing 1 to this bit causes a reset of the SLC NAND flash controller\n");
-
-	print_field(val, 1, 1);
-	printf("[1] writing 1 to this bit clears ECC parity bits and reset the counter for ECC accumulation\n");
-
-	print_field(val, 0, 0);
-	printf("[0] writing 1 starts DMA data channel\n");
-}
-
-static void
-slc__slccfg (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[5]", "CE_LOW");
-	print_field(val, 5, 5);
-	printf("writing 1 forces CEn always low, otherwise CEn is low only when SLC is accessed\n");
-
-	printf(ITEMFMT, "[4]", "DMA_ECC");
-	field = print_field(val, 4, 4);
-	printf("channel %sabled\n", field == 1? "en" : "dis");
-
-	printf(ITEMFMT, "[3]", "ECC_EN");
-	field = print_field(val, 3, 3);
-	printf("%sabled\n", field == 1? "en" : "dis");
-
-	printf(ITEMFMT, "[2]", "DMA_BURST");
-	field = print_field(val, 2, 2);
-	if (field == 1)
-		printf("burst enabled, data channel use DMA_BREQ signal");
-	else
-		printf("burst disabled, use dmasreq0 signal only");
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "DMA_DIR");
-	field = print_field(val, 1, 1);
-	printf("DMA %s SLC\n", field == 1? "read from" : "write to");
-
-	printf(ITEMFMT, "[0]", "external device width select");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("8-bit device");
-	else
-		printf("not used");
-	printf("\n");
-}
-
-static void
-slc__slcstat (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[2]", "DMA_ACTIVE: DMA_FIFO status");
-	field = print_field(val, 2, 2);
-	if (field == 1)
-		printf("the DMA_FIFO contains data");
-	else
-		printf("no data in the DMA_FIFO");
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "SLC_ACTIVE: SLC_FIFO status");
-	field = print_field(val, 1, 1);
-	if (field == 1)
-		printf("the SLC_FIFO contains data");
-	else
-		printf("no data in the SLC_FIFO");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "READY: NAND flash device ready signal");
-	field = print_field(val, 0, 0);
-	printf("device %s\n", field == 1? "ready" : "busy");
-}
-
-static void
-slc__slcintstat (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[1]", "INT_TC_STAT: terminal count interrupt status");
-	field = print_field(val, 1, 1);
-	printf("interrupt is%s pending (after mask)\n", field == 1? "" : " not");
-
-	printf(ITEMFMT, "[0]", "INT_RDY_STAT: device ready interrupt status");
-	field = print_field(val, 0, 0);
-	printf("interrupt is%s pending (after mask)\n", field == 1? "" : " not");
-}
-
-static void
-slc__slcien (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[1]", "INT_TC_EN");
-	field = print_field(val, 1, 1);
-	if (field == 1)
-		printf("enable interrupt when TC has reached 0");
-	else
-		printf("disable TC interrupt");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "INT_RDY_EN");
-	field = print_field(val, 0, 0);
-	if (field == 1)
-		printf("enable interrupt when RDY asserted");
-	else
-		printf("disable RDY interrupt");
-	printf("\n");
-}
-
-static void
-slc__slcisr (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[1]", "INT_TC_SET");
-	field = print_field(val, 1, 1);
-	if (field == 1)
-		printf("writing 1 sets the TC interrupt");
-	else
-		printf("writing 0 has no effect");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "INT_RDY_SET");
-	field = print_field(val, 0, 0);
-	if (field == 1)
-		printf("writing 1 sets the RDY interrupt");
-	else
-		printf("writing 0 has no effect");
-	printf("\n");
-}
-
-static void
-slc__slcicr (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[1]", "INT_TC_CLR");
-	field = print_field(val, 1, 1);
-	if (field == 1)
-		printf("writing 1 clears the TC interrupt");
-	else
-		printf("writing 0 has no effect");
-	printf("\n");
+static const FieldDescription_t slc__slcdata[] = {
+	{.high=7, .low=0, .name_p="NAND flash read or write data", .flags=fieldNoHeader|fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "INT_RDY_CLR");
-	field = print_field(val, 0, 0);
-	if (field == 1)
-		printf("writing 1 clears the RDY interrupt");
-	else
-		printf("writing 0 has no effect");
-	printf("\n");
-}
+static const FieldDescription_t slc__slcaddr[] = {
+	{.high=7, .low=0, .name_p="NAND flash read or write address", .flags=fieldNoHeader|fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-slc__slctac (uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t slc__slccmd[] = {
+	{.high=7, .low=0, .name_p="NAND flash command", .flags=fieldNoHeader|fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[31:28]", "W_RDY");
-	field = print_field(val, 31, 28);
-	printf("%u\n", field);
+static const FieldDescription_t slc__slcstop[] = {
+	{.high=7, .low=0, .name_p="a write to this register causes the SLC flash controller to suspend all command/address sequences", .flags=fieldNoHeader|fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[27:24]", "W_WIDTH");
-	field = print_field(val, 27, 24);
-	printf("%u\n", field);
+static const FieldDescription_t slc__slcctrl[] = {
+	{.high=2, .low=2, .name_p="writing 1 to this bit causes a reset of the SLC NAND flash controller", .flags=fieldNoHeader},
+	{.high=1, .low=1, .name_p="writing 1 to this bit clears ECC parity bits and reset the counter for ECC accumulation", .flags=fieldNoHeader},
+	{.high=0, .low=0, .name_p="writing 1 starts DMA data channel", .flags=fieldNoHeader|fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[23:20]", "W_HOLD");
-	field = print_field(val, 23, 20);
-	printf("%u\n", field);
+static const char * const dmaEcc[] = {"channel disabled", "channel enabled"};
+static const char * const disabledEnabled[] = {"disabled", "enabled"};
+static const char * const dmaBurst[] = {
+	"burst disabled, use dmasreq0 signal only",
+	"burst enabled, data channel use DMA_BREQ signal",
+};
+static const char * const dmaDir[] = {"DMA write to SLC", "DMA read from SLC"};
+static const char * const deviceWidth[] = {"8-bit device", "not used"};
+
+static const FieldDescription_t slc__slccfg[] = {
+	{.high=5, .low=5, .name_p="CE_LOW", .fmt_p="writing 1 forces CEn always low, otherwise CEn is low only when SLC is accessed"},
+	{.high=4, .low=4, .name_p="DMA_ECC", FIELDTEXT(dmaEcc)},
+	{.high=3, .low=3, .name_p="ECC_EN", FIELDTEXT(disabledEnabled)},
+	{.high=2, .low=2, .name_p="DMA_BURST", FIELDTEXT(dmaBurst)},
+	{.high=1, .low=1, .name_p="DMA_DIR", FIELDTEXT(dmaDir)},
+	{.high=0, .low=0, .name_p="external device width select", FIELDTEXT(deviceWidth), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[19:16]", "W_SETUP");
-	field = print_field(val, 19, 16);
-	printf("%u\n", field);
+static const char * const dmaActive[] = {"no data in the DMA_FIFO", "the DMA_FIFO contains data"};
+static const char * const slcActive[] = {"no data in the SLC_FIFO", "the SLC_FIFO contains data"};
+static const char * const ready[] = {"device busy", "device ready"};
 
-	printf(ITEMFMT, "[15:12]", "R_RDY");
-	field = print_field(val, 15, 12);
-	printf("%u\n", field);
+static const FieldDescription_t slc__slcstat[] = {
+	{.high=2, .low=2, .name_p="DMA_ACTIVE: DMA_FIFO status", FIELDTEXT(dmaActive)},
+	{.high=1, .low=1, .name_p="SLC_ACTIVE: SLC_FIFO status", FIELDTEXT(slcActive)},
+	{.high=0, .low=0, .name_p="READY: NAND flash device ready signal", FIELDTEXT(ready), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[11:8]", "R_WIDTH");
-	field = print_field(val, 11, 8);
-	printf("%u\n", field);
+static const char * const pending[] = {"interrupt is not pending (after mask)", "interrupt is pending (after mask)"};
 
-	printf(ITEMFMT, "[7:4]", "R_HOLD");
-	field = print_field(val, 7, 4);
-	printf("%u\n", field);
+static const FieldDescription_t slc__slcintstat[] = {
+	{.high=1, .low=1, .name_p="INT_TC_STAT: terminal count interrupt status", FIELDTEXT(pending)},
+	{.high=0, .low=0, .name_p="INT_RDY_STAT: device ready interrupt status", FIELDTEXT(pending), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[3:0]", "R_SETUP");
-	field = print_field(val, 3, 0);
-	printf("%u\n", field);
-}
+static const char * const tcEn[] = {"disable TC interrupt", "enable interrupt when TC has reached 0"};
+static const char * const rdyEn[] = {"disable RDY interrupt", "enable interrupt when RDY asserted"};
 
-static void
-slc__slctc (uint32_t val)
-{
-	print_field(val, 15, 0);
-	printf("number of remaining bytes to be xfered to/from NAND during DMA\n");
-}
+static const FieldDescription_t slc__slcien[] = {
+	{.high=1, .low=1, .name_p="INT_TC_EN", FIELDTEXT(tcEn)},
+	{.high=0, .low=0, .name_p="INT_RDY_EN", FIELDTEXT(rdyEn), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-slc__slcecc (uint32_t val)
-{
-	uint32_t field;
+static const char * const tcSet[] = {"writing 0 has no effect", "writing 1 sets the TC interrupt"};
+static const char * const rdySet[] = {"writing 0 has no effect", "writing 1 sets the RDY interrupt"};
 
-	printf(ITEMFMT, "[21:6]", "line parity");
-	field = print_field(val, 21, 6);
-	printf("%u\n", field);
+static const FieldDescription_t slc__slcisr[] = {
+	{.high=1, .low=1, .name_p="INT_TC_SET", FIELDTEXT(tcSet)},
+	{.high=0, .low=0, .name_p="INT_RDY_SET", FIELDTEXT(rdySet), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[5:0]", "column parity");
-	field = print_field(val, 5, 0);
-	printf("%u\n", field);
-}
+static const char * const tcClr[] = {"writing 0 has no effect", "writing 1 clears the TC interrupt"};
+static const char * const rdyClr[] = {"writing 0 has no effect", "writing 1 clears the RDY interrupt"};
 
-static void
-slc__slcdmadata (uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t slc__slcicr[] = {
+	{.high=1, .low=1, .name_p="INT_TC_CLR", FIELDTEXT(tcClr)},
+	{.high=0, .low=0, .name_p="INT_RDY_CLR", FIELDTEXT(rdyClr), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[31:24]", "last byte (upper address)");
-	field = print_field(val, 31, 24);
-	printf("0x%x\n", field);
+static const FieldDescription_t slc__slctac[] = {
+	{.high=31, .low=28, .name_p="W_RDY", .fmt_p="%u"},
+	{.high=27, .low=24, .name_p="W_WIDTH", .fmt_p="%u"},
+	{.high=23, .low=20, .name_p="W_HOLD", .fmt_p="%u"},
+	{.high=19, .low=16, .name_p="W_SETUP", .fmt_p="%u"},
+	{.high=15, .low=12, .name_p="R_RDY", .fmt_p="%u"},
+	{.high=11, .low=8,  .name_p="R_WIDTH", .fmt_p="%u"},
+	{.high=7,  .low=4,  .name_p="R_HOLD", .fmt_p="%u"},
+	{.high=3,  .low=0,  .name_p="R_SETUP", .fmt_p="%u", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[23:16]", "third byte");
-	field = print_field(val, 23, 16);
-	printf("0x%x\n", field);
+static const FieldDescription_t slc__slctc[] = {
+	{.high=15, .low=0, .name_p="number of remaining bytes to be xfered to/from NAND during DMA", .flags=fieldNoHeader|fieldNoRange|fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[15:8]", "second byte");
-	field = print_field(val, 15, 8);
-	printf("0x%x\n", field);
+static const FieldDescription_t slc__slcecc[] = {
+	{.high=21, .low=6, .name_p="line parity", .fmt_p="%u"},
+	{.high=5,  .low=0, .name_p="column parity", .fmt_p="%u", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[7:0]", "first byte (lower address)");
-	field = print_field(val, 7, 0);
-	printf("0x%x\n", field);
-}
+static const FieldDescription_t slc__slcdmadata[] = {
+	{.high=31, .low=24, .name_p="last byte (upper address)", .fmt_p="0x%x"},
+	{.high=23, .low=16, .name_p="third byte", .fmt_p="0x%x"},
+	{.high=15, .low=8,  .name_p="second byte", .fmt_p="0x%x"},
+	{.high=7,  .low=0,  .name_p="first byte (lower address)", .fmt_p="0x%x", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
 RegisterDescription_t slc[] = {
-	{0x20020000, 0, "SLC_DATA", "SLC NAND flash data register", accessRW, slc__slcdata},
+	{0x20020000, 0, "SLC_DATA", "SLC NAND flash data register", accessRW | accessPop, slc__slcdata},
 	{0x20020004, 0, "SLC_ADDR", "SLC NAND flash address register", accessWrite, slc__slcaddr},
 	{0x20020008, 0, "SLC_CMD", "SLC NAND flash command register", accessWrite, slc__slccmd},
 	{0x2002000c, 0, "SLC_STOP", "SLC NAND flash stop register", accessWrite, slc__slcstop},
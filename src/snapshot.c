@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * binary register snapshots
+ *
+ * a snapshot is a header followed by 'count' address/value pairs, all
+ * little-endian regardless of the host so a snapshot taken on the lpc32x0
+ * can be decoded anywhere:
+ *
+ *   offset  size  contents
+ *   0       8     SNAPSHOT_MAGIC
+ *   8       4     version (SNAPSHOT_VERSION)
+ *   12      4     count
+ *   16      8     time the snapshot was taken (seconds since the epoch)
+ *   24      8*n   { addr, value } pairs
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "registers.h"
+
+#define SNAPSHOT_MAXCNT (1024 * 1024)
+
+bool
+lpc32x0__write_snapshot (FILE *file_p, const RegValue_t *regs_p, size_t cnt)
+{
+	size_t i;
+	uint64_t now;
+	uint8_t hdr[SNAPSHOT_HDRSZ];
+	uint8_t pair[8];
+
+	if ((file_p == NULL) || ((regs_p == NULL) && (cnt != 0)) || (cnt > SNAPSHOT_MAXCNT))
+		return false;
+
+	now = (uint64_t)time(NULL);
+	memcpy(hdr, SNAPSHOT_MAGIC, 8);
+	lpc32x0__put32(&hdr[8], SNAPSHOT_VERSION);
+	lpc32x0__put32(&hdr[12], (uint32_t)cnt);
+	lpc32x0__put32(&hdr[16], (uint32_t)(now & 0xffffffff));
+	lpc32x0__put32(&hdr[20], (uint32_t)(now >> 32));
+	if (fwrite(hdr, sizeof(hdr), 1, file_p) != 1)
+		return false;
+
+	for (i=0; i<cnt; ++i) {
+		lpc32x0__put32(&pair[0], regs_p[i].addr);
+		lpc32x0__put32(&pair[4], regs_p[i].val);
+		if (fwrite(pair, sizeof(pair), 1, file_p) != 1)
+			return false;
+	}
+	return true;
+}
+
+/*
+ * true if 'buf_p' (at least 8 bytes) starts like a snapshot
+ */
+bool
+lpc32x0__is_snapshot (const void *buf_p)
+{
+	return (memcmp(buf_p, SNAPSHOT_MAGIC, 8) == 0);
+}
+
+/*
+ * check a snapshot header (SNAPSHOT_HDRSZ bytes at 'buf_p') and return its
+ * count and time
+ */
+bool
+lpc32x0__snapshot_header (const void *buf_p, size_t *cnt_p, uint64_t *when_p)
+{
+	const uint8_t *hdr_p = buf_p;
+
+	if (!lpc32x0__is_snapshot(hdr_p)) {
+		printf("not a snapshot\n");
+		return false;
+	}
+	if (lpc32x0__get32(&hdr_p[8]) != SNAPSHOT_VERSION) {
+		printf("unsupported snapshot version %u\n", lpc32x0__get32(&hdr_p[8]));
+		return false;
+	}
+	*cnt_p = lpc32x0__get32(&hdr_p[12]);
+	if (*cnt_p > SNAPSHOT_MAXCNT) {
+		printf("bad snapshot count %zu\n", *cnt_p);
+		return false;
+	}
+	if (when_p != NULL)
+		*when_p = (uint64_t)lpc32x0__get32(&hdr_p[16]) | ((uint64_t)lpc32x0__get32(&hdr_p[20]) << 32);
+	return true;
+}
+
+/*
+ * read a snapshot; the returned array is malloc()'ed and holds *cnt_p
+ * entries, the time it was taken is returned in *when_p (if not NULL)
+ * returns NULL (with *cnt_p == 0) on error
+ */
+RegValue_t *
+lpc32x0__read_snapshot (FILE *file_p, size_t *cnt_p, uint64_t *when_p)
+{
+	size_t i, cnt;
+	uint8_t hdr[SNAPSHOT_HDRSZ];
+	uint8_t pair[8];
+	RegValue_t *regs_p;
+
+	if (cnt_p == NULL)
+		return NULL;
+	*cnt_p = 0;
+	if (file_p == NULL)
+		return NULL;
+
+	if (fread(hdr, sizeof(hdr), 1, file_p) != 1) {
+		printf("short snapshot header\n");
+		return NULL;
+	}
+	if (!lpc32x0__snapshot_header(hdr, &cnt, when_p))
+		return NULL;
+
+	regs_p = malloc((cnt? cnt : 1) * sizeof(*regs_p));
+	if (regs_p == NULL) {
+		perror("malloc()");
+		return NULL;
+	}
+	for (i=0; i<cnt; ++i) {
+		if (fread(pair, sizeof(pair), 1, file_p) != 1) {
+			printf("snapshot truncated after %zu of %zu registers\n", i, cnt);
+			free(regs_p);
+			return NULL;
+		}
+		regs_p[i].addr = lpc32x0__get32(&pair[0]);
+		regs_p[i].val = lpc32x0__get32(&pair[4]);
+	}
+
+	*cnt_p = cnt;
+	return regs_p;
+}
@@ -6,234 +6,117 @@
 #include <stdio.h>
 #include "registers.h"
 
-static void
-spi__global (uint32_t val)
-{
-	uint32_t field;
+static const char * const noActionOrReset[] = {"no action", "SPI interface is reset"};
+static const char * const spiDisabledEnabled[] = {"SPIn interface is disabled", "SPIn interface is enabled"};
 
-	printf(ITEMFMT, "[1]", "rst");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("no action");
-	else
-		printf("SPI interface is reset");
-	printf("\n");
-
-	printf(ITEMFMT, "[0]", "enable");
-	field = print_field(val, 0, 0);
-	printf("SPIn interface is %sabled\n", field==0? "dis" : "en");
-}
-
-static void
-spi__control (uint32_t val)
-{
-	int bit15;
-	uint32_t field;
-
-	printf(ITEMFMT, "[23]", "selects bidirectional or unidirectional usage of the SPIn_DATIO pin");
-	field = print_field(val, 23, 23);
-	printf("SPIn_DATIO pin is %sdirectional", field==0? "bi" : "uni");
-	printf("\n");
-
-	printf(ITEMFMT, "[22]", "busy halt, determines whether SPIn_BUSY affects SPI operation");
-	field = print_field(val, 22, 22);
-	if (field == 1)
-		printf("data xfer is halted if SPIn_BUSY is active during master operation");
-	else
-		printf("the SPIn_BUSY pin is ignored during master operation");
-	printf("\n");
-
-	printf(ITEMFMT, "[21]", "busy polarity - controls the polarity of the SPIn_BUSY signal");
-	field = print_field(val, 21, 21);
-	printf("SPIn_BUSY is active %s\n", field==0? "LOW" : "HIGH");
-
-	printf(ITEMFMT, "[20]", "(reserved)");
-	print_field(val, 20, 20);
-	printf("\n");
-
-	printf(ITEMFMT, "[19]", "endian - controls the order in which the bits are transfered");
-	field = print_field(val, 19, 19);
-	printf("data is xfered %s-first\n", field==0? "MSB" : "LSB");
-
-	printf(ITEMFMT, "[18]", "(reserved)");
-	print_field(val, 18, 18);
-	printf("\n");
-
-	printf(ITEMFMT, "[17:16]", "SPI mode selection");
-	field = print_field(val, 17, 16);
-	switch (field) {
-		case 0:
-			printf("SPI mode 0: clock starts low, data is sampled at the clock rising edge");
-			break;
-		case 1:
-			printf("SPI mode 1: clock starts low, data is sampled at the clock falling edge");
-			break;
-		case 2:
-			printf("SPI mode 2: clock starts high, data is sampled at the clock falling edge");
-			break;
-		case 3:
-			printf("SPI mode 3: clock starts high, data is sampled at the clock rising edge");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[15]", "rxtx - controls the direction of data transfer");
-	field = print_field(val, 15, 15);
-	if (field == 0)
-		printf("data is shifted into the SPI (receive)");
-	else
-		printf("data is shifted out of the SPI (transmit)");
-	printf("\n");
-
-	bit15 = val & 0x00008000;
-	printf(ITEMFMT, "[14]", "thr - controls the FIFO threshold, determines operation of interrupt flag");
-	field = print_field(val, 14, 14);
-	if (bit15) {
-		if (field == 0)
-			printf("the FIFO threshold is disabled");
-		else
-			printf("the FIFO threshold is enabled, threshold=8 entries in FIFO");
-	}
-	else {
-		if (field == 0)
-			printf("the FIFO threshold is disabled; threshold=1 entry in FIFO");
-		else
-			printf("the FIFO threshold is enabled; threshold=56 entries in FIFO");
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[13]", "shift_off - controls generation of clock pulses on SPIn_CLK");
-	field = print_field(val, 13, 13);
-	printf("%sables the generation of clock pulses on SPIn_CLK\n", field==0? "en" : "dis");
-
-	printf(ITEMFMT, "[12:9]", "bitnum - defines the number of bits to xmit or rcve in one block xfer");
-	field = print_field(val, 12, 9);
-	printf("%d bits\n", field+1);
-
-	printf(ITEMFMT, "[8]", "(reserved)");
-	print_field(val, 8, 8);
-	printf("\n");
-
-	printf(ITEMFMT, "[7]", "master");
-	field = print_field(val, 7, 7);
-	if (field == 0)
-		printf("not supported");
-	else
-		printf("SPI is operating as master");
-	printf("\n");
-
-	printf(ITEMFMT, "[6:0]", "rate - SPI transfer rate - SPIn_CLK = HCLK / ((rate+1) x 2)");
-	field = print_field(val, 6, 0);
-	printf("value: %d", field);
-}
-
-static void
-spi__framecount (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[15:0]", "spif - SPI frame count; the number of frames xfered");
-	field = print_field(val, 15, 0);
-	printf("%d frame(s)", field);
-}
-
-static void
-spi__ier (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[1]", "inteot - end of transfer interrupt");
-	field = print_field(val, 1, 1);
-	printf("end of transfer interrupt is %sabled\n", field==0? "dis" : "en");
-
-	printf(ITEMFMT, "[0]", "intthr - FIFO threshold interrupt enable");
-	field = print_field(val, 0, 0);
-	printf("the FIFO threshold interrupt is %sabled", field==0? "dis" : "en");
-}
-
-static void
-spi__stat (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[8]", "intclr - SPI interrupt clear");
-	print_field(val, 8, 8);
-	printf("\n");
-
-	printf(ITEMFMT, "[7]", "eot - end of transfer interrupt");
-	print_field(val, 7, 7);
-	printf("\n");
-
-	printf(ITEMFMT, "[6]", "busylev - SPIn_BUSY level");
-	print_field(val, 6, 6);
-	printf("\n");
-
-	printf(ITEMFMT, "[5:4]", "(reserved)");
-	print_field(val, 5, 4);
-	printf("\n");
-
-	printf(ITEMFMT, "[3]", "shiftact - shift active; indicates when the SPI is transferring data");
-	print_field(val, 3, 3);
-	printf("\n");
-
-	printf(ITEMFMT, "[2]", "bf - FIFO full interrupt flag");
-	print_field(val, 2, 2);
-	printf("\n");
+static const FieldDescription_t spi__global[] = {
+	{.high=1, .low=1, .name_p="rst", FIELDTEXT(noActionOrReset)},
+	{.high=0, .low=0, .name_p="enable", FIELDTEXT(spiDisabledEnabled), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[1]", "thr - FIFO threshold interrupt flag");
-	field = print_field(val, 1, 1);
-	if (field == 0)
-		printf("if rxtx==0: FIFO is below threshold; if rxtx==1: FIFO is above threshold");
-	else
-		printf("if rxtx==0: FIFO is at or above threshold; if rxtx==1: FIFO is at or below threshold");
-	printf("\n");
+static const char * const datioDir[] = {"SPIn_DATIO pin is bidirectional", "SPIn_DATIO pin is unidirectional"};
+static const char * const busyHalt[] = {
+	"the SPIn_BUSY pin is ignored during master operation",
+	"data xfer is halted if SPIn_BUSY is active during master operation",
+};
+static const char * const busyPol[] = {"SPIn_BUSY is active LOW", "SPIn_BUSY is active HIGH"};
+static const char * const endian[] = {"data is xfered MSB-first", "data is xfered LSB-first"};
+static const char * const spiMode[] = {
+	"SPI mode 0: clock starts low, data is sampled at the clock rising edge",
+	"SPI mode 1: clock starts low, data is sampled at the clock falling edge",
+	"SPI mode 2: clock starts high, data is sampled at the clock falling edge",
+	"SPI mode 3: clock starts high, data is sampled at the clock rising edge",
+};
+static const char * const rxtx[] = {
+	"data is shifted into the SPI (receive)",
+	"data is shifted out of the SPI (transmit)",
+};
+// qualified by rxtx (bit 15)
+static const char * const thr[] = {
+	"the FIFO threshold is disabled; threshold=1 entry in FIFO",
+	"the FIFO threshold is enabled; threshold=56 entries in FIFO",
+	"the FIFO threshold is disabled",
+	"the FIFO threshold is enabled, threshold=8 entries in FIFO",
+};
+static const char * const shiftOff[] = {
+	"enables the generation of clock pulses on SPIn_CLK",
+	"disables the generation of clock pulses on SPIn_CLK",
+};
+static const char * const master[] = {"not supported", "SPI is operating as master"};
+
+static const FieldDescription_t spi__control[] = {
+	{.high=23, .low=23, .name_p="selects bidirectional or unidirectional usage of the SPIn_DATIO pin", FIELDTEXT(datioDir)},
+	{.high=22, .low=22, .name_p="busy halt, determines whether SPIn_BUSY affects SPI operation", FIELDTEXT(busyHalt)},
+	{.high=21, .low=21, .name_p="busy polarity - controls the polarity of the SPIn_BUSY signal", FIELDTEXT(busyPol)},
+	{.high=20, .low=20, .name_p="(reserved)"},
+	{.high=19, .low=19, .name_p="endian - controls the order in which the bits are transfered", FIELDTEXT(endian)},
+	{.high=18, .low=18, .name_p="(reserved)"},
+	{.high=17, .low=16, .name_p="SPI mode selection", FIELDTEXT(spiMode)},
+	{.high=15, .low=15, .name_p="rxtx - controls the direction of data transfer", FIELDTEXT(rxtx)},
+	{.high=14, .low=14, .name_p="thr - controls the FIFO threshold, determines operation of interrupt flag", FIELDTEXT(thr), .qualBit=15, .flags=fieldQualified},
+	{.high=13, .low=13, .name_p="shift_off - controls generation of clock pulses on SPIn_CLK", FIELDTEXT(shiftOff)},
+	{.high=12, .low=9,  .name_p="bitnum - defines the number of bits to xmit or rcve in one block xfer", .fmt_p="%d bits", .offset=1},
+	{.high=8,  .low=8,  .name_p="(reserved)"},
+	{.high=7,  .low=7,  .name_p="master", FIELDTEXT(master)},
+	{.high=6,  .low=0,  .name_p="rate - SPI transfer rate - SPIn_CLK = HCLK / ((rate+1) x 2)", .fmt_p="value: %d"},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "be - FIFO empty interrupt flag");
-	field = print_field(val, 0, 0);
-	printf("FIFO is %sempty", field==0? "not " : "");
-}
+static const FieldDescription_t spi__framecount[] = {
+	{.high=15, .low=0, .name_p="spif - SPI frame count; the number of frames xfered", .fmt_p="%d frame(s)"},
+	{.name_p=NULL},
+};
 
-static void
-spi__timctrl (uint32_t val)
-{
-	uint32_t field;
+static const char * const eotIntr[] = {"end of transfer interrupt is disabled", "end of transfer interrupt is enabled"};
+static const char * const thrIntr[] = {"the FIFO threshold interrupt is disabled", "the FIFO threshold interrupt is enabled"};
 
-	printf(ITEMFMT, "[2]", "tirqe - timed interrupt enable");
-	field = print_field(val, 2, 2);
-	printf("timed interrupt is %sabled\n", field==0? "dis" : "en");
+static const FieldDescription_t spi__ier[] = {
+	{.high=1, .low=1, .name_p="inteot - end of transfer interrupt", FIELDTEXT(eotIntr)},
+	{.high=0, .low=0, .name_p="intthr - FIFO threshold interrupt enable", FIELDTEXT(thrIntr)},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[1]", "pirqe - peripheral interrupt enable");
-	field = print_field(val, 1, 1);
-	printf("SPI status interrupt input %sabled\n", field==0? "dis" : "en");
+static const char * const thrFlag[] = {
+	"if rxtx==0: FIFO is below threshold; if rxtx==1: FIFO is above threshold",
+	"if rxtx==0: FIFO is at or above threshold; if rxtx==1: FIFO is at or below threshold",
+};
+static const char * const fifoEmpty[] = {"FIFO is not empty", "FIFO is empty"};
+
+static const FieldDescription_t spi__stat[] = {
+	{.high=8, .low=8, .name_p="intclr - SPI interrupt clear"},
+	{.high=7, .low=7, .name_p="eot - end of transfer interrupt"},
+	{.high=6, .low=6, .name_p="busylev - SPIn_BUSY level"},
+	{.high=5, .low=4, .name_p="(reserved)"},
+	{.high=3, .low=3, .name_p="shiftact - shift active; indicates when the SPI is transferring data"},
+	{.high=2, .low=2, .name_p="bf - FIFO full interrupt flag"},
+	{.high=1, .low=1, .name_p="thr - FIFO threshold interrupt flag", FIELDTEXT(thrFlag)},
+	{.high=0, .low=0, .name_p="be - FIFO empty interrupt flag", FIELDTEXT(fifoEmpty)},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "mode - determines how the timer is used");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("timed interrupt mode");
-	else
-		printf("DMA time-out mode");
-	printf("\n");
-}
+static const char * const timedIntr[] = {"timed interrupt is disabled", "timed interrupt is enabled"};
+static const char * const statusIntr[] = {"SPI status interrupt input disabled", "SPI status interrupt input enabled"};
+static const char * const timerMode[] = {"timed interrupt mode", "DMA time-out mode"};
 
-static void
-spi__timcount (uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t spi__timctrl[] = {
+	{.high=2, .low=2, .name_p="tirqe - timed interrupt enable", FIELDTEXT(timedIntr)},
+	{.high=1, .low=1, .name_p="pirqe - peripheral interrupt enable", FIELDTEXT(statusIntr)},
+	{.high=0, .low=0, .name_p="mode - determines how the timer is used", FIELDTEXT(timerMode), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[15:0]", "count");
-	field = print_field(val, 15, 0);
-	printf("%d", field);
-}
+static const FieldDescription_t spi__timcount[] = {
+	{.high=15, .low=0, .name_p="count", .fmt_p="%d"},
+	{.name_p=NULL},
+};
 
-static void
-spi__timstat (uint32_t val)
-{
-	uint32_t field;
+static const char * const timedPending[] = {"no timed interrupt pending", "timed interrupt pending"};
 
-	printf(ITEMFMT, "[15]", "tirqstat - timed interrupt status flag, write 1 to clear flag");
-	field = print_field(val, 15, 15);
-	printf("%stimed interrupt pending", field==0? "no " : "");
-}
+static const FieldDescription_t spi__timstat[] = {
+	{.high=15, .low=15, .name_p="tirqstat - timed interrupt status flag, write 1 to clear flag", FIELDTEXT(timedPending)},
+	{.name_p=NULL},
+};
 
 RegisterDescription_t spi[] = {
 	{0x400040c4, 0,          "SPI_CTRL", "SPI1 and SPI2 clock and pin control", accessRW, NULL/*see clkpwr*/},
@@ -247,8 +130,8 @@ RegisterDescription_t spi[] = {
 	{0x2009000c, 0,          "SPI2_IER", "SPI2 interrupt enable", accessRW, spi__ier},
 	{0x20088010, 0x00000001, "SPI1_STAT", "SPI1 status", accessRW, spi__stat},
 	{0x20090010, 0x00000001, "SPI2_STAT", "SPI2 status", accessRW, spi__stat},
-	{0x20088014, 0,          "SPI1_DAT", "SPI1 data", accessRW, NULL},
-	{0x20090014, 0,          "SPI2_DAT", "SPI2 data", accessRW, NULL},
+	{0x20088014, 0,          "SPI1_DAT", "SPI1 data", accessRW | accessPop, NULL},
+	{0x20090014, 0,          "SPI2_DAT", "SPI2 data", accessRW | accessPop, NULL},
 	{0x20088400, 0x00000002, "SPI1_TIM_CTRL", "SPI1 timer control", accessRW, spi__timctrl},
 	{0x20090400, 0x00000002, "SPI2_TIM_CTRL", "SPI2 timer control", accessRW, spi__timctrl},
 	{0x20088404, 0,          "SPI1_TIM_COUNT", "SPI1 timer count", accessRW, spi__timcount},
@@ -0,0 +1,384 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * SPI1 receives by GPDMA
+ *
+ * SPI1 asks for DMA (request line DMA_PERIPH_SPI1) when SPI1_TIM_CTRL's
+ * mode bit is set; a channel then moves each frame from SPI1_DAT into the
+ * buffer, with the DMA controlling the flow, so the CPU only has to start
+ * each frame count (SPI1_FRM, up to SPI_DMA_FRAMES frames) and wait for
+ * the end of it
+ *
+ * a channel moves at most 4095 transfers per control word, so a longer
+ * read is a chain of linked-list items of DMA_LLI_BYTES each; the items
+ * live in the same buffer, after the data:
+ *
+ *   phys                      data, 'len' bytes
+ *   phys + ALIGN(len)         item 0 { src, dest, next item, control }
+ *   ...                       item n-1, next == 0, raises the terminal count
+ *
+ * the buffer has to be physically contiguous memory the DMA can reach
+ * and nothing else uses: IRAM, or SDRAM Linux has been told to leave alone
+ * (mem=); it's mapped through the context's backend like the registers
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "registers.h"
+
+#define CON_THR       (1u << 14)
+#define CON_RXTX      (1u << 15)
+
+#define STAT_BE       0x001
+#define STAT_SHIFTACT 0x008
+#define STAT_EOT      0x080
+#define STAT_INTCLR   0x100
+
+#define TIM_CTRL_DMA  0x001
+
+#define DMAC_ENABLE   0x001
+#define SSP_CTRL_SSP1_TX_DMA (1u << 4)
+
+// DMACCxControl
+#define CTRL_SWIDTH_BYTE (0u << 18)
+#define CTRL_DWIDTH_BYTE (0u << 21)
+#define CTRL_DI          (1u << 27)
+#define CTRL_I           (1u << 31)
+
+// DMACCxConfig
+#define CFG_E            0x00001
+#define CFG_SRCPERIPH(n) ((uint32_t)(n) << 1)
+#define CFG_FLOW_P2M     (2u << 11)
+
+#define DMA_LLI_BYTES  4080 // of the 4095 a control word can move
+#define DMA_LLI_SZ     16
+#define SPI_DMA_FRAMES 65535
+
+// the channel is given up on if it moves nothing for this long; at the
+// slowest SPI1 clock a frame takes well under a millisecond
+#define DMA_STALL_NS   100000000ull
+#define DMA_POLL_CHECK 256
+
+#define ALIGN_LLI(n) (((n) + (DMA_LLI_SZ - 1)) & ~(size_t)(DMA_LLI_SZ - 1))
+
+static size_t
+lli_cnt (size_t len)
+{
+	return (len + DMA_LLI_BYTES - 1) / DMA_LLI_BYTES;
+}
+
+static bool
+in_region (uint32_t phys, size_t size, uint32_t base, uint32_t regionSize)
+{
+	return (phys >= base) && ((phys - base) < regionSize) && (size <= (regionSize - (phys - base)));
+}
+
+// the DMA writes the data and reads the items there, so only memory will do
+static bool
+buffer_ok (uint32_t phys, size_t size)
+{
+	return (size != 0) && (in_region(phys, size, IRAM_BASE, IRAM_SIZE) || in_region(phys, size, SDRAM_BASE, SDRAM_SIZE));
+}
+
+// put back the DMA clock, the DMA's enable and SSP_CTRL as open found them
+static void
+restore_regs (const SpiDma_t *dma_p)
+{
+	lpc32x0__ctx_set_reg(dma_p->ctx_p, SSP_CTRL, dma_p->oldSspCtrl);
+	lpc32x0__ctx_set_reg(dma_p->ctx_p, DMAC_CONFIG, dma_p->oldDmacConfig);
+	lpc32x0__ctx_set_reg(dma_p->ctx_p, DMACLK_CTRL, dma_p->oldDmaClkCtrl);
+}
+
+/*
+ * take over GPDMA channel 'channel' for SPI1 and map 'size' bytes of
+ * memory at 'phys' as its buffer; the items are words, so 'phys' has to be
+ * word aligned
+ */
+bool
+lpc32x0__ctx_spi_dma_open (Lpc32x0Ctx_t *ctx_p, unsigned channel, uint32_t phys, size_t size, SpiDma_t *dma_p)
+{
+	if (channel >= DMAC_CHANNELS) {
+		printf("there's no DMA channel %u\n", channel);
+		return false;
+	}
+	if (!buffer_ok(phys, size)) {
+		printf("a %zu byte DMA buffer at 0x%08x isn't within IRAM or SDRAM\n", size, phys);
+		return false;
+	}
+	if (phys & 0x3) {
+		printf("the DMA buffer at 0x%08x isn't word aligned\n", phys);
+		return false;
+	}
+	dma_p->ctx_p = ctx_p;
+	dma_p->channel = channel;
+	dma_p->phys = phys;
+	dma_p->size = size;
+	if (!lpc32x0__ctx_resolve_reg(ctx_p, DMACC_SRCADDR(channel), &dma_p->srcAddr)
+			|| !lpc32x0__ctx_resolve_reg(ctx_p, DMACC_DESTADDR(channel), &dma_p->destAddr)
+			|| !lpc32x0__ctx_resolve_reg(ctx_p, DMACC_LLI(channel), &dma_p->lli)
+			|| !lpc32x0__ctx_resolve_reg(ctx_p, DMACC_CONTROL(channel), &dma_p->control)
+			|| !lpc32x0__ctx_resolve_reg(ctx_p, DMACC_CONFIG(channel), &dma_p->config)
+			|| !lpc32x0__ctx_resolve_reg(ctx_p, DMAC_RAWINTTCSTAT, &dma_p->rawIntTc)
+			|| !lpc32x0__ctx_resolve_reg(ctx_p, DMAC_INTTCCLEAR, &dma_p->intTcClear)
+			|| !lpc32x0__ctx_resolve_reg(ctx_p, DMAC_RAWINTERRSTAT, &dma_p->rawIntErr)
+			|| !lpc32x0__ctx_resolve_reg(ctx_p, DMAC_INTERRCLR, &dma_p->intErrClear)
+			|| !lpc32x0__ctx_resolve_reg(ctx_p, SPI1_TIM_CTRL, &dma_p->timCtrl))
+		return false;
+
+	if (lpc32x0__read(&dma_p->config) & CFG_E) {
+		printf("DMA channel %u is in use\n", channel);
+		return false;
+	}
+
+	// clock the DMA, enable it (little-endian) and give SPI1 its request line
+	if (!lpc32x0__ctx_get_reg(ctx_p, DMACLK_CTRL, &dma_p->oldDmaClkCtrl)
+			|| !lpc32x0__ctx_get_reg(ctx_p, DMAC_CONFIG, &dma_p->oldDmacConfig)
+			|| !lpc32x0__ctx_get_reg(ctx_p, SSP_CTRL, &dma_p->oldSspCtrl))
+		return false;
+	if (!lpc32x0__ctx_set_reg(ctx_p, DMACLK_CTRL, 1)
+			|| !lpc32x0__ctx_set_reg(ctx_p, DMAC_CONFIG, dma_p->oldDmacConfig | DMAC_ENABLE)
+			|| !lpc32x0__ctx_set_reg(ctx_p, SSP_CTRL, dma_p->oldSspCtrl & ~SSP_CTRL_SSP1_TX_DMA)) {
+		restore_regs(dma_p);
+		return false;
+	}
+
+	dma_p->buf_p = lpc32x0__ctx_map_mem(ctx_p, phys, size);
+	if (dma_p->buf_p == NULL) {
+		restore_regs(dma_p);
+		return false;
+	}
+	return true;
+}
+
+bool
+lpc32x0__spi_dma_open (unsigned channel, uint32_t phys, size_t size, SpiDma_t *dma_p)
+{
+	return lpc32x0__ctx_spi_dma_open(lpc32x0__default_ctx(), channel, phys, size, dma_p);
+}
+
+void
+lpc32x0__spi_dma_close (SpiDma_t *dma_p)
+{
+	if (dma_p->buf_p == NULL)
+		return;
+	lpc32x0__ctx_unmap_mem(dma_p->ctx_p, (void*)dma_p->buf_p, dma_p->size);
+	dma_p->buf_p = NULL;
+	restore_regs(dma_p);
+}
+
+/*
+ * the buffer space a read of 'len' bytes needs, with its items
+ */
+size_t
+lpc32x0__spi_dma_need (size_t len)
+{
+	return ALIGN_LLI(len) + (lli_cnt(len) * DMA_LLI_SZ);
+}
+
+/*
+ * the longest read that fits in the buffer along with its items
+ */
+size_t
+lpc32x0__spi_dma_max (const SpiDma_t *dma_p)
+{
+	size_t len, rest;
+
+	// whole items take DMA_LLI_BYTES + DMA_LLI_SZ each, what's left can
+	// hold a last, shorter, one
+	len = (dma_p->size / (DMA_LLI_BYTES + DMA_LLI_SZ)) * DMA_LLI_BYTES;
+	rest = dma_p->size % (DMA_LLI_BYTES + DMA_LLI_SZ);
+	if (rest > DMA_LLI_SZ)
+		len += rest - DMA_LLI_SZ;
+	while ((len != 0) && (lpc32x0__spi_dma_need(len) > dma_p->size))
+		--len;
+	return len;
+}
+
+typedef enum {
+	waitEmpty,
+	waitEot,
+	waitDone,
+} DmaWait_e;
+
+static bool
+dma_wait_done (const SpiXfer_t *spi_p, const SpiDma_t *dma_p, DmaWait_e what)
+{
+	uint32_t stat;
+
+	switch (what) {
+		case waitEmpty:
+			return (lpc32x0__read(&spi_p->stat) & STAT_BE) != 0;
+		case waitEot:
+			stat = lpc32x0__read(&spi_p->stat);
+			return (stat & (STAT_EOT | STAT_SHIFTACT)) == STAT_EOT;
+		default:
+			return !(lpc32x0__read(&dma_p->config) & CFG_E);
+	}
+}
+
+/*
+ * wait for the FIFO to be empty, the end of the frame count, or the channel
+ * to finish; a DMA error stops the channel, after which the FIFO fills and
+ * the receive stalls without ever reaching its end, so this gives up on an
+ * error, on the channel stopping while there's still a frame count to
+ * receive, or when the channel's destination hasn't moved for DMA_STALL_NS
+ */
+static bool
+dma_wait (const SpiXfer_t *spi_p, const SpiDma_t *dma_p, DmaWait_e what)
+{
+	unsigned polls = 0;
+	uint32_t bit = 1u << dma_p->channel, dest, lastDest;
+	uint64_t since;
+
+	lastDest = lpc32x0__read(&dma_p->destAddr);
+	since = lpc32x0__now_ns();
+	while (!dma_wait_done(spi_p, dma_p, what)) {
+		if (lpc32x0__read(&dma_p->rawIntErr) & bit)
+			return false;
+		// the channel stops once it has the last frame, which is after
+		// that frame has been shifted, so look again before giving up
+		if ((what != waitDone) && !(lpc32x0__read(&dma_p->config) & CFG_E))
+			return dma_wait_done(spi_p, dma_p, what);
+		if (++polls % DMA_POLL_CHECK)
+			continue;
+		dest = lpc32x0__read(&dma_p->destAddr);
+		if (dest != lastDest) {
+			lastDest = dest;
+			since = lpc32x0__now_ns();
+		}
+		else if ((lpc32x0__now_ns() - since) > DMA_STALL_NS) {
+			printf("DMA channel %u stalled\n", dma_p->channel);
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * after a failure the rest of the frame count is received by hand and
+ * thrown away, so SPI1 is left idle with an empty FIFO for the next
+ * transfer; it's given up on if no frame arrives for DMA_STALL_NS
+ */
+static void
+spi_flush (const SpiXfer_t *spi_p)
+{
+	uint32_t stat;
+	uint64_t since;
+
+	since = lpc32x0__now_ns();
+	while (1) {
+		stat = lpc32x0__read(&spi_p->stat);
+		if ((stat & STAT_BE) && ((stat & (STAT_EOT | STAT_SHIFTACT)) == STAT_EOT))
+			break;
+		if (!(stat & STAT_BE)) {
+			(void)lpc32x0__read(&spi_p->dat);
+			since = lpc32x0__now_ns();
+		}
+		else if ((lpc32x0__now_ns() - since) > DMA_STALL_NS)
+			break;
+	}
+	lpc32x0__write(&spi_p->stat, STAT_INTCLR);
+}
+
+static void
+put_lli (volatile uint32_t *lli_p, uint32_t src, uint32_t dest, uint32_t next, uint32_t control)
+{
+	lli_p[0] = src;
+	lli_p[1] = dest;
+	lli_p[2] = next;
+	lli_p[3] = control;
+}
+
+/*
+ * receive 'len' bytes from SPI1 (configured by 'spi_p') by DMA, and copy
+ * them to 'data_p'; the chip select is the caller's
+ * returns false if the read doesn't fit the buffer or the DMA failed
+ */
+bool
+lpc32x0__spi_dma_rx (const SpiXfer_t *spi_p, const SpiDma_t *dma_p, uint8_t *data_p, size_t len)
+{
+	bool ok = true;
+	size_t i, cnt, chunk, left, frameLen;
+	uint32_t lliPhys, control, bit, word;
+	volatile uint32_t *lli_p;
+	const volatile uint32_t *buf_p;
+
+	if ((data_p == NULL) || (len == 0))
+		return true;
+	if (len > lpc32x0__spi_dma_max(dma_p)) {
+		printf("a %zu byte read doesn't fit the %zu byte DMA buffer\n", len, dma_p->size);
+		return false;
+	}
+
+	cnt = lli_cnt(len);
+	lliPhys = dma_p->phys + (uint32_t)ALIGN_LLI(len);
+	lli_p = (volatile uint32_t*)(dma_p->buf_p + ALIGN_LLI(len));
+	for (i=0, left=len; i<cnt; ++i, left-=chunk) {
+		chunk = (left > DMA_LLI_BYTES)? DMA_LLI_BYTES : left;
+		control = (uint32_t)chunk | CTRL_SWIDTH_BYTE | CTRL_DWIDTH_BYTE | CTRL_DI;
+		if ((i + 1) == cnt)
+			control |= CTRL_I;
+		put_lli(&lli_p[i * 4], SPI1_DAT, dma_p->phys + (uint32_t)(i * DMA_LLI_BYTES),
+				((i + 1) < cnt)? lliPhys + (uint32_t)((i + 1) * DMA_LLI_SZ) : 0, control);
+	}
+
+	// the channel starts with item 0 loaded
+	bit = 1u << dma_p->channel;
+	lpc32x0__write(&dma_p->config, 0);
+	lpc32x0__write(&dma_p->intTcClear, bit);
+	lpc32x0__write(&dma_p->intErrClear, bit);
+	lpc32x0__write(&dma_p->srcAddr, lli_p[0]);
+	lpc32x0__write(&dma_p->destAddr, lli_p[1]);
+	lpc32x0__write(&dma_p->lli, lli_p[2]);
+	lpc32x0__write(&dma_p->control, lli_p[3]);
+	lpc32x0__write(&dma_p->config, CFG_E | CFG_SRCPERIPH(DMA_PERIPH_SPI1) | CFG_FLOW_P2M);
+
+	lpc32x0__write(&spi_p->con, spi_p->conBase & ~(CON_RXTX | CON_THR));
+	lpc32x0__write(&dma_p->timCtrl, TIM_CTRL_DMA);
+	for (left=len; left!=0; left-=frameLen) {
+		frameLen = (left > SPI_DMA_FRAMES)? SPI_DMA_FRAMES : left;
+		lpc32x0__write(&spi_p->frm, (uint32_t)frameLen);
+		// reading SPI1_DAT starts the receive, once the DMA has emptied
+		// the FIFO so the read doesn't take a frame
+		if (!dma_wait(spi_p, dma_p, waitEmpty)) {
+			ok = false;
+			break;
+		}
+		(void)lpc32x0__read(&spi_p->dat);
+		if (!dma_wait(spi_p, dma_p, waitEot)) {
+			ok = false;
+			break;
+		}
+		lpc32x0__write(&spi_p->stat, STAT_INTCLR);
+	}
+
+	// the last frames may still be on their way out of the FIFO
+	if (ok)
+		ok = dma_wait(spi_p, dma_p, waitDone);
+	ok = ok && !(lpc32x0__read(&dma_p->rawIntErr) & bit) && (lpc32x0__read(&dma_p->rawIntTc) & bit);
+	lpc32x0__write(&dma_p->config, 0);
+	lpc32x0__write(&dma_p->timCtrl, 0);
+	lpc32x0__write(&dma_p->intTcClear, bit);
+	lpc32x0__write(&dma_p->intErrClear, bit);
+	if (!ok) {
+		spi_flush(spi_p);
+		printf("DMA channel %u failed\n", dma_p->channel);
+		return false;
+	}
+
+	// the buffer is uncached, so it's read a word at a time
+	buf_p = (const volatile uint32_t*)dma_p->buf_p;
+	for (i=0; i<(len / 4); ++i) {
+		word = buf_p[i];
+		memcpy(&data_p[i * 4], &word, sizeof(word));
+	}
+	for (i*=4; i<len; ++i)
+		data_p[i] = dma_p->buf_p[i];
+	return true;
+}
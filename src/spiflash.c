@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * SPI-NOR flash identification
+ *
+ * a flash is looked up by its JEDEC ID (the 3 bytes RDID, 0x9f, returns:
+ * manufacturer, memory type, capacity) in a table of parts; one that isn't
+ * in the table can describe itself with SFDP (JESD216, read with 0x5a):
+ *   the SFDP header          "SFDP", the number of parameter headers
+ *   parameter header 0       the basic flash parameter table's length and
+ *                            where it is
+ *   basic table DWORD 1      4KiB erase and its opcode
+ *   basic table DWORD 2      the density
+ *   basic table DWORD 8, 9   up to 4 erase types, 2^N bytes and an opcode
+ *   basic table DWORD 10     the erase types' typical times and the factor
+ *                            to their longest (JESD216B and later)
+ *   basic table DWORD 11     the page size, the page program's typical time
+ *                            and the factor to its longest (JESD216B and later)
+ * SFDP doesn't give the clock a part runs at, so a part only known from its
+ * SFDP gets SPI_FLASH_SFDP_HZ; FAST_READ (0x0b) always takes 8 dummy clocks;
+ * without DWORD 10 and 11 it gets SPI_FLASH_PP_US and SPI_FLASH_SE_MS
+ *
+ * the SPI1 clock is HCLK / ((rate+1) x 2) (rate is SPI1_CON[6:0]), the rate
+ * for a part is the lowest one whose clock doesn't exceed the part's
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "registers.h"
+
+#define SPI_RATE_MAX 0x7f
+
+#define SFDP_SIGNATURE 0x50444653 // "SFDP"
+#define SFDP_BASIC_ID  0x00
+
+#define MHZ(n) ((n) * 1000000u)
+
+/*
+ * typical datasheet values; check them against the part actually fitted
+ * all of them erase 64KiB sectors with 0xd8 and program 256 byte pages, in
+ * no more than the M25P's 3s and 5ms
+ */
+#define PART(nm, m, t, c, sz, hz) { \
+	.name = nm, .id = {m, t, c}, .size = (sz), .sectorSize = 0x10000, \
+	.eraseCmd = 0xd8, .pageSize = 256, .fastReadHz = (hz), .fastReadDummy = 8, \
+	.programUs = SPI_FLASH_PP_US, .eraseMs = SPI_FLASH_SE_MS, \
+}
+
+static const SpiFlashPart_t builtinParts[] = {
+	PART("M25P80",     0x20, 0x20, 0x14, 0x100000, MHZ(40)),
+	PART("M25P16",     0x20, 0x20, 0x15, 0x200000, MHZ(75)),
+	PART("M25P32",     0x20, 0x20, 0x16, 0x400000, MHZ(75)),
+	PART("M25P64",     0x20, 0x20, 0x17, 0x800000, MHZ(50)),
+	PART("M25P128",    0x20, 0x20, 0x18, 0x1000000, MHZ(50)),
+	PART("W25Q16",     0xef, 0x40, 0x15, 0x200000, MHZ(104)),
+	PART("W25Q32",     0xef, 0x40, 0x16, 0x400000, MHZ(104)),
+	PART("W25Q64",     0xef, 0x40, 0x17, 0x800000, MHZ(104)),
+	PART("W25Q128",    0xef, 0x40, 0x18, 0x1000000, MHZ(104)),
+	PART("MX25L1606E", 0xc2, 0x20, 0x15, 0x200000, MHZ(86)),
+	PART("MX25L3206E", 0xc2, 0x20, 0x16, 0x400000, MHZ(86)),
+	PART("MX25L6406E", 0xc2, 0x20, 0x17, 0x800000, MHZ(86)),
+	PART("S25FL032P",  0x01, 0x02, 0x15, 0x400000, MHZ(104)),
+	PART("S25FL064P",  0x01, 0x02, 0x16, 0x800000, MHZ(104)),
+};
+static const size_t builtinPartsSZ = sizeof(builtinParts) / sizeof(builtinParts[0]);
+
+const SpiFlashPart_t *
+lpc32x0__spi_flash_parts (size_t *cnt_p)
+{
+	*cnt_p = builtinPartsSZ;
+	return builtinParts;
+}
+
+const SpiFlashPart_t *
+lpc32x0__find_spi_flash (const uint8_t *id_p)
+{
+	size_t i;
+
+	for (i=0; i<builtinPartsSZ; ++i)
+		if (memcmp(builtinParts[i].id, id_p, sizeof(builtinParts[i].id)) == 0)
+			return &builtinParts[i];
+	return NULL;
+}
+
+static uint32_t
+get24 (const uint8_t *buf_p)
+{
+	return (uint32_t)buf_p[0] | ((uint32_t)buf_p[1] << 8) | ((uint32_t)buf_p[2] << 16);
+}
+
+/*
+ * fill in 'part_p' from the first 'len' bytes of a flash's SFDP space
+ * returns false if there's no SFDP, the basic table isn't within 'len'
+ * bytes, or it describes a part this can't drive (over 16MiB, which needs
+ * 4-byte addresses, or with no erase of at most 64KiB)
+ */
+bool
+lpc32x0__parse_spi_flash_sfdp (const uint8_t *sfdp_p, size_t len, SpiFlashPart_t *part_p)
+{
+	static const unsigned eraseUnitMs[] = {1, 16, 128, 1000};
+	uint32_t ptr, dwords, dw, i, eraseType = 0, time;
+	uint64_t bits;
+	const uint8_t *basic_p;
+
+	if ((len < 16) || (lpc32x0__get32(sfdp_p) != SFDP_SIGNATURE) || (sfdp_p[8] != SFDP_BASIC_ID))
+		return false;
+	dwords = sfdp_p[11];
+	ptr = get24(&sfdp_p[12]);
+	if ((dwords < 2) || (ptr > len) || (((size_t)dwords * 4) > (len - ptr)))
+		return false;
+	basic_p = &sfdp_p[ptr];
+
+	memset(part_p, 0, sizeof(*part_p));
+	snprintf(part_p->name, sizeof(part_p->name), "SFDP %u.%u", sfdp_p[5], sfdp_p[4]);
+
+	dw = lpc32x0__get32(&basic_p[4]);
+	if (dw & 0x80000000) {
+		if ((dw & 0x7fffffff) > 63)
+			return false;
+		bits = 1ull << (dw & 0x7fffffff);
+	}
+	else
+		bits = (uint64_t)dw + 1;
+	if ((bits / 8) > 0x1000000)
+		return false;
+	part_p->size = (uint32_t)(bits / 8);
+
+	// the largest erase of at most 64KiB, 4KiB if that's all there is
+	dw = lpc32x0__get32(&basic_p[0]);
+	if ((dw & 0x3) == 0x1) {
+		part_p->sectorSize = 0x1000;
+		part_p->eraseCmd = (uint8_t)(dw >> 8);
+	}
+	for (i=0; (dwords >= 9) && (i<4); ++i) {
+		dw = lpc32x0__get32(&basic_p[28 + ((i / 2) * 4)]) >> ((i % 2) * 16);
+		if (((dw & 0xff) == 0) || ((dw & 0xff) > 16))
+			continue;
+		if ((1u << (dw & 0xff)) > part_p->sectorSize) {
+			part_p->sectorSize = 1u << (dw & 0xff);
+			part_p->eraseCmd = (uint8_t)(dw >> 8);
+			eraseType = i + 1;
+		}
+	}
+	if (part_p->sectorSize == 0)
+		return false;
+
+	// the longest time is the typical one x 2 x (factor+1)
+	part_p->eraseMs = SPI_FLASH_SE_MS;
+	if ((dwords >= 10) && (eraseType != 0)) {
+		dw = lpc32x0__get32(&basic_p[36]);
+		time = (dw >> (4 + ((eraseType - 1) * 7))) & 0x7f;
+		part_p->eraseMs = ((time & 0x1f) + 1) * eraseUnitMs[time >> 5] * 2 * ((dw & 0xf) + 1);
+	}
+	part_p->pageSize = 256;
+	part_p->programUs = SPI_FLASH_PP_US;
+	if (dwords >= 11) {
+		dw = lpc32x0__get32(&basic_p[40]);
+		part_p->pageSize = 1u << ((dw >> 4) & 0xf);
+		time = (dw >> 8) & 0x3f;
+		part_p->programUs = ((time & 0x1f) + 1) * ((time & 0x20)? 64 : 8) * 2 * ((dw & 0xf) + 1);
+	}
+	part_p->fastReadHz = SPI_FLASH_SFDP_HZ;
+	part_p->fastReadDummy = 8;
+	return true;
+}
+
+/*
+ * the lowest SPI1_CON rate (the fastest clock) at which SPI1_CLK doesn't
+ * exceed 'maxHz' with HCLK at 'hclk'
+ */
+unsigned
+lpc32x0__spi_rate (uint64_t hclk, uint32_t maxHz)
+{
+	uint64_t div;
+
+	if (maxHz == 0)
+		return SPI_RATE_MAX;
+	// (rate+1) x 2 >= hclk / maxHz
+	div = (hclk + maxHz - 1) / maxHz;
+	div = (div + 1) / 2;
+	if (div == 0)
+		return 0;
+	return (div > (SPI_RATE_MAX + 1))? SPI_RATE_MAX : (unsigned)(div - 1);
+}
@@ -0,0 +1,932 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * a behavioural model of SPI1 and the SPI-NOR flash(es) on it, for the sim
+ * backend
+ *
+ * SPI1_GLOBAL, SPI1_CON, SPI1_FRM, SPI1_IER, SPI1_STAT and SPI1_DAT are
+ * modelled, as are the chip selects (GPIO_4 and GPIO_5, driven through
+ * P3_OUTP_SET/P3_OUTP_CLR; P3_OUTP_STATE stays in the image) and the
+ * bootstick detect bit of P3_INP_STATE; the rest of the SPI1 block is
+ * plain memory
+ *
+ * the flashes are wired as on my board (see lpc32x0-spi.c):
+ *   no bootstick: the on-board flash on GPIO_5
+ *   bootstick:    the on-board flash on GPIO_4, the bootstick on GPIO_5
+ * and are M25P16s: 2MiB, 64KiB sectors, 256 byte pages, understanding
+ * RDID, RDSR, WRSR, WREN, WRDI, READ, FAST_READ, PP, SE, BE, DP and RES
+ * with the block protect bits; program and erase take their typical times,
+ * during which only RDSR is answered
+ *
+ * the SPI1 FIFO holds 64 frames; a transmit starts as soon as the FIFO has
+ * data and the frame count (SPI1_FRM) isn't used up, a receive is started
+ * by reading SPI1_DAT with a frame count set and runs until the count is
+ * used up, stalling while the FIFO is full; shift_off only stops a new
+ * receive from being started, and a frame that is shifting when SPI1_CON
+ * is changed finishes the way it started
+ *
+ * the GPDMA is modelled as far as SPI1 uses it: DMACConfig, the channel
+ * registers, the enabled/raw/masked status and the clears; a channel that
+ * is enabled with SPI1 as its source peripheral (DMA_PERIPH_SPI1) and the
+ * DMA controlling a peripheral to memory flow takes each received frame out
+ * of the FIFO as it arrives, while SPI1_TIM_CTRL's mode bit is set, and
+ * follows its linked list; it reaches the memory the sim backend has mapped
+ * (lpc32x0__map_mem()), anything else is a DMA error. memory to peripheral
+ * isn't modelled
+ *
+ * timing
+ * nothing runs in the background; time (in HCLK cycles) only moves when a
+ * modelled register is accessed, each access costing ACCESS_AHB (SPI1) or
+ * ACCESS_APB (GPIO) cycles, after which the shifter is brought up to date
+ * at (rate+1) x 2 cycles per bit (see SPI1_CON); so a program polling
+ * SPI1_STAT sees the FIFO fill or drain at the rate it would on the board,
+ * and the cycle count approximates the time the transfer would take there
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "registers.h"
+#include "sim.h"
+
+#define ACCESS_AHB 8
+#define ACCESS_APB 16
+
+#define GLOBAL_ENABLE 0x01
+#define GLOBAL_RST    0x02
+
+#define CON_RESET     0x00000e08
+#define CON_RXTX      (1u << 15)
+#define CON_THR       (1u << 14)
+#define CON_SHIFTOFF  (1u << 13)
+#define CON_MASTER    (1u << 7)
+#define CON_BITS(c)   ((((c) >> 9) & 0xf) + 1)
+#define CON_RATE(c)   ((c) & 0x7f)
+
+#define STAT_BE       0x001
+#define STAT_THR      0x002
+#define STAT_BF       0x004
+#define STAT_SHIFTACT 0x008
+#define STAT_EOT      0x080
+#define STAT_INTCLR   0x100
+
+#define FIFOSZ 64
+#define THR_RX 56
+#define THR_TX 8
+
+#define TIM_CTRL_DMA 0x001
+
+#define DMAC_ENABLE    0x001
+#define CTRL_SIZE(c)   ((c) & 0xfff)
+#define CTRL_DWIDTH(c) (((c) >> 21) & 0x7)
+#define CTRL_DI        (1u << 27)
+#define CTRL_I         (1u << 31)
+#define CFG_E          0x00001
+#define CFG_SRCPERIPH(c) (((c) >> 1) & 0x1f)
+#define CFG_FLOW(c)    (((c) >> 11) & 0x7)
+#define CFG_IE         (1u << 14)
+#define CFG_ITC        (1u << 15)
+#define CFG_MASK       0x0007ffff
+#define FLOW_P2M       2
+
+#define FLASH_SIZE     0x200000
+#define FLASH_SECTORSZ 0x10000
+#define FLASH_PAGESZ   0x100
+
+// typical M25P16 times, in ns
+#define FLASH_PP_NS 640000ull
+#define FLASH_SE_NS 600000000ull
+#define FLASH_BE_NS 13000000000ull
+#define FLASH_W_NS  1500000ull
+
+#define SR_WIP  0x01
+#define SR_WEL  0x02
+#define SR_BP   0x1c
+#define SR_SRWD 0x80
+
+#define CMD_WRSR  0x01
+#define CMD_PP    0x02
+#define CMD_READ  0x03
+#define CMD_WRDI  0x04
+#define CMD_RDSR  0x05
+#define CMD_WREN  0x06
+#define CMD_FAST  0x0b
+#define CMD_RDID  0x9f
+#define CMD_RES   0xab
+#define CMD_DP    0xb9
+#define CMD_BE    0xc7
+#define CMD_SE    0xd8
+
+static const uint8_t flashId_G[] = {0x20, 0x20, 0x15};
+#define FLASH_SIGNATURE 0x14
+
+typedef struct {
+	bool present;
+	unsigned csBit;
+	uint8_t *mem_p;
+	bool selected;
+	bool powerDown;
+	uint8_t cmd;
+	uint8_t status;
+	uint8_t newStatus;
+	uint32_t cnt;
+	uint32_t addr;
+	uint64_t busyUntil;
+	uint8_t page[FLASH_PAGESZ];
+} Flash_t;
+
+typedef struct {
+	uint32_t srcAddr;
+	uint32_t destAddr;
+	uint32_t lli;
+	uint32_t control;
+	uint32_t config;
+} DmaChan_t;
+
+struct spi_sim {
+	RegHook_t hook;
+	volatile uint32_t *p3_p;
+	bool bootstick;
+	uint32_t hclk;
+	uint64_t now;
+
+	uint32_t global;
+	uint32_t con;
+	uint32_t frm;
+	uint32_t ier;
+	bool eot;
+	uint16_t fifo[FIFOSZ];
+	unsigned fifoHead;
+	unsigned fifoCnt;
+	uint32_t framesLeft;
+	bool receiving;
+
+	bool shifting;
+	bool shiftTx;
+	unsigned shiftBits;
+	uint32_t shiftVal;
+	uint64_t shiftEnd;
+
+	uint32_t timCtrl;
+	uint32_t dmacConfig;
+	uint32_t rawIntTc;
+	uint32_t rawIntErr;
+	DmaChan_t chan[DMAC_CHANNELS];
+	SimMem_t mem;
+
+	Flash_t flash[2];
+	SpiSimStats_t stats;
+};
+
+// P3_OUTP_STATE etc. within the P3 page
+#define P3_WORD(a) (((a) & 0xfff) / 4)
+
+/*
+ * flash
+ */
+static uint64_t
+ns_to_cycles (SpiSim_t *spi_p, uint64_t ns)
+{
+	return (ns * spi_p->hclk) / 1000000000ull;
+}
+
+static bool
+flash_busy (Flash_t *flash_p, uint64_t when)
+{
+	return (when < flash_p->busyUntil);
+}
+
+static bool
+flash_protected (Flash_t *flash_p, uint32_t addr)
+{
+	unsigned bp = (flash_p->status & SR_BP) >> 2;
+
+	if (bp == 0)
+		return false;
+	if (bp >= 6)
+		return true;
+	return (addr >= (FLASH_SIZE - ((uint32_t)FLASH_SECTORSZ << (bp - 1))));
+}
+
+static void
+flash_select (SpiSim_t *spi_p, Flash_t *flash_p)
+{
+	flash_p->selected = true;
+	flash_p->cnt = 0;
+	++spi_p->stats.selects;
+}
+
+static uint8_t
+flash_byte (SpiSim_t *spi_p, Flash_t *flash_p, uint8_t out, uint64_t when)
+{
+	uint32_t n;
+
+	if (flash_p->cnt == 0) {
+		++flash_p->cnt;
+		flash_p->cmd = out;
+		flash_p->addr = 0;
+		if (flash_p->powerDown && (out != CMD_RES))
+			flash_p->cmd = 0;
+		else if (flash_busy(flash_p, when) && (out != CMD_RDSR))
+			flash_p->cmd = 0;
+		else
+			++spi_p->stats.commands;
+		if (flash_p->cmd == CMD_PP)
+			memset(flash_p->page, 0xff, sizeof(flash_p->page));
+		return 0xff;
+	}
+
+	n = flash_p->cnt++;
+	switch (flash_p->cmd) {
+		case CMD_RDID:
+			return (n <= sizeof(flashId_G))? flashId_G[n-1] : 0x00;
+
+		case CMD_RDSR:
+			return (uint8_t)(flash_p->status | (flash_busy(flash_p, when)? SR_WIP : 0));
+
+		case CMD_WRSR:
+			if (n == 1)
+				flash_p->newStatus = out;
+			break;
+
+		case CMD_READ:
+		case CMD_FAST:
+			if (n <= 3) {
+				flash_p->addr = (flash_p->addr << 8) | out;
+				break;
+			}
+			if ((flash_p->cmd == CMD_FAST) && (n == 4))
+				break;
+			return flash_p->mem_p[flash_p->addr++ & (FLASH_SIZE - 1)];
+
+		case CMD_PP:
+			if (n <= 3) {
+				flash_p->addr = (flash_p->addr << 8) | out;
+				break;
+			}
+			// more than a page wraps around and overwrites the start
+			flash_p->page[(flash_p->addr + n - 4) & (FLASH_PAGESZ - 1)] = out;
+			break;
+
+		case CMD_SE:
+			if (n <= 3)
+				flash_p->addr = (flash_p->addr << 8) | out;
+			break;
+
+		case CMD_RES:
+			if (n >= 4)
+				return FLASH_SIGNATURE;
+			break;
+	}
+	return 0xff;
+}
+
+/*
+ * the write commands, WREN/WRDI and power-down are acted on when the chip is
+ * deselected, if the right number of bytes was sent
+ */
+static void
+flash_deselect (SpiSim_t *spi_p, Flash_t *flash_p, uint64_t when)
+{
+	uint32_t i, base;
+	bool wel = (flash_p->status & SR_WEL) != 0;
+
+	flash_p->selected = false;
+	switch (flash_p->cmd) {
+		case CMD_WREN:
+			if (flash_p->cnt == 1)
+				flash_p->status |= SR_WEL;
+			break;
+
+		case CMD_WRDI:
+			if (flash_p->cnt == 1)
+				flash_p->status &= (uint8_t)~SR_WEL;
+			break;
+
+		case CMD_PP:
+			if ((flash_p->cnt < 5) || !wel)
+				break;
+			flash_p->status &= (uint8_t)~SR_WEL;
+			flash_p->addr &= FLASH_SIZE - 1;
+			if (flash_protected(flash_p, flash_p->addr))
+				break;
+			base = flash_p->addr & ~(uint32_t)(FLASH_PAGESZ - 1);
+			for (i=0; i<FLASH_PAGESZ; ++i)
+				flash_p->mem_p[base + i] &= flash_p->page[i];
+			flash_p->busyUntil = when + ns_to_cycles(spi_p, FLASH_PP_NS);
+			++spi_p->stats.programs;
+			break;
+
+		case CMD_SE:
+			if ((flash_p->cnt != 4) || !wel)
+				break;
+			flash_p->status &= (uint8_t)~SR_WEL;
+			flash_p->addr &= FLASH_SIZE - 1;
+			if (flash_protected(flash_p, flash_p->addr))
+				break;
+			memset(flash_p->mem_p + (flash_p->addr & ~(uint32_t)(FLASH_SECTORSZ - 1)), 0xff, FLASH_SECTORSZ);
+			flash_p->busyUntil = when + ns_to_cycles(spi_p, FLASH_SE_NS);
+			++spi_p->stats.erases;
+			break;
+
+		case CMD_BE:
+			if ((flash_p->cnt != 1) || !wel)
+				break;
+			flash_p->status &= (uint8_t)~SR_WEL;
+			if ((flash_p->status & SR_BP) != 0)
+				break;
+			memset(flash_p->mem_p, 0xff, FLASH_SIZE);
+			flash_p->busyUntil = when + ns_to_cycles(spi_p, FLASH_BE_NS);
+			++spi_p->stats.erases;
+			break;
+
+		case CMD_WRSR:
+			if ((flash_p->cnt != 2) || !wel)
+				break;
+			flash_p->status = (uint8_t)((flash_p->newStatus & (SR_SRWD | SR_BP)) | (flash_p->status & SR_WIP));
+			flash_p->busyUntil = when + ns_to_cycles(spi_p, FLASH_W_NS);
+			break;
+
+		case CMD_DP:
+			if (flash_p->cnt == 1)
+				flash_p->powerDown = true;
+			break;
+
+		case CMD_RES:
+			flash_p->powerDown = false;
+			break;
+	}
+	flash_p->cmd = 0;
+}
+
+/*
+ * a file image is the flash itself: it's created if need be and a short
+ * file is padded out to the full size with erased bytes
+ */
+static bool
+flash_open (Flash_t *flash_p, unsigned csBit, const char *file_p)
+{
+	int fd;
+	void *map_p;
+	struct stat st;
+
+	flash_p->present = true;
+	flash_p->csBit = csBit;
+	if (file_p == NULL) {
+		map_p = mmap(NULL, FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (map_p == MAP_FAILED) {
+			perror("mmap()");
+			return false;
+		}
+		flash_p->mem_p = map_p;
+		memset(flash_p->mem_p, 0xff, FLASH_SIZE);
+		return true;
+	}
+
+	fd = open(file_p, O_RDWR | O_CREAT, 0644);
+	if ((fd == -1) || (fstat(fd, &st) == -1)) {
+		perror(file_p);
+		if (fd != -1)
+			close(fd);
+		return false;
+	}
+	if (st.st_size > FLASH_SIZE) {
+		printf("%s: larger than the %d byte flash\n", file_p, FLASH_SIZE);
+		close(fd);
+		return false;
+	}
+	if ((st.st_size < FLASH_SIZE) && (ftruncate(fd, FLASH_SIZE) == -1)) {
+		perror(file_p);
+		close(fd);
+		return false;
+	}
+	map_p = mmap(NULL, FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map_p == MAP_FAILED) {
+		perror("mmap()");
+		return false;
+	}
+	flash_p->mem_p = map_p;
+	memset(flash_p->mem_p + st.st_size, 0xff, (size_t)(FLASH_SIZE - st.st_size));
+	return true;
+}
+
+/*
+ * SPI1
+ */
+static void
+fifo_push (SpiSim_t *spi_p, uint32_t val)
+{
+	spi_p->fifo[(spi_p->fifoHead + spi_p->fifoCnt) % FIFOSZ] = (uint16_t)val;
+	++spi_p->fifoCnt;
+}
+
+static uint32_t
+fifo_pop (SpiSim_t *spi_p)
+{
+	uint32_t val;
+
+	val = spi_p->fifo[spi_p->fifoHead];
+	spi_p->fifoHead = (spi_p->fifoHead + 1) % FIFOSZ;
+	--spi_p->fifoCnt;
+	return val;
+}
+
+static void
+spi_reset (SpiSim_t *spi_p)
+{
+	spi_p->con = CON_RESET;
+	spi_p->frm = 0;
+	spi_p->ier = 0;
+	spi_p->eot = false;
+	spi_p->fifoHead = spi_p->fifoCnt = 0;
+	spi_p->framesLeft = 0;
+	spi_p->receiving = false;
+	spi_p->shifting = false;
+}
+
+static bool
+start_frame (SpiSim_t *spi_p, uint64_t when)
+{
+	if (!(spi_p->global & GLOBAL_ENABLE) || !(spi_p->con & CON_MASTER) || (spi_p->framesLeft == 0))
+		return false;
+
+	if (spi_p->con & CON_RXTX) {
+		if (spi_p->fifoCnt == 0)
+			return false;
+		spi_p->shiftVal = fifo_pop(spi_p);
+		spi_p->shiftTx = true;
+	}
+	else {
+		if (!spi_p->receiving || (spi_p->fifoCnt == FIFOSZ))
+			return false;
+		spi_p->shiftVal = 0;
+		spi_p->shiftTx = false;
+	}
+	spi_p->shifting = true;
+	spi_p->shiftBits = CON_BITS(spi_p->con);
+	spi_p->shiftEnd = when + ((uint64_t)spi_p->shiftBits * (CON_RATE(spi_p->con) + 1) * 2);
+	if (--spi_p->framesLeft == 0)
+		spi_p->receiving = false;
+	return true;
+}
+
+/*
+ * the flashes see a frame when its last bit has been shifted; a flash that
+ * isn't selected doesn't drive the data line, which is pulled high
+ */
+static void
+finish_frame (SpiSim_t *spi_p)
+{
+	size_t i;
+	uint32_t in = 0xffffffff;
+
+	for (i=0; i<2; ++i)
+		if (spi_p->flash[i].present && spi_p->flash[i].selected)
+			in &= flash_byte(spi_p, &spi_p->flash[i], (uint8_t)spi_p->shiftVal, spi_p->shiftEnd) | 0xffffff00;
+	in &= (uint32_t)((1ull << spi_p->shiftBits) - 1);
+
+	spi_p->shifting = false;
+	if (spi_p->shiftTx)
+		++spi_p->stats.txFrames;
+	else {
+		fifo_push(spi_p, in);
+		++spi_p->stats.rxFrames;
+	}
+	if (spi_p->framesLeft == 0)
+		spi_p->eot = true;
+}
+
+/*
+ * GPDMA
+ */
+static void
+dma_error (SpiSim_t *spi_p, unsigned n)
+{
+	spi_p->chan[n].config &= ~(uint32_t)CFG_E;
+	spi_p->rawIntErr |= 1u << n;
+}
+
+// the next item of channel 'n's list, or the end of the transfer
+static void
+dma_next (SpiSim_t *spi_p, unsigned n)
+{
+	DmaChan_t *chan_p = &spi_p->chan[n];
+	uint32_t *lli_p;
+
+	if (chan_p->control & CTRL_I)
+		spi_p->rawIntTc |= 1u << n;
+	if (chan_p->lli == 0) {
+		chan_p->config &= ~(uint32_t)CFG_E;
+		return;
+	}
+	lli_p = spi_p->mem.find_fp(spi_p->mem.arg_p, chan_p->lli & ~(uint32_t)3, 4 * sizeof(uint32_t));
+	if (lli_p == NULL) {
+		dma_error(spi_p, n);
+		return;
+	}
+	chan_p->srcAddr = lli_p[0];
+	chan_p->destAddr = lli_p[1];
+	chan_p->lli = lli_p[2];
+	chan_p->control = lli_p[3];
+}
+
+/*
+ * the channels SPI1 is feeding take the frames out of the FIFO; the DMA is
+ * quick enough next to the SPI clock that it costs no time
+ */
+static void
+dma_service (SpiSim_t *spi_p)
+{
+	unsigned n;
+	size_t width;
+	uint32_t val;
+	uint8_t *dest_p;
+	DmaChan_t *chan_p;
+
+	if (!(spi_p->dmacConfig & DMAC_ENABLE) || !(spi_p->timCtrl & TIM_CTRL_DMA) || (spi_p->con & CON_RXTX))
+		return;
+
+	for (n=0; n<DMAC_CHANNELS; ++n) {
+		chan_p = &spi_p->chan[n];
+		while ((spi_p->fifoCnt != 0) && (chan_p->config & CFG_E)
+				&& (CFG_SRCPERIPH(chan_p->config) == DMA_PERIPH_SPI1)
+				&& (CFG_FLOW(chan_p->config) == FLOW_P2M)) {
+			if (CTRL_SIZE(chan_p->control) == 0) {
+				dma_next(spi_p, n);
+				continue;
+			}
+			width = (size_t)1 << CTRL_DWIDTH(chan_p->control);
+			dest_p = (width <= 4)? spi_p->mem.find_fp(spi_p->mem.arg_p, chan_p->destAddr, width) : NULL;
+			if (dest_p == NULL) {
+				dma_error(spi_p, n);
+				break;
+			}
+			val = fifo_pop(spi_p);
+			memcpy(dest_p, &val, width);
+			++spi_p->stats.dmaFrames;
+			if (chan_p->control & CTRL_DI)
+				chan_p->destAddr += (uint32_t)width;
+			chan_p->control = (chan_p->control & ~(uint32_t)0xfff) | (CTRL_SIZE(chan_p->control) - 1);
+			if (CTRL_SIZE(chan_p->control) == 0)
+				dma_next(spi_p, n);
+		}
+	}
+}
+
+static uint32_t
+dma_enabled (SpiSim_t *spi_p)
+{
+	unsigned n;
+	uint32_t val = 0;
+
+	for (n=0; n<DMAC_CHANNELS; ++n)
+		if (spi_p->chan[n].config & CFG_E)
+			val |= 1u << n;
+	return val;
+}
+
+static uint32_t
+dma_masked (SpiSim_t *spi_p, uint32_t raw, uint32_t cfgBit)
+{
+	unsigned n;
+	uint32_t val = 0;
+
+	for (n=0; n<DMAC_CHANNELS; ++n)
+		if ((raw & (1u << n)) && (spi_p->chan[n].config & cfgBit))
+			val |= 1u << n;
+	return val;
+}
+
+static uint32_t *
+dma_reg (SpiSim_t *spi_p, uint32_t addr)
+{
+	DmaChan_t *chan_p;
+
+	if ((addr < DMACC_SRCADDR(0)) || (addr > DMACC_CONFIG(DMAC_CHANNELS - 1)))
+		return NULL;
+	chan_p = &spi_p->chan[(addr - DMACC_SRCADDR(0)) / 0x20];
+	switch ((addr - DMACC_SRCADDR(0)) % 0x20) {
+		case 0x00: return &chan_p->srcAddr;
+		case 0x04: return &chan_p->destAddr;
+		case 0x08: return &chan_p->lli;
+		case 0x0c: return &chan_p->control;
+		case 0x10: return &chan_p->config;
+	}
+	return NULL;
+}
+
+// run the shifter up to 'now'
+static void
+catch_up (SpiSim_t *spi_p)
+{
+	uint64_t when = spi_p->now;
+
+	dma_service(spi_p);
+	while (1) {
+		if (spi_p->shifting) {
+			if (spi_p->shiftEnd > spi_p->now)
+				return;
+			when = spi_p->shiftEnd;
+			finish_frame(spi_p);
+			dma_service(spi_p);
+		}
+		if (!start_frame(spi_p, when))
+			return;
+	}
+}
+
+static uint32_t
+spi_stat (SpiSim_t *spi_p)
+{
+	uint32_t stat = 0;
+	unsigned thr;
+
+	if (spi_p->fifoCnt == 0)
+		stat |= STAT_BE;
+	if (spi_p->fifoCnt == FIFOSZ)
+		stat |= STAT_BF;
+	if (spi_p->con & CON_RXTX) {
+		thr = (spi_p->con & CON_THR)? THR_TX : 0;
+		if (spi_p->fifoCnt <= thr)
+			stat |= STAT_THR;
+		if (stat & STAT_BF)
+			++spi_p->stats.fullPolls;
+	}
+	else {
+		thr = (spi_p->con & CON_THR)? THR_RX : 1;
+		if (spi_p->fifoCnt >= thr)
+			stat |= STAT_THR;
+		if (stat & STAT_BE)
+			++spi_p->stats.emptyPolls;
+	}
+	if (spi_p->shifting)
+		stat |= STAT_SHIFTACT;
+	if (spi_p->eot)
+		stat |= STAT_EOT;
+	return stat;
+}
+
+static void
+update_selects (SpiSim_t *spi_p)
+{
+	size_t i;
+	bool sel;
+
+	for (i=0; i<2; ++i) {
+		if (!spi_p->flash[i].present)
+			continue;
+		// the chip selects are active low
+		sel = (spi_p->p3_p[P3_WORD(P3_OUTP_STATE)] & (1u << spi_p->flash[i].csBit)) == 0;
+		if (sel && !spi_p->flash[i].selected)
+			flash_select(spi_p, &spi_p->flash[i]);
+		else if (!sel && spi_p->flash[i].selected)
+			flash_deselect(spi_p, &spi_p->flash[i], spi_p->now);
+	}
+}
+
+static void
+tick (SpiSim_t *spi_p, uint32_t addr)
+{
+	spi_p->now += ((addr & 0xfffff000) == (P3_OUTP_STATE & 0xfffff000))? ACCESS_APB : ACCESS_AHB;
+	++spi_p->stats.accesses;
+	catch_up(spi_p);
+}
+
+static uint32_t
+spisim_read (void *dev_p, uint32_t addr)
+{
+	uint32_t val = 0;
+	uint32_t *reg_p;
+	SpiSim_t *spi_p = dev_p;
+
+	tick(spi_p, addr);
+	reg_p = dma_reg(spi_p, addr);
+	if (reg_p != NULL)
+		return *reg_p;
+	switch (addr) {
+		case SPI1_GLOBAL:
+			val = spi_p->global;
+			break;
+		case SPI1_CON:
+			val = spi_p->con;
+			break;
+		case SPI1_FRM:
+			val = spi_p->frm;
+			break;
+		case SPI1_IER:
+			val = spi_p->ier;
+			break;
+		case SPI1_STAT:
+			val = spi_stat(spi_p);
+			break;
+		case SPI1_DAT:
+			if (!(spi_p->con & CON_RXTX) && !spi_p->receiving && (spi_p->framesLeft != 0) && !(spi_p->con & CON_SHIFTOFF))
+				spi_p->receiving = true;
+			if (spi_p->fifoCnt != 0)
+				val = fifo_pop(spi_p);
+			catch_up(spi_p);
+			break;
+		case SPI1_TIM_CTRL:
+			val = spi_p->timCtrl;
+			break;
+		case DMAC_INTTCSTAT:
+			val = dma_masked(spi_p, spi_p->rawIntTc, CFG_ITC);
+			break;
+		case DMAC_INTERRSTAT:
+			val = dma_masked(spi_p, spi_p->rawIntErr, CFG_IE);
+			break;
+		case DMAC_RAWINTTCSTAT:
+			val = spi_p->rawIntTc;
+			break;
+		case DMAC_RAWINTERRSTAT:
+			val = spi_p->rawIntErr;
+			break;
+		case DMAC_ENBLDCHNS:
+			val = dma_enabled(spi_p);
+			break;
+		case DMAC_CONFIG:
+			val = spi_p->dmacConfig;
+			break;
+		case P3_INP_STATE:
+			val = spi_p->p3_p[P3_WORD(P3_INP_STATE)] & ~(uint32_t)P3_INP_BOOTSTICK;
+			if (spi_p->bootstick)
+				val |= P3_INP_BOOTSTICK;
+			break;
+	}
+	return val;
+}
+
+static void
+spisim_write (void *dev_p, uint32_t addr, uint32_t val)
+{
+	uint32_t *reg_p;
+	SpiSim_t *spi_p = dev_p;
+
+	tick(spi_p, addr);
+	reg_p = dma_reg(spi_p, addr);
+	if (reg_p != NULL) {
+		*reg_p = val;
+		if (((addr - DMACC_SRCADDR(0)) % 0x20) == 0x10)
+			*reg_p &= CFG_MASK;
+	}
+	switch (addr) {
+		case SPI1_GLOBAL:
+			spi_p->global = val & (GLOBAL_ENABLE | GLOBAL_RST);
+			if (val & GLOBAL_RST)
+				spi_reset(spi_p);
+			break;
+		case SPI1_CON:
+			spi_p->con = val & 0x00ffffff;
+			break;
+		case SPI1_FRM:
+			spi_p->frm = spi_p->framesLeft = val & 0xffff;
+			spi_p->receiving = false;
+			break;
+		case SPI1_IER:
+			spi_p->ier = val & 0x3;
+			break;
+		case SPI1_STAT:
+			if (val & STAT_INTCLR)
+				spi_p->eot = false;
+			break;
+		case SPI1_DAT:
+			if (!(spi_p->con & CON_RXTX))
+				break;
+			if (spi_p->fifoCnt == FIFOSZ)
+				++spi_p->stats.overruns;
+			else
+				fifo_push(spi_p, val & 0xffff);
+			break;
+		case SPI1_TIM_CTRL:
+			spi_p->timCtrl = val & 0x3;
+			break;
+		case DMAC_INTTCCLEAR:
+			spi_p->rawIntTc &= ~val;
+			break;
+		case DMAC_INTERRCLR:
+			spi_p->rawIntErr &= ~val;
+			break;
+		case DMAC_CONFIG:
+			spi_p->dmacConfig = val & 0x3;
+			break;
+		case P3_OUTP_SET:
+			spi_p->p3_p[P3_WORD(P3_OUTP_STATE)] |= val;
+			update_selects(spi_p);
+			break;
+		case P3_OUTP_CLR:
+			spi_p->p3_p[P3_WORD(P3_OUTP_STATE)] &= ~val;
+			update_selects(spi_p);
+			break;
+	}
+	catch_up(spi_p);
+}
+
+const RegHook_t *
+spisim_hook (SpiSim_t *spi_p, uint32_t addr)
+{
+	switch (addr) {
+		case SPI1_GLOBAL:
+		case SPI1_CON:
+		case SPI1_FRM:
+		case SPI1_IER:
+		case SPI1_STAT:
+		case SPI1_DAT:
+		case P3_INP_STATE:
+		case P3_OUTP_SET:
+		case P3_OUTP_CLR:
+		case SPI1_TIM_CTRL:
+		case DMAC_INTTCSTAT:
+		case DMAC_INTTCCLEAR:
+		case DMAC_INTERRSTAT:
+		case DMAC_INTERRCLR:
+		case DMAC_RAWINTTCSTAT:
+		case DMAC_RAWINTERRSTAT:
+		case DMAC_ENBLDCHNS:
+		case DMAC_CONFIG:
+			return &spi_p->hook;
+	}
+	if (dma_reg(spi_p, addr) != NULL)
+		return &spi_p->hook;
+	return NULL;
+}
+
+void
+spisim_get_stats (SpiSim_t *spi_p, SpiSimStats_t *stats_p)
+{
+	*stats_p = spi_p->stats;
+	stats_p->cycles = spi_p->now;
+	stats_p->hclk = spi_p->hclk;
+}
+
+/*
+ * the model's timing from now on; the time already counted is kept, in
+ * cycles of the old HCLK
+ */
+void
+spisim_set_hclk (SpiSim_t *spi_p, uint32_t hclk)
+{
+	spi_p->hclk = hclk;
+}
+
+void
+spisim_close (SpiSim_t *spi_p)
+{
+	size_t i;
+
+	if (spi_p == NULL)
+		return;
+	for (i=0; i<2; ++i)
+		if (spi_p->flash[i].mem_p != NULL)
+			munmap(spi_p->flash[i].mem_p, FLASH_SIZE);
+	free(spi_p);
+}
+
+/*
+ * 'p3_p' is the image's GPIO page (0x40028000), 'flash_p' and 'bootstick_p'
+ * are flash image files (NULL: the on-board flash is anonymous and erased,
+ * and there's no bootstick), 'mem_p' is the memory the DMA can reach
+ */
+SpiSim_t *
+spisim_open (volatile uint32_t *p3_p, uint32_t hclk, const char *flash_p, const char *bootstick_p, const SimMem_t *mem_p)
+{
+	SpiSim_t *spi_p;
+
+	spi_p = calloc(1, sizeof(*spi_p));
+	if (spi_p == NULL) {
+		perror("calloc()");
+		return NULL;
+	}
+	spi_p->hook.read_fp = spisim_read;
+	spi_p->hook.write_fp = spisim_write;
+	spi_p->hook.dev_p = spi_p;
+	spi_p->p3_p = p3_p;
+	spi_p->hclk = hclk;
+	spi_p->bootstick = (bootstick_p != NULL);
+	spi_p->mem = *mem_p;
+	spi_reset(spi_p);
+
+	if (!flash_open(&spi_p->flash[0], spi_p->bootstick? P3_OUTP_CS_GPIO4 : P3_OUTP_CS_GPIO5, flash_p)) {
+		spisim_close(spi_p);
+		return NULL;
+	}
+	if (spi_p->bootstick && !flash_open(&spi_p->flash[1], P3_OUTP_CS_GPIO5, bootstick_p)) {
+		spisim_close(spi_p);
+		return NULL;
+	}
+
+	// the boot loader leaves both chip selects high
+	spi_p->p3_p[P3_WORD(P3_OUTP_STATE)] |= (1u << P3_OUTP_CS_GPIO4) | (1u << P3_OUTP_CS_GPIO5);
+	return spi_p;
+}
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * SPI1 transfers
+ *
+ * the FIFO is filled and drained a burst at a time using the threshold
+ * flag (SPI1_CON[14] set, SPI1_STAT[1]), rather than polling SPI1_STAT
+ * before every frame:
+ *   transmit  the flag is set while at most SPI_THR_TX frames are left in
+ *             the FIFO, so SPI_FIFO_FRAMES - SPI_THR_TX frames can be
+ *             written without looking (all SPI_FIFO_FRAMES if it's empty)
+ *   receive   the flag is set once SPI_THR_RX frames have arrived, which
+ *             can all be read without looking; what's left of the frame
+ *             count after the last full burst is read once it's all in
+ * each frame count (SPI1_FRM) moves up to SPI_MAX_FRAMES frames, longer
+ * transfers are split
+ *
+ * the FIFO only goes one way at a time (SPI1_CON[15]), so a transfer in
+ * both directions is a transmit followed by a receive, e.g. a flash command
+ * and the data it returns; the chip select is the caller's
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "registers.h"
+
+#define CON_RXTX     (1u << 15)
+#define CON_THR      (1u << 14)
+
+#define STAT_BE       0x001
+#define STAT_THR      0x002
+#define STAT_SHIFTACT 0x008
+#define STAT_EOT      0x080
+#define STAT_INTCLR   0x100
+
+#define SPI_FIFO_FRAMES 56
+#define SPI_THR_TX      8
+#define SPI_THR_RX      56
+#define SPI_MAX_FRAMES  65535
+
+bool
+lpc32x0__ctx_resolve_spi (Lpc32x0Ctx_t *ctx_p, uint32_t conBase, SpiXfer_t *spi_p)
+{
+	if (!lpc32x0__ctx_resolve_reg(ctx_p, SPI1_CON, &spi_p->con))
+		return false;
+	if (!lpc32x0__ctx_resolve_reg(ctx_p, SPI1_FRM, &spi_p->frm))
+		return false;
+	if (!lpc32x0__ctx_resolve_reg(ctx_p, SPI1_STAT, &spi_p->stat))
+		return false;
+	if (!lpc32x0__ctx_resolve_reg(ctx_p, SPI1_DAT, &spi_p->dat))
+		return false;
+	spi_p->conBase = conBase & ~(CON_RXTX | CON_THR);
+	return true;
+}
+
+bool
+lpc32x0__resolve_spi (uint32_t conBase, SpiXfer_t *spi_p)
+{
+	return lpc32x0__ctx_resolve_spi(lpc32x0__default_ctx(), conBase, spi_p);
+}
+
+/*
+ * the frame count is used up once the last frame has been shifted
+ */
+static void
+wait_eot (const SpiXfer_t *spi_p)
+{
+	while ((lpc32x0__read(&spi_p->stat) & (STAT_EOT | STAT_SHIFTACT)) != STAT_EOT)
+		;
+	lpc32x0__write(&spi_p->stat, STAT_INTCLR);
+}
+
+void
+lpc32x0__spi_tx (const SpiXfer_t *spi_p, const uint8_t *data_p, size_t len)
+{
+	uint32_t stat;
+	size_t frameLen, burst;
+
+	if ((data_p == NULL) || (len == 0))
+		return;
+
+	lpc32x0__write(&spi_p->con, spi_p->conBase | CON_RXTX | CON_THR);
+	while (len) {
+		frameLen = (len > SPI_MAX_FRAMES)? SPI_MAX_FRAMES : len;
+		len -= frameLen;
+		lpc32x0__write(&spi_p->frm, (uint32_t)frameLen);
+
+		while (frameLen) {
+			stat = lpc32x0__read(&spi_p->stat);
+			if (stat & STAT_BE)
+				burst = SPI_FIFO_FRAMES;
+			else if (stat & STAT_THR)
+				burst = SPI_FIFO_FRAMES - SPI_THR_TX;
+			else
+				continue;
+			if (burst > frameLen)
+				burst = frameLen;
+			frameLen -= burst;
+			while (burst--)
+				lpc32x0__write(&spi_p->dat, *data_p++);
+		}
+		wait_eot(spi_p);
+	}
+}
+
+void
+lpc32x0__spi_rx (const SpiXfer_t *spi_p, uint8_t *data_p, size_t len)
+{
+	size_t frameLen, burst;
+
+	if ((data_p == NULL) || (len == 0))
+		return;
+
+	lpc32x0__write(&spi_p->con, spi_p->conBase | CON_THR);
+	while (len) {
+		frameLen = (len > SPI_MAX_FRAMES)? SPI_MAX_FRAMES : len;
+		len -= frameLen;
+		lpc32x0__write(&spi_p->frm, (uint32_t)frameLen);
+
+		// reading SPI1_DAT starts the receive
+		(void)lpc32x0__read(&spi_p->dat);
+
+		while (frameLen >= SPI_THR_RX) {
+			while (!(lpc32x0__read(&spi_p->stat) & STAT_THR))
+				;
+			for (burst=0; burst<SPI_THR_RX; ++burst)
+				*data_p++ = (uint8_t)lpc32x0__read(&spi_p->dat);
+			frameLen -= SPI_THR_RX;
+		}
+		wait_eot(spi_p);
+		while (frameLen--)
+			*data_p++ = (uint8_t)lpc32x0__read(&spi_p->dat);
+	}
+}
+
+/*
+ * 'txLen' bytes out, then 'rxLen' bytes in; either can be 0
+ */
+void
+lpc32x0__spi_xfer (const SpiXfer_t *spi_p, const uint8_t *tx_p, size_t txLen, uint8_t *rx_p, size_t rxLen)
+{
+	lpc32x0__spi_tx(spi_p, tx_p, txLen);
+	lpc32x0__spi_rx(spi_p, rx_p, rxLen);
+}
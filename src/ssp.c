@@ -6,213 +6,117 @@
 #include <stdio.h>
 #include "registers.h"
 
-static void
-ssp__cr0 (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[15:8]", "SCR - serial clock rate = HCLK / (CPSDVSR x (SCR+1))");
-	field = print_field(val, 15, 8);
-	printf("%d\n", field);
-
-	printf(ITEMFMT, "[7]", "CPHA - clock out phase - this bit is only used in SPI mode");
-	field = print_field(val, 7, 7);
-	if (field == 0)
-		printf("SSP captures serial data on the first clock transition of the frame");
-	else
-		printf("SSP captures serial data on the second clock transition of the frame");
-	printf("\n");
-
-	printf(ITEMFMT, "[6]", "CPOL - clock out polarity - this bit is only used in SPI mode");
-	field = print_field(val, 6, 6);
-	if (field == 0)
-		printf("SSP controller maintains the bus clock low between frames");
-	else
-		printf("SSP controller maintains the bus clock high between frames");
-	printf("\n");
-
-	printf(ITEMFMT, "[5:4]", "FRF - frame format");
-	field = print_field(val, 5, 4);
-	switch (field) {
-		case 0:
-			printf("SPI");
-			break;
-		case 1:
-			printf("TI");
-			break;
-		case 2:
-			printf("Microwire");
-			break;
-		default:
-			printf("- not supported -");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[3:0]", "DSS - data size select - number of bits transferred in each frame");
-	field = print_field(val, 3, 0);
-	if (field < 3)
-		printf("- not supported -");
-	else
-		printf("%d bit transfer", field+1);
-	printf("\n");
-}
-
-static void
-ssp__cr1 (uint32_t val)
-{
-	int bit2;
-	uint32_t field;
-
-	bit2 = val & 0x4;
-	printf(ITEMFMT, "[3]", "SOD - slave output disable");
-	field = print_field(val, 3, 3);
-	if (bit2) {
-		if (field == 1)
-			printf("block the SSP controller from driving MISO");
-		else
-			printf("allow SSP to drive MISO");
-	}
-	else
-		printf("only relevant when bit 2 (MS) == 1");
-	printf("\n");
-
-	printf(ITEMFMT, "[2]", "MS - master/slave mode (can only be written when SSE == 0)");
-	field = print_field(val, 2, 2);
-	if (field == 0)
-		printf("SSP is master; drives SCLK, MOSI, and SSEL, receives on MISO");
-	else
-		printf("SSP is slave; drives MISO, and receives on SCLK, MOSI, and SSEL");
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "SSE - SSP enable");
-	field = print_field(val, 1, 1);
-	printf("SSP is %sabled\n", field==0? "dis" : "en");
-
-	printf(ITEMFMT, "[0]", "LBM - loop back mode");
-	field = print_field(val, 0, 0);
-	if (field == 0)
-		printf("normal operation");
-	else
-		printf("loop-back mode");
-	printf("\n");
-}
-
-static void
-ssp__status (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[4]", "BSY");
-	field = print_field(val, 4, 4);
-	printf("%sbusy\n", field==0? "not " : "");
-
-	printf(ITEMFMT, "[3]", "RFF");
-	field = print_field(val, 3, 3);
-	printf("receive FIFO %sfull\n", field==0? "not " : "");
-
-	printf(ITEMFMT, "[2]", "RNE");
-	field = print_field(val, 2, 2);
-	printf("receive FIFO %sempty\n", field==1? "not " : "");
-
-	printf(ITEMFMT, "[1]", "TNF");
-	field = print_field(val, 1, 1);
-	printf("transmit FIFO %sfull\n", field==1? "not " : "");
-
-	printf(ITEMFMT, "[0]", "TFE");
-	field = print_field(val, 0, 0);
-	printf("transmit FIFO %sempty", field==0? "not " : "");
-}
-
-static void
-ssp__cpsr (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[7:0]", "clock prescale");
-	field = print_field(val, 7, 0);
-	printf("%d", field);
-}
-
-static void
-ssp__imsc (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[3]", "TXIM - interrupt when the Tx FIFO is at least half empty");
-	field = print_field(val, 3, 3);
-	printf("%sabled\n", field==1? "en" : "dis");
-
-	printf(ITEMFMT, "[2]", "RXIM - interrupt when the Rx FIFO is at least half full");
-	field = print_field(val, 2, 2);
-	printf("%sabled\n", field==1? "en" : "dis");
-
-	printf(ITEMFMT, "[1]", "RTIM - receive timeout interrupt");
-	field = print_field(val, 1, 1);
-	printf("%sabled\n", field==1? "en" : "dis");
-
-	printf(ITEMFMT, "[0]", "RORIM - receive overrun interrupt");
-	field = print_field(val, 0, 0);
-	printf("%sabled\n", field==1? "en" : "dis");
-}
-
-static void
-ssp__ris (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[3]", "TXRIS");
-	field = print_field(val, 3, 3);
-	printf("Tx FIFO is %sat least half empty\n", field==1? "" : "not ");
-
-	printf(ITEMFMT, "[2]", "RXRIS");
-	field = print_field(val, 2, 2);
-	printf("Rx FIFO is %sat least half full\n", field==1? "" : "not ");
-
-	printf(ITEMFMT, "[1]", "RTRIS");
-	field = print_field(val, 1, 1);
-	printf("Rx FIFO is %sempty and has not been read for a timeout period\n", field==1? "not " : "");
-
-	printf(ITEMFMT, "[0]", "RORRIS");
-	field = print_field(val, 0, 0);
-	printf("another frame was %scompletely received while the Rx FIFO was full", field==1? "" : "not ");
-}
-
-static void
-ssp__mis (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[3]", "TXMIS");
-	field = print_field(val, 3, 3);
-	printf("the Tx FIFO is %sat least half empty\n", field==0? "not " : "");
-
-	printf(ITEMFMT, "[2]", "RXMIS");
-	field = print_field(val, 2, 2);
-	printf("the Rx FIFO is %sat least half full\n", field==0? "not " : "");
-
-	printf(ITEMFMT, "[1]", "RTMIS");
-	field = print_field(val, 1, 1);
-	printf("the Rx FIFO is %sempty\n", field==1? "not " : "");
-
-	printf(ITEMFMT, "[0]", "RORMIS");
-	field = print_field(val, 0, 0);
-	printf("another frame was %scompletely received while the Rx FIFO was full", field==1? "" : "not ");
-}
-
-static void
-ssp__dmacr (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[1]", "TXDMAE");
-	field = print_field(val, 1, 1);
-	printf("DMA for the transmit FIFO is %sabled\n", field==1? "en" : "dis");
-
-	printf(ITEMFMT, "[0]", "RXDMAE");
-	field = print_field(val, 0, 0);
-	printf("DMA for the receive FIFO is %sabled", field==1? "en" : "dis");
-}
+static const char * const cpha[] = {
+	"SSP captures serial data on the first clock transition of the frame",
+	"SSP captures serial data on the second clock transition of the frame",
+};
+static const char * const cpol[] = {
+	"SSP controller maintains the bus clock low between frames",
+	"SSP controller maintains the bus clock high between frames",
+};
+static const char * const frf[] = {"SPI", "TI", "Microwire"};
+static const char * const dss[] = {"- not supported -", "- not supported -", "- not supported -"};
+
+static const FieldDescription_t ssp__cr0[] = {
+	{.high=15, .low=8, .name_p="SCR - serial clock rate = HCLK / (CPSDVSR x (SCR+1))", .fmt_p="%d"},
+	{.high=7,  .low=7, .name_p="CPHA - clock out phase - this bit is only used in SPI mode", FIELDTEXT(cpha)},
+	{.high=6,  .low=6, .name_p="CPOL - clock out polarity - this bit is only used in SPI mode", FIELDTEXT(cpol)},
+	{.high=5,  .low=4, .name_p="FRF - frame format", FIELDTEXT(frf), .fmt_p="- not supported -"},
+	{.high=3,  .low=0, .name_p="DSS - data size select - number of bits transferred in each frame", FIELDTEXT(dss), .fmt_p="%d bit transfer", .offset=1, .flags=fieldEOL},
+	{.name_p=NULL},
+};
+
+// qualified by MS (bit 2)
+static const char * const sod[] = {
+	"only relevant when bit 2 (MS) == 1",
+	"only relevant when bit 2 (MS) == 1",
+	"allow SSP to drive MISO",
+	"block the SSP controller from driving MISO",
+};
+static const char * const ms[] = {
+	"SSP is master; drives SCLK, MOSI, and SSEL, receives on MISO",
+	"SSP is slave; drives MISO, and receives on SCLK, MOSI, and SSEL",
+};
+static const char * const sse[] = {"SSP is disabled", "SSP is enabled"};
+static const char * const lbm[] = {"normal operation", "loop-back mode"};
+
+static const FieldDescription_t ssp__cr1[] = {
+	{.high=3, .low=3, .name_p="SOD - slave output disable", FIELDTEXT(sod), .qualBit=2, .flags=fieldQualified},
+	{.high=2, .low=2, .name_p="MS - master/slave mode (can only be written when SSE == 0)", FIELDTEXT(ms)},
+	{.high=1, .low=1, .name_p="SSE - SSP enable", FIELDTEXT(sse)},
+	{.high=0, .low=0, .name_p="LBM - loop back mode", FIELDTEXT(lbm), .flags=fieldEOL},
+	{.name_p=NULL},
+};
+
+static const char * const bsy[] = {"not busy", "busy"};
+static const char * const rff[] = {"receive FIFO not full", "receive FIFO full"};
+static const char * const rne[] = {"receive FIFO empty", "receive FIFO not empty"};
+static const char * const tnf[] = {"transmit FIFO full", "transmit FIFO not full"};
+static const char * const tfe[] = {"transmit FIFO not empty", "transmit FIFO empty"};
+
+static const FieldDescription_t ssp__status[] = {
+	{.high=4, .low=4, .name_p="BSY", FIELDTEXT(bsy)},
+	{.high=3, .low=3, .name_p="RFF", FIELDTEXT(rff)},
+	{.high=2, .low=2, .name_p="RNE", FIELDTEXT(rne)},
+	{.high=1, .low=1, .name_p="TNF", FIELDTEXT(tnf)},
+	{.high=0, .low=0, .name_p="TFE", FIELDTEXT(tfe)},
+	{.name_p=NULL},
+};
+
+static const FieldDescription_t ssp__cpsr[] = {
+	{.high=7, .low=0, .name_p="clock prescale", .fmt_p="%d"},
+	{.name_p=NULL},
+};
+
+static const char * const disabledEnabled[] = {"disabled", "enabled"};
+
+static const FieldDescription_t ssp__imsc[] = {
+	{.high=3, .low=3, .name_p="TXIM - interrupt when the Tx FIFO is at least half empty", FIELDTEXT(disabledEnabled)},
+	{.high=2, .low=2, .name_p="RXIM - interrupt when the Rx FIFO is at least half full", FIELDTEXT(disabledEnabled)},
+	{.high=1, .low=1, .name_p="RTIM - receive timeout interrupt", FIELDTEXT(disabledEnabled)},
+	{.high=0, .low=0, .name_p="RORIM - receive overrun interrupt", FIELDTEXT(disabledEnabled), .flags=fieldEOL},
+	{.name_p=NULL},
+};
+
+static const char * const txris[] = {"Tx FIFO is not at least half empty", "Tx FIFO is at least half empty"};
+static const char * const rxris[] = {"Rx FIFO is not at least half full", "Rx FIFO is at least half full"};
+static const char * const rtris[] = {
+	"Rx FIFO is empty and has not been read for a timeout period",
+	"Rx FIFO is not empty and has not been read for a timeout period",
+};
+static const char * const rorris[] = {
+	"another frame was not completely received while the Rx FIFO was full",
+	"another frame was completely received while the Rx FIFO was full",
+};
+
+static const FieldDescription_t ssp__ris[] = {
+	{.high=3, .low=3, .name_p="TXRIS", FIELDTEXT(txris)},
+	{.high=2, .low=2, .name_p="RXRIS", FIELDTEXT(rxris)},
+	{.high=1, .low=1, .name_p="RTRIS", FIELDTEXT(rtris)},
+	{.high=0, .low=0, .name_p="RORRIS", FIELDTEXT(rorris)},
+	{.name_p=NULL},
+};
+
+static const char * const txmis[] = {"the Tx FIFO is not at least half empty", "the Tx FIFO is at least half empty"};
+static const char * const rxmis[] = {"the Rx FIFO is not at least half full", "the Rx FIFO is at least half full"};
+static const char * const rtmis[] = {"the Rx FIFO is empty", "the Rx FIFO is not empty"};
+
+static const FieldDescription_t ssp__mis[] = {
+	{.high=3, .low=3, .name_p="TXMIS", FIELDTEXT(txmis)},
+	{.high=2, .low=2, .name_p="RXMIS", FIELDTEXT(rxmis)},
+	{.high=1, .low=1, .name_p="RTMIS", FIELDTEXT(rtmis)},
+	{.high=0, .low=0, .name_p="RORMIS", FIELDTEXT(rorris)},
+	{.name_p=NULL},
+};
+
+static const char * const txdmae[] = {"DMA for the transmit FIFO is disabled", "DMA for the transmit FIFO is enabled"};
+static const char * const rxdmae[] = {"DMA for the receive FIFO is disabled", "DMA for the receive FIFO is enabled"};
+
+static const FieldDescription_t ssp__dmacr[] = {
+	{.high=1, .low=1, .name_p="TXDMAE", FIELDTEXT(txdmae)},
+	{.high=0, .low=0, .name_p="RXDMAE", FIELDTEXT(rxdmae)},
+	{.name_p=NULL},
+};
 
 RegisterDescription_t ssp[] = {
 	{0x40004078, 0, "SSP_CTRL", "SSP0/1 clock control", accessRW, NULL/*see clkpwr.c*/},
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * per-register access statistics
+ *
+ * while a context is counting, each register gets the number of reads,
+ * writes and mappings it caused, and the time spent on its accesses split
+ * into:
+ *   lookup  finding the register's description (lpc32x0__get_reg() etc.)
+ *   map     finding or making the register's mapping window
+ *   access  the load or store itself (the bus, or the sim's model)
+ * accesses through a handle only have an access time
+ *
+ * the counters are indexed by the register's position in the sorted address
+ * index (see lpc32x0__reg_index()), like register images
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "registers.h"
+#include "stats.h"
+
+typedef struct {
+	unsigned long reads;
+	unsigned long writes;
+	unsigned long maps;
+	uint64_t lookupNs;
+	uint64_t mapNs;
+	uint64_t accessNs;
+} RegCounters_t;
+
+struct access_stats {
+	size_t slots;
+	RegisterDescription_t **index_pp;
+	RegCounters_t *counters_p;
+};
+
+AccessStats_t *
+stats_open (void)
+{
+	AccessStats_t *stats_p;
+
+	stats_p = calloc(1, sizeof(*stats_p));
+	if (stats_p == NULL) {
+		perror("calloc()");
+		return NULL;
+	}
+	stats_p->index_pp = lpc32x0__reg_index(&stats_p->slots);
+	if (stats_p->index_pp == NULL) {
+		free(stats_p);
+		return NULL;
+	}
+	stats_p->counters_p = calloc(stats_p->slots, sizeof(*stats_p->counters_p));
+	if (stats_p->counters_p == NULL) {
+		perror("calloc()");
+		free(stats_p);
+		return NULL;
+	}
+	return stats_p;
+}
+
+void
+stats_close (AccessStats_t *stats_p)
+{
+	if (stats_p == NULL)
+		return;
+	free(stats_p->counters_p);
+	free(stats_p);
+}
+
+// only known registers are ever accessed or mapped
+static RegCounters_t *
+counters (AccessStats_t *stats_p, uint32_t addr)
+{
+	size_t cnt;
+	RegisterDescription_t **regs_pp;
+
+	regs_pp = lpc32x0__find_reg(addr, &cnt);
+	if (regs_pp == NULL)
+		return NULL;
+	return &stats_p->counters_p[regs_pp - stats_p->index_pp];
+}
+
+void
+stats_access (AccessStats_t *stats_p, uint32_t addr, bool write, uint64_t lookupNs, uint64_t mapNs, uint64_t accessNs)
+{
+	RegCounters_t *counters_p;
+
+	counters_p = counters(stats_p, addr);
+	if (counters_p == NULL)
+		return;
+	if (write)
+		++counters_p->writes;
+	else
+		++counters_p->reads;
+	counters_p->lookupNs += lookupNs;
+	counters_p->mapNs += mapNs;
+	counters_p->accessNs += accessNs;
+}
+
+void
+stats_map (AccessStats_t *stats_p, uint32_t addr)
+{
+	RegCounters_t *counters_p;
+
+	counters_p = counters(stats_p, addr);
+	if (counters_p != NULL)
+		++counters_p->maps;
+}
+
+static const RegCounters_t *cmpCounters_pG;
+
+static uint64_t
+total_ns (const RegCounters_t *counters_p)
+{
+	return counters_p->lookupNs + counters_p->mapNs + counters_p->accessNs;
+}
+
+static int
+slot_cmp (const void *a_p, const void *b_p)
+{
+	uint64_t a = total_ns(&cmpCounters_pG[*(const size_t*)a_p]);
+	uint64_t b = total_ns(&cmpCounters_pG[*(const size_t*)b_p]);
+
+	if (a != b)
+		return (a > b)? -1 : 1;
+	return 0;
+}
+
+/*
+ * the registers that were accessed, the ones that took the most time first
+ */
+void
+stats_print (const AccessStats_t *stats_p, FILE *file_p)
+{
+	size_t i, cnt = 0;
+	size_t *slots_p;
+	unsigned long accesses;
+	const RegCounters_t *c_p;
+	RegCounters_t total = {0, 0, 0, 0, 0, 0};
+
+	slots_p = malloc((stats_p->slots? stats_p->slots : 1) * sizeof(*slots_p));
+	if (slots_p == NULL) {
+		perror("malloc()");
+		return;
+	}
+	for (i=0; i<stats_p->slots; ++i) {
+		c_p = &stats_p->counters_p[i];
+		if ((c_p->reads + c_p->writes + c_p->maps) == 0)
+			continue;
+		slots_p[cnt++] = i;
+		total.reads += c_p->reads;
+		total.writes += c_p->writes;
+		total.maps += c_p->maps;
+		total.lookupNs += c_p->lookupNs;
+		total.mapNs += c_p->mapNs;
+		total.accessNs += c_p->accessNs;
+	}
+	cmpCounters_pG = stats_p->counters_p;
+	qsort(slots_p, cnt, sizeof(*slots_p), slot_cmp);
+
+	fprintf(file_p, "register accesses (times in us):\n");
+	fprintf(file_p, "%-10s %-15s %9s %9s %6s %10s %10s %10s %9s\n",
+			"addr", "register", "reads", "writes", "maps", "lookup", "map", "access", "ns/access");
+	for (i=0; i<cnt; ++i) {
+		c_p = &stats_p->counters_p[slots_p[i]];
+		accesses = c_p->reads + c_p->writes;
+		fprintf(file_p, "0x%08x %-15s %9lu %9lu %6lu %10.1f %10.1f %10.1f %9.1f\n",
+				stats_p->index_pp[slots_p[i]]->addr, stats_p->index_pp[slots_p[i]]->name_p,
+				c_p->reads, c_p->writes, c_p->maps,
+				(double)c_p->lookupNs / 1e3, (double)c_p->mapNs / 1e3, (double)c_p->accessNs / 1e3,
+				accesses? (double)total_ns(c_p) / (double)accesses : 0.0);
+	}
+	accesses = total.reads + total.writes;
+	fprintf(file_p, "%-10s %-15s %9lu %9lu %6lu %10.1f %10.1f %10.1f %9.1f\n",
+			"total", "", total.reads, total.writes, total.maps,
+			(double)total.lookupNs / 1e3, (double)total.mapNs / 1e3, (double)total.accessNs / 1e3,
+			accesses? (double)total_ns(&total) / (double)accesses : 0.0);
+	free(slots_p);
+}
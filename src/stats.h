@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+#ifndef LPC32X0_STATS_H
+#define LPC32X0_STATS_H
+
+#include "registers.h"
+
+typedef struct access_stats AccessStats_t;
+
+AccessStats_t *stats_open (void);
+void stats_close (AccessStats_t *stats_p);
+void stats_access (AccessStats_t *stats_p, uint32_t addr, bool write, uint64_t lookupNs, uint64_t mapNs, uint64_t accessNs);
+void stats_map (AccessStats_t *stats_p, uint32_t addr);
+void stats_print (const AccessStats_t *stats_p, FILE *file_p);
+
+#endif /* LPC32X0_STATS_H */
@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * register access traces
+ *
+ * while a context is tracing, every register read and write made through it
+ * (including through handles resolved while tracing) is recorded; a trace
+ * file is a header followed by a record per access, until the end of the
+ * file, all little-endian like snapshots:
+ *
+ *   offset  size  contents
+ *   0       8     TRACE_MAGIC
+ *   8       4     version (TRACE_VERSION)
+ *   12      4     record size (TRACE_RECSZ)
+ *   16      8     time the trace was started (seconds since the epoch)
+ *   24      16*n  { ns, addr, value } records, 'ns' is the time of the access
+ *                 since the trace was started and 'addr' has TRACE_WRITE
+ *                 set for a write (registers are word aligned)
+ *
+ * recording has to be cheap enough not to change what is being traced, so
+ * the thread doing the accesses only stores each record into a ring buffer
+ * and a flush thread writes them out; there's one of each per trace, so the
+ * ring needs no lock, just the two indices
+ * if the ring fills up the recording thread waits for the flush thread,
+ * which is counted; records are never dropped
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "registers.h"
+#include "trace.h"
+
+#define TRACE_RINGSZ  (64 * 1024)
+#define TRACE_CHUNK   4096
+#define TRACE_FLUSH_NS 1000000
+#define TRACE_MAXCNT  (256 * 1024 * 1024)
+
+struct trace {
+	int fd;
+	uint64_t start;
+	pthread_t thread;
+	atomic_size_t head;
+	atomic_size_t tail;
+	atomic_bool stop;
+	bool failed;
+	unsigned long waits;
+	TraceRecord_t ring[TRACE_RINGSZ];
+	uint8_t buf[TRACE_CHUNK * TRACE_RECSZ];
+};
+
+/*
+ * once a write fails the records are still taken off the ring (so the
+ * recording thread never waits forever) but thrown away
+ */
+static void *
+flush_thread (void *arg_p)
+{
+	size_t head, tail, i, cnt;
+	bool stop;
+	Trace_t *trace_p = arg_p;
+	TraceRecord_t *rec_p;
+	struct timespec ts = {0, TRACE_FLUSH_NS};
+
+	while (1) {
+		stop = atomic_load_explicit(&trace_p->stop, memory_order_acquire);
+		tail = atomic_load_explicit(&trace_p->tail, memory_order_relaxed);
+		head = atomic_load_explicit(&trace_p->head, memory_order_acquire);
+		if (head == tail) {
+			if (stop)
+				break;
+			nanosleep(&ts, NULL);
+			continue;
+		}
+
+		cnt = head - tail;
+		if (cnt > TRACE_CHUNK)
+			cnt = TRACE_CHUNK;
+		for (i=0; i<cnt; ++i) {
+			rec_p = &trace_p->ring[(tail + i) % TRACE_RINGSZ];
+			lpc32x0__put32(&trace_p->buf[(i * TRACE_RECSZ) + 0], (uint32_t)(rec_p->ns & 0xffffffff));
+			lpc32x0__put32(&trace_p->buf[(i * TRACE_RECSZ) + 4], (uint32_t)(rec_p->ns >> 32));
+			lpc32x0__put32(&trace_p->buf[(i * TRACE_RECSZ) + 8], rec_p->addr);
+			lpc32x0__put32(&trace_p->buf[(i * TRACE_RECSZ) + 12], rec_p->val);
+		}
+		atomic_store_explicit(&trace_p->tail, tail + cnt, memory_order_release);
+
+		if (!trace_p->failed && !lpc32x0__write_all(trace_p->fd, trace_p->buf, cnt * TRACE_RECSZ)) {
+			perror("trace write()");
+			trace_p->failed = true;
+		}
+	}
+	return NULL;
+}
+
+Trace_t *
+trace_open (const char *file_p)
+{
+	int ret;
+	uint64_t when;
+	uint8_t hdr[TRACE_HDRSZ];
+	Trace_t *trace_p;
+
+	trace_p = calloc(1, sizeof(*trace_p));
+	if (trace_p == NULL) {
+		perror("calloc()");
+		return NULL;
+	}
+	trace_p->fd = open(file_p, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (trace_p->fd == -1) {
+		perror(file_p);
+		free(trace_p);
+		return NULL;
+	}
+
+	when = (uint64_t)time(NULL);
+	memcpy(hdr, TRACE_MAGIC, 8);
+	lpc32x0__put32(&hdr[8], TRACE_VERSION);
+	lpc32x0__put32(&hdr[12], TRACE_RECSZ);
+	lpc32x0__put32(&hdr[16], (uint32_t)(when & 0xffffffff));
+	lpc32x0__put32(&hdr[20], (uint32_t)(when >> 32));
+	if (!lpc32x0__write_all(trace_p->fd, hdr, sizeof(hdr))) {
+		perror(file_p);
+		close(trace_p->fd);
+		free(trace_p);
+		return NULL;
+	}
+
+	atomic_init(&trace_p->head, 0);
+	atomic_init(&trace_p->tail, 0);
+	atomic_init(&trace_p->stop, false);
+	trace_p->start = lpc32x0__now_ns();
+	ret = pthread_create(&trace_p->thread, NULL, flush_thread, trace_p);
+	if (ret != 0) {
+		errno = ret;
+		perror("pthread_create()");
+		close(trace_p->fd);
+		free(trace_p);
+		return NULL;
+	}
+	return trace_p;
+}
+
+/*
+ * write out what's left and close the trace
+ * returns false if any of it couldn't be written
+ */
+bool
+trace_close (Trace_t *trace_p)
+{
+	bool ok;
+
+	if (trace_p == NULL)
+		return true;
+	atomic_store_explicit(&trace_p->stop, true, memory_order_release);
+	pthread_join(trace_p->thread, NULL);
+	ok = !trace_p->failed;
+	if (close(trace_p->fd) == -1)
+		ok = false;
+	if (trace_p->waits != 0)
+		fprintf(stderr, "trace: waited %lu times for the ring to drain\n", trace_p->waits);
+	free(trace_p);
+	return ok;
+}
+
+void
+trace_record (Trace_t *trace_p, uint32_t addr, uint32_t val, bool write)
+{
+	size_t head;
+	TraceRecord_t *rec_p;
+
+	head = atomic_load_explicit(&trace_p->head, memory_order_relaxed);
+	if ((head - atomic_load_explicit(&trace_p->tail, memory_order_acquire)) == TRACE_RINGSZ) {
+		++trace_p->waits;
+		while ((head - atomic_load_explicit(&trace_p->tail, memory_order_acquire)) == TRACE_RINGSZ)
+			sched_yield();
+	}
+
+	rec_p = &trace_p->ring[head % TRACE_RINGSZ];
+	rec_p->ns = lpc32x0__now_ns() - trace_p->start;
+	rec_p->addr = write? (addr | TRACE_WRITE) : addr;
+	rec_p->val = val;
+	atomic_store_explicit(&trace_p->head, head + 1, memory_order_release);
+}
+
+/*
+ * read a whole trace; the returned array is malloc()'ed and holds *cnt_p
+ * records, the time the trace was started is returned in *when_p (if not
+ * NULL)
+ * returns NULL (with *cnt_p == 0) on error
+ */
+TraceRecord_t *
+lpc32x0__read_trace (FILE *file_p, size_t *cnt_p, uint64_t *when_p)
+{
+	size_t cnt = 0, max = 0;
+	uint8_t hdr[TRACE_HDRSZ];
+	uint8_t rec[TRACE_RECSZ];
+	TraceRecord_t *recs_p = NULL, *tmp_p;
+
+	if (cnt_p == NULL)
+		return NULL;
+	*cnt_p = 0;
+	if (file_p == NULL)
+		return NULL;
+
+	if (fread(hdr, sizeof(hdr), 1, file_p) != 1) {
+		printf("short trace header\n");
+		return NULL;
+	}
+	if (memcmp(hdr, TRACE_MAGIC, 8) != 0) {
+		printf("not a trace\n");
+		return NULL;
+	}
+	if ((lpc32x0__get32(&hdr[8]) != TRACE_VERSION) || (lpc32x0__get32(&hdr[12]) != TRACE_RECSZ)) {
+		printf("unsupported trace version %u (record size %u)\n", lpc32x0__get32(&hdr[8]), lpc32x0__get32(&hdr[12]));
+		return NULL;
+	}
+	if (when_p != NULL)
+		*when_p = (uint64_t)lpc32x0__get32(&hdr[16]) | ((uint64_t)lpc32x0__get32(&hdr[20]) << 32);
+
+	while (fread(rec, sizeof(rec), 1, file_p) == 1) {
+		if (cnt == max) {
+			if (max == TRACE_MAXCNT) {
+				printf("trace has more than %d records\n", TRACE_MAXCNT);
+				free(recs_p);
+				return NULL;
+			}
+			max = max? max * 2 : 4096;
+			tmp_p = realloc(recs_p, max * sizeof(*recs_p));
+			if (tmp_p == NULL) {
+				perror("realloc()");
+				free(recs_p);
+				return NULL;
+			}
+			recs_p = tmp_p;
+		}
+		recs_p[cnt].ns = (uint64_t)lpc32x0__get32(&rec[0]) | ((uint64_t)lpc32x0__get32(&rec[4]) << 32);
+		recs_p[cnt].addr = lpc32x0__get32(&rec[8]);
+		recs_p[cnt].val = lpc32x0__get32(&rec[12]);
+		++cnt;
+	}
+	// a trace cut short (e.g. the tool was killed) loses its partial record
+	if (!feof(file_p))
+		printf("error reading the trace after %zu records\n", cnt);
+
+	if (recs_p == NULL) {
+		recs_p = malloc(sizeof(*recs_p));
+		if (recs_p == NULL) {
+			perror("malloc()");
+			return NULL;
+		}
+	}
+	*cnt_p = cnt;
+	return recs_p;
+}
@@ -0,0 +1,17 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+#ifndef LPC32X0_TRACE_H
+#define LPC32X0_TRACE_H
+
+#include "registers.h"
+
+typedef struct trace Trace_t;
+
+Trace_t *trace_open (const char *file_p);
+bool trace_close (Trace_t *trace_p);
+void trace_record (Trace_t *trace_p, uint32_t addr, uint32_t val, bool write);
+
+#endif /* LPC32X0_TRACE_H */
@@ -9,327 +9,165 @@
 
 #include "registers.h"
 
-static void
-ts__adclkctrl (uint32_t val)
-{
-	uint32_t field;
+static const char * const adcClock[] = {"disable 32kHz clock to ADC block", "enable 32kHz clock to ADC block"};
 
-	printf(ITEMFMT, "[0]", "ADC clock control");
-	field = print_field(val, 0, 0);
-	printf("%sable 32kHz clock to ADC block\n", field == 0? "dis" : "en");
-}
-
-static void
-ts__adclkctrl1 (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[8]", "ADCCLK_SEL: ADC clock select");
-	field = print_field(val, 8, 8);
-	printf("clock ADC and TS from %s clock\n", field == 0? "RTC" : "PERIPH_CLK");
-
-	printf(ITEMFMT, "[7:0]", "ADC_FREQ: controls clock divider when bit [8]=1");
-	field = print_field(val, 7, 0);
-	printf("this is one less than divider\n");
-}
-
-static void
-ts__adcstat (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[8]", "TS FIFO_OVERRUN");
-	field = print_field(val, 8, 8);
-	printf("FIFO %sover run\n", field == 0? "not " : "");
-
-	printf(ITEMFMT, "[7]", "TS FIFO_EMPTY");
-	field = print_field(val, 7, 7);
-	printf("FIFO %sempty\n", field == 0? "not " : "");
-}
-
-static void
-ts__adcselect (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[9:8]", "TS_Ref- selects A/D negative reference voltage");
-	field = print_field(val, 9, 8);
-	switch (field) {
-		case 0:
-			printf("TS_XM");
-			break;
-		case 1:
-			printf("TS_YM");
-			break;
-		case 2:
-			printf("Vss");
-			break;
-		default:
-			printf("not used");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[7:6]", "TS_Ref+ selects A/D positive reference voltage");
-	field = print_field(val, 7, 6);
-	switch (field) {
-		case 0:
-			printf("TS_XP");
-			break;
-		case 1:
-			printf("TS_YP");
-			break;
-		case 2:
-			printf("VDDTS");
-			break;
-		default:
-			printf("not used");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[5:4]", "TS_IN selects the input TS ADC");
-	field = print_field(val, 5, 4);
-	switch (field) {
-		case 0:
-			printf("TS_YM");
-			break;
-		case 1:
-			printf("TS_XM");
-			break;
-		case 2:
-			printf("TS_AUX");
-			break;
-		default:
-			printf("not used");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[3]", "TS_YMC YM control");
-	field = print_field(val, 3, 3);
-	printf("the TS_YM signal to ground is %sconnected\n", field == 0? "dis" : "");
-
-	printf(ITEMFMT, "[2]", "TS_YPC YP control");
-	field = print_field(val, 2, 2);
-	printf("the TS_YP signal to VddTS is %sconnected\n", field == 0? "" : "dis");
-
-	printf(ITEMFMT, "[1]", "TS_XMC XM control");
-	field = print_field(val, 1, 1);
-	printf("the TS_XM sitnal to GND is %sconnected\n", field == 0? "dis" : "");
-
-	printf(ITEMFMT, "[0]", "TS_XPC XP control");
-	field = print_field(val, 0, 0);
-	printf("the TS_XP signal to VddTS is %sconnected\n", field == 0? "dis" : "");
-}
-
-static void
-ts__adcctrl (uint32_t val)
-{
-	uint32_t field;
-
-	printf(ITEMFMT, "[12:11]", "TS_FIFO_CTRL");
-	field = print_field(val, 12, 11);
-	printf("send TSC_IRQ on FIFO level ");
-	switch (field) {
-		case 0:
-			printf("1");
-			break;
-		case 1:
-			printf("4");
-			break;
-		case 2:
-			printf("8");
-			break;
-		default:
-			printf("16");
-			break;
-	}
-	printf("\n");
-
-	printf(ITEMFMT, "[10]", "TS_AUX_EN");
-	field = print_field(val, 10, 10);
-	printf("the AUX measured controller is %sabled\n", field == 0? "dis" : "");
-
-	printf(ITEMFMT, "[9:7]", "TS_X_ACC");
-	field = print_field(val, 9, 7);
-	printf("ADC delivers %u bits\n", 10-field);
-
-	printf(ITEMFMT, "[6:4]", "TS_Y_ACC");
-	field = print_field(val, 6, 4);
-	printf("ADC delivers %u bits\n", 10-field);
-
-	printf(ITEMFMT, "[3]", "TS_POS_DET");
-	field = print_field(val, 3, 3);
-	if (field == 0)
-		printf("normal auto mode");
-	else
-		printf("auto mode including position detect");
-	printf("\n");
-
-	printf(ITEMFMT, "[2]", "TS_ADC_PDC_CTRL");
-	field = print_field(val, 2, 2);
-	if (field == 0)
-		printf("the ADC is in power down");
-	else
-		printf("the ADC is powered up and reset");
-	printf("\n");
-
-	printf(ITEMFMT, "[1]", "TS_ADC_STROBE");
-	field = print_field(val, 1, 1);
-	printf("writing 1 starts an AD conversion\n");
+static const FieldDescription_t ts__adclkctrl[] = {
+	{.high=0, .low=0, .name_p="ADC clock control", FIELDTEXT(adcClock), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[0]", "TS_AUTO_EN");
-	field = print_field(val, 0, 0);
-	printf("the touch screen controller is %sabled\n", field == 0? "dis" : "en");
-}
+static const char * const adcClockSel[] = {"clock ADC and TS from RTC clock", "clock ADC and TS from PERIPH_CLK clock"};
 
-static void
-ts__tscsamplefifo (uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t ts__adclkctrl1[] = {
+	{.high=8, .low=8, .name_p="ADCCLK_SEL: ADC clock select", FIELDTEXT(adcClockSel)},
+	{.high=7, .low=0, .name_p="ADC_FREQ: controls clock divider when bit [8]=1", .fmt_p="this is one less than divider", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[31]", "TSC_P_LEVEL");
-	field = print_field(val, 31, 31);
-	printf("the touch screen is %spressed\n", field == 0? "" : "not ");
+static const char * const overrun[] = {"FIFO not over run", "FIFO over run"};
+static const char * const empty[] = {"FIFO not empty", "FIFO empty"};
 
-	printf(ITEMFMT, "[30]", "FIFO_EMPTY");
-	field = print_field(val, 30, 30);
-	printf("FIFO %sempty\n", field == 0? "not " : "");
+static const FieldDescription_t ts__adcstat[] = {
+	{.high=8, .low=8, .name_p="TS FIFO_OVERRUN", FIELDTEXT(overrun)},
+	{.high=7, .low=7, .name_p="TS FIFO_EMPTY", FIELDTEXT(empty), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[29]", "FIFO_OVERRUN");
-	field = print_field(val, 29, 29);
-	printf("FIFO %sover run\n", field == 0? "not " : "");
+static const char * const refMinus[] = {"TS_XM", "TS_YM", "Vss", "not used"};
+static const char * const refPlus[] = {"TS_XP", "TS_YP", "VDDTS", "not used"};
+static const char * const tsIn[] = {"TS_YM", "TS_XM", "TS_AUX", "not used"};
+static const char * const ymc[] = {"the TS_YM signal to ground is disconnected", "the TS_YM signal to ground is connected"};
+static const char * const ypc[] = {"the TS_YP signal to VddTS is connected", "the TS_YP signal to VddTS is disconnected"};
+static const char * const xmc[] = {"the TS_XM sitnal to GND is disconnected", "the TS_XM sitnal to GND is connected"};
+static const char * const xpc[] = {"the TS_XP signal to VddTS is disconnected", "the TS_XP signal to VddTS is connected"};
+
+static const FieldDescription_t ts__adcselect[] = {
+	{.high=9, .low=8, .name_p="TS_Ref- selects A/D negative reference voltage", FIELDTEXT(refMinus)},
+	{.high=7, .low=6, .name_p="TS_Ref+ selects A/D positive reference voltage", FIELDTEXT(refPlus)},
+	{.high=5, .low=4, .name_p="TS_IN selects the input TS ADC", FIELDTEXT(tsIn)},
+	{.high=3, .low=3, .name_p="TS_YMC YM control", FIELDTEXT(ymc)},
+	{.high=2, .low=2, .name_p="TS_YPC YP control", FIELDTEXT(ypc)},
+	{.high=1, .low=1, .name_p="TS_XMC XM control", FIELDTEXT(xmc)},
+	{.high=0, .low=0, .name_p="TS_XPC XP control", FIELDTEXT(xpc), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[25:16]", "TS_X_VALUE");
-	print_field(val, 25, 16);
-	printf("ADC value of the X coordinate\n");
+static const char * const fifoLevel[] = {
+	"send TSC_IRQ on FIFO level 1",
+	"send TSC_IRQ on FIFO level 4",
+	"send TSC_IRQ on FIFO level 8",
+	"send TSC_IRQ on FIFO level 16",
+};
+static const char * const auxEn[] = {"the AUX measured controller is disabled", "the AUX measured controller is enabled"};
+static const char * const accuracy[] = {
+	"ADC delivers 10 bits",
+	"ADC delivers 9 bits",
+	"ADC delivers 8 bits",
+	"ADC delivers 7 bits",
+	"ADC delivers 6 bits",
+	"ADC delivers 5 bits",
+	"ADC delivers 4 bits",
+	"ADC delivers 3 bits",
+};
+static const char * const posDet[] = {"normal auto mode", "auto mode including position detect"};
+static const char * const adcPdc[] = {"the ADC is in power down", "the ADC is powered up and reset"};
+static const char * const autoEn[] = {"the touch screen controller is disabled", "the touch screen controller is enabled"};
+
+static const FieldDescription_t ts__adcctrl[] = {
+	{.high=12, .low=11, .name_p="TS_FIFO_CTRL", FIELDTEXT(fifoLevel)},
+	{.high=10, .low=10, .name_p="TS_AUX_EN", FIELDTEXT(auxEn)},
+	{.high=9,  .low=7,  .name_p="TS_X_ACC", FIELDTEXT(accuracy)},
+	{.high=6,  .low=4,  .name_p="TS_Y_ACC", FIELDTEXT(accuracy)},
+	{.high=3,  .low=3,  .name_p="TS_POS_DET", FIELDTEXT(posDet)},
+	{.high=2,  .low=2,  .name_p="TS_ADC_PDC_CTRL", FIELDTEXT(adcPdc)},
+	{.high=1,  .low=1,  .name_p="TS_ADC_STROBE", .fmt_p="writing 1 starts an AD conversion"},
+	{.high=0,  .low=0,  .name_p="TS_AUTO_EN", FIELDTEXT(autoEn), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[9:0]", "TS_Y_VALUE");
-	print_field(val, 9, 0);
-	printf("ADC value of the Y coordinate\n");
-}
+static const char * const pLevel[] = {"the touch screen is pressed", "the touch screen is not pressed"};
 
-static void
-ts__tscdtr (uint32_t val)
-{
-	printf(ITEMFMT, "[19:0]", "TSC_DTR");
-	print_field(val, 19, 0);
-	printf("TS controller delay time register\n");
-}
+static const FieldDescription_t ts__tscsamplefifo[] = {
+	{.high=31, .low=31, .name_p="TSC_P_LEVEL", FIELDTEXT(pLevel)},
+	{.high=30, .low=30, .name_p="FIFO_EMPTY", FIELDTEXT(empty)},
+	{.high=29, .low=29, .name_p="FIFO_OVERRUN", FIELDTEXT(overrun)},
+	{.high=25, .low=16, .name_p="TS_X_VALUE", .fmt_p="ADC value of the X coordinate"},
+	{.high=9,  .low=0,  .name_p="TS_Y_VALUE", .fmt_p="ADC value of the Y coordinate", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscrtr (uint32_t val)
-{
-	printf(ITEMFMT, "[19:0]", "TSC_RTR");
-	print_field(val, 19, 0);
-	printf("touch screen controller rise time\n");
-}
+static const FieldDescription_t ts__tscdtr[] = {
+	{.high=19, .low=0, .name_p="TSC_DTR", .fmt_p="TS controller delay time register", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscutr (uint32_t val)
-{
-	printf(ITEMFMT, "[19:0]", "TSC_UTR");
-	print_field(val, 19, 0);
-	printf("touch screen controller update time\n");
-}
+static const FieldDescription_t ts__tscrtr[] = {
+	{.high=19, .low=0, .name_p="TSC_RTR", .fmt_p="touch screen controller rise time", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscttr (uint32_t val)
-{
-	printf(ITEMFMT, "[19:0]", "TSC_TTR");
-	print_field(val, 19, 0);
-	printf("touch screen controller touch time\n");
-}
+static const FieldDescription_t ts__tscutr[] = {
+	{.high=19, .low=0, .name_p="TSC_UTR", .fmt_p="touch screen controller update time", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscdxp (uint32_t val)
-{
-	printf(ITEMFMT, "[19:0]", "TSC_DXP");
-	print_field(val, 19, 0);
-	printf("touch screen controller drain x plate time\n");
-}
+static const FieldDescription_t ts__tscttr[] = {
+	{.high=19, .low=0, .name_p="TSC_TTR", .fmt_p="touch screen controller touch time", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscminx (uint32_t val)
-{
-	printf(ITEMFMT, "[9:0]", "TSC_MIN_X");
-	print_field(val, 9, 0);
-	printf("touch screen controller minimum X value\n");
-}
+static const FieldDescription_t ts__tscdxp[] = {
+	{.high=19, .low=0, .name_p="TSC_DXP", .fmt_p="touch screen controller drain x plate time", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscmaxx (uint32_t val)
-{
-	printf(ITEMFMT, "[9:0]", "TSC_MAX_X");
-	print_field(val, 9, 0);
-	printf("touch screen controller maximum X value\n");
-}
+static const FieldDescription_t ts__tscminx[] = {
+	{.high=9, .low=0, .name_p="TSC_MIN_X", .fmt_p="touch screen controller minimum X value", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscminy (uint32_t val)
-{
-	printf(ITEMFMT, "[9:0]", "TSC_MIN_Y");
-	print_field(val, 9, 0);
-	printf("touch screen controller minimum Y value\n");
-}
+static const FieldDescription_t ts__tscmaxx[] = {
+	{.high=9, .low=0, .name_p="TSC_MAX_X", .fmt_p="touch screen controller maximum X value", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscmaxy (uint32_t val)
-{
-	printf(ITEMFMT, "[9:0]", "TSC_MAX_Y");
-	print_field(val, 9, 0);
-	printf("touch screen controller maximum Y value\n");
-}
+static const FieldDescription_t ts__tscminy[] = {
+	{.high=9, .low=0, .name_p="TSC_MIN_Y", .fmt_p="touch screen controller minimum Y value", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscauxutr (uint32_t val)
-{
-	printf(ITEMFMT, "[31:0]", "TSC_AUX_UTR");
-	print_field(val, 31, 0);
-	printf("touch screen controller AUX update time\n");
-}
+static const FieldDescription_t ts__tscmaxy[] = {
+	{.high=9, .low=0, .name_p="TSC_MAX_Y", .fmt_p="touch screen controller maximum Y value", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscauxmin (uint32_t val)
-{
-	printf(ITEMFMT, "[9:0]", "TSC_AUX_MIN");
-	print_field(val, 9, 0);
-	printf("touch screen controller AUX minimum value\n");
-}
+static const FieldDescription_t ts__tscauxutr[] = {
+	{.high=31, .low=0, .name_p="TSC_AUX_UTR", .fmt_p="touch screen controller AUX update time", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscauxmax (uint32_t val)
-{
-	printf(ITEMFMT, "[9:0]", "TSC_AUX_MAX");
-	print_field(val, 9, 0);
-	printf("touch screen controller AUX maximum value\n");
-}
+static const FieldDescription_t ts__tscauxmin[] = {
+	{.high=9, .low=0, .name_p="TSC_AUX_MIN", .fmt_p="touch screen controller AUX minimum value", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscauxvalue (uint32_t val)
-{
-	printf(ITEMFMT, "[9:0]", "TSC_AUX_VALUE");
-	print_field(val, 9, 0);
-	printf("touch screen controller AUX value\n");
-}
+static const FieldDescription_t ts__tscauxmax[] = {
+	{.high=9, .low=0, .name_p="TSC_AUX_MAX", .fmt_p="touch screen controller AUX maximum value", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-static void
-ts__tscadcvalue (uint32_t val)
-{
-	uint32_t field;
+static const FieldDescription_t ts__tscauxvalue[] = {
+	{.high=9, .low=0, .name_p="TSC_AUX_VALUE", .fmt_p="touch screen controller AUX value", .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
-	printf(ITEMFMT, "[9:0]", "ADC_VALUE");
-	print_field(val, 9, 0);
-	printf("ADC value of last conversion\n");
+static const char * const adcPLevel[] = {"touch screen is pressed", "touch is not pressed"};
 
-	printf(ITEMFMT, "[10]", "TSC_P_LEVEL");
-	field = print_field(val, 10, 10);
-	if (field == 0)
-		printf("touch screen is pressed\n");
-	else
-		printf("touch is not pressed\n");
-}
+static const FieldDescription_t ts__tscadcvalue[] = {
+	{.high=9,  .low=0,  .name_p="ADC_VALUE", .fmt_p="ADC value of last conversion"},
+	{.high=10, .low=10, .name_p="TSC_P_LEVEL", FIELDTEXT(adcPLevel), .flags=fieldEOL},
+	{.name_p=NULL},
+};
 
 RegisterDescription_t ts[] = {
 	{0x400040b4, 0,          "ADCLK_CTRL", "ADC clock control", accessRW, ts__adclkctrl},
@@ -337,7 +175,7 @@ RegisterDescription_t ts[] = {
 	{0x40048000, 0x00000080, "ADC_STAT", "A/D status", accessRead, ts__adcstat},
 	{0x40048004, 0x00000004, "ADC_SELECT", "A/D/ select state", accessRW, ts__adcselect},
 	{0x40048008, 0,          "ADC_CTRL", "A/D control", accessRW, ts__adcctrl},
-	{0x4004800c, 0,          "TSC_SAMPLE_FIFO", "touchscreen sample FIFO", accessRead, ts__tscsamplefifo},
+	{0x4004800c, 0,          "TSC_SAMPLE_FIFO", "touchscreen sample FIFO", accessRead | accessPop, ts__tscsamplefifo},
 	{0x40048010, 0,          "TSC_DTR", "touchscreen delay time", accessRW, ts__tscdtr},
 	{0x40048014, 0,          "TSC_RTR", "touchscreen rise time", accessRW, ts__tscrtr},
 	{0x40048018, 0,          "TSC_UTR", "touchscreen update time", accessRW, ts__tscutr},
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: OSL-3.0
+/*
+ * Copyright (C) 2022  Trevor Woerner <twoerner@gmail.com>
+ */
+
+/*
+ * small helpers shared by the library and the programs
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "registers.h"
+
+// CLOCK_MONOTONIC, in ns
+uint64_t
+lpc32x0__now_ns (void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * the files (snapshots, traces) and SFDP are little-endian
+ */
+void
+lpc32x0__put32 (uint8_t *buf_p, uint32_t val)
+{
+	buf_p[0] = val & 0xff;
+	buf_p[1] = (val >> 8) & 0xff;
+	buf_p[2] = (val >> 16) & 0xff;
+	buf_p[3] = (val >> 24) & 0xff;
+}
+
+uint32_t
+lpc32x0__get32 (const uint8_t *buf_p)
+{
+	return (uint32_t)buf_p[0] | ((uint32_t)buf_p[1] << 8) | ((uint32_t)buf_p[2] << 16) | ((uint32_t)buf_p[3] << 24);
+}
+
+/*
+ * write all of 'len' bytes, retrying short writes and EINTR
+ */
+bool
+lpc32x0__write_all (int fd, const uint8_t *buf_p, size_t len)
+{
+	ssize_t ret;
+
+	while (len != 0) {
+		ret = write(fd, buf_p, len);
+		if (ret == -1) {
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		buf_p += ret;
+		len -= (size_t)ret;
+	}
+	return true;
+}